@@ -46,6 +46,9 @@ __constant double p = 0.95;
 #pragma OPENCL EXTENSION cl_amd_printf : enable
 #pragma OPENCL EXTENSION cl_amd_fp64 : enable
 
+// No fused multiply-add, so the profits match those computed on the host bit for bit.
+#pragma OPENCL FP_CONTRACT OFF
+
 //Important : all the variables that start with the prefix 'param_' are passed to the Open CL C compiler as inline parameter (see.: BuildOptions)
 
 //----------------------------------------------------------------------------
@@ -32,6 +32,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <clRNG/clRNG.h>
 #include "../common.h"
@@ -42,6 +43,15 @@
 #include <clRNG/mrg31k3p.h>
 /*! [clRNG header] */
 
+//Report whether the CPU and the device produced the same summaries of their results, bit for bit
+static void compareSummaries(int count, const StatSummary* cpu, const StatSummary* gpu)
+{
+	if (memcmp(cpu, gpu, count * sizeof(StatSummary)) == 0)
+		printf("\nCPU and device results are identical (%d summar%s)\n", count, count > 1 ? "ies" : "y");
+	else
+		printf("\nCPU and device results differ\n");
+}
+
 //************************************************************************
 // Policies
 //************************************************************************
@@ -50,6 +60,7 @@ int one_Policy(cl_context context, cl_device_id device, cl_command_queue queue,
 	OnePolicyData* data = (OnePolicyData*)data_;
 	int n = data->n;
 	int n1 = data->n1;
+	int n2 = (n1 == 0 ? 0 : n / n1);
 	int m = data->m;
 	int s = data->s;
 	int S = data->S;
@@ -62,22 +73,19 @@ int one_Policy(cl_context context, cl_device_id device, cl_command_queue queue,
 
 	clrngStatus err;
 	size_t streamBufferSize;
-	size_t NbrStreams = ((execType == basic || execType == Case_a) ? 1 : n);
+	size_t NbrStreams = ((execType == basic || execType == Case_a) ? 1 : (execType == Case_c ? n1 : n));
 
-	//Create profit stat
-	double *stat_profit = (double *)malloc(n * sizeof(double));
+	//Create profit stat for the CPU; the results of the device are summarized on the device
+	double *stat_cpu = (double *)malloc(n * sizeof(double));
+	StatSummary summary_cpu, summary_gpu;
 
 	//Creator used to reset the state of the base seed in case there is successive calls to the same "Option"
 	clrngMrg31k3pStreamCreator* Creator = clrngMrg31k3pCopyStreamCreator(NULL, &err);
 	check_error(err, "%s(): cannot create stream creator", __func__);
 
-	
-
 	//Create stream demand
-	if (execType == basic || execType == Case_a || execType == Case_b) {		
-		stream_demand = clrngMrg31k3pCreateStreams(Creator, NbrStreams, &streamBufferSize, &err);
-		check_error(err, "%s(): cannot create random stream demand", __func__);
-	}
+	stream_demand = clrngMrg31k3pCreateStreams(Creator, NbrStreams, &streamBufferSize, &err);
+	check_error(err, "%s(): cannot create random stream demand", __func__);
 
 	//*************************
 	//Simulate on CPU
@@ -85,82 +93,69 @@ int one_Policy(cl_context context, cl_device_id device, cl_command_queue queue,
 	{
 		// in the document, this corresponds to the call to
 		// inventorySimulateRunsOneStream()
-		inventorySimulateRunsCPU(m, s, S, n, stream_demand, NULL, stat_profit, execType, results);
-
+		inventorySimulateRunsCPU(m, &s, &S, 1, n, 0, 0, OnePolicy, basic, stream_demand, NULL, stat_cpu, NULL, results);
 	}
-	else if (execType == Case_a || execType == Case_b)
+	else
 	{
-		//Set the result object ExecOption
-		if (results != NULL){
-			if (execType == Case_a) results->ExecOption = 2;
-			else results->ExecOption = 3;
-		}
+		//Set the result object ExecOption (2 to 5 for cases a to d)
+		if (results != NULL) results->ExecOption = execType;
 
+		//Create stream order
 		stream_order = clrngMrg31k3pCreateStreams(Creator, NbrStreams, &streamBufferSize, &err);
 		check_error(err, "%s(): cannot create random stream order", __func__);
 
-		// in the document, this corresponds to the calls to
+		if (execType == Case_a)
+		{
+			// in the document, this corresponds to the call to
+			// inventorySimulateRunsSubstreams(): run i uses substream i of both streams
+			substreams_demand = clrngMrg31k3pMakeSubstreams(stream_demand, n, &streamBufferSize, &err);
+			check_error(err, "%s(): cannot create random substreams demand", __func__);
+
+			substreams_order = clrngMrg31k3pMakeSubstreams(stream_order, n, &streamBufferSize, &err);
+			check_error(err, "%s(): cannot create random substreams order", __func__);
+		}
+
+		// in the document, case (b) corresponds to the call to
 		// inventorySimulateRunsManyStreams()
-		// inventorySimulateRunsSubstreams()
-		inventorySimulateRunsCPU(m, s, S, n, stream_demand, stream_order, stat_profit, execType, results);
+		inventorySimulateRunsCPU(m, &s, &S, 1, n, n1, n2, OnePolicy, execType,
+			(execType == Case_a ? substreams_demand : stream_demand), (execType == Case_a ? substreams_order : stream_order),
+			stat_cpu, &summary_cpu, results);
 	}
 
 	//*************************
 	//Simulate on Device
 	if (execType != basic){
 
-		if (stream_demand != NULL)
-		    clrngMrg31k3pRewindStreams(NbrStreams, stream_demand);
-		if (stream_order != NULL)
-		    clrngMrg31k3pRewindStreams(NbrStreams, stream_order);
-
 		if (execType == Case_a)
 		{
 			if (results != NULL) (&results[3])->ExecOption = 2;
 			printf("\n+++++++++     On Device (case a) : One policy, two streams with their substreams \n");
-			substreams_demand = clrngMrg31k3pMakeSubstreams(stream_demand, n, &streamBufferSize, &err);
-			check_error(err, "%s(): cannot create random substreams demand", __func__);
-
-			substreams_order = clrngMrg31k3pMakeSubstreams(stream_order, n, &streamBufferSize, &err);
-			check_error(err, "%s(): cannot create random substreams order", __func__);
-
-			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, 0, 0, OnePolicy, "inventorySimulateGPU", streamBufferSize, substreams_demand, substreams_order, stat_profit, (results != NULL?&results[3]:NULL));
-		
+			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, 0, 0, OnePolicy, "inventorySimulateGPU", streamBufferSize, substreams_demand, substreams_order, NULL, &summary_gpu, (results != NULL?&results[3]:NULL));
 		}
 		else if (execType == Case_b)
 		{
 			if (results != NULL) (&results[3])->ExecOption = 3;
 			printf("\n+++++++++     On Device (case b) : One policy, two arrays of n streams each \n");
-			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, 0, 0, OnePolicy, "inventorySimulateGPU", streamBufferSize, stream_demand, stream_order, stat_profit, (results != NULL ? &results[3] : NULL));
+			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, 0, 0, OnePolicy, "inventorySimulateGPU", streamBufferSize, stream_demand, stream_order, NULL, &summary_gpu, (results != NULL ? &results[3] : NULL));
 		}
 		else if (execType == Case_c)
 		{
-			if (results != NULL) results->ExecOption = 4;
+			if (results != NULL) (&results[3])->ExecOption = 4;
 			printf("\n+++++++++     On Device (case c) : One policy, using 2*n1 streams with n2 substreams on each \n");
-			stream_demand = clrngMrg31k3pCreateStreams(Creator, n1, &streamBufferSize, &err);
-			check_error(err, "%s(): cannot create random stream demand", __func__);
-
-			stream_order = clrngMrg31k3pCreateStreams(Creator, n1, &streamBufferSize, &err);
-			check_error(err, "%s(): cannot create random stream order", __func__);
-
-			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, n1, n / n1, OnePolicy, "inventorySimulSubstreamsGPU", streamBufferSize, stream_demand, stream_order, stat_profit, results);
+			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, n1, n2, OnePolicy, "inventorySimulSubstreamsGPU", streamBufferSize, stream_demand, stream_order, NULL, &summary_gpu, (results != NULL ? &results[3] : NULL));
 		}
 		else if (execType == Case_d)
 		{
-			if (results != NULL) results->ExecOption = 5;
+			if (results != NULL) (&results[3])->ExecOption = 5;
 			printf("\n+++++++++     On Device (case d) : One policy, using 2*n streams with 2*n2 streams per Work item \n");
-			stream_demand = clrngMrg31k3pCreateStreams(Creator, n, &streamBufferSize, &err);
-			check_error(err, "%s(): cannot create random stream demand", __func__);
-
-			stream_order = clrngMrg31k3pCreateStreams(Creator, n, &streamBufferSize, &err);
-			check_error(err, "%s(): cannot create random stream order", __func__);
-
-			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, n1, n / n1, OnePolicy, "inventorySimul_DistinctStreams_GPU", streamBufferSize, stream_demand, stream_order, stat_profit, results);
+			inventorySimulateRunsGPU(context, device, queue, m, &s, &S, 1, n, n1, n2, OnePolicy, "inventorySimul_DistinctStreams_GPU", streamBufferSize, stream_demand, stream_order, NULL, &summary_gpu, (results != NULL ? &results[3] : NULL));
 		}
+
+		compareSummaries(1, &summary_cpu, &summary_gpu);
 	}
 
 	//Free resources
-	free(stat_profit);
+	free(stat_cpu);
 	clrngMrg31k3pDestroyStreams(stream_demand);
 	clrngMrg31k3pDestroyStreams(stream_order);
 	clrngMrg31k3pDestroyStreams(substreams_demand);
@@ -184,13 +179,21 @@ int several_Policies(cl_context context, cl_device_id device, cl_command_queue q
 
 	//Declare streams & vars
 	clrngMrg31k3pStream* streams_demand = NULL, *streams_order = NULL;
-	double *stat_profit = NULL, *stat_diff = NULL;
+	double *stat_profit = NULL, *stat_cpu = NULL, *stat_diff = NULL;
+	StatSummary *summaries_cpu = NULL, *summaries_gpu = NULL;
 
 	clrngStatus err;
 	size_t streamBufferSize;
 
-	//Allocate stat profit for  n*P runs
-	stat_profit = (double *)malloc(n * P * sizeof(double));
+	//Allocate stat profit for  n*P runs; the device results are transferred only for Option1,
+	//whose policies are simulated in separate launches, to compute their differences
+	if (_optionType == Option1)
+		stat_profit = (double *)malloc(n * P * sizeof(double));
+	stat_cpu = (double *)malloc(n * P * sizeof(double));
+
+	//Summaries of the P policies and of their P - 1 differences with policy 0
+	summaries_cpu = (StatSummary *)malloc((2 * P - 1) * sizeof(StatSummary));
+	summaries_gpu = (StatSummary *)malloc((2 * P - 1) * sizeof(StatSummary));
 
 	//Creator used to reset the state of the base seed in case there is successive calls to the same "Option"
 	clrngMrg31k3pStreamCreator* Creator = clrngMrg31k3pCopyStreamCreator(NULL, &err);
@@ -209,10 +212,12 @@ int several_Policies(cl_context context, cl_device_id device, cl_command_queue q
 		printf("+++++++++     Simulate n2 runs on n1 work items using 2*n1 streams and n2 substreams for each, for P policies in series \n");
 		printf("+++++++++     CRN simulation : \n");
 		for (int k = 0; k < P; k++) {
-			inventorySimulateRunsGPU(context, device, queue, m, &s[k], &S[k], P, n, n1, n/n1, Option1, "inventorySimulSubstreamsGPU", streamBufferSize, streams_demand, streams_order, &stat_profit[k*n], NULL);
+			inventorySimulateRunsCPU(m, &s[k], &S[k], P, n, n1, n/n1, Option1, Case_c, streams_demand, streams_order, &stat_cpu[k*n], &summaries_cpu[k], NULL);
+			inventorySimulateRunsGPU(context, device, queue, m, &s[k], &S[k], P, n, n1, n/n1, Option1, "inventorySimulSubstreamsGPU", streamBufferSize, streams_demand, streams_order, &stat_profit[k*n], &summaries_gpu[k], NULL);
 			clrngMrg31k3pRewindStreams(n1, streams_demand);
 			clrngMrg31k3pRewindStreams(n1, streams_order);
 		}
+		compareSummaries(P, summaries_cpu, summaries_gpu);
 		//Compute CI
 		stat_diff = (double *)malloc(n * sizeof(double));
 		for (int i = 0; i < n; i++)
@@ -222,7 +227,11 @@ int several_Policies(cl_context context, cl_device_id device, cl_command_queue q
 
 		printf("\n+++++++++     IRN simulation : \n");
 		for (int k = 0; k < P; k++) {
-			inventorySimulateRunsGPU(context, device, queue, m, &s[k], &S[k], P, n, n1, n / n1, Option1, "inventorySimulSubstreamsGPU", streamBufferSize, streams_demand, streams_order, &stat_profit[k*n], NULL);
+			inventorySimulateRunsCPU(m, &s[k], &S[k], P, n, n1, n / n1, Option1, Case_c, streams_demand, streams_order, &stat_cpu[k*n], &summaries_cpu[k], NULL);
+			inventorySimulateRunsGPU(context, device, queue, m, &s[k], &S[k], P, n, n1, n / n1, Option1, "inventorySimulSubstreamsGPU", streamBufferSize, streams_demand, streams_order, &stat_profit[k*n], &summaries_gpu[k], NULL);
+
+			clrngMrg31k3pDestroyStreams(streams_demand);
+			clrngMrg31k3pDestroyStreams(streams_order);
 
 			streams_demand = clrngMrg31k3pCreateStreams(NULL, n1, &streamBufferSize, &err);
 			check_error(err, "%s(): cannot create random streams demand", __func__);
@@ -231,6 +240,8 @@ int several_Policies(cl_context context, cl_device_id device, cl_command_queue q
 			check_error(err, "%s(): cannot create random streams order", __func__);
 
 		}
+		compareSummaries(P, summaries_cpu, summaries_gpu);
+
 		//Compute CI
 		for (int i = 0; i < n; i++)
 			stat_diff[i] = stat_profit[n + i] - stat_profit[i];
@@ -242,20 +253,15 @@ int several_Policies(cl_context context, cl_device_id device, cl_command_queue q
 		if (results != NULL) results->ExecOption = 7;
 		
 		//printf("+++++++++     Simulate n2 runs on n1p workitmes using n1 streams and n2 substreams, all P policies in parallel\n");
+		inventorySimulateRunsCPU(m, s, S, P, n * P, n1 * P, n/n1, Option2, Case_c, streams_demand, streams_order, stat_cpu, summaries_cpu, NULL);
 		inventorySimulateRunsGPU(context, device, queue, m, s, S, P, n * P, n1 * P, n/n1, Option2, "inventorySimulPoliciesGPU",
-			                streamBufferSize, streams_demand, streams_order, stat_profit, results);
+			                streamBufferSize, streams_demand, streams_order, NULL, summaries_gpu, results);
+		compareSummaries(2 * P - 1, summaries_cpu, summaries_gpu);
 
-		//Compute CI
-		stat_diff = (double *)malloc(n * sizeof(double));
-		int n2 = n / n1;
-		for (int j = 0; j < n2; j++)
-			for (int i = 0; i < n1; i++)
-			{
-				int index = i + (j*n1*P);
-				stat_diff[i + j*n1] = stat_profit[n1 + index] - stat_profit[index];
-			}
+		//Compute CI, from the summaries of the differences computed on the device
 		//printf("\nDifference:\n ------------\n");
-		computeCI(n, stat_diff, results);
+		for (int k = 1; k < P; k++)
+			reportCI(&summaries_gpu[P + k - 1], results);
 	}
 
 	//Free Resources
@@ -265,6 +271,9 @@ int several_Policies(cl_context context, cl_device_id device, cl_command_queue q
 	clrngMrg31k3pDestroyStreamCreator(Creator);
 	free(stat_diff);
 	free(stat_profit);
+	free(stat_cpu);
+	free(summaries_cpu);
+	free(summaries_gpu);
 
 	return EXIT_SUCCESS;
 }
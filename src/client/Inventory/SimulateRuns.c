@@ -34,6 +34,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+
 #include <clRNG/clRNG.h>
 #include <clRNG/mrg31k3p.h>
 #include "../common.h"
@@ -52,6 +53,33 @@
 
 static char _options[255];
 
+//************************************************************************
+// Statistics
+//************************************************************************
+
+//Layout of the n results of a simulation, for the statistics: with Option2, each row of
+//workItems = n1*P results holds n1 runs for each of the P policies in turn, and the
+//differences with policy 0 are also summarized.
+static void statLayout(ExecOption Option, int P, int n, int workItems, int* runs, int* rowLength, int* P_layout, int* series)
+{
+	*runs = (Option == Option2 ? n / P : n);
+	*rowLength = (Option == Option2 ? workItems : n);
+	*P_layout = (Option == Option2 ? P : 1);
+	*series = (Option == Option2 ? 2 * P - 1 : 1);
+}
+
+static void reportSummaries(ExecOption Option, int P, const StatSummary* summaries, simResult * results)
+{
+	if (Option != Option2) {
+		reportCI(&summaries[0], results);
+		return;
+	}
+	for (int i = 0; i < P; i++) {
+		printf("Policy %d :\n", i);
+		reportCI(&summaries[i], NULL);
+	}
+}
+
 //************************************************************************
 // Device Simulation
 //************************************************************************
@@ -89,7 +117,7 @@ char * Build_Options(char _options[255], int m, int n2, int s, int S, int P)
 clrngStatus inventorySimulateRunsGPU(cl_context context, cl_device_id device, cl_command_queue queue, 
 	                            int m, int* s, int* S, int P, int n, int n1, int n2, ExecOption Option,
 								const char * kernelName, size_t streamsBufSize, clrngMrg31k3pStream * streams_demand, clrngMrg31k3pStream * streams_order, 
-								double *stat, simResult * results)
+								double *stat, StatSummary * summaries, simResult * results)
 {
 	cl_int err;
 	size_t global_size;
@@ -157,13 +185,23 @@ clrngStatus inventorySimulateRunsGPU(cl_context context, cl_device_id device, cl
 	clGetEventProfilingInfo(prof_event, CL_PROFILING_COMMAND_END, sizeof(time_end), &time_end, NULL);
 	cl_ulong total_GPU_time = time_end - time_start;
 
-	// After execution, transfer the results in the stat_diff array.
-	err = clEnqueueReadBuffer(queue, stat_buffer, CL_TRUE, 0, n * sizeof(double), stat, 0, NULL, NULL);
-	check_error(err, "%s(): cannot read the buffer", __func__);
+	// Summarize the results on the device; only the summaries are transferred.
+	int runs, rowLength, P_layout, series;
+	statLayout(Option, P, n, (int)global_size, &runs, &rowLength, &P_layout, &series);
+	StatSummary * local_summaries = (summaries == NULL ? (StatSummary *)malloc(series * sizeof(StatSummary)) : NULL);
+	if (summaries == NULL) summaries = local_summaries;
+	total_GPU_time += reduce_statistics(context, device, queue, stat_buffer, runs, rowLength, P_layout, series, summaries);
+
+	// Transfer the results themselves only if they were requested.
+	if (stat != NULL) {
+		err = clEnqueueReadBuffer(queue, stat_buffer, CL_TRUE, 0, n * sizeof(double), stat, 0, NULL, NULL);
+		check_error(err, "%s(): cannot read the buffer", __func__);
+	}
 
-	if (Option != Option2) printf("\nTotal GPU time (sec.): %1.5f\n", (total_GPU_time / 1.0e9));
+	printf("\nTotal GPU time (sec.): %1.5f\n", (total_GPU_time / 1.0e9));
 
-	computeCI(n, stat, results);
+	reportSummaries(Option, P, summaries, results);
+	free(local_summaries);
 
 	//Record results
 	if (results != NULL){
@@ -213,50 +251,121 @@ double inventorySimulateOneRun(int m, int s, int S, clrngMrg31k3pStream* stream_
 }
 /* [simulate one run] */
 
-clrngStatus inventorySimulateRunsCPU(int m, int s, int S, int n, clrngMrg31k3pStream* stream_demand, clrngMrg31k3pStream* stream_order, 
-	                                 double *stat_profit, ExecType execType, simResult * results)
+//CPU counterpart of a kernel launch
+typedef struct CPUJob_ {
+	int m;
+	int* s;
+	int* S;
+	int P;
+	int n2;              // Runs per work item.
+	int globalSize;      // Total number of work items.
+	ExecOption Option;
+	ExecType execType;
+	const clrngMrg31k3pStream* streams_demand;
+	const clrngMrg31k3pStream* streams_order;
+	double* stat;
+} CPUJob;
+
+//Work item gid of the device kernel selected by the job, using private copies of its streams
+static void inventorySimulateWorkItemCPU(const CPUJob* job, int gid)
+{
+	clrngMrg31k3pStream stream_demand_d, stream_order_d;
+
+	if (job->Option == Option2) {
+		// inventorySimulPoliciesGPU : policy gid / n1, streams gid % n1 and their substreams.
+		int n1 = job->globalSize / job->P;
+		int policy = gid / n1;
+		clrngMrg31k3pCopyOverStreams(1, &stream_demand_d, &job->streams_demand[gid % n1]);
+		clrngMrg31k3pCopyOverStreams(1, &stream_order_d, &job->streams_order[gid % n1]);
+		for (int i = 0; i < job->n2; i++) {
+			job->stat[i * job->globalSize + gid] = inventorySimulateOneRun(job->m, job->s[policy], job->S[policy], &stream_demand_d, &stream_order_d);
+			clrngMrg31k3pForwardToNextSubstreams(1, &stream_demand_d);
+			clrngMrg31k3pForwardToNextSubstreams(1, &stream_order_d);
+		}
+	}
+	else if (job->execType == Case_c) {
+		// inventorySimulSubstreamsGPU : streams gid and n2 of their substreams.
+		clrngMrg31k3pCopyOverStreams(1, &stream_demand_d, &job->streams_demand[gid]);
+		clrngMrg31k3pCopyOverStreams(1, &stream_order_d, &job->streams_order[gid]);
+		for (int i = 0; i < job->n2; i++) {
+			job->stat[i * job->globalSize + gid] = inventorySimulateOneRun(job->m, job->s[0], job->S[0], &stream_demand_d, &stream_order_d);
+			clrngMrg31k3pForwardToNextSubstreams(1, &stream_demand_d);
+			clrngMrg31k3pForwardToNextSubstreams(1, &stream_order_d);
+		}
+	}
+	else if (job->execType == Case_d) {
+		// inventorySimul_DistinctStreams_GPU : streams i * n1 + gid, i = 0..n2-1.
+		for (int i = 0; i < job->n2; i++) {
+			int j = i * job->globalSize + gid;
+			clrngMrg31k3pCopyOverStreams(1, &stream_demand_d, &job->streams_demand[j]);
+			clrngMrg31k3pCopyOverStreams(1, &stream_order_d, &job->streams_order[j]);
+			job->stat[j] = inventorySimulateOneRun(job->m, job->s[0], job->S[0], &stream_demand_d, &stream_order_d);
+		}
+	}
+	else {
+		// inventorySimulateGPU, cases (a) and (b) : streams (or substreams) gid.
+		clrngMrg31k3pCopyOverStreams(1, &stream_demand_d, &job->streams_demand[gid]);
+		clrngMrg31k3pCopyOverStreams(1, &stream_order_d, &job->streams_order[gid]);
+		job->stat[gid] = inventorySimulateOneRun(job->m, job->s[0], job->S[0], &stream_demand_d, &stream_order_d);
+	}
+}
+
+//Run one contiguous range of the work items of the CPU simulation, as task index of count
+static void runWorkItems(size_t index, size_t count, void* arg)
+{
+	const CPUJob* job = (const CPUJob*)arg;
+	int first = (int)((long long)index * job->globalSize / (long long)count);
+	int last = (int)((long long)(index + 1) * job->globalSize / (long long)count);
+	for (int gid = first; gid < last; gid++)
+		inventorySimulateWorkItemCPU(job, gid);
+}
+
+clrngStatus inventorySimulateRunsCPU(int m, int* s, int* S, int P, int n, int n1, int n2, ExecOption Option, ExecType execType,
+	                                 clrngMrg31k3pStream* streams_demand, clrngMrg31k3pStream* streams_order,
+	                                 double *stat, StatSummary * summaries, simResult * results)
 {
-	clock_t start = clock();
+	CPUJob job = { m, s, S, P, n2, 0, Option, execType, streams_demand, streams_order, stat };
+	int threadCount = 1;
 
-	if (execType == basic){
+	double start = wall_time();
+
+	if (Option == OnePolicy && execType == basic){
 		// (basic case) : Performs n independent simulation runs of the system for m days with the (s,S) policy
 		// using a single stream and the same substream for everything, and saves daily profit values.
 		// Equivalent implementation of inventorySimulateRunsOneStream() from the document.
+		// Every run continues the same stream, so the runs cannot be distributed across threads.
 		for (int i = 0; i < n; i++)
-			stat_profit[i] = inventorySimulateOneRun(m, s, S, stream_demand, stream_demand);
+			stat[i] = inventorySimulateOneRun(m, s[0], S[0], streams_demand, streams_demand);
 		if (results != NULL) results->ExecOption = 1;
 	}
-
-	else if (execType == Case_a){
-		//Case (a) : Similar to (basic), but using two streams and their substreams.
-		// Equivalent implementation of inventorySimulateRunsSubstreams() from the document.
-		for (int i = 0; i < n; i++){
-			stat_profit[i] = inventorySimulateOneRun(m, s, S, stream_demand, stream_order);
-			clrngMrg31k3pForwardToNextSubstreams(1, stream_demand);
-			clrngMrg31k3pForwardToNextSubstreams(1, stream_order);
-		}
-		if (results != NULL) results->ExecOption = 2;
+	else {
+		// Same work items as the device kernels; n1 == 0 means one work item per run.
+		job.globalSize = (n1 == 0 ? n : n1);
+		threadCount = (int)processor_count();
+		if (threadCount > job.globalSize)
+			threadCount = job.globalSize;
+		threadCount = (int)run_threads(threadCount, runWorkItems, &job);
 	}
 
-	else if (execType == Case_b){
-		//Case (b) : Similar to (basic), but with two arrays of n streams each, using a new pair of streams for each run.
-		// Equivalent implementation of inventorySimulateRunsManyStreams() from the document.
-		for (int i = 0; i < n; i++)
-			stat_profit[i] = inventorySimulateOneRun(m, s, S, &stream_demand[i], &stream_order[i]);
-		if (results != NULL) results->ExecOption = 3;
-	}
+	//Summarize the results, as on the device
+	int runs, rowLength, P_layout, series;
+	statLayout(Option, P, n, (n1 == 0 ? n : n1), &runs, &rowLength, &P_layout, &series);
+	StatSummary * local_summaries = (summaries == NULL ? (StatSummary *)malloc(series * sizeof(StatSummary)) : NULL);
+	if (summaries == NULL) summaries = local_summaries;
+	statSummarize(stat, runs, rowLength, P_layout, series, summaries);
+
 	//Compute Execution Time
-	clock_t end = clock();
-	float CPU_time = (float)(end - start) / CLOCKS_PER_SEC;
-	printf("\nTotal CPU time (sec.): %1.6f\n", CPU_time);
+	double CPU_time = wall_time() - start;
+	printf("\nTotal CPU time (sec.): %1.6f  (%d thread%s)\n", CPU_time, threadCount, threadCount > 1 ? "s" : "");
 
 	//Compute CI
-	computeCI(n, stat_profit, results);
+	reportSummaries(Option, P, summaries, results);
+	free(local_summaries);
 
 	//Record results
 	if (results != NULL){
 		results->SimType = CPU_Exec;
-		results->CPU_time = CPU_time;
+		results->CPU_time = (float)CPU_time;
 	}
 
 	return (clrngStatus)EXIT_SUCCESS;
@@ -35,12 +35,20 @@
 
 #include <clRNG/mrg31k3p.h>
 #include "../common.h"
+#include "Types.h"
 
 //Device Simulation
-clrngStatus inventorySimulateRunsGPU(cl_context context, cl_device_id device, cl_command_queue queue, int m, int* s, int* S, int P, int n, int n1, int n2, ExecOption Option, const char * kernelName, size_t streamsBufSize, clrngMrg31k3pStream * streams_demand, clrngMrg31k3pStream * streams_order, double *stat, simResult * results);
+//The results are summarized on the device by reduce_statistics(), and transferred to stat only if
+//stat is not NULL.  If not NULL, summaries receives the summary of the results or, with Option2,
+//those of the P policies followed by those of their differences with policy 0.
+clrngStatus inventorySimulateRunsGPU(cl_context context, cl_device_id device, cl_command_queue queue, int m, int* s, int* S, int P, int n, int n1, int n2, ExecOption Option, const char * kernelName, size_t streamsBufSize, clrngMrg31k3pStream * streams_demand, clrngMrg31k3pStream * streams_order, double *stat, StatSummary * summaries, simResult * results);
 
 //CPU Simulation
-clrngStatus inventorySimulateRunsCPU(int m, int s, int S, int n, clrngMrg31k3pStream* streams_demand, clrngMrg31k3pStream* streams_order, double *stat_profit, ExecType execType, simResult * results);
+//Runs the work items of the kernel used by the device simulation on all processors, so results
+//match those of inventorySimulateRunsGPU() called with the same arguments; execType selects the
+//kernel for OnePolicy and Option1 (Case_c), and basic runs serially on streams_demand[0].
+//The summaries are computed with statSummarize(), the host counterpart of reduce_statistics().
+clrngStatus inventorySimulateRunsCPU(int m, int* s, int* S, int P, int n, int n1, int n2, ExecOption Option, ExecType execType, clrngMrg31k3pStream* streams_demand, clrngMrg31k3pStream* streams_order, double *stat, StatSummary * summaries, simResult * results);
 
 
 
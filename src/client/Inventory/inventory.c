@@ -100,28 +100,26 @@ int main()
 		}
 		case 4: {
 			printf("\n===========================================================================\n ONE POLICY:\n=============\n");
-			//no CPU implementation : (case c) 
+			printf("+++++++++     On CPU (case c) : One policy, using 2*n1 streams with n2 substreams on each \n");
 			OnePolicyData data = { n, n1, m, s[0], S[0], Case_c };
 			ret = call_with_opencl(platform_index, device_type, device_index, &one_Policy, &data, true);
 			break;
 		}
 		case 5: {
 			printf("\n===========================================================================\n ONE POLICY:\n=============\n");
-			//no CPU implementation : (case d)
+			printf("+++++++++     On CPU (case d) : One policy, using 2*n streams with 2*n2 streams per Work item \n");
 			OnePolicyData data = { n, n1, m, s[0], S[0], Case_d };
 			ret = call_with_opencl(platform_index, device_type, device_index, &one_Policy, &data, true);
 			break;
 		}
 		case 6: {
 			printf("\n===========================================================================\n Several policies Option1:\n=========\n");
-			//no CPU implementation : Several policies (option 1)
 			SeveralPoliciesData data = { n, n1, m, s, S, P, Option1 };
 			ret = call_with_opencl(platform_index, device_type, device_index, &several_Policies, &data, true);
 			break;
 		}
 		case 7: {
 			printf("\n===========================================================================\n Several policies Option2:\n=========\n");
-			//no CPU implementation : Several policies (option 2)
 			SeveralPoliciesData data = { n, n1, m, s, S, P, Option2 };
 			ret = call_with_opencl(platform_index, device_type, device_index, &several_Policies, &data, false);
 			break;
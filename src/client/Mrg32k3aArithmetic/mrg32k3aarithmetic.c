@@ -0,0 +1,169 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/* Throughput of the integer and floating-point recurrences of MRG32k3a on an
+ * OpenCL device (the CPU by default).
+ *
+ * The same kernel is built without and with CLRNG_MRG32K3A_FP_ARITHMETIC and
+ * run on the same streams; the final states of both runs must be identical,
+ * and equal to those obtained on the host with clrngMrg32k3aAdvanceStreams().
+ *
+ * Usage: Mrg32k3aArithmetic [cpu|gpu] [streams] [values per stream]
+ */
+
+#if defined(__APPLE__) || defined(__MACOSX)
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "../common.h"
+
+#include <clRNG/mrg32k3a.h>
+
+typedef struct TaskData_ {
+    size_t stream_count;
+    cl_uint per_stream;
+} TaskData;
+
+/* Run the kernel built with the given options on a copy of the streams.
+ * Returns the kernel time in seconds and leaves the final streams in \c out.
+ */
+static double run(cl_context context, cl_device_id device, cl_command_queue queue, const char* options,
+    const TaskData* data, const clrngMrg32k3aStream* streams, size_t streams_size, clrngMrg32k3aStream* out)
+{
+    cl_int err;
+    cl_program program = build_program_from_file(context, device,
+	    "client/Mrg32k3aArithmetic/mrg32k3aarithmetic_kernel.cl", PATH_RELATIVE_TO_LIB, options);
+    cl_kernel kernel = clCreateKernel(program, "sumU01", &err);
+    check_error(err, "cannot create kernel");
+
+    cl_mem streams_buf = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+	    streams_size, (void*)streams, &err);
+    check_error(err, "cannot create streams buffer");
+    cl_mem sums_buf = clCreateBuffer(context, CL_MEM_WRITE_ONLY,
+	    data->stream_count * sizeof(cl_float), NULL, &err);
+    check_error(err, "cannot create sums buffer");
+
+    err  = clSetKernelArg(kernel, 0, sizeof(streams_buf), &streams_buf);
+    err |= clSetKernelArg(kernel, 1, sizeof(data->per_stream), &data->per_stream);
+    err |= clSetKernelArg(kernel, 2, sizeof(sums_buf), &sums_buf);
+    check_error(err, "cannot set kernel arguments");
+
+    cl_event event;
+    size_t global_size = data->stream_count;
+    err = clEnqueueNDRangeKernel(queue, kernel, 1, NULL, &global_size, NULL, 0, NULL, &event);
+    check_error(err, "cannot enqueue kernel");
+    err = clWaitForEvents(1, &event);
+    check_error(err, "error waiting for events");
+
+    cl_ulong start, end;
+    clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(start), &start, NULL);
+    clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END,   sizeof(end),   &end,   NULL);
+
+    err = clEnqueueReadBuffer(queue, streams_buf, CL_TRUE, 0, streams_size, out, 0, NULL, NULL);
+    check_error(err, "cannot read streams buffer");
+
+    clReleaseEvent(event);
+    clReleaseMemObject(sums_buf);
+    clReleaseMemObject(streams_buf);
+    clReleaseKernel(kernel);
+    clReleaseProgram(program);
+
+    return (end - start) / 1.0e9;
+}
+
+/* Count the streams whose current states differ */
+static size_t count_diff(size_t count, const clrngMrg32k3aStream* a, const clrngMrg32k3aStream* b)
+{
+    size_t diff = 0;
+    for (size_t i = 0; i < count; i++)
+	if (memcmp(&a[i].current, &b[i].current, sizeof(a[i].current)) != 0)
+	    diff++;
+    return diff;
+}
+
+int task(cl_context context, cl_device_id device, cl_command_queue queue, void* data_)
+{
+    clrngStatus err;
+    const TaskData* data = (const TaskData*) data_;
+    size_t count = data->stream_count;
+
+    size_t streams_size;
+    clrngMrg32k3aStream* streams = clrngMrg32k3aCreateStreams(NULL, count, &streams_size, &err);
+    check_error(err, "cannot create random streams");
+    clrngMrg32k3aStream* out_int = clrngMrg32k3aCopyStreams(count, streams, &err);
+    check_error(err, "cannot copy streams");
+    clrngMrg32k3aStream* out_fp = clrngMrg32k3aCopyStreams(count, streams, &err);
+    check_error(err, "cannot copy streams");
+
+    // warm-up run, to exclude one-time costs from the first measurement
+    run(context, device, queue, NULL, data, streams, streams_size, out_int);
+
+    double t_int = run(context, device, queue, NULL, data, streams, streams_size, out_int);
+    double t_fp  = run(context, device, queue, "-DCLRNG_MRG32K3A_FP_ARITHMETIC", data, streams, streams_size, out_fp);
+
+    double values = (double)count * data->per_stream;
+    printf("\n%lu streams, %u values per stream\n\n", (unsigned long)count, data->per_stream);
+    printf("recurrence        time (s)     values/s\n");
+    printf("integer       %12.5f %12.4g\n", t_int, values / t_int);
+    printf("floating-point%12.5f %12.4g\n", t_fp,  values / t_fp);
+    printf("\nspeedup of the floating-point recurrence: %.2f\n", t_int / t_fp);
+
+    // compare the final states with each other and with the host
+    err = clrngMrg32k3aAdvanceStreams(count, streams, 0, (cl_int)data->per_stream);
+    check_error(err, "cannot advance streams");
+    size_t diff_fp = count_diff(count, out_int, out_fp);
+    size_t diff_host = count_diff(count, out_int, streams);
+    printf("\nstreams with different states: %lu (integer vs floating-point), %lu (device vs host)\n",
+	(unsigned long)diff_fp, (unsigned long)diff_host);
+
+    clrngMrg32k3aDestroyStreams(out_fp);
+    clrngMrg32k3aDestroyStreams(out_int);
+    clrngMrg32k3aDestroyStreams(streams);
+
+    return diff_fp == 0 && diff_host == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[])
+{
+    cl_device_type device_type = argc > 1 && strcmp(argv[1], "gpu") == 0 ? CL_DEVICE_TYPE_GPU : CL_DEVICE_TYPE_CPU;
+    TaskData data = {
+	data.stream_count = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : (size_t)1 << 14,
+	data.per_stream   = argc > 3 ? (cl_uint)strtoul(argv[3], NULL, 10) : 1 << 12
+    };
+
+    return call_with_opencl(0, device_type, 0, &task, &data, true);
+}
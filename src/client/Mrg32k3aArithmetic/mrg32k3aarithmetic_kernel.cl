@@ -0,0 +1,50 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/* Kernel of the Mrg32k3aArithmetic client, built with and without
+ * CLRNG_MRG32K3A_FP_ARITHMETIC.
+ */
+
+#define CLRNG_SINGLE_PRECISION
+#include <clRNG/mrg32k3a.clh>
+
+__kernel void sumU01(__global clrngMrg32k3aHostStream* streams, uint perStream, __global float* sums) {
+    int gid = get_global_id(0);
+    clrngMrg32k3aStream private_stream_d;
+    clrngMrg32k3aCopyOverStreamsFromGlobal(1, &private_stream_d, &streams[gid]);
+    float sum = 0.0f;
+    for (uint i = 0; i < perStream; i++)
+        sum += clrngMrg32k3aRandomU01(&private_stream_d);
+    sums[gid] = sum;
+    // the final states are compared between the two recurrences
+    clrngMrg32k3aCopyOverStreamsToGlobal(1, &streams[gid], &private_stream_d);
+}
@@ -0,0 +1,101 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/* Throughput of the Philox-4x32 bijection for different numbers of rounds.
+ *
+ * The bijection is timed directly for each number of rounds, over the same
+ * counters, and the library generator is timed for the number of rounds it
+ * was built with (CLRNG_PHILOX432_ROUNDS).
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <clRNG/philox432.h>
+#include <clRNG/private/Random123/philox.h>
+
+static double elapsed(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char* argv[])
+{
+    // number of counters to encrypt (4 outputs each)
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : (size_t)1 << 24;
+    const unsigned rounds[] = { 7, 10 };
+    cl_uint check = 0;
+    double seconds[2];
+
+    printf("%lu counters (%lu outputs)\n\n", (unsigned long)count, (unsigned long)(4 * count));
+    printf("rounds     time (s)    outputs/s\n");
+
+    for (size_t r = 0; r < sizeof(rounds) / sizeof(rounds[0]); r++) {
+	philox4x32_key_t key = { { 0, 0 } };
+	philox4x32_ctr_t ctr = { { 0, 0, 0, 0 } };
+	clock_t start = clock();
+	for (size_t i = 0; i < count; i++) {
+	    ctr.v[0] = (cl_uint)i;
+	    philox4x32_ctr_t out = philox4x32_R(rounds[r], ctr, key);
+	    // keep the computation from being optimized away
+	    check ^= out.v[0] ^ out.v[1] ^ out.v[2] ^ out.v[3];
+	}
+	seconds[r] = elapsed(start);
+	printf("%6u %12.4f %12.4g\n", rounds[r], seconds[r], 4 * count / seconds[r]);
+    }
+    printf("\nspeedup of %u rounds over %u rounds: %.2f\n", rounds[0], rounds[1], seconds[1] / seconds[0]);
+
+    // library generator, through the stream interface
+    clrngStatus err;
+    clrngPhilox432Stream* stream = clrngPhilox432CreateStreams(NULL, 1, NULL, &err);
+    if (err != CLRNG_SUCCESS) {
+	fprintf(stderr, "cannot create stream: %s\n", clrngGetErrorString());
+	return EXIT_FAILURE;
+    }
+    cl_double* numbers = (cl_double*)malloc(4 * count * sizeof(cl_double));
+    clock_t start = clock();
+    err = clrngPhilox432RandomU01Array(stream, 4 * count, numbers);
+    double t = elapsed(start);
+    if (err != CLRNG_SUCCESS) {
+	fprintf(stderr, "cannot generate numbers: %s\n", clrngGetErrorString());
+	return EXIT_FAILURE;
+    }
+    printf("\nclrngPhilox432RandomU01Array() with %d rounds: %.4f s, %.4g values/s\n",
+	CLRNG_PHILOX432_ROUNDS, t, 4 * count / t);
+
+    printf("(checksum %08x %.6f)\n", check, numbers[4 * count - 1]);
+    free(numbers);
+    clrngPhilox432DestroyStreams(stream);
+
+    return EXIT_SUCCESS;
+}
@@ -77,12 +77,6 @@ typedef struct TaskData_ {
     int display;
 } TaskData;
 
-void multistream_fill_array(size_t stream_count, clrngStream* streams, size_t number_count, fp_type* numbers)
-{
-  for (size_t i = 0; i < number_count; i++)
-    numbers[i] = clrngRandomU01(&streams[i % stream_count]);
-}
-
 int task(cl_context context, cl_device_id device, cl_command_queue queue, void* data_)
 {
     cl_int err;
@@ -101,7 +95,8 @@ int task(cl_context context, cl_device_id device, cl_command_queue queue, void*
 
     // fill array on the host, using the same ordering as on the device
     clock_t host_start_time = clock();
-    multistream_fill_array(stream_count, streams, number_count, numbers_host);
+    err = clrngHostRandomU01Array(stream_count, streams, number_count, numbers_host, 0);
+    check_error(err, "cannot fill array on the host");
     clock_t host_end_time = clock();
 
     if (data->display) {
@@ -113,9 +108,6 @@ int task(cl_context context, cl_device_id device, cl_command_queue queue, void*
     // output computing time
     printf("\nComputing time on the host: %1.5f s\n", (float)(host_end_time - host_start_time) / CLOCKS_PER_SEC);
 
-    // reset streams for usage on device
-    clrngRewindStreams(stream_count, streams);
-
     // create OpenCL buffers
     /*! [streams buffer] */
     cl_mem streams_buf = clCreateBuffer(context, CL_MEM_HOST_WRITE_ONLY | CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, streams_buf_size, streams, &err);
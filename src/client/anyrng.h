@@ -113,6 +113,7 @@
 #define clrngMakeOverSubstreams         RNG_MEMBER_(RNG_PREFIX, MakeOverSubstreams)
 #define clrngAdvanceSubstreams          RNG_MEMBER_(RNG_PREFIX, AdvanceSubstreams)
 #define clrngDeviceRandomU01Array       RNG_MEMBER_(RNG_PREFIX, DeviceRandomU01Array)
+#define clrngHostRandomU01Array         RNG_MEMBER_(RNG_PREFIX, HostRandomU01Array)
 #define clrngWriteStreamInfo            RNG_MEMBER_(RNG_PREFIX, WriteStreamInfo)
 
 #ifdef __CLRNG_DEVICE_API
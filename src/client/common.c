@@ -30,13 +30,25 @@
  ***********************************************************************
  */
 
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
+#include <time.h>
 #include "common.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #include <clRNG/clRNG.h>
 
 
@@ -49,17 +61,18 @@
 
 // Computes and prints the average, variance, and a 95\% CI on the mean
 // for the n values in statTally.
-// The variance is computed in a simple (unsafe) way, via a sum of squares.
 void computeCI(int n, double* stat_tally, simResult * results)
 {
-	double sum = 0.0;
-	double sum_squares = 0.0;
-	for (int i = 0; i<n; i++) {
-		sum += stat_tally[i];
-		sum_squares += stat_tally[i] * stat_tally[i];
-	}
-	double average = sum / n;
-	double variance = (sum_squares - average * sum) / (n - 1);
+	StatSummary stat;
+	statSummarize(stat_tally, n, n, 1, 1, &stat);
+	reportCI(&stat, results);
+}
+
+void reportCI(const StatSummary* stat, simResult * results)
+{
+	int n = (int)stat->count;
+	double average = stat->mean;
+	double variance = stat->M2 / (n - 1);
 	double halfwidth = 1.96 * sqrt(variance / n); // CI half-width.
 	if (results == NULL){
 		printf("numObs\t\tmean\t\tvariance\t95%% confidence interval\n");
@@ -74,6 +87,77 @@ void computeCI(int n, double* stat_tally, simResult * results)
 	}
 }
 
+cl_ulong reduce_statistics(
+	cl_context context,
+	cl_device_id device,
+	cl_command_queue queue,
+	cl_mem values,
+	int runs,
+	int rowLength,
+	int P,
+	int series,
+	StatSummary* summaries)
+{
+    cl_int err;
+    int chunkCount = (runs + STAT_CHUNK - 1) / STAT_CHUNK;
+    size_t chunks_size = (size_t)chunkCount * series;
+    size_t series_size = series;
+    size_t merge_size = series_size * STAT_MERGE_GROUP;
+    size_t merge_group_size = STAT_MERGE_GROUP;
+
+    cl_mem chunks = clCreateBuffer(context, CL_MEM_READ_WRITE, chunks_size * sizeof(StatSummary), NULL, &err);
+    check_error(err, "%s(): cannot create chunk summaries buffer", __func__);
+
+    cl_mem summaries_buffer = clCreateBuffer(context, CL_MEM_WRITE_ONLY | CL_MEM_HOST_READ_ONLY, series_size * sizeof(StatSummary), NULL, &err);
+    check_error(err, "%s(): cannot create summaries buffer", __func__);
+
+    cl_program program = build_program_from_file(context, device,
+	    "client/Statistics.clh", PATH_RELATIVE_TO_LIB, NULL);
+
+    cl_kernel chunks_kernel = clCreateKernel(program, "statChunks", &err);
+    check_error(err, "%s(): cannot create kernel statChunks", __func__);
+
+    cl_kernel merge_kernel = clCreateKernel(program, "statMergeChunks", &err);
+    check_error(err, "%s(): cannot create kernel statMergeChunks", __func__);
+
+    err  = clSetKernelArg(chunks_kernel, 0, sizeof(values), &values);
+    err |= clSetKernelArg(chunks_kernel, 1, sizeof(runs), &runs);
+    err |= clSetKernelArg(chunks_kernel, 2, sizeof(rowLength), &rowLength);
+    err |= clSetKernelArg(chunks_kernel, 3, sizeof(P), &P);
+    err |= clSetKernelArg(chunks_kernel, 4, sizeof(chunks), &chunks);
+    err |= clSetKernelArg(merge_kernel, 0, sizeof(chunks), &chunks);
+    err |= clSetKernelArg(merge_kernel, 1, sizeof(chunkCount), &chunkCount);
+    err |= clSetKernelArg(merge_kernel, 2, sizeof(summaries_buffer), &summaries_buffer);
+    check_error(err, "%s(): cannot set kernel arguments", __func__);
+
+    cl_event events[2];
+    err = clEnqueueNDRangeKernel(queue, chunks_kernel, 1, NULL, &chunks_size, NULL, 0, NULL, &events[0]);
+    check_error(err, "%s(): cannot enqueue kernel statChunks", __func__);
+
+    err = clEnqueueNDRangeKernel(queue, merge_kernel, 1, NULL, &merge_size, &merge_group_size, 1, &events[0], &events[1]);
+    check_error(err, "%s(): cannot enqueue kernel statMergeChunks", __func__);
+
+    err = clEnqueueReadBuffer(queue, summaries_buffer, CL_TRUE, 0, series_size * sizeof(StatSummary), summaries, 1, &events[1], NULL);
+    check_error(err, "%s(): cannot read summaries buffer", __func__);
+
+    cl_ulong time = 0;
+    for (int i = 0; i < 2; i++) {
+	cl_ulong time_start, time_end;
+	clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_START, sizeof(time_start), &time_start, NULL);
+	clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_END, sizeof(time_end), &time_end, NULL);
+	time += time_end - time_start;
+	clReleaseEvent(events[i]);
+    }
+
+    clReleaseKernel(chunks_kernel);
+    clReleaseKernel(merge_kernel);
+    clReleaseProgram(program);
+    clReleaseMemObject(chunks);
+    clReleaseMemObject(summaries_buffer);
+
+    return time;
+}
+
 void check_error(cl_int errcode, const char* msg, ...) {
     if (errcode < 0) {
 	char formatted[1024];
@@ -328,3 +412,92 @@ cl_program build_program_from_file(
 
     return program;
 }
+
+
+size_t processor_count(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (size_t)count : 1;
+#endif
+}
+
+double wall_time(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER count, frequency;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return (double)count.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+}
+
+typedef struct ThreadWorker_ {
+	ThreadTask task;
+	void* arg;
+	size_t index, count;
+	int launched;
+} ThreadWorker;
+
+#ifdef _WIN32
+static DWORD WINAPI thread_main(LPVOID arg)
+#else
+static void* thread_main(void* arg)
+#endif
+{
+	ThreadWorker* w = (ThreadWorker*)arg;
+	w->task(w->index, w->count, w->arg);
+	return 0;
+}
+
+size_t run_threads(size_t count, ThreadTask task, void* arg)
+{
+	ThreadWorker* workers = (ThreadWorker*)malloc(count * sizeof(ThreadWorker));
+#ifdef _WIN32
+	HANDLE* threads = (HANDLE*)malloc(count * sizeof(HANDLE));
+#else
+	pthread_t* threads = (pthread_t*)malloc(count * sizeof(pthread_t));
+#endif
+	if (count <= 1 || workers == NULL || threads == NULL) {
+		for (size_t k = 0; k < count; k++)
+			task(k, count, arg);
+		free(workers);
+		free(threads);
+		return 1;
+	}
+
+	for (size_t k = 0; k < count; k++) {
+		ThreadWorker w = { task, arg, k, count, 0 };
+		workers[k] = w;
+#ifdef _WIN32
+		threads[k] = CreateThread(NULL, 0, thread_main, &workers[k], 0, NULL);
+		workers[k].launched = (threads[k] != NULL);
+#else
+		workers[k].launched = (pthread_create(&threads[k], NULL, thread_main, &workers[k]) == 0);
+#endif
+		if (!workers[k].launched)
+			task(k, count, arg);
+	}
+
+	for (size_t k = 0; k < count; k++) {
+		if (!workers[k].launched)
+			continue;
+#ifdef _WIN32
+		WaitForSingleObject(threads[k], INFINITE);
+		CloseHandle(threads[k]);
+#else
+		pthread_join(threads[k], NULL);
+#endif
+	}
+	free(threads);
+	free(workers);
+	return count;
+}
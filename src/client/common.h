@@ -41,6 +41,8 @@
 
 #include <stdio.h>
 
+#include "Statistics.clh"
+
 #if defined ( WIN32 )
 #define __func__ __FUNCTION__
 #endif
@@ -77,6 +79,31 @@ typedef struct policyPoint_{
 //Confidence Interval calculation
 void computeCI(int n, double* statTally, simResult * results);
 
+//Prints the 95% confidence interval on the mean of the values summarized by stat,
+//or records it in results if results is not NULL
+void reportCI(const StatSummary* stat, simResult * results);
+
+/*! @brief Summarize simulation results on the device.
+ *
+ *  Compute on the device the summaries that statSummarize() computes on the host,
+ *  from the same arguments, with the kernels of Statistics.clh.
+ *  Only the \c series summaries are transferred to the host.
+ *
+ *  @return Execution time of the kernels, in nanoseconds.
+ *
+ *  @note The program displays an error message and is interrupted upon error.
+ */
+cl_ulong reduce_statistics(
+	cl_context context,
+	cl_device_id device,
+	cl_command_queue queue,
+	cl_mem values,
+	int runs,
+	int rowLength,
+	int P,
+	int series,
+	StatSummary* summaries);
+
 /*! @brief Interrupt the program if an error has occurred.
  *
  *  Print the error message \c msg to standard error and exists the program if
@@ -186,4 +213,27 @@ int call_with_opencl(
 	int (*task)(cl_context,cl_device_id,cl_command_queue,void*),
 	void* data,
 	bool echoVersion);
+
+/*! @brief Number of processors available to the program (at least 1).
+ */
+size_t processor_count(void);
+
+/*! @brief Wall-clock time in seconds, from a monotonic clock.
+ */
+double wall_time(void);
+
+/*! @brief Function run by run_threads(), as task number \c index of \c count.
+ */
+typedef void (*ThreadTask)(size_t index, size_t count, void* arg);
+
+/*! @brief Run tasks in parallel, one thread per task.
+ *
+ *  Call \c task(k, count, arg) for k = 0, ..., count - 1 and wait for them to
+ *  complete.  A task that cannot be given to a new thread is run by the
+ *  calling thread.
+ *
+ *  @return Number of tasks that could run at the same time: \c count, or 1 if
+ *  the threads could not be allocated.
+ */
+size_t run_threads(size_t count, ThreadTask task, void* arg);
 #endif
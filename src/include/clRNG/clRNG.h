@@ -42,9 +42,9 @@
  *  \cite iLEC08j, \cite rLEC02a .
  *  Streams can also be divided into segments of equal length called substreams,
  *  as in \cite rLEC91a, \cite rLEC02a, \cite iLEC08j .
- *  Currently, the library implements the following three generators: 
- *  MRG31k3p \cite rLEC00b, MRG32k3a \cite rLEC99b, LFSR113 \cite rLEC99a and
- *  Philox-4×32-10 \cite rSAL11a .
+ *  Currently, the library implements the following five generators: 
+ *  MRG31k3p \cite rLEC00b, MRG32k3a \cite rLEC99b, LFSR113 \cite rLEC99a,
+ *  Philox-4×32-10 and Threefry-4×32-20 \cite rSAL11a .
  *  
  *
  *  ### Generators and prefixes
@@ -258,6 +258,16 @@
  *  A comprehensive list of supported device-side library options are described
  *  in \ref clRNG_template.h.
  *
+ *
+ *  \subsection cxx_interface C++ Interface
+ *
+ *  C++17 host code can include \ref clRNG.hpp instead of the C headers.
+ *  It provides the class templates clrng::Creator, clrng::Stream and
+ *  clrng::StreamArray, parameterized by the generator type (e.g.,
+ *  `clrng::Stream<clrng::Mrg32k3a>`), with inlined generation functions.
+ *  Stream objects can be used as uniform random bit generators with the
+ *  distributions of the C++ standard library.
+ *
  */
 
 
@@ -316,6 +326,14 @@
 #define _CLRNG_TAG_FPTYPE(name)           _CLRNG_TAG_FPTYPE_(name,_CLRNG_FPTYPE)
 #define _CLRNG_TAG_FPTYPE_(name,fptype)   _CLRNG_TAG_FPTYPE__(name,fptype)
 #define _CLRNG_TAG_FPTYPE__(name,fptype)  name##_##fptype
+/* largest double below 1, i.e., 1 - 2^-53 */
+#define _CLRNG_U01_53_MAX                 0.99999999999999988898
+/* count draws from a stream object, see CLRNG_INSTRUMENT */
+#ifdef CLRNG_INSTRUMENT
+#define _CLRNG_COUNT_DRAWS(stream, n)     ((stream)->draws += (n))
+#else
+#define _CLRNG_COUNT_DRAWS(stream, n)     ((void)0)
+#endif
 /** \endinternal
  */
 
@@ -350,6 +368,119 @@ typedef enum clrngStatus_ {
 	CLRNG_FUNCTION_NOT_IMPLEMENTED
 } clrngStatus;
 
+/*! @brief Flags for clrngSerializeStreams() and clrngWriteStreams()
+ *
+ *  The current state of each stream is always serialized.  These flags
+ *  select which other states are stored along with it; a state that is not
+ *  stored is set to the current state on deserialization.
+ */
+typedef enum clrngSerializeFlags_ {
+    CLRNG_SERIALIZE_CURRENT    = 0,      /*!< current state only */
+    CLRNG_SERIALIZE_INITIAL    = 1 << 0, /*!< also store the initial state */
+    CLRNG_SERIALIZE_SUBSTREAM  = 1 << 1, /*!< also store the substream state */
+    CLRNG_SERIALIZE_ALL        = CLRNG_SERIALIZE_INITIAL | CLRNG_SERIALIZE_SUBSTREAM
+} clrngSerializeFlags;
+
+/*! @brief Flags for clrngCreateStreamPool() and clrngOpenStreamPool()
+ */
+typedef enum clrngStreamPoolFlags_ {
+    CLRNG_POOL_SPARSE          = 0,      /*!< compute each stream on first access */
+    CLRNG_POOL_PRECOMPUTE      = 1 << 0, /*!< compute all streams when creating the pool */
+    CLRNG_POOL_READ_ONLY       = 1 << 1  /*!< open an existing pool for reading only */
+} clrngStreamPoolFlags;
+
+/*! @brief Output layouts for clrngParallelFillU01()
+ */
+typedef enum clrngFillLayout_ {
+    CLRNG_FILL_INTERLEAVED     = 0,      /*!< value \c i of stream \c s at index `i * streamCount + s`, as with clrngDeviceRandomU01Array() */
+    CLRNG_FILL_BLOCKED         = 1       /*!< value \c i of stream \c s at index `s * (numberCount / streamCount) + i` */
+} clrngFillLayout;
+
+/*! @brief Memory allocation function for clrngSetAllocator()
+ *
+ *  Must return a block of at least \c size bytes aligned on \c alignment
+ *  bytes (a power of two, at least 16), or `NULL` on failure.
+ */
+typedef void* (*clrngAllocFunction)(size_t size, size_t alignment, void* userData);
+
+/*! @brief Memory release function for clrngSetAllocator()
+ *
+ *  Receives a block returned by the matching allocation function, along with
+ *  the size that was requested for it.
+ */
+typedef void (*clrngFreeFunction)(void* ptr, size_t size, void* userData);
+
+/*! @brief Memory allocator
+ *
+ *  A pair of allocation and release functions and the user data passed to
+ *  both.  Every object allocated by the library (stream arrays, stream
+ *  creators, stream pools and temporary buffers) is obtained through the
+ *  allocator set with clrngSetAllocator(), or through the one given to an
+ *  `Ex` function such as clrngAllocStreamsEx().
+ *  Objects remember their allocator, so they are released through the
+ *  right one even if the global allocator has changed in the meantime.
+ */
+typedef struct clrngAllocator_ {
+    clrngAllocFunction alloc;    /*!< allocation function */
+    clrngFreeFunction  free;     /*!< release function */
+    void*              userData; /*!< last argument of \c alloc and \c free */
+} clrngAllocator;
+
+/*! @brief Generator identifiers
+ */
+typedef enum clrngGenerator_ {
+    CLRNG_ALL_GENERATORS       = 0,      /*!< all generators together, for clrngGetDeviceStats() */
+    CLRNG_MRG31K3P             = 1,      /*!< MRG31k3p */
+    CLRNG_MRG32K3A             = 2,      /*!< MRG32k3a */
+    CLRNG_LFSR113              = 3,      /*!< LFSR113 */
+    CLRNG_PHILOX432            = 4,      /*!< Philox-4x32-10 */
+    CLRNG_THREEFRY432          = 5       /*!< Threefry-4x32-20 */
+} clrngGenerator;
+
+/*! @brief Cumulative statistics on the kernels enqueued by the library
+ *
+ *  Filled by clrngGetDeviceStats().  Times are in seconds.
+ */
+typedef struct clrngDeviceStats_ {
+    cl_ulong  programBuilds;     /*!< number of programs compiled */
+    cl_ulong  programCacheHits;  /*!< number of times a compiled program was reused */
+    cl_double buildSeconds;      /*!< time spent creating and compiling programs */
+    cl_ulong  kernelLaunches;    /*!< number of kernels enqueued */
+    cl_double enqueueSeconds;    /*!< time spent in clEnqueueNDRangeKernel() */
+    cl_ulong  kernelsTimed;      /*!< number of kernels whose execution time is included in \c kernelSeconds */
+    cl_double kernelSeconds;     /*!< execution time of the kernels on the device */
+    cl_ulong  bytesWritten;      /*!< number of bytes written to output buffers */
+    cl_ulong  numbersGenerated;  /*!< number of random numbers generated */
+} clrngDeviceStats;
+
+/*! @brief Description of a kernel enqueued by the library, for clrngEnqueueCallback
+ */
+typedef struct clrngEnqueueInfo_ {
+    cl_uint          generator;    /*!< one of clrngGenerator */
+    const char*      function;     /*!< name of the library function that enqueues the kernel */
+    cl_command_queue queue;        /*!< command queue */
+    cl_kernel        kernel;       /*!< kernel, with its arguments set */
+    size_t           globalSize;   /*!< global work size */
+    size_t           localSize;    /*!< local work size */
+    size_t           numberCount;  /*!< number of random numbers to generate */
+    cl_event         event;        /*!< event of the kernel (after the enqueue only, can be `NULL`) */
+    cl_int           status;       /*!< value returned by clEnqueueNDRangeKernel() (after the enqueue only) */
+} clrngEnqueueInfo;
+
+/*! @brief Function called before or after each kernel enqueue, see clrngSetEnqueueCallbacks()
+ */
+typedef void (*clrngEnqueueCallback)(const clrngEnqueueInfo* info, void* userData);
+
+/*! @brief Launch configuration of the fill kernel of a generator on a device
+ *
+ *  Filled by clrngGetDeviceTuning() and clrngTuneDeviceKernels().
+ */
+typedef struct clrngDeviceTuning_ {
+    size_t    localSize;         /*!< work-group size used when there are enough streams */
+    cl_double numbersPerSecond;  /*!< throughput measured by clrngTuneDeviceKernels(), or 0 */
+    cl_bool   tuned;             /*!< whether \c localSize was chosen by clrngTuneDeviceKernels() (now or in the on-disk cache) */
+} clrngDeviceTuning;
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -368,6 +499,11 @@ CLRNGAPI const char* clrngGetErrorString();
  *
  *  Generate and return "-I${CLRNG_ROOT}/include", where \c ${CLRNG_ROOT} is
  *  the value of the \c CLRNG_ROOT environment variable.
+ *  If the library was built with \c CLRNG_INSTRUMENT, the string also
+ *  contains "-DCLRNG_INSTRUMENT", so that device stream objects have the
+ *  same layout as host stream objects; likewise, it defines
+ *  \c CLRNG_PHILOX432_ROUNDS if the library was built with a number of
+ *  Philox432 rounds other than the default.
  *  This string is meant to be passed as an option to the OpenCL C compiler for
  *  programs that make use of the clRNG device-side headers.
  *  If the \c CLRNG_ROOT environment variable is not defined, it defaults
@@ -395,6 +531,143 @@ CLRNGAPI const char* clrngGetLibraryDeviceIncludes(cl_int* err);
  */
 CLRNGAPI const char* clrngGetLibraryRoot();
 
+/*! @brief Set the memory allocator used by the library
+ *
+ *  Replace the default allocator (based on the C library) with \c allocFunc
+ *  and \c freeFunc.  This can be used, for example, to place stream arrays
+ *  in page-locked memory and pass them to clCreateBuffer() with
+ *  `CL_MEM_USE_HOST_PTR`, or in huge pages or NUMA-local memory.
+ *  Passing `NULL` for both functions restores the default allocator.
+ *
+ *  This function is not thread-safe; it should be called before any other
+ *  library function allocates memory.
+ *
+ *  @param[in]  allocFunc   Allocation function, or `NULL`.
+ *  @param[in]  freeFunc    Release function, or `NULL`.
+ *  @param[in]  userData    Value passed as the last argument of both functions.
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngSetAllocator(clrngAllocFunction allocFunc, clrngFreeFunction freeFunc, void* userData);
+
+/*! @brief Retrieve statistics on the kernels enqueued by the library
+ *
+ *  The counters are cumulative since the start of the program or the last
+ *  call to clrngResetDeviceStats().
+ *  Every call to a device function of the library that enqueues a kernel,
+ *  such as clrngDeviceRandomU01Array(), is counted, as well as every
+ *  compilation of a program; compiled programs are cached per context and
+ *  device, and reused by subsequent calls.
+ *
+ *  The execution time of the kernels on the device is available only for
+ *  the kernels enqueued on command queues created with
+ *  `CL_QUEUE_PROFILING_ENABLE`; it is collected from event callbacks when the
+ *  kernels complete, so \c kernelsTimed can be less than \c kernelLaunches
+ *  until the queues are finished.
+ *
+ *  This function is thread-safe.
+ *
+ *  @param[in]  generator   One of clrngGenerator, or ::CLRNG_ALL_GENERATORS
+ *                          for the totals over all generators.
+ *  @param[out] stats       Statistics.
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngGetDeviceStats(cl_uint generator, clrngDeviceStats* stats);
+
+/*! @brief Reset the statistics returned by clrngGetDeviceStats() to zero
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngResetDeviceStats();
+
+/*! @brief Set functions to call around each kernel enqueued by the library
+ *
+ *  \c before is called after the kernel arguments are set and just before
+ *  the kernel is enqueued; \c after is called just after the call to
+ *  clEnqueueNDRangeKernel(), with the \c event and \c status members of
+ *  \c info set.  The event belongs to the library and is valid only during
+ *  the call; use clRetainEvent() or clSetEventCallback() to follow it.
+ *  The callbacks are called from the thread that calls the library
+ *  function.  Passing `NULL` disables a callback.
+ *
+ *  @param[in]  before      Function called before each enqueue, or `NULL`.
+ *  @param[in]  after       Function called after each enqueue, or `NULL`.
+ *  @param[in]  userData    Value passed as the last argument of both functions.
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngSetEnqueueCallbacks(clrngEnqueueCallback before, clrngEnqueueCallback after, void* userData);
+
+/*! @brief Release the programs compiled and cached by the library
+ *
+ *  Each cached program retains its OpenCL context, so a context in which the
+ *  library has enqueued kernels is not destroyed by clReleaseContext() until
+ *  its programs are released, either by this function or by
+ *  clrngReleaseContextPrograms().
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngReleaseProgramCache();
+
+/*! @brief Release the programs cached by the library for one context
+ *
+ *  Like clrngReleaseProgramCache(), but only for the programs built in
+ *  \c context; the programs of other contexts stay cached.  Call it before
+ *  releasing \c context so that the context can actually be destroyed.
+ *
+ *  @param[in]  context     Context whose programs to release.
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngReleaseContextPrograms(cl_context context);
+
+/*! @brief Choose the work-group size of the fill kernel by benchmarking
+ *
+ *  Run the kernel of clrngDeviceRandomU01Array() on the device of \c queue
+ *  with each candidate work-group size (multiples of the preferred size
+ *  multiple of the kernel, up to its maximum work-group size), and keep the
+ *  fastest.  The choice is used by all subsequent calls for the same
+ *  device, generator and precision, and is saved to the on-disk cache so
+ *  that other processes use it without benchmarking again.
+ *
+ *  The on-disk cache is the file `tuning.txt` in the directory given by the
+ *  \c CLRNG_CACHE_DIR environment variable, which defaults to
+ *  `$XDG_CACHE_HOME/clRNG`, `$HOME/.cache/clRNG` or, on Windows,
+ *  `%LOCALAPPDATA%\clRNG`.  Setting \c CLRNG_CACHE_DIR to an empty value
+ *  disables the cache.  Entries are keyed on the vendor, name and driver
+ *  version of the device, so that a driver update is tuned again.
+ *
+ *  The benchmark takes a fraction of a second and blocks until \c queue is
+ *  finished.
+ *
+ *  @param[in]  generator       One of clrngGenerator, except ::CLRNG_ALL_GENERATORS.
+ *  @param[in]  queue           Command queue of the device.
+ *  @param[in]  singlePrecision Whether to tune the \c cl_float (instead of \c cl_double) kernel.
+ *  @param[out] tuning          Chosen configuration, or `NULL`.
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngTuneDeviceKernels(cl_uint generator, cl_command_queue queue, cl_bool singlePrecision, clrngDeviceTuning* tuning);
+
+/*! @brief Retrieve the work-group size used by the fill kernel
+ *
+ *  Return the choice made by clrngTuneDeviceKernels(), in this process or
+ *  in the on-disk cache, if any; otherwise, the default, which is the
+ *  maximum work-group size of the kernel on the device.
+ *  In either case, the work-group size is reduced to the number of streams
+ *  when there are fewer, and the global work size is rounded up to a
+ *  multiple of the work-group size, with the extra work-items idle.
+ *
+ *  @param[in]  generator       One of clrngGenerator, except ::CLRNG_ALL_GENERATORS.
+ *  @param[in]  queue           Command queue of the device.
+ *  @param[in]  singlePrecision Whether to query the \c cl_float (instead of \c cl_double) kernel.
+ *  @param[out] tuning          Configuration.
+ *
+ *  @return     Error status
+ */
+CLRNGAPI clrngStatus clrngGetDeviceTuning(cl_uint generator, cl_command_queue queue, cl_bool singlePrecision, clrngDeviceTuning* tuning);
+
 #ifdef __cplusplus
 }
 #endif
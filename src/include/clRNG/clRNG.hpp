@@ -0,0 +1,852 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/*! @file clRNG.hpp
+ *  @brief Header-only C++17 interface to the clRNG host API
+ *
+ *  This header wraps the C interface of the generators declared in
+ *  mrg31k3p.h, mrg32k3a.h, lfsr113.h, philox432.h and threefry432.h into
+ *  class templates parameterized by a generator type:
+ *
+ *  - clrng::Creator<G> owns a stream creator (RAII around
+ *    clrngCopyStreamCreator() and clrngDestroyStreamCreator());
+ *    for the MRGs, clrng::Creator<G, clrng::Spacing<e, c>> instead uses
+ *    jump matrices computed at compile time;
+ *  - clrng::Stream<G> holds a single stream by value and satisfies the
+ *    requirements of a uniform random bit generator (C++20
+ *    `std::uniform_random_bit_generator`), so it can be passed directly to
+ *    the distributions of `<random>`;
+ *  - clrng::StreamArray<G> owns a contiguous array of streams (move-only)
+ *    whose layout is that of the C stream objects, so that data() can be
+ *    copied to a device buffer as is.
+ *
+ *  where \c G is one of clrng::Mrg31k3p, clrng::Mrg32k3a, clrng::Lfsr113,
+ *  clrng::Philox432 or clrng::Threefry432.
+ *
+ *  The generation functions (operator(), u01(), randomInteger()) are
+ *  inlined from the same recurrence code as the C library (the
+ *  `NextState()` functions of the private `.c.h` files), so they produce
+ *  exactly the same values as clrngRandomU01() and clrngRandomInteger(),
+ *  without going through the C
+ *  ABI nor checking arguments.  Stream creation and navigation go through
+ *  the C library, and C errors are reported by throwing clrng::Error.
+ *
+ *  Example:
+ *  \code{cpp}
+ *      #include <clRNG/clRNG.hpp>
+ *      #include <random>
+ *
+ *      clrng::Creator<clrng::Mrg32k3a> creator;
+ *      clrng::StreamArray<clrng::Mrg32k3a> streams = creator.createStreams(100);
+ *      std::normal_distribution<double> normal;
+ *      double x = normal(streams[0]);
+ *      double u = streams[1].u01();
+ *  \endcode
+ */
+
+#pragma once
+#ifndef CLRNG_HPP
+#define CLRNG_HPP
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#error "clRNG.hpp requires C++17"
+#endif
+
+#include <clRNG/clRNG.h>
+#include <clRNG/mrg31k3p.h>
+#include <clRNG/mrg32k3a.h>
+#include <clRNG/lfsr113.h>
+#include <clRNG/philox432.h>
+#include <clRNG/threefry432.h>
+#include <clRNG/private/mrg31k3p_matrices.h>
+#include <clRNG/private/mrg32k3a_matrices.h>
+
+// recurrences shared with the C library and the device code
+#define CLRNG_NEXT_STATE_ONLY
+#include <clRNG/private/mrg31k3p.c.h>
+#include <clRNG/private/mrg32k3a.c.h>
+#include <clRNG/private/lfsr113.c.h>
+#include <clRNG/private/philox432.c.h>
+#include <clRNG/private/threefry432.c.h>
+#undef CLRNG_NEXT_STATE_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace clrng {
+
+/*! @brief Exception thrown when a function of the C library fails
+ */
+class Error : public std::runtime_error {
+public:
+	Error(clrngStatus status, const char* message)
+		: std::runtime_error(message ? message : "clRNG error"), status_(status) {}
+
+	/*! @brief Error status returned by the C library
+	 */
+	clrngStatus status() const noexcept { return status_; }
+
+private:
+	clrngStatus status_;
+};
+
+namespace detail {
+
+inline void check(clrngStatus err)
+{
+	if (err != CLRNG_SUCCESS)
+		throw Error(err, clrngGetErrorString());
+}
+
+/*  3x3 matrices over Z_m, for m < 2^32, usable in constant expressions.
+ *  These are the constexpr counterparts of modMatMat(), modMatPowLog2() and
+ *  modMatPow() in modularHost.c.h.
+ */
+struct Matrix {
+	std::uint64_t a[3][3];
+};
+
+constexpr bool operator==(const Matrix& x, const Matrix& y)
+{
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			if (x.a[i][j] != y.a[i][j])
+				return false;
+	return true;
+}
+
+constexpr bool operator!=(const Matrix& x, const Matrix& y) { return !(x == y); }
+
+constexpr Matrix identity()
+{
+	return Matrix{ { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } } };
+}
+
+constexpr Matrix matMat(const Matrix& x, const Matrix& y, std::uint64_t m)
+{
+	Matrix z{};
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++) {
+			std::uint64_t acc = 0;
+			for (int k = 0; k < 3; k++)
+				acc = (x.a[i][k] * y.a[k][j] + acc) % m;
+			z.a[i][j] = acc;
+		}
+	return z;
+}
+
+// x^(2^e)
+constexpr Matrix matPowLog2(Matrix x, std::uint64_t m, int e)
+{
+	for (int i = 0; i < e; i++)
+		x = matMat(x, x, m);
+	return x;
+}
+
+// x^n
+constexpr Matrix matPow(Matrix x, std::uint64_t m, std::uint64_t n)
+{
+	Matrix z = identity();
+	while (n > 0) {
+		if (n & 1)
+			z = matMat(x, z, m);
+		x = matMat(x, x, m);
+		n >>= 1;
+	}
+	return z;
+}
+
+template <class T>
+void matVec(const Matrix& x, T v[3], std::uint64_t m) noexcept
+{
+	std::uint64_t w[3];
+	for (int i = 0; i < 3; i++) {
+		std::uint64_t acc = 0;
+		for (int k = 0; k < 3; k++)
+			acc = (x.a[i][k] * v[k] + acc) % m;
+		w[i] = acc;
+	}
+	for (int i = 0; i < 3; i++)
+		v[i] = (T)w[i];
+}
+
+} // namespace detail
+
+
+/*! @name Generators
+ *
+ *  Each generator type bundles the C types of a generator, its recurrence
+ *  and output transformations (inlined), and the entry points of the C
+ *  library used for stream management.  They are not meant to be
+ *  instantiated.
+ */
+/*! @{ */
+
+/*! @brief MRG31k3p generator
+ */
+struct Mrg31k3p {
+	using state_type   = clrngMrg31k3pStreamState;
+	using stream_type  = clrngMrg31k3pStream;
+	using creator_type = clrngMrg31k3pStreamCreator;
+	using result_type  = cl_uint;
+
+	static constexpr cl_uint m1 = 2147483647u;   // 2^31 - 1
+	static constexpr cl_uint m2 = 2147462579u;   // 2^31 - 21069
+
+	static constexpr result_type min() { return 1; }
+	static constexpr result_type max() { return m1; }
+
+	static result_type next(state_type& s) noexcept { return clrngMrg31k3pNextState(&s); }
+
+	static constexpr detail::Matrix A1p0  { CLRNG_MRG31K3P_A1P0 };
+	static constexpr detail::Matrix A2p0  { CLRNG_MRG31K3P_A2P0 };
+	static constexpr detail::Matrix invA1 { CLRNG_MRG31K3P_INVA1 };
+	static constexpr detail::Matrix invA2 { CLRNG_MRG31K3P_INVA2 };
+
+	static cl_double u01_cl_double(result_type z) noexcept { return z * mrg31k3p_NORM_cl_double; }
+	static cl_float  u01_cl_float (result_type z) noexcept { return (cl_float)(z * mrg31k3p_NORM_cl_float); }
+
+	static creator_type* copyCreator(const creator_type* c, clrngStatus* err) { return clrngMrg31k3pCopyStreamCreator(c, err); }
+	static clrngStatus destroyCreator(creator_type* c) { return clrngMrg31k3pDestroyStreamCreator(c); }
+	static clrngStatus rewindCreator(creator_type* c) { return clrngMrg31k3pRewindStreamCreator(c); }
+	static clrngStatus setBaseCreatorState(creator_type* c, const state_type* s) { return clrngMrg31k3pSetBaseCreatorState(c, s); }
+	static clrngStatus changeStreamsSpacing(creator_type* c, cl_int e, cl_int k) { return clrngMrg31k3pChangeStreamsSpacing(c, e, k); }
+	static stream_type* allocStreams(size_t n, size_t* bufSize, clrngStatus* err) { return clrngMrg31k3pAllocStreams(n, bufSize, err); }
+	static clrngStatus destroyStreams(stream_type* s) { return clrngMrg31k3pDestroyStreams(s); }
+	static clrngStatus createOverStreams(creator_type* c, size_t n, stream_type* s) { return clrngMrg31k3pCreateOverStreams(c, n, s); }
+	static clrngStatus rewindStreams(size_t n, stream_type* s) { return clrngMrg31k3pRewindStreams(n, s); }
+	static clrngStatus rewindSubstreams(size_t n, stream_type* s) { return clrngMrg31k3pRewindSubstreams(n, s); }
+	static clrngStatus forwardToNextSubstreams(size_t n, stream_type* s) { return clrngMrg31k3pForwardToNextSubstreams(n, s); }
+	static clrngStatus advanceStreams(size_t n, stream_type* s, cl_int e, cl_int k) { return clrngMrg31k3pAdvanceStreams(n, s, e, k); }
+};
+
+/*! @brief MRG32k3a generator
+ */
+struct Mrg32k3a {
+	using state_type   = clrngMrg32k3aStreamState;
+	using stream_type  = clrngMrg32k3aStream;
+	using creator_type = clrngMrg32k3aStreamCreator;
+	using result_type  = cl_uint;
+
+	static constexpr std::int64_t m1 = 4294967087;
+	static constexpr std::int64_t m2 = 4294944443;
+
+	static constexpr result_type min() { return 1; }
+	static constexpr result_type max() { return (result_type)m1; }
+
+	static result_type next(state_type& s) noexcept { return (result_type)clrngMrg32k3aNextState(&s); }
+
+	static constexpr detail::Matrix A1p0  { CLRNG_MRG32K3A_A1P0 };
+	static constexpr detail::Matrix A2p0  { CLRNG_MRG32K3A_A2P0 };
+	static constexpr detail::Matrix invA1 { CLRNG_MRG32K3A_INVA1 };
+	static constexpr detail::Matrix invA2 { CLRNG_MRG32K3A_INVA2 };
+
+	static cl_double u01_cl_double(result_type z) noexcept { return z * Mrg32k3a_NORM_cl_double; }
+	static cl_float  u01_cl_float (result_type z) noexcept { return (cl_float)(z * Mrg32k3a_NORM_cl_float); }
+
+	static creator_type* copyCreator(const creator_type* c, clrngStatus* err) { return clrngMrg32k3aCopyStreamCreator(c, err); }
+	static clrngStatus destroyCreator(creator_type* c) { return clrngMrg32k3aDestroyStreamCreator(c); }
+	static clrngStatus rewindCreator(creator_type* c) { return clrngMrg32k3aRewindStreamCreator(c); }
+	static clrngStatus setBaseCreatorState(creator_type* c, const state_type* s) { return clrngMrg32k3aSetBaseCreatorState(c, s); }
+	static clrngStatus changeStreamsSpacing(creator_type* c, cl_int e, cl_int k) { return clrngMrg32k3aChangeStreamsSpacing(c, e, k); }
+	static stream_type* allocStreams(size_t n, size_t* bufSize, clrngStatus* err) { return clrngMrg32k3aAllocStreams(n, bufSize, err); }
+	static clrngStatus destroyStreams(stream_type* s) { return clrngMrg32k3aDestroyStreams(s); }
+	static clrngStatus createOverStreams(creator_type* c, size_t n, stream_type* s) { return clrngMrg32k3aCreateOverStreams(c, n, s); }
+	static clrngStatus rewindStreams(size_t n, stream_type* s) { return clrngMrg32k3aRewindStreams(n, s); }
+	static clrngStatus rewindSubstreams(size_t n, stream_type* s) { return clrngMrg32k3aRewindSubstreams(n, s); }
+	static clrngStatus forwardToNextSubstreams(size_t n, stream_type* s) { return clrngMrg32k3aForwardToNextSubstreams(n, s); }
+	static clrngStatus advanceStreams(size_t n, stream_type* s, cl_int e, cl_int k) { return clrngMrg32k3aAdvanceStreams(n, s, e, k); }
+};
+
+/*! @brief LFSR113 generator
+ */
+struct Lfsr113 {
+	using state_type   = clrngLfsr113StreamState;
+	using stream_type  = clrngLfsr113Stream;
+	using creator_type = clrngLfsr113StreamCreator;
+	using result_type  = cl_uint;
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 4294967295u; }
+
+	static result_type next(state_type& s) noexcept { return (result_type)clrngLfsr113NextState(&s); }
+
+	static cl_double u01_cl_double(result_type z) noexcept { return z * Lfsr113_NORM_cl_double; }
+	static cl_float  u01_cl_float (result_type z) noexcept { return (cl_float)(z * Lfsr113_NORM_cl_float); }
+
+	static creator_type* copyCreator(const creator_type* c, clrngStatus* err) { return clrngLfsr113CopyStreamCreator(c, err); }
+	static clrngStatus destroyCreator(creator_type* c) { return clrngLfsr113DestroyStreamCreator(c); }
+	static clrngStatus rewindCreator(creator_type* c) { return clrngLfsr113RewindStreamCreator(c); }
+	static clrngStatus setBaseCreatorState(creator_type* c, const state_type* s) { return clrngLfsr113SetBaseCreatorState(c, s); }
+	static clrngStatus changeStreamsSpacing(creator_type* c, cl_int e, cl_int k) { return clrngLfsr113ChangeStreamsSpacing(c, e, k); }
+	static stream_type* allocStreams(size_t n, size_t* bufSize, clrngStatus* err) { return clrngLfsr113AllocStreams(n, bufSize, err); }
+	static clrngStatus destroyStreams(stream_type* s) { return clrngLfsr113DestroyStreams(s); }
+	static clrngStatus createOverStreams(creator_type* c, size_t n, stream_type* s) { return clrngLfsr113CreateOverStreams(c, n, s); }
+	static clrngStatus rewindStreams(size_t n, stream_type* s) { return clrngLfsr113RewindStreams(n, s); }
+	static clrngStatus rewindSubstreams(size_t n, stream_type* s) { return clrngLfsr113RewindSubstreams(n, s); }
+	static clrngStatus forwardToNextSubstreams(size_t n, stream_type* s) { return clrngLfsr113ForwardToNextSubstreams(n, s); }
+	static clrngStatus advanceStreams(size_t n, stream_type* s, cl_int e, cl_int k) { return clrngLfsr113AdvanceStreams(n, s, e, k); }
+};
+
+/*! @brief Philox-4x32-10 counter-based generator
+ */
+struct Philox432 {
+	using state_type   = clrngPhilox432StreamState;
+	using stream_type  = clrngPhilox432Stream;
+	using creator_type = clrngPhilox432StreamCreator;
+	using result_type  = cl_uint;
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 4294967295u; }
+
+	static result_type next(state_type& s) noexcept { return clrngPhilox432NextState(&s); }
+
+	static cl_double u01_cl_double(result_type z) noexcept { return (z + 0.5) * COUNTER432_NORM_cl_double; }
+	static cl_float  u01_cl_float (result_type z) noexcept { return (cl_float)((z + 0.5) * COUNTER432_NORM_cl_float); }
+
+	static creator_type* copyCreator(const creator_type* c, clrngStatus* err) { return clrngPhilox432CopyStreamCreator(c, err); }
+	static clrngStatus destroyCreator(creator_type* c) { return clrngPhilox432DestroyStreamCreator(c); }
+	static clrngStatus rewindCreator(creator_type* c) { return clrngPhilox432RewindStreamCreator(c); }
+	static clrngStatus setBaseCreatorState(creator_type* c, const state_type* s) { return clrngPhilox432SetBaseCreatorState(c, s); }
+	static clrngStatus changeStreamsSpacing(creator_type* c, cl_int e, cl_int k) { return clrngPhilox432ChangeStreamsSpacing(c, e, k); }
+	static stream_type* allocStreams(size_t n, size_t* bufSize, clrngStatus* err) { return clrngPhilox432AllocStreams(n, bufSize, err); }
+	static clrngStatus destroyStreams(stream_type* s) { return clrngPhilox432DestroyStreams(s); }
+	static clrngStatus createOverStreams(creator_type* c, size_t n, stream_type* s) { return clrngPhilox432CreateOverStreams(c, n, s); }
+	static clrngStatus rewindStreams(size_t n, stream_type* s) { return clrngPhilox432RewindStreams(n, s); }
+	static clrngStatus rewindSubstreams(size_t n, stream_type* s) { return clrngPhilox432RewindSubstreams(n, s); }
+	static clrngStatus forwardToNextSubstreams(size_t n, stream_type* s) { return clrngPhilox432ForwardToNextSubstreams(n, s); }
+	static clrngStatus advanceStreams(size_t n, stream_type* s, cl_int e, cl_int k) { return clrngPhilox432AdvanceStreams(n, s, e, k); }
+};
+
+/*! @brief Threefry-4x32-20 counter-based generator
+ */
+struct Threefry432 {
+	using state_type   = clrngThreefry432StreamState;
+	using stream_type  = clrngThreefry432Stream;
+	using creator_type = clrngThreefry432StreamCreator;
+	using result_type  = cl_uint;
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 4294967295u; }
+
+	static result_type next(state_type& s) noexcept { return clrngThreefry432NextState(&s); }
+
+	static cl_double u01_cl_double(result_type z) noexcept { return (z + 0.5) * COUNTER432_NORM_cl_double; }
+	static cl_float  u01_cl_float (result_type z) noexcept { return (cl_float)((z + 0.5) * COUNTER432_NORM_cl_float); }
+
+	static creator_type* copyCreator(const creator_type* c, clrngStatus* err) { return clrngThreefry432CopyStreamCreator(c, err); }
+	static clrngStatus destroyCreator(creator_type* c) { return clrngThreefry432DestroyStreamCreator(c); }
+	static clrngStatus rewindCreator(creator_type* c) { return clrngThreefry432RewindStreamCreator(c); }
+	static clrngStatus setBaseCreatorState(creator_type* c, const state_type* s) { return clrngThreefry432SetBaseCreatorState(c, s); }
+	static clrngStatus changeStreamsSpacing(creator_type* c, cl_int e, cl_int k) { return clrngThreefry432ChangeStreamsSpacing(c, e, k); }
+	static stream_type* allocStreams(size_t n, size_t* bufSize, clrngStatus* err) { return clrngThreefry432AllocStreams(n, bufSize, err); }
+	static clrngStatus destroyStreams(stream_type* s) { return clrngThreefry432DestroyStreams(s); }
+	static clrngStatus createOverStreams(creator_type* c, size_t n, stream_type* s) { return clrngThreefry432CreateOverStreams(c, n, s); }
+	static clrngStatus rewindStreams(size_t n, stream_type* s) { return clrngThreefry432RewindStreams(n, s); }
+	static clrngStatus rewindSubstreams(size_t n, stream_type* s) { return clrngThreefry432RewindSubstreams(n, s); }
+	static clrngStatus forwardToNextSubstreams(size_t n, stream_type* s) { return clrngThreefry432ForwardToNextSubstreams(n, s); }
+	static clrngStatus advanceStreams(size_t n, stream_type* s, cl_int e, cl_int k) { return clrngThreefry432AdvanceStreams(n, s, e, k); }
+};
+
+/*! @} */
+
+
+/*! @name Compile-time stream spacing
+ *
+ *  For the multiple recursive generators (Mrg31k3p and Mrg32k3a), the jump
+ *  matrices of a spacing can be computed at compile time.
+ */
+/*! @{ */
+
+/*! @brief Spacing of \f$2^e + c\f$ steps (of \f$c\f$ steps if \f$e = 0\f$)
+ *
+ *  Same meaning as the arguments of clrngChangeStreamsSpacing().
+ */
+template <int E, int C = 0>
+struct Spacing {
+	static_assert(E >= 0, "the exponent of a spacing must be >= 0");
+	static constexpr int e = E;
+	static constexpr int c = C;
+};
+
+/*! @brief Standard spacings of a generator
+ *
+ *  \c stream is the spacing between the streams produced by the default
+ *  creator, \c substream the one between the substreams of a stream.
+ */
+template <class G>
+struct StandardSpacings;
+
+template <>
+struct StandardSpacings<Mrg31k3p> {
+	using stream    = Spacing<134>;
+	using substream = Spacing<72>;
+};
+
+template <>
+struct StandardSpacings<Mrg32k3a> {
+	using stream    = Spacing<127>;
+	using substream = Spacing<76>;
+};
+
+/*! @brief Pair of jump matrices, one per component of a generator
+ */
+struct JumpMatrices {
+	detail::Matrix a1;
+	detail::Matrix a2;
+};
+
+namespace detail {
+
+// same computation as in clrngChangeStreamsSpacing()
+template <class G>
+constexpr JumpMatrices jumpMatrices(int e, int c)
+{
+	const std::uint64_t m1 = (std::uint64_t)G::m1;
+	const std::uint64_t m2 = (std::uint64_t)G::m2;
+	JumpMatrices nu{
+		c >= 0 ? matPow(G::A1p0, m1, (std::uint64_t)c) : matPow(G::invA1, m1, (std::uint64_t)-(std::int64_t)c),
+		c >= 0 ? matPow(G::A2p0, m2, (std::uint64_t)c) : matPow(G::invA2, m2, (std::uint64_t)-(std::int64_t)c)
+	};
+	if (e > 0) {
+		nu.a1 = matMat(matPowLog2(G::A1p0, m1, e), nu.a1, m1);
+		nu.a2 = matMat(matPowLog2(G::A2p0, m2, e), nu.a2, m2);
+	}
+	return nu;
+}
+
+} // namespace detail
+
+/*! @brief Jump matrices of spacing \c S for generator \c G, computed at compile time
+ */
+template <class G, class S>
+inline constexpr JumpMatrices jumpMatrices = detail::jumpMatrices<G>(S::e, S::c);
+
+/*! @} */
+
+// Table of the standard spacings, recomputed at compile time and checked
+// against the constants pasted in the C library.
+static_assert(detail::matMat(Mrg31k3p::A1p0, Mrg31k3p::invA1, Mrg31k3p::m1) == detail::identity() &&
+	detail::matMat(Mrg31k3p::A2p0, Mrg31k3p::invA2, Mrg31k3p::m2) == detail::identity(),
+	"CLRNG_MRG31K3P_INVA1/2 are not the inverses of CLRNG_MRG31K3P_A1P0/A2P0");
+static_assert(jumpMatrices<Mrg31k3p, StandardSpacings<Mrg31k3p>::substream>.a1 == detail::Matrix{ CLRNG_MRG31K3P_A1P72 } &&
+	jumpMatrices<Mrg31k3p, StandardSpacings<Mrg31k3p>::substream>.a2 == detail::Matrix{ CLRNG_MRG31K3P_A2P72 },
+	"CLRNG_MRG31K3P_A1P72/A2P72 do not jump 2^72 steps");
+static_assert(jumpMatrices<Mrg31k3p, StandardSpacings<Mrg31k3p>::stream>.a1 == detail::Matrix{ CLRNG_MRG31K3P_A1P134 } &&
+	jumpMatrices<Mrg31k3p, StandardSpacings<Mrg31k3p>::stream>.a2 == detail::Matrix{ CLRNG_MRG31K3P_A2P134 },
+	"CLRNG_MRG31K3P_A1P134/A2P134 do not jump 2^134 steps");
+static_assert(detail::matMat(Mrg32k3a::A1p0, Mrg32k3a::invA1, Mrg32k3a::m1) == detail::identity() &&
+	detail::matMat(Mrg32k3a::A2p0, Mrg32k3a::invA2, Mrg32k3a::m2) == detail::identity(),
+	"CLRNG_MRG32K3A_INVA1/2 are not the inverses of CLRNG_MRG32K3A_A1P0/A2P0");
+static_assert(jumpMatrices<Mrg32k3a, StandardSpacings<Mrg32k3a>::substream>.a1 == detail::Matrix{ CLRNG_MRG32K3A_A1P76 } &&
+	jumpMatrices<Mrg32k3a, StandardSpacings<Mrg32k3a>::substream>.a2 == detail::Matrix{ CLRNG_MRG32K3A_A2P76 },
+	"CLRNG_MRG32K3A_A1P76/A2P76 do not jump 2^76 steps");
+static_assert(jumpMatrices<Mrg32k3a, StandardSpacings<Mrg32k3a>::stream>.a1 == detail::Matrix{ CLRNG_MRG32K3A_A1P127 } &&
+	jumpMatrices<Mrg32k3a, StandardSpacings<Mrg32k3a>::stream>.a2 == detail::Matrix{ CLRNG_MRG32K3A_A2P127 },
+	"CLRNG_MRG32K3A_A1P127/A2P127 do not jump 2^127 steps");
+
+
+/*! @brief Single random stream, held by value
+ *
+ *  Copying a Stream object duplicates the stream, including its current,
+ *  initial and substream states (like clrngCopyStreams()).
+ *  A Stream object has the same layout as the C stream object of its
+ *  generator.
+ *  Streams are obtained from Creator::createStream() or by wrapping a C
+ *  stream object; there is no default constructor, which would have to take
+ *  the next stream of the library default creator behind the caller's back.
+ */
+template <class G>
+class Stream {
+public:
+	using generator_type = G;
+	using state_type     = typename G::state_type;
+	using stream_type    = typename G::stream_type;
+	using result_type    = typename G::result_type;
+
+	/*! @brief Wrap a copy of an existing C stream object
+	 */
+	explicit Stream(const stream_type& stream) noexcept : stream_(stream) {}
+
+	static constexpr result_type min() { return G::min(); }
+	static constexpr result_type max() { return G::max(); }
+
+	/*! @brief Advance the stream by one step and return the raw output
+	 *
+	 *  The returned value is uniformly distributed over [min(), max()].
+	 */
+	result_type operator()() noexcept
+	{
+		_CLRNG_COUNT_DRAWS(&stream_, 1);
+		return G::next(stream_.current);
+	}
+
+	/*! @brief Same as clrngRandomU01(), with \c F one of \c cl_float or \c cl_double
+	 */
+	template <class F = cl_double>
+	F u01() noexcept
+	{
+		static_assert(std::is_same<F, cl_float>::value || std::is_same<F, cl_double>::value,
+			"u01() is defined for cl_float and cl_double only");
+		_CLRNG_COUNT_DRAWS(&stream_, 1);
+		if constexpr (std::is_same<F, cl_float>::value)
+			return G::u01_cl_float(G::next(stream_.current));
+		else
+			return G::u01_cl_double(G::next(stream_.current));
+	}
+
+	/*! @brief Same as clrngRandomInteger(), with \c F one of \c cl_float or \c cl_double
+	 */
+	template <class F = cl_double>
+	cl_int randomInteger(cl_int i, cl_int j) noexcept
+	{
+		return i + (cl_int)((j - i + 1) * u01<F>());
+	}
+
+	/*! @brief Same as clrngRewindStreams()
+	 */
+	void rewind() { detail::check(G::rewindStreams(1, &stream_)); }
+
+	/*! @brief Same as clrngRewindSubstreams()
+	 */
+	void rewindSubstream() { detail::check(G::rewindSubstreams(1, &stream_)); }
+
+	/*! @brief Same as clrngForwardToNextSubstreams()
+	 */
+	void nextSubstream() { detail::check(G::forwardToNextSubstreams(1, &stream_)); }
+
+	/*! @brief Same as clrngAdvanceStreams()
+	 */
+	void advance(cl_int e, cl_int c) { detail::check(G::advanceStreams(1, &stream_, e, c)); }
+
+	const state_type& current() const noexcept { return stream_.current; }
+
+	/*! @brief Underlying C stream object, for use with the C API
+	 */
+	stream_type&       get() noexcept       { return stream_; }
+	const stream_type& get() const noexcept { return stream_; }
+
+private:
+	stream_type stream_;
+};
+
+
+/*! @brief Owner of a contiguous array of streams
+ *
+ *  The array is allocated by the C library and released on destruction.
+ *  StreamArray objects can be moved but not copied.
+ */
+template <class G>
+class StreamArray {
+public:
+	using generator_type = G;
+	using stream_type    = typename G::stream_type;
+	using value_type     = Stream<G>;
+	using iterator       = Stream<G>*;
+	using const_iterator = const Stream<G>*;
+
+	static_assert(std::is_standard_layout<Stream<G>>::value && sizeof(Stream<G>) == sizeof(stream_type),
+		"Stream<G> must have the layout of the C stream type");
+
+	StreamArray() noexcept = default;
+
+	/*! @brief Allocate \c count uninitialized streams (see clrngAllocStreams())
+	 */
+	explicit StreamArray(size_t count)
+	{
+		clrngStatus err;
+		streams_ = G::allocStreams(count, &bufSize_, &err);
+		detail::check(err);
+		count_ = count;
+	}
+
+	/*! @brief Take ownership of a stream array allocated by the C library
+	 */
+	StreamArray(stream_type* streams, size_t count) noexcept
+		: streams_(streams), count_(count), bufSize_(count * sizeof(stream_type)) {}
+
+	StreamArray(const StreamArray&) = delete;
+	StreamArray& operator=(const StreamArray&) = delete;
+
+	StreamArray(StreamArray&& other) noexcept
+		: streams_(std::exchange(other.streams_, nullptr)),
+		  count_(std::exchange(other.count_, 0)),
+		  bufSize_(std::exchange(other.bufSize_, 0)) {}
+
+	StreamArray& operator=(StreamArray&& other) noexcept
+	{
+		if (this != &other) {
+			reset();
+			streams_ = std::exchange(other.streams_, nullptr);
+			count_   = std::exchange(other.count_, 0);
+			bufSize_ = std::exchange(other.bufSize_, 0);
+		}
+		return *this;
+	}
+
+	~StreamArray() { reset(); }
+
+	size_t size() const noexcept { return count_; }
+	bool empty() const noexcept { return count_ == 0; }
+
+	/*! @brief Size in bytes of the array, e.g., for clCreateBuffer()
+	 */
+	size_t bufferSize() const noexcept { return bufSize_; }
+
+	Stream<G>&       operator[](size_t i) noexcept       { return begin()[i]; }
+	const Stream<G>& operator[](size_t i) const noexcept { return begin()[i]; }
+
+	iterator       begin() noexcept       { return reinterpret_cast<Stream<G>*>(streams_); }
+	iterator       end() noexcept         { return begin() + count_; }
+	const_iterator begin() const noexcept { return reinterpret_cast<const Stream<G>*>(streams_); }
+	const_iterator end() const noexcept   { return begin() + count_; }
+
+	/*! @brief Underlying C stream array
+	 */
+	stream_type*       data() noexcept       { return streams_; }
+	const stream_type* data() const noexcept { return streams_; }
+
+	/*! @brief Same as clrngRewindStreams() on the whole array
+	 */
+	void rewind() { detail::check(G::rewindStreams(count_, streams_)); }
+
+	/*! @brief Same as clrngRewindSubstreams() on the whole array
+	 */
+	void rewindSubstreams() { detail::check(G::rewindSubstreams(count_, streams_)); }
+
+	/*! @brief Same as clrngForwardToNextSubstreams() on the whole array
+	 */
+	void nextSubstreams() { detail::check(G::forwardToNextSubstreams(count_, streams_)); }
+
+	/*! @brief Same as clrngAdvanceStreams() on the whole array
+	 */
+	void advance(cl_int e, cl_int c) { detail::check(G::advanceStreams(count_, streams_, e, c)); }
+
+	/*! @brief Give up ownership of the C stream array
+	 */
+	stream_type* release() noexcept
+	{
+		count_ = bufSize_ = 0;
+		return std::exchange(streams_, nullptr);
+	}
+
+private:
+	void reset() noexcept
+	{
+		if (streams_)
+			G::destroyStreams(streams_);
+		streams_ = nullptr;
+		count_ = bufSize_ = 0;
+	}
+
+	stream_type* streams_ = nullptr;
+	size_t count_ = 0;
+	size_t bufSize_ = 0;
+};
+
+
+/*! @brief Stream creator
+ *
+ *  A newly constructed Creator is a copy of the library default creator
+ *  (see clrngCopyStreamCreator()).  Copying a Creator object copies the
+ *  underlying creator, including the state of the next stream to be created.
+ *
+ *  With \c S a Spacing<e, c>, the creator is implemented in this header and
+ *  its jump matrices are computed at compile time; see the specialization
+ *  Creator<G, Spacing<E, C>>.
+ */
+template <class G, class S = void>
+class Creator {
+public:
+	using generator_type = G;
+	using state_type     = typename G::state_type;
+	using creator_type   = typename G::creator_type;
+
+	Creator() : creator_(copy(nullptr)) {}
+
+	Creator(const Creator& other) : creator_(copy(other.creator_)) {}
+
+	Creator(Creator&& other) noexcept : creator_(std::exchange(other.creator_, nullptr)) {}
+
+	Creator& operator=(Creator other) noexcept
+	{
+		std::swap(creator_, other.creator_);
+		return *this;
+	}
+
+	~Creator()
+	{
+		if (creator_)
+			G::destroyCreator(creator_);
+	}
+
+	/*! @brief Same as clrngRewindStreamCreator()
+	 */
+	void rewind() { detail::check(G::rewindCreator(creator_)); }
+
+	/*! @brief Same as clrngSetBaseCreatorState()
+	 */
+	void setBaseState(const state_type& baseState) { detail::check(G::setBaseCreatorState(creator_, &baseState)); }
+
+	/*! @brief Same as clrngChangeStreamsSpacing()
+	 */
+	void changeSpacing(cl_int e, cl_int c) { detail::check(G::changeStreamsSpacing(creator_, e, c)); }
+
+	/*! @brief Create the next stream
+	 */
+	Stream<G> createStream()
+	{
+		typename G::stream_type stream;
+		detail::check(G::createOverStreams(creator_, 1, &stream));
+		return Stream<G>(stream);
+	}
+
+	/*! @brief Create the next \c count streams (see clrngCreateStreams())
+	 */
+	StreamArray<G> createStreams(size_t count)
+	{
+		StreamArray<G> streams(count);
+		detail::check(G::createOverStreams(creator_, count, streams.data()));
+		return streams;
+	}
+
+	/*! @brief Underlying C creator object, for use with the C API
+	 */
+	creator_type* get() const noexcept { return creator_; }
+
+private:
+	static creator_type* copy(const creator_type* creator)
+	{
+		clrngStatus err;
+		creator_type* c = G::copyCreator(creator, &err);
+		detail::check(err);
+		return c;
+	}
+
+	creator_type* creator_;
+};
+
+
+/*! @brief Stream creator with a spacing fixed at compile time
+ *
+ *  Equivalent to a Creator<G> on which changeSpacing(E, C) has been called,
+ *  except that the jump matrices are computed at compile time and streams
+ *  are created without going through the C library.  Only available for the
+ *  multiple recursive generators (Mrg31k3p and Mrg32k3a).
+ *
+ *  A newly constructed object starts from the base state of the library
+ *  default creator.
+ */
+template <class G, int E, int C>
+class Creator<G, Spacing<E, C>> {
+public:
+	using generator_type = G;
+	using state_type     = typename G::state_type;
+	using spacing_type   = Spacing<E, C>;
+
+	static_assert(std::is_same<G, Mrg31k3p>::value || std::is_same<G, Mrg32k3a>::value,
+		"compile-time spacing is only available for Mrg31k3p and Mrg32k3a");
+
+	/*! @brief Jump matrices from one stream to the next
+	 */
+	static constexpr JumpMatrices jump = jumpMatrices<G, spacing_type>;
+
+	Creator()
+	{
+		Creator<G> base;
+		base.rewind();
+		initial_ = next_ = base.createStream().get().initial;
+	}
+
+	/*! @brief Same as clrngRewindStreamCreator()
+	 */
+	void rewind() noexcept { next_ = initial_; }
+
+	/*! @brief Same as clrngSetBaseCreatorState()
+	 */
+	void setBaseState(const state_type& baseState)
+	{
+		// validate the seed with the C library
+		Creator<G>().setBaseState(baseState);
+		initial_ = next_ = baseState;
+	}
+
+	/*! @brief Create the next stream
+	 */
+	Stream<G> createStream() noexcept
+	{
+		typename G::stream_type stream;
+		create(stream);
+		return Stream<G>(stream);
+	}
+
+	/*! @brief Create the next \c count streams (see clrngCreateStreams())
+	 */
+	StreamArray<G> createStreams(size_t count)
+	{
+		StreamArray<G> streams(count);
+		for (size_t i = 0; i < count; i++)
+			create(streams.data()[i]);
+		return streams;
+	}
+
+	/*! @brief State of the next stream to be created
+	 */
+	const state_type& nextState() const noexcept { return next_; }
+
+private:
+	void create(typename G::stream_type& stream) noexcept
+	{
+		stream.initial = stream.substream = stream.current = next_;
+#ifdef CLRNG_INSTRUMENT
+		stream.draws = 0;
+#endif
+		detail::matVec(jump.a1, next_.g1, (std::uint64_t)G::m1);
+		detail::matVec(jump.a2, next_.g2, (std::uint64_t)G::m2);
+	}
+
+	state_type initial_;
+	state_type next_;
+};
+
+} // namespace clrng
+
+#endif /* CLRNG_HPP */
+
+/*
+ * vim: syntax=cpp.doxygen spell spelllang=en fdm=syntax fdls=0
+ */
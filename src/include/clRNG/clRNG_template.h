@@ -111,6 +111,73 @@
  *    are kept in private memory and is accessible, in a work item.
  *    **This option applies only to the device; operations on substreams are 
  *    always available on the host.**
+ *  - \c CLRNG_NO_REWIND:
+ *    With this option, a device stream object holds only the current state of
+ *    the stream: no pointer to the initial state is kept, and
+ *    clrngRewindStreams() is not available on the device.
+ *    Such stream objects are best loaded with
+ *    clrngCopyOverStreamStatesFromGlobal() from a compact buffer of
+ *    clrngStreamState objects filled on the host by clrngGetStreamStates(),
+ *    which is a third of the size of the corresponding array of host stream
+ *    objects for the MRG31k3p, MRG32k3a and LFSR113 generators.
+ *    This option cannot be combined with \c CLRNG_ENABLE_SUBSTREAMS, and
+ *    it applies only to the device.
+ *  - \c CLRNG_INSTRUMENT:
+ *    With this option, each stream object has an additional member \c draws,
+ *    of type \c cl_ulong, which counts the outputs of the generator consumed
+ *    through it by clrngRandomU01(), clrngRandomInteger(), clrngRandomU01_53()
+ *    and the corresponding array functions (clrngRandomU01_53() consumes two
+ *    outputs per value).  The counter is set to 0 when a stream object is
+ *    created (including by clrngMakeSubstreams(), deserialization and stream
+ *    pools), is copied along with the stream, and is not affected by rewinding
+ *    or advancing the stream nor by the functions that copy stream states only.
+ *    On the device, clrngCopyOverStreamsToGlobal() writes it back, so the
+ *    number of values drawn in a kernel can be read on the host.
+ *    Unlike the other options, this one changes the layout of host stream
+ *    objects, so it must be defined consistently for the library (CMake option
+ *    \c BUILD_INSTRUMENT), the host code and the device code; the options
+ *    returned by clrngGetLibraryDeviceIncludes() define it for the device when
+ *    the library was built with it.
+ *    Without this option, the counting code is not compiled at all.
+ *  - \c CLRNG_PHILOX432_ROUNDS:
+ *    Number of rounds of the Philox-4×32 bijection, from 1 to 16 (10 by
+ *    default).  With fewer rounds, each output is cheaper to compute, but the
+ *    Philox432 sequence is different; 7 rounds is the smallest number that
+ *    passes the BigCrush battery of TestU01 \cite rSAL11a .
+ *    Like \c CLRNG_INSTRUMENT, it must be defined consistently for the
+ *    library (CMake option \c PHILOX432_ROUNDS), the host code and the device
+ *    code, and the options returned by clrngGetLibraryDeviceIncludes() define
+ *    it for the device when the library was built with a value other than 10.
+ *  - \c CLRNG_MRG32K3A_FP_ARITHMETIC:
+ *    MRG32k3a then computes its recurrence in double-precision arithmetic, as
+ *    in the original implementation of \cite rLEC99b , with a reduction
+ *    based on \c floor() that maps to fused multiply-adds, instead of 64-bit
+ *    integer products and remainders, which are emulated and slow on GPUs.
+ *    The states and the generated values are exactly the same, so the option
+ *    can be activated on the device and the host separately; the device must
+ *    support double precision, even with \c CLRNG_SINGLE_PRECISION.
+ *    The kernels of the library use it on all devices if the library was
+ *    built with it (CMake option \c MRG32K3A_FP_ARITHMETIC); the
+ *    Mrg32k3aArithmetic example times both recurrences on a given device.
+ *  - \c CLRNG_MRG31K3P_MULT_31:
+ *    MRG31k3p then computes the modular products of its jumps (substreams
+ *    on the device, also streams on the host) on 16-bit halves, with 32-bit
+ *    integers only, instead of with 64-bit products, for devices without
+ *    fast 64-bit integer multiplication.  The results are exactly the same, so the option can
+ *    be activated on the device and the host separately.  It is off by
+ *    default on the device; on the host, it is on when \c size_t has 32
+ *    bits, and on all hosts if the library was built with it (CMake option
+ *    \c MRG31K3P_MULT_31).
+ *  - \c CLRNG_FULL_PRECISION_DOUBLE:
+ *    With this option, clrngRandomU01() and clrngRandomU01Array() are mapped to
+ *    clrngRandomU01_53() and clrngRandomU01Array_53(), so that every
+ *    double-precision value carries 53 random bits instead of the 31 or 32
+ *    bits of a single output of the generator.  Each value then consumes two
+ *    successive outputs of the stream.
+ *    This option has no effect when \c CLRNG_SINGLE_PRECISION is also defined,
+ *    and it does not affect clrngRandomInteger() nor
+ *    clrngDeviceRandomU01Array().
+ *    It can be activated on the device and the host separately.
  *
  *  For example, to enable substreams support, generate single-precision floating point numbers 
  *  on the device, and use the MRG31k3p generator, one would have, in the device
@@ -142,12 +209,13 @@
  *  The following table lists the RNG's that are currently implemented in clRNG
  *  with the name of the corresponding header file.
  *
- *  | RNG            | Prefix        | Host Header File | Device Header File |
- *  | -------------- | ------------- | ---------------- | ------------------ |
- *  | MRG31k3p       | `Mrg31k3p`    | mrg31k3p.h       | mrg31k3p.clh       |
- *  | MRG32k3a       | `Mrg32k3a`    | mrg32k3a.h       | mrg32k3a.clh       |
- *  | LFSR113        | `Lfsr113`     | lfsr113.h        | lfsr113.clh        |
- *  | Philox-4×32-10 | `Philox432`   | philox432.h      | philox432.clh      |
+ *  | RNG              | Prefix        | Host Header File | Device Header File |
+ *  | ---------------- | ------------- | ---------------- | ------------------ |
+ *  | MRG31k3p         | `Mrg31k3p`    | mrg31k3p.h       | mrg31k3p.clh       |
+ *  | MRG32k3a         | `Mrg32k3a`    | mrg32k3a.h       | mrg32k3a.clh       |
+ *  | LFSR113          | `Lfsr113`     | lfsr113.h        | lfsr113.clh        |
+ *  | Philox-4×32-10   | `Philox432`   | philox432.h      | philox432.clh      |
+ *  | Threefry-4×32-20 | `Threefry432` | threefry432.h    | threefry432.clh    |
  *
  *
  *  ## The MRG31k3p Generator
@@ -193,8 +261,14 @@
  *  The period length of approximately \f$2^{113}\f$ is divided into 
  *  approximately \f$2^{23}\f$ non-overlapping streams of length \f$Z=2^{90}\f$.
  *  Each stream is further partitioned into \f$2^{35}\f$ substreams of length \f$W=2^{55}\f$.
- *  Note that the functions \c clrngLfsr113ChangeStreamsSpacing() and 
- *  \c clrngLfsr113AdvancedStreams() are not implemented in the current version.
+ *  The functions \c clrngLfsr113ChangeStreamsSpacing() and
+ *  \c clrngLfsr113AdvanceStreams() jump ahead with powers of the
+ *  transition matrices of the four components over GF(2), taking the number
+ *  of steps modulo the period of each component; the matrices of \f$2^k\f$
+ *  steps are computed once and cached.
+ *  The low bits of each component, which the recurrence ignores, may then
+ *  differ from those obtained by clrngLfsr113ForwardToNextSubstreams(), but
+ *  the generated values are identical.
  *
  *
  *  ## The Philox-4×32-10 Generator
@@ -210,9 +284,14 @@
  *  and a 2-bit index used to iterate over the four 32-bit outputs generated for 
  *  each counter value.
  *  The counter is represented internally as a vector of four 32-bit \c cl_uint
- *  values and the index, as a single \c cl_uint value.
- *  In the current clRNG version, the key is the same for all streams, so it 
- *  is not stored in each stream object but rather hardcoded in the implementation.
+ *  values, the index as a single \c cl_uint value, and the key as two 
+ *  \c cl_uint values.
+ *  By default, the key is 0 for all streams, and streams are obtained by 
+ *  spacing their counters as described below.
+ *  Alternatively, after a call to \c clrngPhilox432ChangeStreamsKeying(), 
+ *  a stream creator gives each stream its own key, with the counter starting 
+ *  at 0: stream \f$k\f$ then depends only on \f$k\f$, and can be computed 
+ *  directly with \c clrngPhilox432MakeKeyedState(), on the host or in a kernel.
  *  The period length of \f$2^{130}\f$ is divided into \f$2^{28}\f$ non-overlapping streams 
  *  of length \f$Z=2^{102}\f$.
  *  Each stream is further partitioned into \f$2^{36}\f$ substreams of length \f$W=2^{66}\f$.
@@ -223,6 +302,29 @@
  *  Note that the function \c clrngPhilox432ChangeStreamsSpacing() supports 
  *  only values of \f$c\f$ that are multiples of 4, with either \f$e = 0\f$ or \f$e 
  *  \geq 2\f$.
+ *  Since the state is a position in the sequence, it can also be read and set 
+ *  directly with \c clrngPhilox432GetPosition() and \c clrngPhilox432SetPosition(),
+ *  and \c clrngPhilox432JumpStreams() moves streams forward or backward by an 
+ *  arbitrary number of steps modulo \f$2^{130}\f$, in constant time.
+ *
+ *
+ *  ## The Threefry-4×32-20 Generator
+ *
+ *  The counter-based Threefry-4×32-20 generator is also defined in 
+ *  \cite rSAL11a , where the Threefish block cipher is reduced to 32-bit 
+ *  words and to 20 rounds of additions, rotations and exclusive-ors.
+ *  It uses no multiplications, which makes it preferable to Philox-4×32-10 
+ *  on devices with slow integer multiplication.
+ *  In its implementation, the function and type names start with 
+ *  \c clrngThreefry432.
+ *  Everything said above for Philox-4×32-10 applies to this generator as 
+ *  well: the state has the same layout (a 128-bit counter, the deck of the 
+ *  four outputs of the current counter value, a 2-bit index and a 64-bit 
+ *  key), the period length, streams and substreams are the same, and the 
+ *  streams can be keyed, positioned and moved in the same way.
+ *  The key of Threefry-4×32 has 128 bits, of which the upper 64 are 0.
+ *  With a key of 0 and the same initial counter, the values are those of 
+ *  Random123's \c Engine module for \c threefry4x32.
  *  
  */
 
@@ -308,6 +410,22 @@ extern "C" {
 clrngStreamCreator* clrngCopyStreamCreator(const clrngStreamCreator* creator, clrngStatus* err);
 
 
+/*! @brief Duplicate a stream creator object using a specific allocator
+ *
+ *  Same as clrngCopyStreamCreator(), except that the new stream creator is
+ *  allocated through \c allocator.  It is still released with
+ *  clrngDestroyStreamCreator().
+ *
+ *  @param[in]  creator     Stream creator object to be copied, or `NULL` to
+ *                          copy the default stream creator.
+ *  @param[in]  allocator   Allocator, or `NULL` for the one set with
+ *                          clrngSetAllocator().
+ *  @param[out] err         Error status variable, or `NULL`.
+ *  @return     The newly created stream creator object.
+ */
+clrngStreamCreator* clrngCopyStreamCreatorEx(const clrngStreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err);
+
+
 /*! @brief Destroy a stream creator object
  *
  *  Release the resources associated to a stream creator object.
@@ -394,6 +512,28 @@ clrngStatus clrngChangeStreamsSpacing(clrngStreamCreator* creator, cl_int e, cl_
 clrngStream* clrngAllocStreams(size_t count, size_t* bufSize, clrngStatus* err);
 
 
+/*! @brief Reserve aligned memory for one or more stream objects using a specific allocator
+ *
+ *  Same as clrngAllocStreams(), except that the buffer is aligned on
+ *  \c alignment bytes and allocated through \c allocator.  For example, an
+ *  allocator returning page-locked memory, with \c alignment set to the page
+ *  size, produces a buffer that can be passed to clCreateBuffer() with
+ *  `CL_MEM_USE_HOST_PTR` without an intermediate copy.
+ *  The buffer is still released with clrngDestroyStreams().
+ *
+ *  @param[in]      count       Number of stream objects to allocate.
+ *  @param[in]      alignment   Alignment of the buffer in bytes: 0 for the
+ *                              default, or a power of two.
+ *  @param[in]      allocator   Allocator, or `NULL` for the one set with
+ *                              clrngSetAllocator().
+ *  @param[out]     bufSize     Size in bytes of the allocated buffer, or
+ *                              `NULL` if not needed.
+ *  @param[out]     err         Error status variable, or `NULL`.
+ *  @return     Pointer to the newly allocated buffer.
+ */
+clrngStream* clrngAllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
+
 /*! @brief Destroy one or many stream objects
  *
  *  Release the memory space taken by those stream objects.
@@ -425,6 +565,27 @@ clrngStatus clrngDestroyStreams(clrngStream* streams);
 clrngStream* clrngCreateStreams(clrngStreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err);
 
 
+/*! @brief Allocate memory for and create new RNG stream objects using a specific allocator
+ *
+ *  Same as clrngCreateStreams(), except that the buffer is allocated as with
+ *  clrngAllocStreamsEx().
+ *
+ *  @param[in,out]  creator     Stream creator object, or `NULL` to use the
+ *                              default stream creator.
+ *  @param[in]      count       Size of the array (use 1 for a single stream
+ *                              object).
+ *  @param[in]      alignment   Alignment of the buffer in bytes: 0 for the
+ *                              default, or a power of two.
+ *  @param[in]      allocator   Allocator, or `NULL` for the one set with
+ *                              clrngSetAllocator().
+ *  @param[out]     bufSize     Size in bytes of the allocated buffer, or
+ *                              `NULL` if not needed.
+ *  @param[out]     err         Error status variable, or `NULL`.
+ *  @return     The newly created stream object or array of stream objects.
+ */
+clrngStream* clrngCreateStreamsEx(clrngStreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
+
 /*! @brief Create new RNG stream objects in already allocated memory
  *
  *  This function is similar to \c clrngCreateStreams(), except that it does not reserve 
@@ -463,6 +624,24 @@ clrngStatus clrngCreateOverStreams(clrngStreamCreator* creator, size_t count, cl
 clrngStream* clrngCopyStreams(size_t count, const clrngStream* streams, clrngStatus* err);
 
 
+/*! @brief Clone RNG stream objects using a specific allocator
+ *
+ *  Same as clrngCopyStreams(), except that the new buffer is allocated as
+ *  with clrngAllocStreamsEx().
+ *
+ *  @param[in]  count       Number of stream objects in the array (use 1 for a
+ *                          single stream object).
+ *  @param[in]  streams     Stream object or array of stream objects to be cloned.
+ *  @param[in]  alignment   Alignment of the buffer in bytes: 0 for the
+ *                          default, or a power of two.
+ *  @param[in]  allocator   Allocator, or `NULL` for the one set with
+ *                          clrngSetAllocator().
+ *  @param[out] err         Error status variable, or `NULL`.
+ *  @return     The newly created stream object or array of stream objects.
+ */
+clrngStream* clrngCopyStreamsEx(size_t count, const clrngStream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err);
+
+
 /*! @brief Copy RNG stream objects in already allocated memory [**device**]
  *
  *  Copy (or restore) the stream objects \c srcStreams into the buffer \c destStreams, 
@@ -521,6 +700,86 @@ clrngStatus clrngCopyOverStreamsFromGlobal(size_t count, clrngStream* destStream
 clrngStatus clrngCopyOverStreamsToGlobal(size_t count, clrngHostStream* destStreams, const clrngStream* srcStreams);
 
 
+/*! @brief Load RNG stream objects from compact state buffers in global memory [**device-only**]
+ *
+ *  Copy the stream states \c srcStates from global memory as the current
+ *  states of the device stream objects in the buffer \c destStreams in
+ *  private memory.
+ *  The buffer \c srcStates is normally filled on the host with
+ *  clrngGetStreamStates().
+ *  Unless \c CLRNG_NO_REWIND is defined, the initial state of each device
+ *  stream (and the initial state of its current substream, with
+ *  \c CLRNG_ENABLE_SUBSTREAMS) is set to the loaded state, so that
+ *  clrngRewindStreams() returns to it.
+ *
+ *  @param[in]  count			Number of stream objects to load (use 1 for a single
+ *								stream object).
+ *  @param[out] destStreams		Destination buffer into which to copy (its
+ *								content will be overwritten).
+ *  @param[in]  srcStates		Stream state or array of stream states to be loaded.
+ *
+ *  @return     Error status
+ */
+clrngStatus clrngCopyOverStreamStatesFromGlobal(size_t count, clrngStream* destStreams, const clrngStreamState* srcStates);
+
+
+/*! @brief Store the current states of RNG stream objects into global memory [**device-only**]
+ *
+ *  Copy the current state of each of the device stream objects
+ *  \c srcStreams into the compact state buffer \c destStates in global
+ *  memory, from where the host can read it back with clrngSetStreamStates().
+ *
+ *  @param[in]  count			Number of stream states to copy (use 1 for a single
+ *								stream object).
+ *  @param[out] destStates		Destination buffer into which to copy (its
+ *								content will be overwritten).
+ *  @param[in]  srcStreams		Device stream object or array of device stream objects
+ *								whose current states are to be copied.
+ *
+ *  @return     Error status
+ */
+clrngStatus clrngCopyOverStreamStatesToGlobal(size_t count, clrngStreamState* destStates, const clrngStream* srcStreams);
+
+
+/*! @brief Extract the current states of RNG stream objects
+ *
+ *  Copy the current state of each of the \c count stream objects in
+ *  \c streams into the buffer \c states.
+ *  The resulting compact buffer holds only one state per stream and can be
+ *  sent to the device instead of the stream objects themselves, to be loaded
+ *  there with clrngCopyOverStreamStatesFromGlobal().
+ *
+ *  @param[in]  count       Number of stream objects (use 1 for a single
+ *                          stream object).
+ *  @param[in]  streams     Stream object or array of stream objects.
+ *  @param[out] states      Buffer of \c count stream states (its content
+ *                          will be overwritten).
+ *
+ *  @return     Error status
+ */
+clrngStatus clrngGetStreamStates(size_t count, const clrngStream* streams, clrngStreamState* states);
+
+
+/*! @brief Update the current states of RNG stream objects
+ *
+ *  Set the current state of each of the \c count stream objects in
+ *  \c streams to the corresponding entry of \c states, typically read back
+ *  from the device after a kernel stored them with
+ *  clrngCopyOverStreamStatesToGlobal().
+ *  The initial states of the streams and of their current substreams are left
+ *  unchanged, so the streams can still be rewound on the host.
+ *
+ *  @param[in]  count       Number of stream objects (use 1 for a single
+ *                          stream object).
+ *  @param[in,out] streams  Stream object or array of stream objects to
+ *                          update.
+ *  @param[in]  states      Stream state or array of stream states.
+ *
+ *  @return     Error status
+ */
+clrngStatus clrngSetStreamStates(size_t count, clrngStream* streams, const clrngStreamState* states);
+
+
 /*! @} */
 
 
@@ -597,6 +856,53 @@ clrngStatus clrngRandomU01Array(clrngStream* stream, size_t count, cl_double* bu
 clrngStatus clrngRandomIntegerArray(clrngStream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 
 
+/*! @brief Generate the next random value in (0,1) with full double precision [**device**]
+ *
+ *  Generate and return a (pseudo)random number from the uniform distribution
+ *  over the interval \f$(0,1)\f$ whose 53 significant bits are all random,
+ *  using \c stream.
+ *  The stream state is advanced by two steps: if \f$z_1\f$ and \f$z_2\f$
+ *  are the two successive outputs and \f$\mathrm{norm}\f$ is the factor
+ *  applied by clrngRandomU01(), the returned value is
+ *  \f$z_1 \cdot \mathrm{norm} + z_2 \cdot \mathrm{norm}^2\f$ for
+ *  Mrg31k3p, Mrg32k3a and Lfsr113, and
+ *  \f$z_1 \cdot \mathrm{norm} + (z_2 + 1/2) \cdot \mathrm{norm}^2\f$ for
+ *  Philox432 and Threefry432 (the offset of their clrngRandomU01() applies
+ *  to the low output only).  It is computed as
+ *  \f$(z_1 + z_2 \cdot \mathrm{norm}) \cdot \mathrm{norm}\f$ in double
+ *  precision, with \f$z_2 + 1/2\f$ in place of \f$z_2\f$ for the
+ *  counter-based generators, and kept strictly below 1.
+ *  Hence it always lies within one output granularity of
+ *  \f$z_1 \cdot \mathrm{norm}\f$.
+ *
+ *  On the device, this function is not available when
+ *  \c CLRNG_SINGLE_PRECISION is defined.
+ *
+ *  @param[in,out]  stream      Stream used to generate the random value.
+ *  @return     A random double-precision value uniformly distributed in
+ *              \f$(0,1)\f$
+ */
+cl_double clrngRandomU01_53(clrngStream* stream);
+
+
+/*! @brief Fill an array with successive full-precision random values in (0,1) [**device**]
+ *
+ *  Fill preallocated \c buffer with \c count successive (pseudo)random
+ *  numbers, consuming \c 2*count outputs of \c stream.
+ *  Equivalent to calling clrngRandomU01_53() \c count times to fill the
+ *  buffer, and produces bit-identical values.
+ *  On the host, the outputs of the generator are produced in blocks and
+ *  combined into floating-point values with SIMD instructions when the
+ *  target supports them.
+ *
+ *  @param[in,out]  stream      Stream used to generate the random values.
+ *  @param[in]      count       Number of values in the array.
+ *  @param[out]     buffer      Destination buffer (must be pre-allocated).
+ *  @return     Error status
+ */
+clrngStatus clrngRandomU01Array_53(clrngStream* stream, size_t count, cl_double* buffer);
+
+
 /*! @name Stream Navigation
  *
  *  Functions to roll back or advance streams by many steps.
@@ -617,6 +923,7 @@ clrngStatus clrngRandomIntegerArray(clrngStream* stream, cl_int i, cl_int j, siz
  *
  *  @warning This function can be slow on the device, because it reads the
  *  initial state from global memory.
+ *  It is not available on the device when \c CLRNG_NO_REWIND is defined.
  */
 clrngStatus clrngRewindStreams(size_t count, clrngStream* streams);
 
@@ -709,6 +1016,32 @@ clrngStatus clrngMakeOverSubstreams(clrngStream* stream, size_t count, clrngStre
  */
 clrngStatus clrngAdvanceStreams(size_t count, clrngStream* streams, cl_int e, cl_int c);
 
+/*! @brief Position of a stream in its current substream
+ *
+ *  Compute the number of steps from the initial state of the current
+ *  substream of \c stream to its current state, that is, the number of
+ *  outputs of the generator consumed since the substream was entered
+ *  (clrngRandomU01_53() consumes two outputs per value).
+ *  Comparing the result with the length of a substream tells whether a
+ *  stream was used beyond its current substream.
+ *
+ *  For Philox432 and Threefry432, the position is obtained exactly from the
+ *  difference of the counters, up to \f$2^{64}\f$ steps.
+ *  For the other generators, it is found by a discrete logarithm computation
+ *  (a baby-step giant-step search), whose time and memory grow as the square
+ *  root of the position; positions beyond \f$2^{40}\f$ steps cannot be found
+ *  and result in an error.  Finding positions close to \f$2^{40}\f$ takes
+ *  up to about a second and uses about 16 MB of memory.
+ *
+ *  This function is independent of \c CLRNG_INSTRUMENT.
+ *
+ *  @param[in]      stream      Stream object.
+ *  @param[out]     position    Number of steps from the start of the current substream.
+ *  @return     Error status: ::CLRNG_INVALID_VALUE if the position could not
+ *              be determined.
+ */
+clrngStatus clrngGetStreamPosition(const clrngStream* stream, cl_ulong* position);
+
 
 /*! @} */
 
@@ -760,13 +1093,18 @@ clrngStatus clrngAdvanceStreams(size_t count, clrngStream* streams, cl_int e, cl
  *  @warning In the current implementation, the array \c streams is left
  *  unchanged, as there is no write-back from the device code.
  *
- *  @warning In the current implementation, if the device doesn't support OpenCL
- *  2.0, \c numberCount must be smaller than or a multiple of the device's
- *  maximum workgroup size.
- *
  *  @warning In the current implementation, only \c numQueuesAndEvents = 1 is
  *  supported.
  *
+ *  The kernel is compiled on the first call for a given context, device and
+ *  precision, and the program is cached for subsequent calls until
+ *  clrngReleaseProgramCache() or clrngReleaseContextPrograms() is called.
+ *  The cached program retains the context, which therefore outlives
+ *  clReleaseContext() until then.  Compilations and kernel runs are
+ *  counted in the statistics returned by clrngGetDeviceStats().
+ *  The work-group size is the one chosen by clrngTuneDeviceKernels(), if
+ *  any, and is described by clrngGetDeviceTuning().
+ *
  *  Assume the variables \c context and \c queue are a valid OpenCL context and
  *  command queue, and that we want to generate \c number_count using \c
  *  stream_count distinct streams, where \c number_count is a multiple of \c
@@ -793,6 +1131,143 @@ clrngStatus clrngDeviceRandomU01Array(size_t streamCount, cl_mem streams,
 	cl_command_queue* commQueues, cl_uint numWaitEvents,
 	const cl_event* waitEvents, cl_event* outEvents);
 
+/*! @brief Fill an OpenCL buffer with random numbers, using more work-items than streams
+ *
+ *  Fill the buffer \c outBuffer with \c numberCount uniform random numbers
+ *  of type \c cl_double (or of type \c cl_float if \c CLRNG_SINGLE_PRECISION
+ *  is defined), taking the first `perStream = ceil(numberCount / streamCount)`
+ *  values of each of the \c streamCount streams in \c streams, in the blocked
+ *  layout: value \c i of stream \c s is stored at index `s * perStream + i`,
+ *  for indices below \c numberCount.  Unlike
+ *  clrngDeviceRandomU01Array(), \c numberCount can be any positive number; the
+ *  last streams then contribute fewer values, or none.
+ *  When \c numberCount is a multiple of \c streamCount, the result is
+ *  identical to that of clrngParallelFillU01() with ::CLRNG_FILL_BLOCKED.
+ *
+ *  The values of each stream are split into blocks of \c blockSize values,
+ *  each generated by a separate work-item, which first jumps ahead in its
+ *  stream to the start of its block.  For the MRGs and LFSR113, the jumps
+ *  use matrices computed on the host for the block size and uploaded with
+ *  the kernel (one per bit of the block index); for Philox432 and
+ *  Threefry432, they add to the counter.  Thus a few streams can occupy the
+ *  whole device, and a large output does not require a large array of
+ *  streams.
+ *
+ *  The array \c streams is left unchanged.
+ *
+ *  @param[in]  streamCount     Number of streams in \c streams.
+ *  @param[in]  streams         Buffer of stream objects.
+ *  @param[in]  numberCount     Number of values to generate.
+ *  @param[out] outBuffer       Buffer in which the values are stored.
+ *  @param[in]  blockSize       Number of values generated per work-item, or 0
+ *                              to choose it so that the device is filled.
+ *  @param[in]  queue           Command queue.
+ *  @param[in]  numWaitEvents   Number of events in the event wait list.
+ *  @param[in]  waitEvents      Event wait list.
+ *  @param[out] outEvent        Event of the kernel, or `NULL`.
+ *  @return     Error status
+ *
+ *  The note of clrngDeviceRandomU01Array() about the device header files, the
+ *  program cache and the statistics applies.
+ */
+clrngStatus clrngDeviceFillU01(size_t streamCount, cl_mem streams,
+	size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+/*! @brief Advance the state of streams stored in an OpenCL buffer by many steps
+ *
+ *  Device counterpart of clrngAdvanceStreams(), with the same meaning of
+ *  \c e and \c c: the current state of each of the \c count streams in
+ *  \c streams is advanced by \f$k\f$ steps, and their initial and substream
+ *  states are left unchanged.  The streams do not have to be read back to
+ *  the host.  The jump is computed once on the host and passed to the
+ *  kernel as an argument; each work-item applies it to one stream, as a
+ *  matrix-vector product for the MRGs and LFSR113 and as an addition to the
+ *  counter for Philox432 and Threefry432.  The result is identical to that
+ *  of clrngAdvanceStreams().
+ *
+ *  @param[in]      count           Number of streams in \c streams.
+ *  @param[in,out]  streams         Buffer of stream objects.
+ *  @param[in]      e               Value of \f$e\f$.
+ *  @param[in]      c               Value of \f$c\f$.
+ *  @param[in]      queue           Command queue.
+ *  @param[in]      numWaitEvents   Number of events in the event wait list.
+ *  @param[in]      waitEvents      Event wait list.
+ *  @param[out]     outEvent        Event of the kernel, or `NULL`.
+ *  @return     Error status
+ *
+ *  The note of clrngDeviceRandomU01Array() about the device header files, the
+ *  program cache and the statistics applies; the kernel does not require
+ *  double precision.
+ */
+clrngStatus clrngDeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+
+/*! @brief Fill a host array of random numbers using multiple threads
+ *
+ *  Fill the array \c numbers with \c numberCount uniform random numbers of
+ *  type \c cl_double (or of type \c cl_float if \c CLRNG_SINGLE_PRECISION is
+ *  defined), taking `numberCount / streamCount` successive values from each
+ *  of the \c streamCount streams in \c streams, which are advanced
+ *  accordingly.
+ *  With ::CLRNG_FILL_INTERLEAVED, the result is identical to that of
+ *  clrngDeviceRandomU01Array() with the same streams.
+ *
+ *  The streams are split into \c threadCount contiguous ranges, each
+ *  processed by its own thread, pinned to its own processor where the
+ *  operating system supports it.  With ::CLRNG_FILL_BLOCKED, each thread is
+ *  the first to write to the contiguous part of \c numbers that holds the
+ *  values of its streams, so if \c numbers has not been written to before
+ *  (e.g., it was just obtained from the system allocator), the operating
+ *  system places those pages in the memory closest to the processor that
+ *  fills them.  With ::CLRNG_FILL_INTERLEAVED, each thread writes a few
+ *  values of every row, so most pages are shared by several threads and
+ *  their placement is not controlled.
+ *  The content of \c numbers does not depend on \c threadCount.
+ *  Like clrngDeviceRandomU01Array(), this function is not affected by
+ *  \c CLRNG_FULL_PRECISION_DOUBLE.
+ *
+ *  @param[in]      streamCount     Number of streams in \c streams.
+ *  @param[in,out]  streams         Array of stream objects.
+ *  @param[in]      numberCount     Number of random numbers to store in \c numbers;
+ *                                  must be a multiple of \c streamCount.
+ *  @param[out]     numbers         Destination array.
+ *  @param[in]      threadCount     Number of threads, or 0 to use one thread
+ *                                  per processor available to the process.
+ *  @param[in]      layout          One of ::clrngFillLayout.
+ *  @return     Error status
+ */
+clrngStatus clrngParallelFillU01(size_t streamCount, clrngStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout);
+
+/*! @brief Fill a host array of random numbers exactly as clrngDeviceRandomU01Array() does
+ *
+ *  Host counterpart of clrngDeviceRandomU01Array(), with the same semantics:
+ *  each of the \c streamCount streams in \c streams generates
+ *  `numberCount / streamCount` successive values of type \c cl_double (or
+ *  of type \c cl_float if \c CLRNG_SINGLE_PRECISION is defined), and value
+ *  \c i of stream \c s is stored in `numbers[i * streamCount + s]`.
+ *  As on the device, the values are generated from copies of the streams,
+ *  which are left unchanged.
+ *  This allows the same application code to run on systems with or
+ *  without an OpenCL device, with identical results.
+ *
+ *  The work is shared among \c threadCount threads.  Each thread starts
+ *  with an equal share of the streams, divided into small chunks, and
+ *  threads that run out of work take chunks not yet started from the
+ *  others.  The content of \c numbers does not depend on \c threadCount.
+ *
+ *  @param[in]      streamCount     Number of streams in \c streams.
+ *  @param[in]      streams         Array of stream objects.
+ *  @param[in]      numberCount     Number of random numbers to store in \c numbers;
+ *                                  must be a multiple of \c streamCount.
+ *  @param[out]     numbers         Destination array.
+ *  @param[in]      threadCount     Number of threads, or 0 to use one thread
+ *                                  per processor available to the process.
+ *  @return     Error status
+ */
+clrngStatus clrngHostRandomU01Array(size_t streamCount, const clrngStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount);
+
 
 /*! @} */
 
@@ -810,6 +1285,173 @@ clrngStatus clrngDeviceRandomU01Array(size_t streamCount, cl_mem streams,
  */
 clrngStatus clrngWriteStreamInfo(const clrngStream* stream, FILE *file);
 
+/*! @brief Serialize an array of stream objects to a memory buffer
+ *
+ *  Store the states of \c count stream objects in a compact binary format
+ *  made of 32-bit little-endian words, which does not depend on the host
+ *  endianness or on the layout of the stream objects in memory.
+ *  Each stream is stored as its current state, optionally followed by its
+ *  initial and substream states, as selected by \c flags.
+ *  The data can be read back with clrngDeserializeStreams() or, if written
+ *  to a file, with clrngReadStreams().
+ *
+ *  @param[in]     count    Number of stream objects.
+ *  @param[in]     streams  Stream objects to serialize.
+ *  @param[in]     flags    Bitwise OR of ::clrngSerializeFlags values.
+ *  @param[out]    buffer   Destination buffer.  If `NULL`, only the
+ *                          required size is returned in \c bufSize.
+ *  @param[in,out] bufSize  Size in bytes of \c buffer on input; number of
+ *                          bytes written (or needed) on output.
+ *  @return     Error status
+ */
+clrngStatus clrngSerializeStreams(size_t count, const clrngStream* streams, cl_uint flags, void* buffer, size_t* bufSize);
+
+/*! @brief Serialize an array of stream objects to a file
+ *
+ *  Same as clrngSerializeStreams(), but write to a binary file.
+ *
+ *  @param[in]  count    Number of stream objects.
+ *  @param[in]  streams  Stream objects to serialize.
+ *  @param[in]  flags    Bitwise OR of ::clrngSerializeFlags values.
+ *  @param[in]  file     File opened for writing in binary mode.
+ *  @return     Error status
+ */
+clrngStatus clrngWriteStreams(size_t count, const clrngStream* streams, cl_uint flags, FILE *file);
+
+/*! @brief Deserialize an array of stream objects from a memory buffer
+ *
+ *  Allocate and return a new array of stream objects restored from the data
+ *  produced by clrngSerializeStreams().
+ *  The states that were not serialized are set to the current state.
+ *  The returned array must be released with clrngDestroyStreams().
+ *
+ *  @param[in]  buffer   Serialized data.
+ *  @param[in]  bufSize  Size in bytes of \c buffer.
+ *  @param[out] count    Number of streams read.  Ignored if `NULL`.
+ *  @param[out] err      Error status variable, or `NULL`.
+ *  @return     Newly allocated stream objects, or `NULL` on error.
+ */
+clrngStream* clrngDeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err);
+
+/*! @brief Read an array of stream objects from a file
+ *
+ *  Same as clrngDeserializeStreams(), for a file written by
+ *  clrngWriteStreams().  The file is mapped in memory (read-only) rather
+ *  than read through a stream.
+ *
+ *  @param[in]  path     Path of the file.
+ *  @param[out] count    Number of streams read.  Ignored if `NULL`.
+ *  @param[out] err      Error status variable, or `NULL`.
+ *  @return     Newly allocated stream objects, or `NULL` on error.
+ */
+clrngStream* clrngReadStreams(const char* path, size_t* count, clrngStatus* err);
+
+
+/*! @} */
+
+
+/*! @name Stream Pools
+ *
+ *  A stream pool holds a very large number of streams in a memory-mapped
+ *  file.  Stream \f$k\f$ of a pool is the \f$k\f$-th stream that the
+ *  creator used to build the pool would have produced, but it is computed
+ *  only on first access, by jumping ahead \f$k\f$ times the stream spacing
+ *  in \f$O(\log k)\f$ operations, and then stored in the file.
+ *  The file is sparse: only the pages holding streams that were accessed
+ *  take memory and disk space.
+ *
+ *  Streams are stored as laid out in host memory, so a pool file can only be
+ *  used on hosts with the same architecture.  Since the file is mapped with
+ *  shared access, changes made to the streams obtained with
+ *  clrngGetPoolStream() persist in the file, and a simulation can resume from
+ *  the states it left in the pool.  Several processes can open the same pool
+ *  with ::CLRNG_POOL_READ_ONLY and get streams with clrngCopyPoolStreams().
+ *  A given stream must not be materialized concurrently by several threads.
+ *
+ *  Stream pools are available for all generators.
+ */
+/*! @{ */
+
+/*! @brief Stream pool (opaque)
+ */
+typedef struct clrngStreamPool_ clrngStreamPool;
+
+/*! @brief Create a stream pool file
+ *
+ *  The pool contains the next \c count streams of \c creator, which is
+ *  advanced as if clrngCreateStreams() had been called.
+ *  Any existing file at \c path is overwritten.
+ *
+ *  @param[in,out] creator  Stream creator, or `NULL` for the default creator.
+ *  @param[in]     count    Number of streams in the pool.
+ *  @param[in]     path     Path of the pool file.
+ *  @param[in]     flags    ::CLRNG_POOL_SPARSE or ::CLRNG_POOL_PRECOMPUTE.
+ *  @param[out]    err      Error status variable, or `NULL`.
+ *  @return     New pool object, or `NULL` on error.
+ */
+clrngStreamPool* clrngCreateStreamPool(clrngStreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err);
+
+/*! @brief Open an existing stream pool file
+ *
+ *  @param[in]  path     Path of the pool file.
+ *  @param[in]  flags    ::CLRNG_POOL_READ_ONLY to open the file for reading only.
+ *  @param[out] err      Error status variable, or `NULL`.
+ *  @return     Pool object, or `NULL` on error.
+ */
+clrngStreamPool* clrngOpenStreamPool(const char* path, cl_uint flags, clrngStatus* err);
+
+/*! @brief Close a stream pool
+ *
+ *  The stream objects obtained with clrngGetPoolStream() become invalid.
+ *  Changes are written to the file by the operating system; call
+ *  clrngSyncStreamPool() first to wait until they are.
+ *
+ *  @param[in]  pool    Pool object.
+ *  @return     Error status
+ */
+clrngStatus clrngDestroyStreamPool(clrngStreamPool* pool);
+
+/*! @brief Write the changes made to a stream pool back to its file
+ *
+ *  @param[in]  pool    Pool object.
+ *  @return     Error status
+ */
+clrngStatus clrngSyncStreamPool(clrngStreamPool* pool);
+
+/*! @brief Number of streams in a pool
+ *
+ *  @param[in]  pool    Pool object.
+ *  @return     Number of streams.
+ */
+size_t clrngGetStreamPoolSize(const clrngStreamPool* pool);
+
+/*! @brief Access a stream of a pool in place
+ *
+ *  Materialize stream \c index if needed and return a pointer to it inside
+ *  the mapped file.  Not available for pools opened with
+ *  ::CLRNG_POOL_READ_ONLY.
+ *
+ *  @param[in]  pool    Pool object.
+ *  @param[in]  index   Index of the stream.
+ *  @param[out] err     Error status variable, or `NULL`.
+ *  @return     Stream object, valid until the pool is destroyed, or `NULL` on error.
+ */
+clrngStream* clrngGetPoolStream(clrngStreamPool* pool, size_t index, clrngStatus* err);
+
+/*! @brief Copy streams out of a pool
+ *
+ *  Copy streams \c first to \c first + \c count - 1 of the pool to \c
+ *  streams.  Streams that were not materialized are computed, but not stored
+ *  in the pool.
+ *
+ *  @param[in]  pool    Pool object.
+ *  @param[in]  first   Index of the first stream to copy.
+ *  @param[in]  count   Number of streams to copy.
+ *  @param[out] streams Destination stream objects.
+ *  @return     Error status
+ */
+clrngStatus clrngCopyPoolStreams(const clrngStreamPool* pool, size_t first, size_t count, clrngStream* streams);
+
 
 /*! @} */
 
@@ -67,6 +67,11 @@ struct clrngLfsr113Stream_ {
 			clrngLfsr113StreamState substream;
 		};
 	};
+#ifdef CLRNG_INSTRUMENT
+	/*! @brief Number of values drawn from the stream object (see \c CLRNG_INSTRUMENT)
+	*/
+	cl_ulong draws;
+#endif
 };
 
 /*! @copybrief clrngStream
@@ -90,6 +95,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngLfsr113StreamCreator* clrngLfsr113CopyStreamCreator(const clrngLfsr113StreamCreator* creator, clrngStatus* err);
 
+	/*! @copybrief clrngCopyStreamCreatorEx()
+	*  @see clrngCopyStreamCreatorEx()
+	*/
+	CLRNGAPI clrngLfsr113StreamCreator* clrngLfsr113CopyStreamCreatorEx(const clrngLfsr113StreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err);
+
 	/*! @copybrief clrngDestroyStreamCreator()
 	*  @see clrngDestroyStreamCreator()
 	*/
@@ -115,6 +125,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngLfsr113Stream* clrngLfsr113AllocStreams(size_t count, size_t* bufSize, clrngStatus* err);
 
+	/*! @copybrief clrngAllocStreamsEx()
+	*  @see clrngAllocStreamsEx()
+	*/
+	CLRNGAPI clrngLfsr113Stream* clrngLfsr113AllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 	/*! @copybrief clrngDestroyStreams()
 	*  @see clrngDestroyStreams()
 	*/
@@ -130,6 +145,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngLfsr113Stream* clrngLfsr113CreateStreams(clrngLfsr113StreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err);
 
+	/*! @copybrief clrngCreateStreamsEx()
+	*  @see clrngCreateStreamsEx()
+	*/
+	CLRNGAPI clrngLfsr113Stream* clrngLfsr113CreateStreamsEx(clrngLfsr113StreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 	/*! @copybrief clrngCopyOverStreams()
 	*  @see clrngCopyOverStreams()
 	*/
@@ -140,9 +160,29 @@ extern "C" {
 	*/
 	CLRNGAPI clrngLfsr113Stream* clrngLfsr113CopyStreams(size_t count, const clrngLfsr113Stream* streams, clrngStatus* err);
 
+	/*! @copybrief clrngCopyStreamsEx()
+	*  @see clrngCopyStreamsEx()
+	*/
+	CLRNGAPI clrngLfsr113Stream* clrngLfsr113CopyStreamsEx(size_t count, const clrngLfsr113Stream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err);
+
+	/*! @copybrief clrngGetStreamStates()
+	*  @see clrngGetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113GetStreamStates(size_t count, const clrngLfsr113Stream* streams, clrngLfsr113StreamState* states);
+
+	/*! @copybrief clrngSetStreamStates()
+	*  @see clrngSetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113SetStreamStates(size_t count, clrngLfsr113Stream* streams, const clrngLfsr113StreamState* states);
+
+#if defined(CLRNG_FULL_PRECISION_DOUBLE) && !defined(CLRNG_SINGLE_PRECISION)
+#define clrngLfsr113RandomU01          clrngLfsr113RandomU01_53
+#define clrngLfsr113RandomU01Array     clrngLfsr113RandomU01Array_53
+#else
 #define clrngLfsr113RandomU01          _CLRNG_TAG_FPTYPE(clrngLfsr113RandomU01)
-#define clrngLfsr113RandomInteger      _CLRNG_TAG_FPTYPE(clrngLfsr113RandomInteger)
 #define clrngLfsr113RandomU01Array     _CLRNG_TAG_FPTYPE(clrngLfsr113RandomU01Array)
+#endif
+#define clrngLfsr113RandomInteger      _CLRNG_TAG_FPTYPE(clrngLfsr113RandomInteger)
 #define clrngLfsr113RandomIntegerArray _CLRNG_TAG_FPTYPE(clrngLfsr113RandomIntegerArray)
 
 	/*! @copybrief clrngRandomU01()
@@ -173,6 +213,16 @@ extern "C" {
 	CLRNGAPI clrngStatus clrngLfsr113RandomIntegerArray_cl_float (clrngLfsr113Stream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 	CLRNGAPI clrngStatus clrngLfsr113RandomIntegerArray_cl_double(clrngLfsr113Stream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 
+	/*! @copybrief clrngRandomU01_53()
+	*  @see clrngRandomU01_53()
+	*/
+	CLRNGAPI cl_double clrngLfsr113RandomU01_53(clrngLfsr113Stream* stream);
+
+	/*! @copybrief clrngRandomU01Array_53()
+	*  @see clrngRandomU01Array_53()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113RandomU01Array_53(clrngLfsr113Stream* stream, size_t count, cl_double* buffer);
+
 	/*! @copybrief clrngRewindStreams()
 	*  @see clrngRewindStreams()
 	*/
@@ -203,6 +253,14 @@ extern "C" {
 	*/
 	CLRNGAPI clrngStatus clrngLfsr113AdvanceStreams(size_t count, clrngLfsr113Stream* streams, cl_int e, cl_int c);
 
+	/*! @copybrief clrngGetStreamPosition()
+	*
+	*  Positions beyond \f$2^{40}\f$ steps cannot be found and result in
+	*  ::CLRNG_INVALID_VALUE.
+	*  @see clrngGetStreamPosition()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113GetStreamPosition(const clrngLfsr113Stream* stream, cl_ulong* position);
+
 	/*! @copybrief clrngDeviceRandomU01Array()
 	*  @see clrngDeviceRandomU01Array()
 	*/
@@ -222,11 +280,113 @@ extern "C" {
 /** \endinternal
  */
 
+	/*! @copybrief clrngDeviceFillU01()
+	*  @see clrngDeviceFillU01()
+	*/
+#ifdef CLRNG_SINGLE_PRECISION
+#define clrngLfsr113DeviceFillU01(...) clrngLfsr113DeviceFillU01_(__VA_ARGS__, CL_TRUE)
+#else
+#define clrngLfsr113DeviceFillU01(...) clrngLfsr113DeviceFillU01_(__VA_ARGS__, CL_FALSE)
+#endif
+
+	/** \internal
+	 *  @brief Helper function for clrngLfsr113DeviceFillU01()
+	 */
+	CLRNGAPI clrngStatus clrngLfsr113DeviceFillU01_(size_t streamCount, cl_mem streams,
+		size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+		cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision);
+/** \endinternal
+ */
+
+	/*! @copybrief clrngDeviceAdvanceStreams()
+	*  @see clrngDeviceAdvanceStreams()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113DeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+		cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+#define clrngLfsr113ParallelFillU01 _CLRNG_TAG_FPTYPE(clrngLfsr113ParallelFillU01)
+
+	/*! @copybrief clrngParallelFillU01()
+	*  @see clrngParallelFillU01()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113ParallelFillU01(size_t streamCount, clrngLfsr113Stream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngLfsr113ParallelFillU01_cl_float (size_t streamCount, clrngLfsr113Stream* streams, size_t numberCount, cl_float * numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngLfsr113ParallelFillU01_cl_double(size_t streamCount, clrngLfsr113Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout);
+
+#define clrngLfsr113HostRandomU01Array _CLRNG_TAG_FPTYPE(clrngLfsr113HostRandomU01Array)
+
+	/*! @copybrief clrngHostRandomU01Array()
+	*  @see clrngHostRandomU01Array()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113HostRandomU01Array(size_t streamCount, const clrngLfsr113Stream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngLfsr113HostRandomU01Array_cl_float (size_t streamCount, const clrngLfsr113Stream* streams, size_t numberCount, cl_float * numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngLfsr113HostRandomU01Array_cl_double(size_t streamCount, const clrngLfsr113Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount);
+
 	/*! @copybrief clrngWriteStreamInfo()
 	*  @see clrngWriteStreamInfo()
 	*/
 	CLRNGAPI clrngStatus clrngLfsr113WriteStreamInfo(const clrngLfsr113Stream* stream, FILE *file);
 
+	/*! @copybrief clrngSerializeStreams()
+	*  @see clrngSerializeStreams()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113SerializeStreams(size_t count, const clrngLfsr113Stream* streams, cl_uint flags, void* buffer, size_t* bufSize);
+
+	/*! @copybrief clrngWriteStreams()
+	*  @see clrngWriteStreams()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113WriteStreams(size_t count, const clrngLfsr113Stream* streams, cl_uint flags, FILE *file);
+
+	/*! @copybrief clrngDeserializeStreams()
+	*  @see clrngDeserializeStreams()
+	*/
+	CLRNGAPI clrngLfsr113Stream* clrngLfsr113DeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngReadStreams()
+	*  @see clrngReadStreams()
+	*/
+	CLRNGAPI clrngLfsr113Stream* clrngLfsr113ReadStreams(const char* path, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngStreamPool
+	*  @see clrngStreamPool
+	*/
+	typedef struct clrngLfsr113StreamPool_ clrngLfsr113StreamPool;
+
+	/*! @copybrief clrngCreateStreamPool()
+	*  @see clrngCreateStreamPool()
+	*/
+	CLRNGAPI clrngLfsr113StreamPool* clrngLfsr113CreateStreamPool(clrngLfsr113StreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngOpenStreamPool()
+	*  @see clrngOpenStreamPool()
+	*/
+	CLRNGAPI clrngLfsr113StreamPool* clrngLfsr113OpenStreamPool(const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngDestroyStreamPool()
+	*  @see clrngDestroyStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113DestroyStreamPool(clrngLfsr113StreamPool* pool);
+
+	/*! @copybrief clrngSyncStreamPool()
+	*  @see clrngSyncStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113SyncStreamPool(clrngLfsr113StreamPool* pool);
+
+	/*! @copybrief clrngGetStreamPoolSize()
+	*  @see clrngGetStreamPoolSize()
+	*/
+	CLRNGAPI size_t clrngLfsr113GetStreamPoolSize(const clrngLfsr113StreamPool* pool);
+
+	/*! @copybrief clrngGetPoolStream()
+	*  @see clrngGetPoolStream()
+	*/
+	CLRNGAPI clrngLfsr113Stream* clrngLfsr113GetPoolStream(clrngLfsr113StreamPool* pool, size_t index, clrngStatus* err);
+
+	/*! @copybrief clrngCopyPoolStreams()
+	*  @see clrngCopyPoolStreams()
+	*/
+	CLRNGAPI clrngStatus clrngLfsr113CopyPoolStreams(const clrngLfsr113StreamPool* pool, size_t first, size_t count, clrngLfsr113Stream* streams);
+
 
 #if 0
 	CLRNGAPI clrngLfsr113Stream* clrngLfsr113GetStreamByIndex(clrngLfsr113Stream* stream, cl_uint index);
@@ -70,6 +70,11 @@ struct clrngMrg31k3pStream_ {
 			clrngMrg31k3pStreamState substream;
 		};
 	};
+#ifdef CLRNG_INSTRUMENT
+	/*! @brief Number of values drawn from the stream object (see \c CLRNG_INSTRUMENT)
+	*/
+	cl_ulong draws;
+#endif
 };
 
 /*! @copybrief clrngStream
@@ -93,6 +98,11 @@ extern "C" {
  */
 CLRNGAPI clrngMrg31k3pStreamCreator* clrngMrg31k3pCopyStreamCreator(const clrngMrg31k3pStreamCreator* creator, clrngStatus* err);
 
+/*! @copybrief clrngCopyStreamCreatorEx()
+ *  @see clrngCopyStreamCreatorEx()
+ */
+CLRNGAPI clrngMrg31k3pStreamCreator* clrngMrg31k3pCopyStreamCreatorEx(const clrngMrg31k3pStreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err);
+
 /*! @copybrief clrngDestroyStreamCreator()
  *  @see clrngDestroyStreamCreator()
  */
@@ -118,6 +128,11 @@ CLRNGAPI clrngStatus clrngMrg31k3pChangeStreamsSpacing(clrngMrg31k3pStreamCreato
  */
 CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pAllocStreams(size_t count, size_t* bufSize, clrngStatus* err);
 
+/*! @copybrief clrngAllocStreamsEx()
+ *  @see clrngAllocStreamsEx()
+ */
+CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pAllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 /*! @copybrief clrngDestroyStreams()
  *  @see clrngDestroyStreams()
  */
@@ -133,6 +148,11 @@ CLRNGAPI clrngStatus clrngMrg31k3pCreateOverStreams(clrngMrg31k3pStreamCreator*
  */
 CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pCreateStreams(clrngMrg31k3pStreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err);
 
+/*! @copybrief clrngCreateStreamsEx()
+ *  @see clrngCreateStreamsEx()
+ */
+CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pCreateStreamsEx(clrngMrg31k3pStreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 /*! @copybrief clrngCopyOverStreams()
  *  @see clrngCopyOverStreams()
  */
@@ -143,9 +163,29 @@ CLRNGAPI clrngStatus clrngMrg31k3pCopyOverStreams(size_t count, clrngMrg31k3pStr
  */
 CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pCopyStreams(size_t count, const clrngMrg31k3pStream* streams, clrngStatus* err);
 
+/*! @copybrief clrngCopyStreamsEx()
+ *  @see clrngCopyStreamsEx()
+ */
+CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pCopyStreamsEx(size_t count, const clrngMrg31k3pStream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err);
+
+/*! @copybrief clrngGetStreamStates()
+ *  @see clrngGetStreamStates()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pGetStreamStates(size_t count, const clrngMrg31k3pStream* streams, clrngMrg31k3pStreamState* states);
+
+/*! @copybrief clrngSetStreamStates()
+ *  @see clrngSetStreamStates()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pSetStreamStates(size_t count, clrngMrg31k3pStream* streams, const clrngMrg31k3pStreamState* states);
+
+#if defined(CLRNG_FULL_PRECISION_DOUBLE) && !defined(CLRNG_SINGLE_PRECISION)
+#define clrngMrg31k3pRandomU01          clrngMrg31k3pRandomU01_53
+#define clrngMrg31k3pRandomU01Array     clrngMrg31k3pRandomU01Array_53
+#else
 #define clrngMrg31k3pRandomU01          _CLRNG_TAG_FPTYPE(clrngMrg31k3pRandomU01)
-#define clrngMrg31k3pRandomInteger      _CLRNG_TAG_FPTYPE(clrngMrg31k3pRandomInteger)
 #define clrngMrg31k3pRandomU01Array     _CLRNG_TAG_FPTYPE(clrngMrg31k3pRandomU01Array)
+#endif
+#define clrngMrg31k3pRandomInteger      _CLRNG_TAG_FPTYPE(clrngMrg31k3pRandomInteger)
 #define clrngMrg31k3pRandomIntegerArray _CLRNG_TAG_FPTYPE(clrngMrg31k3pRandomIntegerArray)
 
 /*! @copybrief clrngRandomU01()
@@ -176,6 +216,16 @@ CLRNGAPI clrngStatus clrngMrg31k3pRandomIntegerArray(clrngMrg31k3pStream* stream
 CLRNGAPI clrngStatus clrngMrg31k3pRandomIntegerArray_cl_float (clrngMrg31k3pStream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 CLRNGAPI clrngStatus clrngMrg31k3pRandomIntegerArray_cl_double(clrngMrg31k3pStream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 
+/*! @copybrief clrngRandomU01_53()
+ *  @see clrngRandomU01_53()
+ */
+CLRNGAPI cl_double clrngMrg31k3pRandomU01_53(clrngMrg31k3pStream* stream);
+
+/*! @copybrief clrngRandomU01Array_53()
+ *  @see clrngRandomU01Array_53()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pRandomU01Array_53(clrngMrg31k3pStream* stream, size_t count, cl_double* buffer);
+
 /*! @copybrief clrngRewindStreams()
  *  @see clrngRewindStreams()
  */
@@ -206,6 +256,14 @@ CLRNGAPI clrngStatus clrngMrg31k3pMakeOverSubstreams(clrngMrg31k3pStream* stream
  */
 CLRNGAPI clrngStatus clrngMrg31k3pAdvanceStreams(size_t count, clrngMrg31k3pStream* streams, cl_int e, cl_int c);
 
+/*! @copybrief clrngGetStreamPosition()
+ *
+ *  Positions beyond \f$2^{40}\f$ steps cannot be found and result in
+ *  ::CLRNG_INVALID_VALUE.
+ *  @see clrngGetStreamPosition()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pGetStreamPosition(const clrngMrg31k3pStream* stream, cl_ulong* position);
+
 /*! @copybrief clrngDeviceRandomU01Array()
  *  @see clrngDeviceRandomU01Array()
  */
@@ -225,11 +283,113 @@ CLRNGAPI clrngStatus clrngMrg31k3pDeviceRandomU01Array_(size_t streamCount, cl_m
 /** \endinternal
  */
 
+/*! @copybrief clrngDeviceFillU01()
+ *  @see clrngDeviceFillU01()
+ */
+#ifdef CLRNG_SINGLE_PRECISION
+#define clrngMrg31k3pDeviceFillU01(...) clrngMrg31k3pDeviceFillU01_(__VA_ARGS__, CL_TRUE)
+#else
+#define clrngMrg31k3pDeviceFillU01(...) clrngMrg31k3pDeviceFillU01_(__VA_ARGS__, CL_FALSE)
+#endif
+
+/** \internal
+ *  @brief Helper function for clrngMrg31k3pDeviceFillU01()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pDeviceFillU01_(size_t streamCount, cl_mem streams,
+	size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision);
+/** \endinternal
+ */
+
+/*! @copybrief clrngDeviceAdvanceStreams()
+ *  @see clrngDeviceAdvanceStreams()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pDeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+#define clrngMrg31k3pParallelFillU01 _CLRNG_TAG_FPTYPE(clrngMrg31k3pParallelFillU01)
+
+/*! @copybrief clrngParallelFillU01()
+ *  @see clrngParallelFillU01()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pParallelFillU01(size_t streamCount, clrngMrg31k3pStream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount, cl_uint layout);
+CLRNGAPI clrngStatus clrngMrg31k3pParallelFillU01_cl_float (size_t streamCount, clrngMrg31k3pStream* streams, size_t numberCount, cl_float * numbers, size_t threadCount, cl_uint layout);
+CLRNGAPI clrngStatus clrngMrg31k3pParallelFillU01_cl_double(size_t streamCount, clrngMrg31k3pStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout);
+
+#define clrngMrg31k3pHostRandomU01Array _CLRNG_TAG_FPTYPE(clrngMrg31k3pHostRandomU01Array)
+
+/*! @copybrief clrngHostRandomU01Array()
+ *  @see clrngHostRandomU01Array()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pHostRandomU01Array(size_t streamCount, const clrngMrg31k3pStream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount);
+CLRNGAPI clrngStatus clrngMrg31k3pHostRandomU01Array_cl_float (size_t streamCount, const clrngMrg31k3pStream* streams, size_t numberCount, cl_float * numbers, size_t threadCount);
+CLRNGAPI clrngStatus clrngMrg31k3pHostRandomU01Array_cl_double(size_t streamCount, const clrngMrg31k3pStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount);
+
 /*! @copybrief clrngWriteStreamInfo()
  *  @see clrngWriteStreamInfo()
  */
 CLRNGAPI clrngStatus clrngMrg31k3pWriteStreamInfo(const clrngMrg31k3pStream* stream, FILE *file);
 
+/*! @copybrief clrngSerializeStreams()
+ *  @see clrngSerializeStreams()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pSerializeStreams(size_t count, const clrngMrg31k3pStream* streams, cl_uint flags, void* buffer, size_t* bufSize);
+
+/*! @copybrief clrngWriteStreams()
+ *  @see clrngWriteStreams()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pWriteStreams(size_t count, const clrngMrg31k3pStream* streams, cl_uint flags, FILE *file);
+
+/*! @copybrief clrngDeserializeStreams()
+ *  @see clrngDeserializeStreams()
+ */
+CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pDeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err);
+
+/*! @copybrief clrngReadStreams()
+ *  @see clrngReadStreams()
+ */
+CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pReadStreams(const char* path, size_t* count, clrngStatus* err);
+
+/*! @copybrief clrngStreamPool
+ *  @see clrngStreamPool
+ */
+typedef struct clrngMrg31k3pStreamPool_ clrngMrg31k3pStreamPool;
+
+/*! @copybrief clrngCreateStreamPool()
+ *  @see clrngCreateStreamPool()
+ */
+CLRNGAPI clrngMrg31k3pStreamPool* clrngMrg31k3pCreateStreamPool(clrngMrg31k3pStreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err);
+
+/*! @copybrief clrngOpenStreamPool()
+ *  @see clrngOpenStreamPool()
+ */
+CLRNGAPI clrngMrg31k3pStreamPool* clrngMrg31k3pOpenStreamPool(const char* path, cl_uint flags, clrngStatus* err);
+
+/*! @copybrief clrngDestroyStreamPool()
+ *  @see clrngDestroyStreamPool()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pDestroyStreamPool(clrngMrg31k3pStreamPool* pool);
+
+/*! @copybrief clrngSyncStreamPool()
+ *  @see clrngSyncStreamPool()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pSyncStreamPool(clrngMrg31k3pStreamPool* pool);
+
+/*! @copybrief clrngGetStreamPoolSize()
+ *  @see clrngGetStreamPoolSize()
+ */
+CLRNGAPI size_t clrngMrg31k3pGetStreamPoolSize(const clrngMrg31k3pStreamPool* pool);
+
+/*! @copybrief clrngGetPoolStream()
+ *  @see clrngGetPoolStream()
+ */
+CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pGetPoolStream(clrngMrg31k3pStreamPool* pool, size_t index, clrngStatus* err);
+
+/*! @copybrief clrngCopyPoolStreams()
+ *  @see clrngCopyPoolStreams()
+ */
+CLRNGAPI clrngStatus clrngMrg31k3pCopyPoolStreams(const clrngMrg31k3pStreamPool* pool, size_t first, size_t count, clrngMrg31k3pStream* streams);
+
 
 #if 0
 CLRNGAPI clrngMrg31k3pStream* clrngMrg31k3pGetStreamByIndex(clrngMrg31k3pStream* stream, cl_uint index);
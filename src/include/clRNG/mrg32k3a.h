@@ -70,6 +70,11 @@ struct clrngMrg32k3aStream_ {
 			clrngMrg32k3aStreamState substream;
 		};
 	};
+#ifdef CLRNG_INSTRUMENT
+	/*! @brief Number of values drawn from the stream object (see \c CLRNG_INSTRUMENT)
+	*/
+	cl_ulong draws;
+#endif
 };
 
 /*! @copybrief clrngStream
@@ -93,6 +98,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngMrg32k3aStreamCreator* clrngMrg32k3aCopyStreamCreator(const clrngMrg32k3aStreamCreator* creator, clrngStatus* err);
 
+	/*! @copybrief clrngCopyStreamCreatorEx()
+	*  @see clrngCopyStreamCreatorEx()
+	*/
+	CLRNGAPI clrngMrg32k3aStreamCreator* clrngMrg32k3aCopyStreamCreatorEx(const clrngMrg32k3aStreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err);
+
 	/*! @copybrief clrngDestroyStreamCreator()
 	*  @see clrngDestroyStreamCreator()
 	*/
@@ -118,6 +128,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aAllocStreams(size_t count, size_t* bufSize, clrngStatus* err);
 
+	/*! @copybrief clrngAllocStreamsEx()
+	*  @see clrngAllocStreamsEx()
+	*/
+	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aAllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 	/*! @copybrief clrngDestroyStreams()
 	*  @see clrngDestroyStreams()
 	*/
@@ -133,6 +148,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aCreateStreams(clrngMrg32k3aStreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err);
 
+	/*! @copybrief clrngCreateStreamsEx()
+	*  @see clrngCreateStreamsEx()
+	*/
+	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aCreateStreamsEx(clrngMrg32k3aStreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 	/*! @copybrief clrngCopyOverStreams()
 	*  @see clrngCopyOverStreams()
 	*/
@@ -143,9 +163,29 @@ extern "C" {
 	*/
 	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aCopyStreams(size_t count, const clrngMrg32k3aStream* streams, clrngStatus* err);
 
+	/*! @copybrief clrngCopyStreamsEx()
+	*  @see clrngCopyStreamsEx()
+	*/
+	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aCopyStreamsEx(size_t count, const clrngMrg32k3aStream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err);
+
+	/*! @copybrief clrngGetStreamStates()
+	*  @see clrngGetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aGetStreamStates(size_t count, const clrngMrg32k3aStream* streams, clrngMrg32k3aStreamState* states);
+
+	/*! @copybrief clrngSetStreamStates()
+	*  @see clrngSetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aSetStreamStates(size_t count, clrngMrg32k3aStream* streams, const clrngMrg32k3aStreamState* states);
+
+#if defined(CLRNG_FULL_PRECISION_DOUBLE) && !defined(CLRNG_SINGLE_PRECISION)
+#define clrngMrg32k3aRandomU01          clrngMrg32k3aRandomU01_53
+#define clrngMrg32k3aRandomU01Array     clrngMrg32k3aRandomU01Array_53
+#else
 #define clrngMrg32k3aRandomU01          _CLRNG_TAG_FPTYPE(clrngMrg32k3aRandomU01)
-#define clrngMrg32k3aRandomInteger      _CLRNG_TAG_FPTYPE(clrngMrg32k3aRandomInteger)
 #define clrngMrg32k3aRandomU01Array     _CLRNG_TAG_FPTYPE(clrngMrg32k3aRandomU01Array)
+#endif
+#define clrngMrg32k3aRandomInteger      _CLRNG_TAG_FPTYPE(clrngMrg32k3aRandomInteger)
 #define clrngMrg32k3aRandomIntegerArray _CLRNG_TAG_FPTYPE(clrngMrg32k3aRandomIntegerArray)
 
 	/*! @copybrief clrngRandomU01()
@@ -176,6 +216,16 @@ extern "C" {
 	CLRNGAPI clrngStatus clrngMrg32k3aRandomIntegerArray_cl_float (clrngMrg32k3aStream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 	CLRNGAPI clrngStatus clrngMrg32k3aRandomIntegerArray_cl_double(clrngMrg32k3aStream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 
+	/*! @copybrief clrngRandomU01_53()
+	*  @see clrngRandomU01_53()
+	*/
+	CLRNGAPI cl_double clrngMrg32k3aRandomU01_53(clrngMrg32k3aStream* stream);
+
+	/*! @copybrief clrngRandomU01Array_53()
+	*  @see clrngRandomU01Array_53()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aRandomU01Array_53(clrngMrg32k3aStream* stream, size_t count, cl_double* buffer);
+
 	/*! @copybrief clrngRewindStreams()
 	*  @see clrngRewindStreams()
 	*/
@@ -206,6 +256,14 @@ extern "C" {
 	*/
 	CLRNGAPI clrngStatus clrngMrg32k3aAdvanceStreams(size_t count, clrngMrg32k3aStream* streams, cl_int e, cl_int c);
 
+	/*! @copybrief clrngGetStreamPosition()
+	*
+	*  Positions beyond \f$2^{40}\f$ steps cannot be found and result in
+	*  ::CLRNG_INVALID_VALUE.
+	*  @see clrngGetStreamPosition()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aGetStreamPosition(const clrngMrg32k3aStream* stream, cl_ulong* position);
+
 	/*! @copybrief clrngDeviceRandomU01Array()
 	*  @see clrngDeviceRandomU01Array()
 	*/
@@ -225,11 +283,113 @@ extern "C" {
 /** \endinternal
  */
 
+	/*! @copybrief clrngDeviceFillU01()
+	*  @see clrngDeviceFillU01()
+	*/
+#ifdef CLRNG_SINGLE_PRECISION
+#define clrngMrg32k3aDeviceFillU01(...) clrngMrg32k3aDeviceFillU01_(__VA_ARGS__, CL_TRUE)
+#else
+#define clrngMrg32k3aDeviceFillU01(...) clrngMrg32k3aDeviceFillU01_(__VA_ARGS__, CL_FALSE)
+#endif
+
+	/** \internal
+	 *  @brief Helper function for clrngMrg32k3aDeviceFillU01()
+	 */
+	CLRNGAPI clrngStatus clrngMrg32k3aDeviceFillU01_(size_t streamCount, cl_mem streams,
+		size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+		cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision);
+/** \endinternal
+ */
+
+	/*! @copybrief clrngDeviceAdvanceStreams()
+	*  @see clrngDeviceAdvanceStreams()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aDeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+		cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+#define clrngMrg32k3aParallelFillU01 _CLRNG_TAG_FPTYPE(clrngMrg32k3aParallelFillU01)
+
+	/*! @copybrief clrngParallelFillU01()
+	*  @see clrngParallelFillU01()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aParallelFillU01(size_t streamCount, clrngMrg32k3aStream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngMrg32k3aParallelFillU01_cl_float (size_t streamCount, clrngMrg32k3aStream* streams, size_t numberCount, cl_float * numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngMrg32k3aParallelFillU01_cl_double(size_t streamCount, clrngMrg32k3aStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout);
+
+#define clrngMrg32k3aHostRandomU01Array _CLRNG_TAG_FPTYPE(clrngMrg32k3aHostRandomU01Array)
+
+	/*! @copybrief clrngHostRandomU01Array()
+	*  @see clrngHostRandomU01Array()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aHostRandomU01Array(size_t streamCount, const clrngMrg32k3aStream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngMrg32k3aHostRandomU01Array_cl_float (size_t streamCount, const clrngMrg32k3aStream* streams, size_t numberCount, cl_float * numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngMrg32k3aHostRandomU01Array_cl_double(size_t streamCount, const clrngMrg32k3aStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount);
+
 	/*! @copybrief clrngWriteStreamInfo()
 	*  @see clrngWriteStreamInfo()
 	*/
 	CLRNGAPI clrngStatus clrngMrg32k3aWriteStreamInfo(const clrngMrg32k3aStream* stream, FILE *file);
 
+	/*! @copybrief clrngSerializeStreams()
+	*  @see clrngSerializeStreams()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aSerializeStreams(size_t count, const clrngMrg32k3aStream* streams, cl_uint flags, void* buffer, size_t* bufSize);
+
+	/*! @copybrief clrngWriteStreams()
+	*  @see clrngWriteStreams()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aWriteStreams(size_t count, const clrngMrg32k3aStream* streams, cl_uint flags, FILE *file);
+
+	/*! @copybrief clrngDeserializeStreams()
+	*  @see clrngDeserializeStreams()
+	*/
+	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aDeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngReadStreams()
+	*  @see clrngReadStreams()
+	*/
+	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aReadStreams(const char* path, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngStreamPool
+	*  @see clrngStreamPool
+	*/
+	typedef struct clrngMrg32k3aStreamPool_ clrngMrg32k3aStreamPool;
+
+	/*! @copybrief clrngCreateStreamPool()
+	*  @see clrngCreateStreamPool()
+	*/
+	CLRNGAPI clrngMrg32k3aStreamPool* clrngMrg32k3aCreateStreamPool(clrngMrg32k3aStreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngOpenStreamPool()
+	*  @see clrngOpenStreamPool()
+	*/
+	CLRNGAPI clrngMrg32k3aStreamPool* clrngMrg32k3aOpenStreamPool(const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngDestroyStreamPool()
+	*  @see clrngDestroyStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aDestroyStreamPool(clrngMrg32k3aStreamPool* pool);
+
+	/*! @copybrief clrngSyncStreamPool()
+	*  @see clrngSyncStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aSyncStreamPool(clrngMrg32k3aStreamPool* pool);
+
+	/*! @copybrief clrngGetStreamPoolSize()
+	*  @see clrngGetStreamPoolSize()
+	*/
+	CLRNGAPI size_t clrngMrg32k3aGetStreamPoolSize(const clrngMrg32k3aStreamPool* pool);
+
+	/*! @copybrief clrngGetPoolStream()
+	*  @see clrngGetPoolStream()
+	*/
+	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aGetPoolStream(clrngMrg32k3aStreamPool* pool, size_t index, clrngStatus* err);
+
+	/*! @copybrief clrngCopyPoolStreams()
+	*  @see clrngCopyPoolStreams()
+	*/
+	CLRNGAPI clrngStatus clrngMrg32k3aCopyPoolStreams(const clrngMrg32k3aStreamPool* pool, size_t first, size_t count, clrngMrg32k3aStream* streams);
+
 
 #if 0
 	CLRNGAPI clrngMrg32k3aStream* clrngMrg32k3aGetStreamByIndex(clrngMrg32k3aStream* stream, cl_uint index);
@@ -43,52 +43,19 @@
 #include <stdio.h>
 
 
-/*  @brief State type of a Philox432 stream
-*
-*  The state is a seed consisting of a 128bits counter
-*
-*  @see clrngStreamState
+/*! @brief Number of rounds of the Philox-4x32 bijection (see \c CLRNG_PHILOX432_ROUNDS)
 */
+#ifndef CLRNG_PHILOX432_ROUNDS
+#define CLRNG_PHILOX432_ROUNDS 10
+#endif
+#if CLRNG_PHILOX432_ROUNDS < 1 || CLRNG_PHILOX432_ROUNDS > 16
+#error "CLRNG_PHILOX432_ROUNDS must be between 1 and 16"
+#endif
 
-typedef struct clrngPhilox432SB_ {
-	cl_uint msb, lsb;   //most significant bits, and the least significant bits
-}clrngPhilox432SB;
-
-typedef struct clrngPhilox432Counter_ {
-	clrngPhilox432SB H, L;
-} clrngPhilox432Counter;
-
-
-typedef struct {
-	clrngPhilox432Counter  ctr;  // 128 bits counter
-	cl_uint  deck[4];            // this table hold the 4x32 generated uint from philox4x32(ctr,kry) function
-	cl_uint deckIndex;           //the index of actual pregenerated integer to give to the user
-} clrngPhilox432StreamState;
-
-
-struct clrngPhilox432Stream_ {
-	union {
-		struct {
-			clrngPhilox432StreamState states[3];
-		};
-		struct {
-			clrngPhilox432StreamState current;
-			clrngPhilox432StreamState initial;
-			clrngPhilox432StreamState substream;
-		};
-	};
-};
-
-/*! @copybrief clrngStream
-*  @see clrngStream
-*/
-typedef struct clrngPhilox432Stream_ clrngPhilox432Stream;
-
-struct clrngPhilox432StreamCreator_;
-/*! @copybrief clrngStreamCreator
-*  @see clrngStreamCreator
-*/
-typedef struct clrngPhilox432StreamCreator_ clrngPhilox432StreamCreator;
+// state, position and stream types, shared with Threefry432
+#define COUNTER432_RNG(name) clrngPhilox432##name
+#include <clRNG/private/counter432.h>
+#undef COUNTER432_RNG
 
 
 #ifdef __cplusplus
@@ -100,6 +67,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngPhilox432StreamCreator* clrngPhilox432CopyStreamCreator(const clrngPhilox432StreamCreator* creator, clrngStatus* err);
 
+	/*! @copybrief clrngCopyStreamCreatorEx()
+	*  @see clrngCopyStreamCreatorEx()
+	*/
+	CLRNGAPI clrngPhilox432StreamCreator* clrngPhilox432CopyStreamCreatorEx(const clrngPhilox432StreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err);
+
 	/*! @copybrief clrngDestroyStreamCreator()
 	*  @see clrngDestroyStreamCreator()
 	*/
@@ -120,11 +92,58 @@ extern "C" {
 	*/
 	CLRNGAPI clrngStatus clrngPhilox432ChangeStreamsSpacing(clrngPhilox432StreamCreator* creator, cl_int e, cl_int c);
 
+	/*! @brief Give each new stream its own key
+	*
+	*  When \c keyPerStream is \c CL_TRUE, the streams subsequently created
+	*  with \c creator all start at counter 0, and differ by their key instead
+	*  of their counter: the key of the next stream is that of the next state
+	*  of the creator (the key of the base state after a rewind), and is
+	*  incremented by one for each stream created.  With the default base
+	*  state, stream \f$k\f$ thus has key \f$k\f$, and can be obtained
+	*  directly with clrngPhilox432MakeKeyedState().
+	*  The number of streams is then bounded by \f$2^{64}\f$, each with the
+	*  full period of \f$2^{130}\f$ and the usual substreams; the spacing
+	*  set with clrngPhilox432ChangeStreamsSpacing() is ignored.
+	*
+	*  Unkeyed streams all have key 0, so with the default base state,
+	*  keyed stream 0 (key 0, counter 0) is the same stream as the first
+	*  unkeyed stream of the default creator.  To mix both modes without
+	*  overlap, give the keyed creator a base state with a nonzero key, or
+	*  skip keyed stream 0.
+	*
+	*  @param[in,out] creator  Stream creator; the default creator cannot be modified.
+	*  @param[in]  keyPerStream  Whether to key streams rather than space their counters.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432ChangeStreamsKeying(clrngPhilox432StreamCreator* creator, cl_bool keyPerStream);
+
+	/*! @brief Initial state of the stream with the given key [**device**]
+	*
+	*  Set \c state to counter 0 under key \c key, in constant time.
+	*  On the device, with \c CLRNG_NO_REWIND defined, a work item can
+	*  derive its own stream from its global ID instead of reading it from a
+	*  buffer:
+	*  @code
+	*  clrngPhilox432Stream stream;
+	*  clrngPhilox432MakeKeyedState(get_global_id(0), &stream.current);
+	*  @endcode
+	*
+	*  @param[in]  key         Key (stream identifier).
+	*  @param[out] state       Stream state.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432MakeKeyedState(cl_ulong key, clrngPhilox432StreamState* state);
+
 	/*! @copybrief clrngAllocStreams()
 	*  @see clrngAllocStreams()
 	*/
 	CLRNGAPI clrngPhilox432Stream* clrngPhilox432AllocStreams(size_t count, size_t* bufSize, clrngStatus* err);
 
+	/*! @copybrief clrngAllocStreamsEx()
+	*  @see clrngAllocStreamsEx()
+	*/
+	CLRNGAPI clrngPhilox432Stream* clrngPhilox432AllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 	/*! @copybrief clrngDestroyStreams()
 	*  @see clrngDestroyStreams()
 	*/
@@ -140,6 +159,11 @@ extern "C" {
 	*/
 	CLRNGAPI clrngPhilox432Stream* clrngPhilox432CreateStreams(clrngPhilox432StreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err);
 
+	/*! @copybrief clrngCreateStreamsEx()
+	*  @see clrngCreateStreamsEx()
+	*/
+	CLRNGAPI clrngPhilox432Stream* clrngPhilox432CreateStreamsEx(clrngPhilox432StreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
 	/*! @copybrief clrngCopyOverStreams()
 	*  @see clrngCopyOverStreams()
 	*/
@@ -150,9 +174,29 @@ extern "C" {
 	*/
 	CLRNGAPI clrngPhilox432Stream* clrngPhilox432CopyStreams(size_t count, const clrngPhilox432Stream* streams, clrngStatus* err);
 
+	/*! @copybrief clrngCopyStreamsEx()
+	*  @see clrngCopyStreamsEx()
+	*/
+	CLRNGAPI clrngPhilox432Stream* clrngPhilox432CopyStreamsEx(size_t count, const clrngPhilox432Stream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err);
+
+	/*! @copybrief clrngGetStreamStates()
+	*  @see clrngGetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432GetStreamStates(size_t count, const clrngPhilox432Stream* streams, clrngPhilox432StreamState* states);
+
+	/*! @copybrief clrngSetStreamStates()
+	*  @see clrngSetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432SetStreamStates(size_t count, clrngPhilox432Stream* streams, const clrngPhilox432StreamState* states);
+
+#if defined(CLRNG_FULL_PRECISION_DOUBLE) && !defined(CLRNG_SINGLE_PRECISION)
+#define clrngPhilox432RandomU01          clrngPhilox432RandomU01_53
+#define clrngPhilox432RandomU01Array     clrngPhilox432RandomU01Array_53
+#else
 #define clrngPhilox432RandomU01          _CLRNG_TAG_FPTYPE(clrngPhilox432RandomU01)
-#define clrngPhilox432RandomInteger      _CLRNG_TAG_FPTYPE(clrngPhilox432RandomInteger)
 #define clrngPhilox432RandomU01Array     _CLRNG_TAG_FPTYPE(clrngPhilox432RandomU01Array)
+#endif
+#define clrngPhilox432RandomInteger      _CLRNG_TAG_FPTYPE(clrngPhilox432RandomInteger)
 #define clrngPhilox432RandomIntegerArray _CLRNG_TAG_FPTYPE(clrngPhilox432RandomIntegerArray)
 
 	/*! @copybrief clrngRandomU01()
@@ -183,6 +227,16 @@ extern "C" {
 	CLRNGAPI clrngStatus clrngPhilox432RandomIntegerArray_cl_float (clrngPhilox432Stream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 	CLRNGAPI clrngStatus clrngPhilox432RandomIntegerArray_cl_double(clrngPhilox432Stream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
 
+	/*! @copybrief clrngRandomU01_53()
+	*  @see clrngRandomU01_53()
+	*/
+	CLRNGAPI cl_double clrngPhilox432RandomU01_53(clrngPhilox432Stream* stream);
+
+	/*! @copybrief clrngRandomU01Array_53()
+	*  @see clrngRandomU01Array_53()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432RandomU01Array_53(clrngPhilox432Stream* stream, size_t count, cl_double* buffer);
+
 	/*! @copybrief clrngRewindStreams()
 	*  @see clrngRewindStreams()
 	*/
@@ -213,6 +267,50 @@ extern "C" {
 	*/
 	CLRNGAPI clrngStatus clrngPhilox432AdvanceStreams(size_t count, clrngPhilox432Stream* streams, cl_int e, cl_int c);
 
+	/*! @copybrief clrngGetStreamPosition()
+	*  @see clrngGetStreamPosition()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432GetStreamPosition(const clrngPhilox432Stream* stream, cl_ulong* position);
+
+	/*! @brief Absolute position of the current state of a stream
+	*
+	*  Unlike clrngPhilox432GetStreamPosition(), the position is not relative
+	*  to the substream, and is exact over the whole period.
+	*
+	*  @param[in]  stream      Stream object.
+	*  @param[out] position    Counter and index of the next value in its deck.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432GetPosition(const clrngPhilox432Stream* stream, clrngPhilox432Position* position);
+
+	/*! @brief Move the current state of a stream to an absolute position
+	*
+	*  The initial and substream states of \c stream are not modified.
+	*
+	*  @param[in,out] stream   Stream object.
+	*  @param[in]  position    New position; \c index must be smaller than 4.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432SetPosition(clrngPhilox432Stream* stream, const clrngPhilox432Position* position);
+
+	/*! @brief Advance or rewind streams by any number of steps
+	*
+	*  Move the current state of each of the \c count streams in \c streams
+	*  forward, or backward if \c backward is \c CL_TRUE, by
+	*  `4 * steps->ctr + steps->index` steps, modulo \f$2^{130}\f$, with
+	*  128-bit arithmetic on the counters.
+	*  The cost per stream does not depend on the number of steps.
+	*  clrngPhilox432AdvanceStreams() is the special case of
+	*  \f$2^e + c\f$ steps.
+	*
+	*  @param[in]  count       Number of streams in \c streams.
+	*  @param[in,out] streams  Array of stream objects.
+	*  @param[in]  steps       Number of steps; \c index must be smaller than 4.
+	*  @param[in]  backward    Whether to move backward.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432JumpStreams(size_t count, clrngPhilox432Stream* streams, const clrngPhilox432Position* steps, cl_bool backward);
+
 	/*! @copybrief clrngDeviceRandomU01Array()
 	*  @see clrngDeviceRandomU01Array()
 	*/
@@ -230,11 +328,111 @@ extern "C" {
 		cl_command_queue* commQueues, cl_uint numWaitEvents,
 		const cl_event* waitEvents, cl_event* outEvents, cl_bool singlePrecision);
 
+	/*! @copybrief clrngDeviceFillU01()
+	*  @see clrngDeviceFillU01()
+	*/
+#ifdef CLRNG_SINGLE_PRECISION
+#define clrngPhilox432DeviceFillU01(...) clrngPhilox432DeviceFillU01_(__VA_ARGS__, CL_TRUE)
+#else
+#define clrngPhilox432DeviceFillU01(...) clrngPhilox432DeviceFillU01_(__VA_ARGS__, CL_FALSE)
+#endif
+
+	/** \internal
+	 *  @brief Helper function for clrngPhilox432DeviceFillU01()
+	 */
+	CLRNGAPI clrngStatus clrngPhilox432DeviceFillU01_(size_t streamCount, cl_mem streams,
+		size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+		cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision);
+
+	/*! @copybrief clrngDeviceAdvanceStreams()
+	*  @see clrngDeviceAdvanceStreams()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432DeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+		cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+#define clrngPhilox432ParallelFillU01 _CLRNG_TAG_FPTYPE(clrngPhilox432ParallelFillU01)
+
+	/*! @copybrief clrngParallelFillU01()
+	*  @see clrngParallelFillU01()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432ParallelFillU01(size_t streamCount, clrngPhilox432Stream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngPhilox432ParallelFillU01_cl_float (size_t streamCount, clrngPhilox432Stream* streams, size_t numberCount, cl_float * numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngPhilox432ParallelFillU01_cl_double(size_t streamCount, clrngPhilox432Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout);
+
+#define clrngPhilox432HostRandomU01Array _CLRNG_TAG_FPTYPE(clrngPhilox432HostRandomU01Array)
+
+	/*! @copybrief clrngHostRandomU01Array()
+	*  @see clrngHostRandomU01Array()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432HostRandomU01Array(size_t streamCount, const clrngPhilox432Stream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngPhilox432HostRandomU01Array_cl_float (size_t streamCount, const clrngPhilox432Stream* streams, size_t numberCount, cl_float * numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngPhilox432HostRandomU01Array_cl_double(size_t streamCount, const clrngPhilox432Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount);
+
 	/*! @copybrief clrngWriteStreamInfo()
 	*  @see clrngWriteStreamInfo()
 	*/
 	CLRNGAPI clrngStatus clrngPhilox432WriteStreamInfo(const clrngPhilox432Stream* stream, FILE *file);
 
+	/*! @copybrief clrngSerializeStreams()
+	*  @see clrngSerializeStreams()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432SerializeStreams(size_t count, const clrngPhilox432Stream* streams, cl_uint flags, void* buffer, size_t* bufSize);
+
+	/*! @copybrief clrngWriteStreams()
+	*  @see clrngWriteStreams()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432WriteStreams(size_t count, const clrngPhilox432Stream* streams, cl_uint flags, FILE *file);
+
+	/*! @copybrief clrngDeserializeStreams()
+	*  @see clrngDeserializeStreams()
+	*/
+	CLRNGAPI clrngPhilox432Stream* clrngPhilox432DeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngReadStreams()
+	*  @see clrngReadStreams()
+	*/
+	CLRNGAPI clrngPhilox432Stream* clrngPhilox432ReadStreams(const char* path, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngStreamPool
+	*  @see clrngStreamPool
+	*/
+	typedef struct clrngPhilox432StreamPool_ clrngPhilox432StreamPool;
+
+	/*! @copybrief clrngCreateStreamPool()
+	*  @see clrngCreateStreamPool()
+	*/
+	CLRNGAPI clrngPhilox432StreamPool* clrngPhilox432CreateStreamPool(clrngPhilox432StreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngOpenStreamPool()
+	*  @see clrngOpenStreamPool()
+	*/
+	CLRNGAPI clrngPhilox432StreamPool* clrngPhilox432OpenStreamPool(const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngDestroyStreamPool()
+	*  @see clrngDestroyStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432DestroyStreamPool(clrngPhilox432StreamPool* pool);
+
+	/*! @copybrief clrngSyncStreamPool()
+	*  @see clrngSyncStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432SyncStreamPool(clrngPhilox432StreamPool* pool);
+
+	/*! @copybrief clrngGetStreamPoolSize()
+	*  @see clrngGetStreamPoolSize()
+	*/
+	CLRNGAPI size_t clrngPhilox432GetStreamPoolSize(const clrngPhilox432StreamPool* pool);
+
+	/*! @copybrief clrngGetPoolStream()
+	*  @see clrngGetPoolStream()
+	*/
+	CLRNGAPI clrngPhilox432Stream* clrngPhilox432GetPoolStream(clrngPhilox432StreamPool* pool, size_t index, clrngStatus* err);
+
+	/*! @copybrief clrngCopyPoolStreams()
+	*  @see clrngCopyPoolStreams()
+	*/
+	CLRNGAPI clrngStatus clrngPhilox432CopyPoolStreams(const clrngPhilox432StreamPool* pool, size_t first, size_t count, clrngPhilox432Stream* streams);
+
 
 #if 0
 	CLRNGAPI clrngPhilox432Stream* clrngPhilox432GetStreamByIndex(clrngPhilox432Stream* stream, cl_uint index);
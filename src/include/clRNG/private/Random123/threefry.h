@@ -0,0 +1,138 @@
+/*
+Copyright 2010-2011, D. E. Shaw Research.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+* Redistributions of source code must retain the above copyright
+  notice, this list of conditions, and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions, and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+* Neither the name of D. E. Shaw Research nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _threefry_dot_h_
+#define _threefry_dot_h_
+
+/** \cond HIDDEN_FROM_DOXYGEN */
+
+#include "features/compilerfeatures.h"
+#include "array.h"
+
+/*
+// Threefry-4x32: the Threefish block cipher reduced to 32-bit words and
+// without tweak, as described in Salmon et al., "Parallel random numbers:
+// as easy as 1, 2, 3" (SC11).  Only the 4x32 variant is provided here, with
+// the same interface as philox4x32 in philox.h:
+//   threefry4x32_R(R, ctr, key)   R rounds (R <= 20)
+//   threefry4x32(ctr, key)        the default 20 rounds
+*/
+
+/* Rotation constants of Threefry-4x32, indexed by round modulo 8 */
+enum r123_enum_threefry32x4 {
+    R_32x4_0_0=10, R_32x4_0_1=26,
+    R_32x4_1_0=11, R_32x4_1_1=21,
+    R_32x4_2_0=13, R_32x4_2_1=27,
+    R_32x4_3_0=23, R_32x4_3_1= 5,
+    R_32x4_4_0= 6, R_32x4_4_1=20,
+    R_32x4_5_0=17, R_32x4_5_1=11,
+    R_32x4_6_0=25, R_32x4_6_1=10,
+    R_32x4_7_0=18, R_32x4_7_1=20
+};
+
+/* Parity constant of the Skein key schedule */
+#define SKEIN_KS_PARITY32 0x1BD11BDA
+
+#ifndef THREEFRY4x32_DEFAULT_ROUNDS
+#define THREEFRY4x32_DEFAULT_ROUNDS 20
+#endif
+
+enum r123_enum_threefry4x32 { threefry4x32_rounds = THREEFRY4x32_DEFAULT_ROUNDS };
+typedef struct r123array4x32 threefry4x32_ctr_t;
+typedef struct r123array4x32 threefry4x32_key_t;
+typedef struct r123array4x32 threefry4x32_ukey_t;
+
+R123_CUDA_DEVICE R123_STATIC_INLINE threefry4x32_key_t threefry4x32keyinit(threefry4x32_ukey_t uk) { return uk; }
+
+R123_CUDA_DEVICE R123_STATIC_INLINE R123_FORCE_INLINE(uint32_t RotL_32(uint32_t x, unsigned int N));
+R123_CUDA_DEVICE R123_STATIC_INLINE uint32_t RotL_32(uint32_t x, unsigned int N)
+{
+    return (x << (N & 31)) | (x >> ((32 - N) & 31));
+}
+
+/* Even rounds mix (0,1) and (2,3); odd rounds mix (0,3) and (2,1). */
+#define _threefry4x32_round_even(X, r)                                  \
+    X[0] += X[1]; X[1] = RotL_32(X[1], R_32x4_##r##_0); X[1] ^= X[0];  \
+    X[2] += X[3]; X[3] = RotL_32(X[3], R_32x4_##r##_1); X[3] ^= X[2];
+#define _threefry4x32_round_odd(X, r)                                   \
+    X[0] += X[3]; X[3] = RotL_32(X[3], R_32x4_##r##_0); X[3] ^= X[0];  \
+    X[2] += X[1]; X[1] = RotL_32(X[1], R_32x4_##r##_1); X[1] ^= X[2];
+
+/* Key injection s, after every fourth round */
+#define _threefry4x32_inject(X, ks, s)                                  \
+    X[0] += ks[(s) % 5]; X[1] += ks[((s) + 1) % 5];                     \
+    X[2] += ks[((s) + 2) % 5]; X[3] += ks[((s) + 3) % 5]; X[3] += (s);
+
+R123_CUDA_DEVICE R123_STATIC_INLINE R123_FORCE_INLINE(threefry4x32_ctr_t threefry4x32_R(unsigned int R, threefry4x32_ctr_t in, threefry4x32_key_t k));
+R123_CUDA_DEVICE R123_STATIC_INLINE threefry4x32_ctr_t threefry4x32_R(unsigned int R, threefry4x32_ctr_t in, threefry4x32_key_t k)
+{
+    threefry4x32_ctr_t X;
+    uint32_t ks[5];
+    R123_ASSERT(R<=20);
+    ks[4] = SKEIN_KS_PARITY32;
+    ks[0] = k.v[0]; X.v[0] = in.v[0] + ks[0]; ks[4] ^= k.v[0];
+    ks[1] = k.v[1]; X.v[1] = in.v[1] + ks[1]; ks[4] ^= k.v[1];
+    ks[2] = k.v[2]; X.v[2] = in.v[2] + ks[2]; ks[4] ^= k.v[2];
+    ks[3] = k.v[3]; X.v[3] = in.v[3] + ks[3]; ks[4] ^= k.v[3];
+
+    if(R>0){  _threefry4x32_round_even(X.v, 0) }
+    if(R>1){  _threefry4x32_round_odd (X.v, 1) }
+    if(R>2){  _threefry4x32_round_even(X.v, 2) }
+    if(R>3){  _threefry4x32_round_odd (X.v, 3) }
+    if(R>3){  _threefry4x32_inject(X.v, ks, 1) }
+    if(R>4){  _threefry4x32_round_even(X.v, 4) }
+    if(R>5){  _threefry4x32_round_odd (X.v, 5) }
+    if(R>6){  _threefry4x32_round_even(X.v, 6) }
+    if(R>7){  _threefry4x32_round_odd (X.v, 7) }
+    if(R>7){  _threefry4x32_inject(X.v, ks, 2) }
+    if(R>8){  _threefry4x32_round_even(X.v, 0) }
+    if(R>9){  _threefry4x32_round_odd (X.v, 1) }
+    if(R>10){ _threefry4x32_round_even(X.v, 2) }
+    if(R>11){ _threefry4x32_round_odd (X.v, 3) }
+    if(R>11){ _threefry4x32_inject(X.v, ks, 3) }
+    if(R>12){ _threefry4x32_round_even(X.v, 4) }
+    if(R>13){ _threefry4x32_round_odd (X.v, 5) }
+    if(R>14){ _threefry4x32_round_even(X.v, 6) }
+    if(R>15){ _threefry4x32_round_odd (X.v, 7) }
+    if(R>15){ _threefry4x32_inject(X.v, ks, 4) }
+    if(R>16){ _threefry4x32_round_even(X.v, 0) }
+    if(R>17){ _threefry4x32_round_odd (X.v, 1) }
+    if(R>18){ _threefry4x32_round_even(X.v, 2) }
+    if(R>19){ _threefry4x32_round_odd (X.v, 3) }
+    if(R>19){ _threefry4x32_inject(X.v, ks, 5) }
+    return X;
+}
+
+#define threefry4x32(c,k) threefry4x32_R(threefry4x32_rounds, c, k)
+
+/** \endcond */
+
+#endif
@@ -0,0 +1,429 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file counter432.c.h
+ *  @brief Code for the counter-based generators common to the host and device
+ *
+ *  Philox432 and Threefry432 differ only by the bijection that maps their
+ *  128-bit counter and 64-bit key to the deck of four output words; this file
+ *  implements everything else, once per generator (see counter432.h).
+ *
+ *  The following preprocessor symbols must be defined:
+ *  - `COUNTER432_RNG(name)`, which pastes the prefix of the generator (e.g.,
+ *    `clrngPhilox432`) to \c name;
+ *  - `COUNTER432_CTR_T` and `COUNTER432_KEY_T`, the Random123 counter and key
+ *    types of the bijection;
+ *  - `COUNTER432_BIJECTION(c, k)`, which returns the image of counter \c c
+ *    under key \c k.  Only the first two words of the key are set.
+ */
+
+#if !defined(COUNTER432_RNG) || !defined(COUNTER432_CTR_T) || !defined(COUNTER432_KEY_T) || !defined(COUNTER432_BIJECTION)
+#error "COUNTER432_RNG, COUNTER432_CTR_T, COUNTER432_KEY_T and COUNTER432_BIJECTION must be defined"
+#endif
+
+#ifndef COUNTER432_NORM_cl_double
+#define COUNTER432_NORM_cl_double    1.0 / 0x100000000L   // 1.0 /2^32
+#define COUNTER432_NORM_cl_float     2.32830644e-010
+#endif
+
+static COUNTER432_RNG(Counter) COUNTER432_RNG(Add)(COUNTER432_RNG(Counter) a, COUNTER432_RNG(Counter) b)
+{
+	COUNTER432_RNG(Counter) c;
+	cl_uint carry;
+
+	// a word equal to its input after a carry-in has wrapped around as well
+	c.L.lsb = a.L.lsb + b.L.lsb;
+	carry = c.L.lsb < a.L.lsb;
+	c.L.msb = a.L.msb + b.L.msb + carry;
+	carry = c.L.msb < a.L.msb || (carry && c.L.msb == a.L.msb);
+
+	c.H.lsb = a.H.lsb + b.H.lsb + carry;
+	carry = c.H.lsb < a.H.lsb || (carry && c.H.lsb == a.H.lsb);
+	c.H.msb = a.H.msb + b.H.msb + carry;
+
+	return c;
+}
+
+static void COUNTER432_RNG(GenerateDeck)(COUNTER432_RNG(StreamState) *currentState)
+{
+	//Key of the stream (zero by default)
+	COUNTER432_KEY_T k = { { currentState->key.lsb, currentState->key.msb } };
+
+	//get the currect state
+	COUNTER432_CTR_T c = { { 0 } };
+	c.v[0] = currentState->ctr.L.lsb;
+	c.v[1] = currentState->ctr.L.msb;
+	c.v[2] = currentState->ctr.H.lsb;
+	c.v[3] = currentState->ctr.H.msb;
+
+	//Generate 4 uint and store them into the stream state
+	COUNTER432_CTR_T r = COUNTER432_BIJECTION(c, k);
+	currentState->deck[3] = r.v[0];
+	currentState->deck[2] = r.v[1];
+	currentState->deck[1] = r.v[2];
+	currentState->deck[0] = r.v[3];
+}
+
+/*! @brief Advance the rng one step
+*/
+static cl_uint COUNTER432_RNG(NextState)(COUNTER432_RNG(StreamState) *currentState) {
+
+	if ((currentState->deckIndex == 0))
+	{
+		COUNTER432_RNG(GenerateDeck)(currentState);
+	
+	}
+
+	cl_uint result = currentState->deck[currentState->deckIndex];
+	
+	currentState->deckIndex++;
+
+	// Advance to the next Counter.
+	if (currentState->deckIndex == 4) {
+
+		COUNTER432_RNG(Counter) incBy1 = { { 0, 0 }, { 0, 1 } };
+		currentState->ctr = COUNTER432_RNG(Add)(currentState->ctr, incBy1);
+
+		currentState->deckIndex = 0;
+		COUNTER432_RNG(GenerateDeck)(currentState);
+	}
+
+	return result;
+
+}
+
+// clRNG.hpp defines CLRNG_NEXT_STATE_ONLY to get only the recurrence above
+#ifndef CLRNG_NEXT_STATE_ONLY
+
+#ifdef __CLRNG_DEVICE_API
+
+clrngStatus COUNTER432_RNG(CopyOverStreamsFromGlobal)(size_t count, COUNTER432_RNG(Stream)* destStreams, __global const COUNTER432_RNG(HostStream)* srcStreams)
+{
+	//Check params
+	if (!destStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
+	if (!srcStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++) {
+		destStreams[i].current = srcStreams[i].current;
+#ifndef CLRNG_NO_REWIND
+		destStreams[i].initial = &srcStreams[i].initial;
+#endif
+#ifdef CLRNG_ENABLE_SUBSTREAMS
+		destStreams[i].substream = srcStreams[i].substream;
+#endif
+#ifdef CLRNG_INSTRUMENT
+		destStreams[i].draws     = srcStreams[i].draws;
+#endif
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(CopyOverStreamsToGlobal)(size_t count, __global COUNTER432_RNG(HostStream)* destStreams, const COUNTER432_RNG(Stream)* srcStreams)
+{
+	//Check params
+	if (!destStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
+	if (!srcStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++) {
+		destStreams[i].current = srcStreams[i].current;
+#ifndef CLRNG_NO_REWIND
+		destStreams[i].initial = *srcStreams[i].initial;
+#endif
+#ifdef CLRNG_ENABLE_SUBSTREAMS
+		destStreams[i].substream = srcStreams[i].substream;
+#endif
+#ifdef CLRNG_INSTRUMENT
+		destStreams[i].draws     = srcStreams[i].draws;
+#endif
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(CopyOverStreamStatesFromGlobal)(size_t count, COUNTER432_RNG(Stream)* destStreams, __global const COUNTER432_RNG(StreamState)* srcStates)
+{
+	//Check params
+	if (!destStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
+	if (!srcStates)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStates cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++) {
+		destStreams[i].current = srcStates[i];
+#ifndef CLRNG_NO_REWIND
+		destStreams[i].initial = &srcStates[i];
+#endif
+#ifdef CLRNG_ENABLE_SUBSTREAMS
+		destStreams[i].substream = srcStates[i];
+#endif
+#ifdef CLRNG_INSTRUMENT
+		destStreams[i].draws     = 0;
+#endif
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(CopyOverStreamStatesToGlobal)(size_t count, __global COUNTER432_RNG(StreamState)* destStates, const COUNTER432_RNG(Stream)* srcStreams)
+{
+	//Check params
+	if (!destStates)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStates cannot be NULL", __func__);
+	if (!srcStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		destStates[i] = srcStreams[i].current;
+
+	return CLRNG_SUCCESS;
+}
+
+#endif
+
+COUNTER432_RNG(Counter) COUNTER432_RNG(Substract)(COUNTER432_RNG(Counter) a, COUNTER432_RNG(Counter) b)
+{
+	COUNTER432_RNG(Counter) c;
+	cl_uint borrow;
+
+	c.L.lsb = a.L.lsb - b.L.lsb;
+	borrow = c.L.lsb > a.L.lsb;
+	c.L.msb = a.L.msb - b.L.msb - borrow;
+	borrow = c.L.msb > a.L.msb || (borrow && c.L.msb == a.L.msb);
+
+	c.H.lsb = a.H.lsb - b.H.lsb - borrow;
+	borrow = c.H.lsb > a.H.lsb || (borrow && c.H.lsb == a.H.lsb);
+	c.H.msb = a.H.msb - b.H.msb - borrow;
+
+	return c;
+}
+
+clrngStatus COUNTER432_RNG(CopyOverStreams)(size_t count, COUNTER432_RNG(Stream)* destStreams, const COUNTER432_RNG(Stream)* srcStreams)
+{
+	//Check params
+	if (!destStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
+	if (!srcStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		destStreams[i] = srcStreams[i];
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(MakeKeyedState)(cl_ulong key, COUNTER432_RNG(StreamState)* state)
+{
+	//Check params
+	if (!state)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): state cannot be NULL", __func__);
+
+	COUNTER432_RNG(Counter) zero = { { 0, 0 }, { 0, 0 } };
+	state->ctr = zero;
+	state->deckIndex = 0;
+	state->key.msb = (cl_uint)(key >> 32);
+	state->key.lsb = (cl_uint)key;
+	COUNTER432_RNG(GenerateDeck)(state);
+
+	return CLRNG_SUCCESS;
+}
+
+// The following would be much cleaner with C++ templates instead of macros.
+
+// We use an underscore on the r.h.s. to avoid potential recursion with certain
+// preprocessors.
+#define IMPLEMENT_GENERATE_FOR_TYPE(fptype) \
+	\
+	fptype COUNTER432_RNG(RandomU01_##fptype)(COUNTER432_RNG(Stream)* stream) { \
+	    _CLRNG_COUNT_DRAWS(stream, 1); \
+	    return (COUNTER432_RNG(NextState)(&stream->current) + 0.5) * COUNTER432_NORM_##fptype; \
+	} \
+	\
+	cl_int COUNTER432_RNG(RandomInteger_##fptype)(COUNTER432_RNG(Stream)* stream, cl_int i, cl_int j) { \
+	    return i + (cl_int)((j - i + 1) * COUNTER432_RNG(RandomU01_##fptype)(stream)); \
+	} \
+	\
+	clrngStatus COUNTER432_RNG(RandomU01Array_##fptype)(COUNTER432_RNG(Stream)* stream, size_t count, fptype* buffer) { \
+		if (!stream) \
+			return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__); \
+		if (!buffer) \
+			return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__); \
+		for (size_t i = 0; i < count; i++)  \
+			buffer[i] = COUNTER432_RNG(RandomU01_##fptype)(stream); \
+		return CLRNG_SUCCESS; \
+	} \
+	\
+	clrngStatus COUNTER432_RNG(RandomIntegerArray_##fptype)(COUNTER432_RNG(Stream)* stream, cl_int i, cl_int j, size_t count, cl_int* buffer) { \
+		if (!stream) \
+			return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__); \
+		if (!buffer) \
+			return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__); \
+		for (size_t k = 0; k < count; k++) \
+			buffer[k] = COUNTER432_RNG(RandomInteger_##fptype)(stream, i, j); \
+		return CLRNG_SUCCESS; \
+	}
+
+// On the host, implement everything.
+// On the device, implement only what is required to avoid cluttering memory.
+#if defined(CLRNG_SINGLE_PRECISION)  || !defined(__CLRNG_DEVICE_API)
+IMPLEMENT_GENERATE_FOR_TYPE(cl_float)
+#endif
+#if !defined(CLRNG_SINGLE_PRECISION) || !defined(__CLRNG_DEVICE_API)
+IMPLEMENT_GENERATE_FOR_TYPE(cl_double)
+#endif
+
+// Clean up macros, especially to avoid polluting device code.
+#undef IMPLEMENT_GENERATE_FOR_TYPE
+
+#if !defined(CLRNG_SINGLE_PRECISION) || !defined(__CLRNG_DEVICE_API)
+/*! @brief Combine two successive outputs into a value in (0,1) with 53 random bits
+*/
+cl_double COUNTER432_RNG(RandomU01_53)(COUNTER432_RNG(Stream)* stream)
+{
+#ifdef __CLRNG_DEVICE_API
+#pragma OPENCL FP_CONTRACT OFF
+#endif
+	// The host version of COUNTER432_RNG(RandomU01Array_53)() performs exactly the
+	// same floating-point operations, so keep both in sync.
+	_CLRNG_COUNT_DRAWS(stream, 2);
+	cl_double hi = (cl_double)COUNTER432_RNG(NextState)(&stream->current);
+	cl_double lo = (cl_double)COUNTER432_RNG(NextState)(&stream->current) + 0.5;
+	cl_double norm = COUNTER432_NORM_cl_double;
+	cl_double u = (hi + lo * norm) * norm;
+	return u < _CLRNG_U01_53_MAX ? u : _CLRNG_U01_53_MAX;
+}
+
+#ifdef __CLRNG_DEVICE_API
+clrngStatus COUNTER432_RNG(RandomU01Array_53)(COUNTER432_RNG(Stream)* stream, size_t count, cl_double* buffer)
+{
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	for (size_t i = 0; i < count; i++)
+		buffer[i] = COUNTER432_RNG(RandomU01_53)(stream);
+	return CLRNG_SUCCESS;
+}
+#endif
+#endif
+
+
+
+#if !defined(CLRNG_NO_REWIND) || !defined(__CLRNG_DEVICE_API)
+clrngStatus COUNTER432_RNG(RewindStreams)(size_t count, COUNTER432_RNG(Stream)* streams)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	//Reset current state to the stream initial state
+	for (size_t j = 0; j < count; j++) {
+#ifdef __CLRNG_DEVICE_API
+#ifdef CLRNG_ENABLE_SUBSTREAMS
+		streams[j].current = streams[j].substream = *streams[j].initial;
+#else
+		streams[j].current = *streams[j].initial;
+#endif
+#else
+		streams[j].current = streams[j].substream = streams[j].initial;
+#endif
+}
+
+	return CLRNG_SUCCESS;
+}
+#endif
+
+#if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
+
+clrngStatus COUNTER432_RNG(RewindSubstreams)(size_t count, COUNTER432_RNG(Stream)* streams)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	//Reset current state to the subStream initial state
+	for (size_t j = 0; j < count; j++) {
+		streams[j].current = streams[j].substream;
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+static void COUNTER432_RNG(ResetNextSubStream)(COUNTER432_RNG(Stream)* stream){
+
+	//2^64 states
+	COUNTER432_RNG(Counter) steps = { { 0, 1 }, { 0, 0 } };
+
+	//move the substream counter 2^64 steps forward.
+	stream->substream.ctr = COUNTER432_RNG(Add)(stream->substream.ctr, steps);
+
+	COUNTER432_RNG(RewindSubstreams)(1, stream);
+}
+
+clrngStatus COUNTER432_RNG(ForwardToNextSubstreams)(size_t count, COUNTER432_RNG(Stream)* streams)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	for (size_t k = 0; k < count; k++) {
+
+		COUNTER432_RNG(ResetNextSubStream)(&streams[k]);
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(MakeOverSubstreams)(COUNTER432_RNG(Stream)* stream, size_t count, COUNTER432_RNG(Stream)* substreams)
+{
+	for (size_t i = 0; i < count; i++) {
+		clrngStatus err;
+		// snapshot current stream into substreams[i]
+		err = COUNTER432_RNG(CopyOverStreams)(1, &substreams[i], stream);
+		if (err != CLRNG_SUCCESS)
+			return err;
+#ifdef CLRNG_INSTRUMENT
+		substreams[i].draws = 0;
+#endif
+		// advance to next substream
+		err = COUNTER432_RNG(ForwardToNextSubstreams)(1, stream);
+		if (err != CLRNG_SUCCESS)
+			return err;
+	}
+	return CLRNG_SUCCESS;
+}
+
+#endif
+
+#endif // CLRNG_NEXT_STATE_ONLY
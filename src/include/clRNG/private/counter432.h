@@ -0,0 +1,149 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file counter432.h
+ *  @brief Types of the counter-based generators Philox432 and Threefry432
+ *
+ *  Both generators apply a 4x32 bijection to a 128-bit counter, under a 64-bit
+ *  key, and hand out the four resulting words one at a time, so they share
+ *  their state and stream types.  This file is included by philox432.h,
+ *  threefry432.h and their device counterparts, once per generator.
+ *
+ *  The preprocessor symbol `COUNTER432_RNG(name)` must be defined to paste the
+ *  prefix of the generator (e.g., `clrngPhilox432`) to \c name.
+ *
+ *  On the device (`__CLRNG_DEVICE_API` defined), the stream type refers to its
+ *  initial state in global memory, and the host layout is available as
+ *  \c HostStream.
+ */
+
+#ifndef COUNTER432_RNG
+#error "COUNTER432_RNG must be defined"
+#endif
+
+typedef struct COUNTER432_RNG(SB_) {
+	cl_uint msb, lsb;   //most significant bits, and the least significant bits
+} COUNTER432_RNG(SB);
+
+typedef struct COUNTER432_RNG(Counter_) {
+	COUNTER432_RNG(SB) H, L;
+} COUNTER432_RNG(Counter);
+
+/*  @brief State type of a stream
+*
+*  The state is a 128-bit counter, the deck of the four words obtained from
+*  the counter and the key, and the index of the next word to hand out.
+*
+*  @see clrngStreamState
+*/
+typedef struct {
+	COUNTER432_RNG(Counter) ctr;    // 128 bits counter
+	cl_uint deck[4];                // the 4x32 words generated by the bijection of (ctr, key)
+	cl_uint deckIndex;              // the index of the next word of the deck to give to the user
+	COUNTER432_RNG(SB) key;         // 64 bits key, zero unless streams are keyed
+} COUNTER432_RNG(StreamState);
+
+#ifdef __CLRNG_DEVICE_API
+
+struct COUNTER432_RNG(Stream_) {
+	COUNTER432_RNG(StreamState) current;
+#ifndef CLRNG_NO_REWIND
+#if __OPENCL_C_VERSION__ >= 200
+	// use generic address space
+	const COUNTER432_RNG(StreamState)* initial;
+#else
+	// force global address space
+	__global const COUNTER432_RNG(StreamState)* initial;
+#endif
+#ifdef CLRNG_ENABLE_SUBSTREAMS
+	COUNTER432_RNG(StreamState) substream;
+#endif
+#endif
+#ifdef CLRNG_INSTRUMENT
+	cl_ulong draws;
+#endif
+};
+typedef struct COUNTER432_RNG(Stream_) COUNTER432_RNG(Stream);
+
+struct COUNTER432_RNG(HostStream_) {
+	COUNTER432_RNG(StreamState) current;
+	COUNTER432_RNG(StreamState) initial;
+	COUNTER432_RNG(StreamState) substream;
+#ifdef CLRNG_INSTRUMENT
+	cl_ulong draws;
+#endif
+};
+typedef struct COUNTER432_RNG(HostStream_) COUNTER432_RNG(HostStream);
+
+#else
+
+/*! @brief Absolute position in the sequence of a generator, or number of steps
+*
+*  Value \c index (0 to 3) of the deck of counter \c ctr, that is, the
+*  130-bit number `4 * ctr + index`.  As a number of steps, it is taken
+*  modulo \f$2^{130}\f$, the period of the generator.
+*/
+typedef struct {
+	COUNTER432_RNG(Counter) ctr;
+	cl_uint index;
+} COUNTER432_RNG(Position);
+
+struct COUNTER432_RNG(Stream_) {
+	union {
+		struct {
+			COUNTER432_RNG(StreamState) states[3];
+		};
+		struct {
+			COUNTER432_RNG(StreamState) current;
+			COUNTER432_RNG(StreamState) initial;
+			COUNTER432_RNG(StreamState) substream;
+		};
+	};
+#ifdef CLRNG_INSTRUMENT
+	/*! @brief Number of values drawn from the stream object (see \c CLRNG_INSTRUMENT)
+	*/
+	cl_ulong draws;
+#endif
+};
+
+/*! @copybrief clrngStream
+*  @see clrngStream
+*/
+typedef struct COUNTER432_RNG(Stream_) COUNTER432_RNG(Stream);
+
+struct COUNTER432_RNG(StreamCreator_);
+/*! @copybrief clrngStreamCreator
+*  @see clrngStreamCreator
+*/
+typedef struct COUNTER432_RNG(StreamCreator_) COUNTER432_RNG(StreamCreator);
+
+#endif
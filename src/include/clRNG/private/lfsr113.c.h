@@ -41,21 +41,6 @@
 #define Lfsr113_NORM_cl_double 1.0 / 0x100000001L   // 2^32 + 1    // 2.328306436538696e-10
 #define Lfsr113_NORM_cl_float  2.3283063e-10
 
-
-clrngStatus clrngLfsr113CopyOverStreams(size_t count, clrngLfsr113Stream* destStreams, const clrngLfsr113Stream* srcStreams)
-{
-	//Check params
-	if (!destStreams)
-		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
-	if (!srcStreams)
-		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
-
-	for (size_t i = 0; i < count; i++)
-		destStreams[i] = srcStreams[i];
-
-	return CLRNG_SUCCESS;
-}
-
 /*! @brief Advance the rng one step and returns z such that 1 <= z <= lfsr113_M1
 */
 static cl_ulong clrngLfsr113NextState(clrngLfsr113StreamState *currentState) {
@@ -78,6 +63,25 @@ static cl_ulong clrngLfsr113NextState(clrngLfsr113StreamState *currentState) {
 
 }
 
+// clRNG.hpp defines CLRNG_NEXT_STATE_ONLY to get only the recurrence above
+#ifndef CLRNG_NEXT_STATE_ONLY
+
+
+clrngStatus clrngLfsr113CopyOverStreams(size_t count, clrngLfsr113Stream* destStreams, const clrngLfsr113Stream* srcStreams)
+{
+	//Check params
+	if (!destStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
+	if (!srcStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		destStreams[i] = srcStreams[i];
+
+	return CLRNG_SUCCESS;
+}
+
+
 // The following would be much cleaner with C++ templates instead of macros.
 
 // We use an underscore on the r.h.s. to avoid potential recursion with certain
@@ -85,6 +89,7 @@ static cl_ulong clrngLfsr113NextState(clrngLfsr113StreamState *currentState) {
 #define IMPLEMENT_GENERATE_FOR_TYPE(fptype) \
 	\
 	fptype clrngLfsr113RandomU01_##fptype(clrngLfsr113Stream* stream) { \
+	    _CLRNG_COUNT_DRAWS(stream, 1); \
 	    return clrngLfsr113NextState(&stream->current) * Lfsr113_NORM_##fptype; \
 	} \
 	\
@@ -124,8 +129,41 @@ IMPLEMENT_GENERATE_FOR_TYPE(cl_double)
 // Clean up macros, especially to avoid polluting device code.
 #undef IMPLEMENT_GENERATE_FOR_TYPE
 
+#if !defined(CLRNG_SINGLE_PRECISION) || !defined(__CLRNG_DEVICE_API)
+/*! @brief Combine two successive outputs into a value in (0,1) with 53 random bits
+*/
+cl_double clrngLfsr113RandomU01_53(clrngLfsr113Stream* stream)
+{
+#ifdef __CLRNG_DEVICE_API
+#pragma OPENCL FP_CONTRACT OFF
+#endif
+	// The host version of clrngLfsr113RandomU01Array_53() performs exactly the
+	// same floating-point operations, so keep both in sync.
+	_CLRNG_COUNT_DRAWS(stream, 2);
+	cl_double hi = (cl_double)clrngLfsr113NextState(&stream->current);
+	cl_double lo = (cl_double)clrngLfsr113NextState(&stream->current);
+	cl_double norm = Lfsr113_NORM_cl_double;
+	cl_double u = (hi + lo * norm) * norm;
+	return u < _CLRNG_U01_53_MAX ? u : _CLRNG_U01_53_MAX;
+}
+
+#ifdef __CLRNG_DEVICE_API
+clrngStatus clrngLfsr113RandomU01Array_53(clrngLfsr113Stream* stream, size_t count, cl_double* buffer)
+{
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	for (size_t i = 0; i < count; i++)
+		buffer[i] = clrngLfsr113RandomU01_53(stream);
+	return CLRNG_SUCCESS;
+}
+#endif
+#endif
+
 
 
+#if !defined(CLRNG_NO_REWIND) || !defined(__CLRNG_DEVICE_API)
 clrngStatus clrngLfsr113RewindStreams(size_t count, clrngLfsr113Stream* streams)
 {
 	//Check params
@@ -146,6 +184,7 @@ clrngStatus clrngLfsr113RewindStreams(size_t count, clrngLfsr113Stream* streams)
 
 	return CLRNG_SUCCESS;
 }
+#endif
 
 #if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
 clrngStatus clrngLfsr113RewindSubstreams(size_t count, clrngLfsr113Stream* streams)
@@ -264,6 +303,9 @@ clrngStatus clrngLfsr113MakeOverSubstreams(clrngLfsr113Stream* stream, size_t co
 		err = clrngLfsr113CopyOverStreams(1, &substreams[i], stream);
 		if (err != CLRNG_SUCCESS)
 		    return err;
+#ifdef CLRNG_INSTRUMENT
+		substreams[i].draws = 0;
+#endif
 		// advance to next substream
 		err = clrngLfsr113ForwardToNextSubstreams(1, stream);
 		if (err != CLRNG_SUCCESS)
@@ -273,5 +315,6 @@ clrngStatus clrngLfsr113MakeOverSubstreams(clrngLfsr113Stream* stream, size_t co
 }
 
 #endif
+#endif // CLRNG_NEXT_STATE_ONLY
 
 #endif // PRIVATE_Lfsr113_CH
@@ -41,6 +41,11 @@
  *  `MODULAR_FIXED_SIZE` must be set to the size (number of rows or of columns)
  *  of the matrix.
  *
+ *  If the preprocessor symbol `MODULAR_MULT_31` is defined, the moduli must be
+ *  of the form \f$2^{31} - c\f$ with \f$0 < c < 2^{15}\f$, and the modular
+ *  multiplication uses only 32-bit integers, so `MODULAR_NUMBER_TYPE` must be
+ *  cl_uint.
+ *
  *  @note If the project is migrated to C++, this could be rewritten much more
  *  clearly using templates.
  */
@@ -59,8 +64,39 @@
 #  define MATRIX_ELEM(mat, i, j) (mat[i * N + j])
 #endif // MODULAR_FIXED_SIZE
 
+#ifdef MODULAR_MULT_31
+
+//! Reduce x < 2^32 modulo m = 2^31 - c, using 2^31 = c (mod m)
+static cl_uint modFold31(cl_uint x, cl_uint m)
+{
+    x = (x & 0x7fffffff) + (0x80000000u - m) * (x >> 31);
+    return x >= m ? x - m : x;
+}
+
+//! Compute x * 2^16 % m for x < m = 2^31 - c, with shifts and masks
+static cl_uint modShift31(cl_uint x, cl_uint m)
+{
+    return modFold31(((x & 0x7fff) << 16) + (0x80000000u - m) * (x >> 15), m);
+}
+
+//! Compute (a*s + c) % m without 64-bit intermediates
+//  @details The 16-bit halves of a and s are multiplied separately, and the
+//  powers of 2^16 are applied with modShift31().
+static cl_uint modMult(cl_uint a, cl_uint s, cl_uint c, cl_uint m)
+{
+    cl_uint ah = a >> 16, al = a & 0xffff;
+    cl_uint sh = s >> 16, sl = s & 0xffff;
+    cl_uint x = modShift31(modShift31(ah * sh, m), m);
+    x += modShift31(modFold31(ah * sl + al * sh, m), m);
+    x = x >= m ? x - m : x;
+    x += modFold31(al * sl, m);
+    x = x >= m ? x - m : x;
+    x += c;
+    return x >= m ? x - m : x;
+}
+
+#elif 1
 //! Compute (a*s + c) % m
-#if 1
 #define modMult(a, s, c, m) ((MODULAR_NUMBER_TYPE)(((cl_ulong) a * s + c) % m))
 #else
 static MODULAR_NUMBER_TYPE modMult(MODULAR_NUMBER_TYPE a, MODULAR_NUMBER_TYPE s, MODULAR_NUMBER_TYPE c, MODULAR_NUMBER_TYPE m)
@@ -38,6 +38,8 @@
 #ifndef PRIVATE_MRG31K3P_CH
 #define PRIVATE_MRG31K3P_CH
 
+#include "mrg31k3p_matrices.h"
+
 #define mrg31k3p_M1 2147483647             /* 2^31 - 1 */
 #define mrg31k3p_M2 2147462579             /* 2^31 - 21069 */
 
@@ -49,50 +51,6 @@
 #define mrg31k3p_NORM_cl_double 4.656612873077392578125e-10  /* 1/2^31 */
 #define mrg31k3p_NORM_cl_float  4.6566126e-10
 
-
-
-#if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
-
-// clrngMrg31k3p_A1p72 and clrngMrg31k3p_A2p72 jump 2^72 steps forward
-#if defined(__CLRNG_DEVICE_API)
-__constant
-#else
-static
-#endif
-cl_uint clrngMrg31k3p_A1p72[3][3] = { 
-    {1516919229,  758510237, 499121365},
-    {1884998244, 1516919229, 335398200},
-    {601897748,  1884998244, 358115744}
-};
-
-#if defined(__CLRNG_DEVICE_API)
-__constant
-#else
-static
-#endif
-cl_uint clrngMrg31k3p_A2p72[3][3] = { 
-    {1228857673, 1496414766,  954677935},
-    {1133297478, 1407477216, 1496414766},
-    {2002613992, 1639496704, 1407477216}
-};
-
-#endif
-
-
-clrngStatus clrngMrg31k3pCopyOverStreams(size_t count, clrngMrg31k3pStream* destStreams, const clrngMrg31k3pStream* srcStreams)
-{
-    //Check params
-	if (!destStreams)
-	return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
-	if (!srcStreams)
-	return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
-
-    for (size_t i = 0; i < count; i++)
-		destStreams[i] = srcStreams[i];
-
-    return CLRNG_SUCCESS;
-}
-
 /*! @brief Advance the rng one step and returns z such that 1 <= z <= mrg31k3p_M1
  */
 static cl_uint clrngMrg31k3pNextState(clrngMrg31k3pStreamState* currentState)
@@ -141,6 +99,46 @@ static cl_uint clrngMrg31k3pNextState(clrngMrg31k3pStreamState* currentState)
 		return (g1[0] - g2[0]);
 }
 
+// clRNG.hpp defines CLRNG_NEXT_STATE_ONLY to get only the recurrence above
+#ifndef CLRNG_NEXT_STATE_ONLY
+
+
+
+#if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
+
+// clrngMrg31k3p_A1p72 and clrngMrg31k3p_A2p72 jump 2^72 steps forward
+#if defined(__CLRNG_DEVICE_API)
+__constant
+#else
+static
+#endif
+cl_uint clrngMrg31k3p_A1p72[3][3] = CLRNG_MRG31K3P_A1P72;
+
+#if defined(__CLRNG_DEVICE_API)
+__constant
+#else
+static
+#endif
+cl_uint clrngMrg31k3p_A2p72[3][3] = CLRNG_MRG31K3P_A2P72;
+
+#endif
+
+
+clrngStatus clrngMrg31k3pCopyOverStreams(size_t count, clrngMrg31k3pStream* destStreams, const clrngMrg31k3pStream* srcStreams)
+{
+    //Check params
+	if (!destStreams)
+	return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
+	if (!srcStreams)
+	return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+
+    for (size_t i = 0; i < count; i++)
+		destStreams[i] = srcStreams[i];
+
+    return CLRNG_SUCCESS;
+}
+
+
 // The following would be much cleaner with C++ templates instead of macros.
 
 // We use an underscore on the r.h.s. to avoid potential recursion with certain
@@ -148,6 +146,7 @@ static cl_uint clrngMrg31k3pNextState(clrngMrg31k3pStreamState* currentState)
 #define IMPLEMENT_GENERATE_FOR_TYPE(fptype) \
 	\
 	fptype clrngMrg31k3pRandomU01_##fptype(clrngMrg31k3pStream* stream) { \
+	    _CLRNG_COUNT_DRAWS(stream, 1); \
 	    return clrngMrg31k3pNextState(&stream->current) * mrg31k3p_NORM_##fptype; \
 	} \
 	\
@@ -187,8 +186,41 @@ IMPLEMENT_GENERATE_FOR_TYPE(cl_double)
 // Clean up macros, especially to avoid polluting device code.
 #undef IMPLEMENT_GENERATE_FOR_TYPE
 
+#if !defined(CLRNG_SINGLE_PRECISION) || !defined(__CLRNG_DEVICE_API)
+/*! @brief Combine two successive outputs into a value in (0,1) with 53 random bits
+*/
+cl_double clrngMrg31k3pRandomU01_53(clrngMrg31k3pStream* stream)
+{
+#ifdef __CLRNG_DEVICE_API
+#pragma OPENCL FP_CONTRACT OFF
+#endif
+	// The host version of clrngMrg31k3pRandomU01Array_53() performs exactly the
+	// same floating-point operations, so keep both in sync.
+	_CLRNG_COUNT_DRAWS(stream, 2);
+	cl_double hi = (cl_double)clrngMrg31k3pNextState(&stream->current);
+	cl_double lo = (cl_double)clrngMrg31k3pNextState(&stream->current);
+	cl_double norm = mrg31k3p_NORM_cl_double;
+	cl_double u = (hi + lo * norm) * norm;
+	return u < _CLRNG_U01_53_MAX ? u : _CLRNG_U01_53_MAX;
+}
+
+#ifdef __CLRNG_DEVICE_API
+clrngStatus clrngMrg31k3pRandomU01Array_53(clrngMrg31k3pStream* stream, size_t count, cl_double* buffer)
+{
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	for (size_t i = 0; i < count; i++)
+		buffer[i] = clrngMrg31k3pRandomU01_53(stream);
+	return CLRNG_SUCCESS;
+}
+#endif
+#endif
+
 
 
+#if !defined(CLRNG_NO_REWIND) || !defined(__CLRNG_DEVICE_API)
 clrngStatus clrngMrg31k3pRewindStreams(size_t count, clrngMrg31k3pStream* streams)
 {
 	//Check params
@@ -209,6 +241,7 @@ clrngStatus clrngMrg31k3pRewindStreams(size_t count, clrngMrg31k3pStream* stream
 
 	return CLRNG_SUCCESS;
 }
+#endif
 
 #if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
 clrngStatus clrngMrg31k3pRewindSubstreams(size_t count, clrngMrg31k3pStream* streams)
@@ -230,11 +263,18 @@ clrngStatus clrngMrg31k3pForwardToNextSubstreams(size_t count, clrngMrg31k3pStre
 	if (!streams)
 		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
 	
+#ifdef __CLRNG_DEVICE_API
 	for (size_t k = 0; k < count; k++) {
 		modMatVec (clrngMrg31k3p_A1p72, streams[k].substream.g1, streams[k].substream.g1, mrg31k3p_M1);
 		modMatVec (clrngMrg31k3p_A2p72, streams[k].substream.g2, streams[k].substream.g2, mrg31k3p_M2);
 		streams[k].current = streams[k].substream;
 	}
+#else
+	// jumpStates() is defined by the host library
+	jumpStates(clrngMrg31k3p_A1p72, clrngMrg31k3p_A2p72, count, &streams[0].substream, sizeof(clrngMrg31k3pStream));
+	for (size_t k = 0; k < count; k++)
+		streams[k].current = streams[k].substream;
+#endif
 
 	return CLRNG_SUCCESS;
 }
@@ -247,6 +287,9 @@ clrngStatus clrngMrg31k3pMakeOverSubstreams(clrngMrg31k3pStream* stream, size_t
 		err = clrngMrg31k3pCopyOverStreams(1, &substreams[i], stream);
 		if (err != CLRNG_SUCCESS)
 		    return err;
+#ifdef CLRNG_INSTRUMENT
+		substreams[i].draws = 0;
+#endif
 		// advance to next substream
 		err = clrngMrg31k3pForwardToNextSubstreams(1, stream);
 		if (err != CLRNG_SUCCESS)
@@ -255,5 +298,6 @@ clrngStatus clrngMrg31k3pMakeOverSubstreams(clrngMrg31k3pStream* stream, size_t
 	return CLRNG_SUCCESS;
 }
 #endif // substreams
+#endif // CLRNG_NEXT_STATE_ONLY
 
 #endif // PRIVATE_MRG31K3P_CH
@@ -0,0 +1,84 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/*! @file mrg31k3p_matrices.h
+ *  @brief Transition and jump matrices of the MRG31k3p generator
+ *
+ *  Initializers shared by the host library, the device code and clRNG.hpp,
+ *  which recomputes them at compile time and checks them against these values.
+ */
+#pragma once
+#ifndef PRIVATE_MRG31K3P_MATRICES_H
+#define PRIVATE_MRG31K3P_MATRICES_H
+
+// one step forward
+#define CLRNG_MRG31K3P_A1P0 { \
+    {0, 4194304, 129}, \
+    {1, 0, 0}, \
+    {0, 1, 0} }
+#define CLRNG_MRG31K3P_A2P0 { \
+    {32768, 0, 32769}, \
+    {1, 0, 0}, \
+    {0, 1, 0} }
+
+// one step backward (inverses of the above mod mrg31k3p_M1 and mrg31k3p_M2)
+#define CLRNG_MRG31K3P_INVA1 { \
+    { 0, 1, 0 }, \
+    { 0, 0, 1 }, \
+    { 1531538725, 0, 915561289 } }
+#define CLRNG_MRG31K3P_INVA2 { \
+    { 0, 1, 0 }, \
+    { 0, 0, 1 }, \
+    { 252696625, 252696624, 0 } }
+
+// 2^72 steps forward (substreams)
+#define CLRNG_MRG31K3P_A1P72 { \
+    {1516919229,  758510237, 499121365}, \
+    {1884998244, 1516919229, 335398200}, \
+    {601897748,  1884998244, 358115744} }
+#define CLRNG_MRG31K3P_A2P72 { \
+    {1228857673, 1496414766,  954677935}, \
+    {1133297478, 1407477216, 1496414766}, \
+    {2002613992, 1639496704, 1407477216} }
+
+// 2^134 steps forward (default stream spacing)
+#define CLRNG_MRG31K3P_A1P134 { \
+    {1702500920, 1849582496, 1656874625}, \
+    { 828554832, 1702500920, 1512419905}, \
+    {1143731069,  828554832,  102237247} }
+#define CLRNG_MRG31K3P_A2P134 { \
+    { 796789021, 1464208080,  607337906}, \
+    {1241679051, 1431130166, 1464208080}, \
+    {1401213391, 1178684362, 1431130166} }
+
+#endif
@@ -37,54 +37,71 @@
 #ifndef PRIVATE_MRG32K3A_CH
 #define PRIVATE_MRG32K3A_CH
 
+#include "mrg32k3a_matrices.h"
+
+#if defined(CLRNG_MRG32K3A_FP_ARITHMETIC) && !defined(__CLRNG_DEVICE_API)
+#include <math.h>
+#endif
+
 #define Mrg32k3a_M1 4294967087            
 #define Mrg32k3a_M2 4294944443             
 
 #define Mrg32k3a_NORM_cl_double 2.328306549295727688e-10
 #define Mrg32k3a_NORM_cl_float  2.3283064e-10
 
-#if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
+#ifdef CLRNG_MRG32K3A_FP_ARITHMETIC
 
-// clrngMrg32k3a_A1p76 and clrngMrg32k3a_A2p76 jump 2^76 steps forward
-#if defined(__CLRNG_DEVICE_API)
-__constant
-#else
-static
-#endif
-cl_ulong clrngMrg32k3a_A1p76[3][3] = {
-	{ 82758667, 1871391091, 4127413238 },
-	{ 3672831523, 69195019, 1871391091 },
-	{ 3672091415, 3528743235, 69195019 }
-};
+/*! @brief Reduce \c p modulo \c m in double arithmetic, for |p| < 2^53
+*
+*  The quotient estimated with the inverse of \c m is off by at most one, and
+*  `p - k * m` is computed exactly (it can be contracted into an FMA), so the
+*  result is the same as that of the integer implementation.
+*/
+static cl_double clrngMrg32k3aModFP(cl_double p, cl_double m, cl_double invm)
+{
+	p -= floor(p * invm) * m;
+	if (p < 0.0)
+		p += m;
+	else if (p >= m)
+		p -= m;
+	return p;
+}
 
-#if defined(__CLRNG_DEVICE_API)
-__constant
-#else
-static
-#endif
-cl_ulong clrngMrg32k3a_A2p76[3][3] = {
-	{ 1511326704, 3759209742, 1610795712 },
-	{ 4292754251, 1511326704, 3889917532 },
-	{ 3859662829, 4292754251, 3708466080 }
-};
+/*! @brief Advance the rng one step and returns z such that 1 <= z <= Mrg32k3a_M1
+*
+*  Floating-point version of the recurrence of \cite rLEC99b, selected with
+*  \c CLRNG_MRG32K3A_FP_ARITHMETIC; the products are exact in double precision.
+*/
+static cl_ulong clrngMrg32k3aNextState(clrngMrg32k3aStreamState* currentState)
+{
 
-#endif
+	cl_ulong* g1 = currentState->g1;
+	cl_ulong* g2 = currentState->g2;
 
+	cl_double p0, p1;
 
-clrngStatus clrngMrg32k3aCopyOverStreams(size_t count, clrngMrg32k3aStream* destStreams, const clrngMrg32k3aStream* srcStreams)
-{
-	//Check params
-	if (!destStreams)
-		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
-	if (!srcStreams)
-		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+	/* component 1 */
+	p0 = 1403580.0 * (cl_double)g1[1] - 810728.0 * (cl_double)g1[0];
+	p0 = clrngMrg32k3aModFP(p0, 4294967087.0, 1.0 / 4294967087.0);
+	g1[0] = g1[1];
+	g1[1] = g1[2];
+	g1[2] = (cl_ulong)p0;
 
-	for (size_t i = 0; i < count; i++)
-		destStreams[i] = srcStreams[i];
+	/* component 2 */
+	p1 = 527612.0 * (cl_double)g2[2] - 1370589.0 * (cl_double)g2[0];
+	p1 = clrngMrg32k3aModFP(p1, 4294944443.0, 1.0 / 4294944443.0);
+	g2[0] = g2[1];
+	g2[1] = g2[2];
+	g2[2] = (cl_ulong)p1;
 
-	return CLRNG_SUCCESS;
+	/* combinations */
+	if (p0 > p1)
+		return (cl_ulong)(p0 - p1);
+	else return (cl_ulong)(p0 - p1 + 4294967087.0);
 }
 
+#else
+
 /*! @brief Advance the rng one step and returns z such that 1 <= z <= Mrg32k3a_M1
 */
 static cl_ulong clrngMrg32k3aNextState(clrngMrg32k3aStreamState* currentState)
@@ -119,6 +136,46 @@ static cl_ulong clrngMrg32k3aNextState(clrngMrg32k3aStreamState* currentState)
 	else return (p0 - p1 + Mrg32k3a_M1);
 }
 
+#endif
+
+// clRNG.hpp defines CLRNG_NEXT_STATE_ONLY to get only the recurrence above
+#ifndef CLRNG_NEXT_STATE_ONLY
+
+#if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
+
+// clrngMrg32k3a_A1p76 and clrngMrg32k3a_A2p76 jump 2^76 steps forward
+#if defined(__CLRNG_DEVICE_API)
+__constant
+#else
+static
+#endif
+cl_ulong clrngMrg32k3a_A1p76[3][3] = CLRNG_MRG32K3A_A1P76;
+
+#if defined(__CLRNG_DEVICE_API)
+__constant
+#else
+static
+#endif
+cl_ulong clrngMrg32k3a_A2p76[3][3] = CLRNG_MRG32K3A_A2P76;
+
+#endif
+
+
+clrngStatus clrngMrg32k3aCopyOverStreams(size_t count, clrngMrg32k3aStream* destStreams, const clrngMrg32k3aStream* srcStreams)
+{
+	//Check params
+	if (!destStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): destStreams cannot be NULL", __func__);
+	if (!srcStreams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): srcStreams cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		destStreams[i] = srcStreams[i];
+
+	return CLRNG_SUCCESS;
+}
+
+
 
 // The following would be much cleaner with C++ templates instead of macros.
 
@@ -127,6 +184,7 @@ static cl_ulong clrngMrg32k3aNextState(clrngMrg32k3aStreamState* currentState)
 #define IMPLEMENT_GENERATE_FOR_TYPE(fptype) \
 	\
 	fptype clrngMrg32k3aRandomU01_##fptype(clrngMrg32k3aStream* stream) { \
+	    _CLRNG_COUNT_DRAWS(stream, 1); \
 	    return clrngMrg32k3aNextState(&stream->current) * Mrg32k3a_NORM_##fptype; \
 	} \
 	\
@@ -166,8 +224,41 @@ IMPLEMENT_GENERATE_FOR_TYPE(cl_double)
 // Clean up macros, especially to avoid polluting device code.
 #undef IMPLEMENT_GENERATE_FOR_TYPE
 
+#if !defined(CLRNG_SINGLE_PRECISION) || !defined(__CLRNG_DEVICE_API)
+/*! @brief Combine two successive outputs into a value in (0,1) with 53 random bits
+*/
+cl_double clrngMrg32k3aRandomU01_53(clrngMrg32k3aStream* stream)
+{
+#ifdef __CLRNG_DEVICE_API
+#pragma OPENCL FP_CONTRACT OFF
+#endif
+	// The host version of clrngMrg32k3aRandomU01Array_53() performs exactly the
+	// same floating-point operations, so keep both in sync.
+	_CLRNG_COUNT_DRAWS(stream, 2);
+	cl_double hi = (cl_double)clrngMrg32k3aNextState(&stream->current);
+	cl_double lo = (cl_double)clrngMrg32k3aNextState(&stream->current);
+	cl_double norm = Mrg32k3a_NORM_cl_double;
+	cl_double u = (hi + lo * norm) * norm;
+	return u < _CLRNG_U01_53_MAX ? u : _CLRNG_U01_53_MAX;
+}
+
+#ifdef __CLRNG_DEVICE_API
+clrngStatus clrngMrg32k3aRandomU01Array_53(clrngMrg32k3aStream* stream, size_t count, cl_double* buffer)
+{
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	for (size_t i = 0; i < count; i++)
+		buffer[i] = clrngMrg32k3aRandomU01_53(stream);
+	return CLRNG_SUCCESS;
+}
+#endif
+#endif
+
 
 
+#if !defined(CLRNG_NO_REWIND) || !defined(__CLRNG_DEVICE_API)
 clrngStatus clrngMrg32k3aRewindStreams(size_t count, clrngMrg32k3aStream* streams)
 {
 	//Check params
@@ -188,6 +279,7 @@ clrngStatus clrngMrg32k3aRewindStreams(size_t count, clrngMrg32k3aStream* stream
 
 	return CLRNG_SUCCESS;
 }
+#endif
 
 #if defined(CLRNG_ENABLE_SUBSTREAMS) || !defined(__CLRNG_DEVICE_API)
 clrngStatus clrngMrg32k3aRewindSubstreams(size_t count, clrngMrg32k3aStream* streams)
@@ -226,6 +318,9 @@ clrngStatus clrngMrg32k3aMakeOverSubstreams(clrngMrg32k3aStream* stream, size_t
 		err = clrngMrg32k3aCopyOverStreams(1, &substreams[i], stream);
 		if (err != CLRNG_SUCCESS)
 		    return err;
+#ifdef CLRNG_INSTRUMENT
+		substreams[i].draws = 0;
+#endif
 		// advance to next substream
 		err = clrngMrg32k3aForwardToNextSubstreams(1, stream);
 		if (err != CLRNG_SUCCESS)
@@ -234,5 +329,6 @@ clrngStatus clrngMrg32k3aMakeOverSubstreams(clrngMrg32k3aStream* stream, size_t
 	return CLRNG_SUCCESS;
 }
 #endif
+#endif // CLRNG_NEXT_STATE_ONLY
 
 #endif // PRIVATE_Mrg32k3a_CH
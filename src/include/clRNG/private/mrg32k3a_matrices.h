@@ -0,0 +1,84 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/*! @file mrg32k3a_matrices.h
+*  @brief Transition and jump matrices of the Mrg32k3a generator
+*
+*  Initializers shared by the host library, the device code and clRNG.hpp,
+*  which recomputes them at compile time and checks them against these values.
+*/
+#pragma once
+#ifndef PRIVATE_MRG32K3A_MATRICES_H
+#define PRIVATE_MRG32K3A_MATRICES_H
+
+// one step forward
+#define CLRNG_MRG32K3A_A1P0 { \
+	{ 0, 1, 0 }, \
+	{ 0, 0, 1 }, \
+	{ 4294156359, 1403580, 0 } }
+#define CLRNG_MRG32K3A_A2P0 { \
+	{ 0, 1, 0 }, \
+	{ 0, 0, 1 }, \
+	{ 4293573854, 0, 527612 } }
+
+// one step backward (inverses of the above mod Mrg32k3a_M1 and Mrg32k3a_M2)
+#define CLRNG_MRG32K3A_INVA1 { \
+	{ 184888585, 0, 1945170933 }, \
+	{ 1, 0, 0 }, \
+	{ 0, 1, 0 } }
+#define CLRNG_MRG32K3A_INVA2 { \
+	{ 0, 360363334, 4225571728 }, \
+	{ 1, 0, 0 }, \
+	{ 0, 1, 0 } }
+
+// 2^76 steps forward (substreams)
+#define CLRNG_MRG32K3A_A1P76 { \
+	{ 82758667, 1871391091, 4127413238 }, \
+	{ 3672831523, 69195019, 1871391091 }, \
+	{ 3672091415, 3528743235, 69195019 } }
+#define CLRNG_MRG32K3A_A2P76 { \
+	{ 1511326704, 3759209742, 1610795712 }, \
+	{ 4292754251, 1511326704, 3889917532 }, \
+	{ 3859662829, 4292754251, 3708466080 } }
+
+// 2^127 steps forward (default stream spacing)
+#define CLRNG_MRG32K3A_A1P127 { \
+	{ 2427906178, 3580155704, 949770784 }, \
+	{ 226153695, 1230515664, 3580155704 }, \
+	{ 1988835001, 986791581, 1230515664 } }
+#define CLRNG_MRG32K3A_A2P127 { \
+	{ 1464411153, 277697599, 1610723613 }, \
+	{ 32183930, 1464411153, 1022607788 }, \
+	{ 2824425944, 32183930, 2093834863 } }
+
+#endif
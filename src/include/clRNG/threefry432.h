@@ -0,0 +1,439 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*  @file Threefry432.h
+*  @brief Specific interface for the Threefry432 generator
+*  @see clRNG_template.h
+*/
+
+#pragma once
+#ifndef THREEFRY432_H
+#define THREEFRY432_H
+
+#include <clRNG/clRNG.h>
+#include <stdio.h>
+
+
+// state, position and stream types, shared with Philox432
+#define COUNTER432_RNG(name) clrngThreefry432##name
+#include <clRNG/private/counter432.h>
+#undef COUNTER432_RNG
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/*! @copybrief clrngCopyStreamCreator()
+	*  @see clrngCopyStreamCreator()
+	*/
+	CLRNGAPI clrngThreefry432StreamCreator* clrngThreefry432CopyStreamCreator(const clrngThreefry432StreamCreator* creator, clrngStatus* err);
+
+	/*! @copybrief clrngCopyStreamCreatorEx()
+	*  @see clrngCopyStreamCreatorEx()
+	*/
+	CLRNGAPI clrngThreefry432StreamCreator* clrngThreefry432CopyStreamCreatorEx(const clrngThreefry432StreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err);
+
+	/*! @copybrief clrngDestroyStreamCreator()
+	*  @see clrngDestroyStreamCreator()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432DestroyStreamCreator(clrngThreefry432StreamCreator* creator);
+
+	/*! @copybrief clrngRewindStreamCreator()
+	 *  @see clrngRewindStreamCreator()
+	 */
+	CLRNGAPI clrngStatus clrngThreefry432RewindStreamCreator(clrngThreefry432StreamCreator* creator);
+
+	/*! @copybrief clrngSetBaseCreatorState()
+	*  @see clrngSetBaseCreatorState()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432SetBaseCreatorState(clrngThreefry432StreamCreator* creator, const clrngThreefry432StreamState* baseState);
+
+	/*! @copybrief clrngChangeStreamsSpacing()
+	*  @see clrngChangeStreamsSpacing()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432ChangeStreamsSpacing(clrngThreefry432StreamCreator* creator, cl_int e, cl_int c);
+
+	/*! @brief Give each new stream its own key
+	*
+	*  When \c keyPerStream is \c CL_TRUE, the streams subsequently created
+	*  with \c creator all start at counter 0, and differ by their key instead
+	*  of their counter: the key of the next stream is that of the next state
+	*  of the creator (the key of the base state after a rewind), and is
+	*  incremented by one for each stream created.  With the default base
+	*  state, stream \f$k\f$ thus has key \f$k\f$, and can be obtained
+	*  directly with clrngThreefry432MakeKeyedState().
+	*  The number of streams is then bounded by \f$2^{64}\f$, each with the
+	*  full period of \f$2^{130}\f$ and the usual substreams; the spacing
+	*  set with clrngThreefry432ChangeStreamsSpacing() is ignored.
+	*
+	*  Unkeyed streams all have key 0, so with the default base state,
+	*  keyed stream 0 (key 0, counter 0) is the same stream as the first
+	*  unkeyed stream of the default creator.  To mix both modes without
+	*  overlap, give the keyed creator a base state with a nonzero key, or
+	*  skip keyed stream 0.
+	*
+	*  @param[in,out] creator  Stream creator; the default creator cannot be modified.
+	*  @param[in]  keyPerStream  Whether to key streams rather than space their counters.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432ChangeStreamsKeying(clrngThreefry432StreamCreator* creator, cl_bool keyPerStream);
+
+	/*! @brief Initial state of the stream with the given key [**device**]
+	*
+	*  Set \c state to counter 0 under key \c key, in constant time.
+	*  On the device, with \c CLRNG_NO_REWIND defined, a work item can
+	*  derive its own stream from its global ID instead of reading it from a
+	*  buffer:
+	*  @code
+	*  clrngThreefry432Stream stream;
+	*  clrngThreefry432MakeKeyedState(get_global_id(0), &stream.current);
+	*  @endcode
+	*
+	*  @param[in]  key         Key (stream identifier).
+	*  @param[out] state       Stream state.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432MakeKeyedState(cl_ulong key, clrngThreefry432StreamState* state);
+
+	/*! @copybrief clrngAllocStreams()
+	*  @see clrngAllocStreams()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432AllocStreams(size_t count, size_t* bufSize, clrngStatus* err);
+
+	/*! @copybrief clrngAllocStreamsEx()
+	*  @see clrngAllocStreamsEx()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432AllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
+	/*! @copybrief clrngDestroyStreams()
+	*  @see clrngDestroyStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432DestroyStreams(clrngThreefry432Stream* streams);
+
+	/*! @copybrief clrngCreateOverStreams()
+	*  @see clrngCreateOverStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432CreateOverStreams(clrngThreefry432StreamCreator* creator, size_t count, clrngThreefry432Stream* streams);
+
+	/*! @copybrief clrngCreateStreams()
+	*  @see clrngCreateStreams()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432CreateStreams(clrngThreefry432StreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err);
+
+	/*! @copybrief clrngCreateStreamsEx()
+	*  @see clrngCreateStreamsEx()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432CreateStreamsEx(clrngThreefry432StreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err);
+
+	/*! @copybrief clrngCopyOverStreams()
+	*  @see clrngCopyOverStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432CopyOverStreams(size_t count, clrngThreefry432Stream* destStreams, const clrngThreefry432Stream* srcStreams);
+
+	/*! @copybrief clrngCopyStreams()
+	*  @see clrngCopyStreams()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432CopyStreams(size_t count, const clrngThreefry432Stream* streams, clrngStatus* err);
+
+	/*! @copybrief clrngCopyStreamsEx()
+	*  @see clrngCopyStreamsEx()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432CopyStreamsEx(size_t count, const clrngThreefry432Stream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err);
+
+	/*! @copybrief clrngGetStreamStates()
+	*  @see clrngGetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432GetStreamStates(size_t count, const clrngThreefry432Stream* streams, clrngThreefry432StreamState* states);
+
+	/*! @copybrief clrngSetStreamStates()
+	*  @see clrngSetStreamStates()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432SetStreamStates(size_t count, clrngThreefry432Stream* streams, const clrngThreefry432StreamState* states);
+
+#if defined(CLRNG_FULL_PRECISION_DOUBLE) && !defined(CLRNG_SINGLE_PRECISION)
+#define clrngThreefry432RandomU01          clrngThreefry432RandomU01_53
+#define clrngThreefry432RandomU01Array     clrngThreefry432RandomU01Array_53
+#else
+#define clrngThreefry432RandomU01          _CLRNG_TAG_FPTYPE(clrngThreefry432RandomU01)
+#define clrngThreefry432RandomU01Array     _CLRNG_TAG_FPTYPE(clrngThreefry432RandomU01Array)
+#endif
+#define clrngThreefry432RandomInteger      _CLRNG_TAG_FPTYPE(clrngThreefry432RandomInteger)
+#define clrngThreefry432RandomIntegerArray _CLRNG_TAG_FPTYPE(clrngThreefry432RandomIntegerArray)
+
+	/*! @copybrief clrngRandomU01()
+	*  @see clrngRandomU01()
+	*/
+	CLRNGAPI _CLRNG_FPTYPE clrngThreefry432RandomU01(clrngThreefry432Stream* stream);
+	CLRNGAPI cl_float  clrngThreefry432RandomU01_cl_float (clrngThreefry432Stream* stream);
+	CLRNGAPI cl_double clrngThreefry432RandomU01_cl_double(clrngThreefry432Stream* stream);
+
+	/*! @copybrief clrngRandomInteger()
+	*  @see clrngRandomInteger()
+	*/
+	CLRNGAPI cl_int clrngThreefry432RandomInteger(clrngThreefry432Stream* stream, cl_int i, cl_int j);
+	CLRNGAPI cl_int clrngThreefry432RandomInteger_cl_float (clrngThreefry432Stream* stream, cl_int i, cl_int j);
+	CLRNGAPI cl_int clrngThreefry432RandomInteger_cl_double(clrngThreefry432Stream* stream, cl_int i, cl_int j);
+
+	/*! @copybrief clrngRandomU01Array()
+	*  @see clrngRandomU01Array()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432RandomU01Array(clrngThreefry432Stream* stream, size_t count, _CLRNG_FPTYPE* buffer);
+	CLRNGAPI clrngStatus clrngThreefry432RandomU01Array_cl_float (clrngThreefry432Stream* stream, size_t count, cl_float * buffer);
+	CLRNGAPI clrngStatus clrngThreefry432RandomU01Array_cl_double(clrngThreefry432Stream* stream, size_t count, cl_double* buffer);
+
+	/*! @copybrief clrngRandomIntegerArray()
+	*  @see clrngRandomIntegerArray()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432RandomIntegerArray(clrngThreefry432Stream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
+	CLRNGAPI clrngStatus clrngThreefry432RandomIntegerArray_cl_float (clrngThreefry432Stream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
+	CLRNGAPI clrngStatus clrngThreefry432RandomIntegerArray_cl_double(clrngThreefry432Stream* stream, cl_int i, cl_int j, size_t count, cl_int* buffer);
+
+	/*! @copybrief clrngRandomU01_53()
+	*  @see clrngRandomU01_53()
+	*/
+	CLRNGAPI cl_double clrngThreefry432RandomU01_53(clrngThreefry432Stream* stream);
+
+	/*! @copybrief clrngRandomU01Array_53()
+	*  @see clrngRandomU01Array_53()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432RandomU01Array_53(clrngThreefry432Stream* stream, size_t count, cl_double* buffer);
+
+	/*! @copybrief clrngRewindStreams()
+	*  @see clrngRewindStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432RewindStreams(size_t count, clrngThreefry432Stream* streams);
+
+	/*! @copybrief clrngRewindSubstreams()
+	*  @see clrngRewindSubstreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432RewindSubstreams(size_t count, clrngThreefry432Stream* streams);
+
+	/*! @copybrief clrngForwardToNextSubstreams()
+	*  @see clrngForwardToNextSubstreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432ForwardToNextSubstreams(size_t count, clrngThreefry432Stream* streams);
+
+	/*! @copybrief clrngMakeSubstreams()
+	*  @see clrngMakeSubstreams()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432MakeSubstreams(clrngThreefry432Stream* stream, size_t count, size_t* bufSize, clrngStatus* err);
+
+	/*! @copybrief clrngMakeOverSubstreams()
+	*  @see clrngMakeOverSubstreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432MakeOverSubstreams(clrngThreefry432Stream* stream, size_t count, clrngThreefry432Stream* substreams);
+
+	/*! @copybrief clrngAdvanceStreams()
+	*  @see clrngAdvanceStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432AdvanceStreams(size_t count, clrngThreefry432Stream* streams, cl_int e, cl_int c);
+
+	/*! @copybrief clrngGetStreamPosition()
+	*  @see clrngGetStreamPosition()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432GetStreamPosition(const clrngThreefry432Stream* stream, cl_ulong* position);
+
+	/*! @brief Absolute position of the current state of a stream
+	*
+	*  Unlike clrngThreefry432GetStreamPosition(), the position is not relative
+	*  to the substream, and is exact over the whole period.
+	*
+	*  @param[in]  stream      Stream object.
+	*  @param[out] position    Counter and index of the next value in its deck.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432GetPosition(const clrngThreefry432Stream* stream, clrngThreefry432Position* position);
+
+	/*! @brief Move the current state of a stream to an absolute position
+	*
+	*  The initial and substream states of \c stream are not modified.
+	*
+	*  @param[in,out] stream   Stream object.
+	*  @param[in]  position    New position; \c index must be smaller than 4.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432SetPosition(clrngThreefry432Stream* stream, const clrngThreefry432Position* position);
+
+	/*! @brief Advance or rewind streams by any number of steps
+	*
+	*  Move the current state of each of the \c count streams in \c streams
+	*  forward, or backward if \c backward is \c CL_TRUE, by
+	*  `4 * steps->ctr + steps->index` steps, modulo \f$2^{130}\f$, with
+	*  128-bit arithmetic on the counters.
+	*  The cost per stream does not depend on the number of steps.
+	*  clrngThreefry432AdvanceStreams() is the special case of
+	*  \f$2^e + c\f$ steps.
+	*
+	*  @param[in]  count       Number of streams in \c streams.
+	*  @param[in,out] streams  Array of stream objects.
+	*  @param[in]  steps       Number of steps; \c index must be smaller than 4.
+	*  @param[in]  backward    Whether to move backward.
+	*  @return     Error status
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432JumpStreams(size_t count, clrngThreefry432Stream* streams, const clrngThreefry432Position* steps, cl_bool backward);
+
+	/*! @copybrief clrngDeviceRandomU01Array()
+	*  @see clrngDeviceRandomU01Array()
+	*/
+#ifdef CLRNG_SINGLE_PRECISION
+#define clrngThreefry432DeviceRandomU01Array(...) clrngThreefry432DeviceRandomU01Array_(__VA_ARGS__, CL_TRUE)
+#else
+#define clrngThreefry432DeviceRandomU01Array(...) clrngThreefry432DeviceRandomU01Array_(__VA_ARGS__, CL_FALSE)
+#endif
+
+	/** \internal
+	 *  @brief Helper function for clrngThreefry432DeviceRandomU01Array()
+	 */
+	CLRNGAPI clrngStatus clrngThreefry432DeviceRandomU01Array_(size_t streamCount, cl_mem streams,
+		size_t numberCount, cl_mem outBuffer, cl_uint numQueuesAndEvents,
+		cl_command_queue* commQueues, cl_uint numWaitEvents,
+		const cl_event* waitEvents, cl_event* outEvents, cl_bool singlePrecision);
+
+	/*! @copybrief clrngDeviceFillU01()
+	*  @see clrngDeviceFillU01()
+	*/
+#ifdef CLRNG_SINGLE_PRECISION
+#define clrngThreefry432DeviceFillU01(...) clrngThreefry432DeviceFillU01_(__VA_ARGS__, CL_TRUE)
+#else
+#define clrngThreefry432DeviceFillU01(...) clrngThreefry432DeviceFillU01_(__VA_ARGS__, CL_FALSE)
+#endif
+
+	/** \internal
+	 *  @brief Helper function for clrngThreefry432DeviceFillU01()
+	 */
+	CLRNGAPI clrngStatus clrngThreefry432DeviceFillU01_(size_t streamCount, cl_mem streams,
+		size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+		cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision);
+
+	/*! @copybrief clrngDeviceAdvanceStreams()
+	*  @see clrngDeviceAdvanceStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432DeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+		cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+#define clrngThreefry432ParallelFillU01 _CLRNG_TAG_FPTYPE(clrngThreefry432ParallelFillU01)
+
+	/*! @copybrief clrngParallelFillU01()
+	*  @see clrngParallelFillU01()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432ParallelFillU01(size_t streamCount, clrngThreefry432Stream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngThreefry432ParallelFillU01_cl_float (size_t streamCount, clrngThreefry432Stream* streams, size_t numberCount, cl_float * numbers, size_t threadCount, cl_uint layout);
+	CLRNGAPI clrngStatus clrngThreefry432ParallelFillU01_cl_double(size_t streamCount, clrngThreefry432Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout);
+
+#define clrngThreefry432HostRandomU01Array _CLRNG_TAG_FPTYPE(clrngThreefry432HostRandomU01Array)
+
+	/*! @copybrief clrngHostRandomU01Array()
+	*  @see clrngHostRandomU01Array()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432HostRandomU01Array(size_t streamCount, const clrngThreefry432Stream* streams, size_t numberCount, _CLRNG_FPTYPE* numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngThreefry432HostRandomU01Array_cl_float (size_t streamCount, const clrngThreefry432Stream* streams, size_t numberCount, cl_float * numbers, size_t threadCount);
+	CLRNGAPI clrngStatus clrngThreefry432HostRandomU01Array_cl_double(size_t streamCount, const clrngThreefry432Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount);
+
+	/*! @copybrief clrngWriteStreamInfo()
+	*  @see clrngWriteStreamInfo()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432WriteStreamInfo(const clrngThreefry432Stream* stream, FILE *file);
+
+	/*! @copybrief clrngSerializeStreams()
+	*  @see clrngSerializeStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432SerializeStreams(size_t count, const clrngThreefry432Stream* streams, cl_uint flags, void* buffer, size_t* bufSize);
+
+	/*! @copybrief clrngWriteStreams()
+	*  @see clrngWriteStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432WriteStreams(size_t count, const clrngThreefry432Stream* streams, cl_uint flags, FILE *file);
+
+	/*! @copybrief clrngDeserializeStreams()
+	*  @see clrngDeserializeStreams()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432DeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngReadStreams()
+	*  @see clrngReadStreams()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432ReadStreams(const char* path, size_t* count, clrngStatus* err);
+
+	/*! @copybrief clrngStreamPool
+	*  @see clrngStreamPool
+	*/
+	typedef struct clrngThreefry432StreamPool_ clrngThreefry432StreamPool;
+
+	/*! @copybrief clrngCreateStreamPool()
+	*  @see clrngCreateStreamPool()
+	*/
+	CLRNGAPI clrngThreefry432StreamPool* clrngThreefry432CreateStreamPool(clrngThreefry432StreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngOpenStreamPool()
+	*  @see clrngOpenStreamPool()
+	*/
+	CLRNGAPI clrngThreefry432StreamPool* clrngThreefry432OpenStreamPool(const char* path, cl_uint flags, clrngStatus* err);
+
+	/*! @copybrief clrngDestroyStreamPool()
+	*  @see clrngDestroyStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432DestroyStreamPool(clrngThreefry432StreamPool* pool);
+
+	/*! @copybrief clrngSyncStreamPool()
+	*  @see clrngSyncStreamPool()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432SyncStreamPool(clrngThreefry432StreamPool* pool);
+
+	/*! @copybrief clrngGetStreamPoolSize()
+	*  @see clrngGetStreamPoolSize()
+	*/
+	CLRNGAPI size_t clrngThreefry432GetStreamPoolSize(const clrngThreefry432StreamPool* pool);
+
+	/*! @copybrief clrngGetPoolStream()
+	*  @see clrngGetPoolStream()
+	*/
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432GetPoolStream(clrngThreefry432StreamPool* pool, size_t index, clrngStatus* err);
+
+	/*! @copybrief clrngCopyPoolStreams()
+	*  @see clrngCopyPoolStreams()
+	*/
+	CLRNGAPI clrngStatus clrngThreefry432CopyPoolStreams(const clrngThreefry432StreamPool* pool, size_t first, size_t count, clrngThreefry432Stream* streams);
+
+
+#if 0
+	CLRNGAPI clrngThreefry432Stream* clrngThreefry432GetStreamByIndex(clrngThreefry432Stream* stream, cl_uint index);
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+#endif
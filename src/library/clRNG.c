@@ -84,6 +84,24 @@ const char* clrngGetLibraryRoot()
 
 static char lib_includes[1024];
 
+// device stream objects must have the same layout as on the host
+#ifdef CLRNG_INSTRUMENT
+#define INSTRUMENT_DEFINES " -DCLRNG_INSTRUMENT"
+#else
+#define INSTRUMENT_DEFINES ""
+#endif
+
+// and the device must generate the same Philox432 sequence
+#define DEFINE_STR_(x) #x
+#define DEFINE_STR(x) DEFINE_STR_(x)
+#ifdef CLRNG_PHILOX432_ROUNDS
+#define PHILOX432_DEFINES " -DCLRNG_PHILOX432_ROUNDS=" DEFINE_STR(CLRNG_PHILOX432_ROUNDS)
+#else
+#define PHILOX432_DEFINES ""
+#endif
+
+#define DEVICE_DEFINES INSTRUMENT_DEFINES PHILOX432_DEFINES
+
 const char* clrngGetLibraryDeviceIncludes(cl_int* err)
 {
 	if (err) 
@@ -97,7 +115,7 @@ const char* clrngGetLibraryDeviceIncludes(cl_int* err)
 #endif
 		lib_includes,
 		sizeof(lib_includes),
-		"-I\"%s/include\"",
+		"-I\"%s/include\"" DEVICE_DEFINES,
 		clrngGetLibraryRoot());
 
 #ifdef _MSC_VER
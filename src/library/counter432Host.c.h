@@ -0,0 +1,972 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file counter432Host.c.h
+ *  @brief Host code for the counter-based generators
+ *
+ *  This file provides the library code specific to the host for Philox432
+ *  and Threefry432; the code shared by the host and the device is in
+ *  counter432.c.h.  It must be included after the private .c.h file of the
+ *  generator, with `COUNTER432_RNG(name)` defined as in counter432.c.h and
+ *  the following preprocessor symbols defined:
+ *  - `COUNTER432_GENERATOR` and `COUNTER432_SERIAL`, the clrngGenerator and
+ *    serialization tags of the generator;
+ *  - `COUNTER432_KERNEL_PRELUDE`, the beginning of the device kernel sources,
+ *    which includes the device header of the generator and defines
+ *    `COUNTER432_RNG(name)` there as well.
+ */
+
+#pragma once
+#ifndef COUNTER432_HOST_CH
+#define COUNTER432_HOST_CH
+
+struct COUNTER432_RNG(StreamCreator_) {
+	COUNTER432_RNG(StreamState) initialState;
+	COUNTER432_RNG(StreamState) nextState;
+	COUNTER432_RNG(Counter) JumpDistance;
+	cl_bool keyPerStream;
+};
+
+// positions and numbers of steps: 4 * ctr + index, modulo 2^130
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128;
+__extension__ typedef __int128 int128;
+
+static uint128 counterToInt(COUNTER432_RNG(Counter) c)
+{
+	return (uint128)c.H.msb << 96 | (uint128)c.H.lsb << 64 | (cl_ulong)c.L.msb << 32 | c.L.lsb;
+}
+
+static COUNTER432_RNG(Counter) intToCounter(uint128 x)
+{
+	COUNTER432_RNG(Counter) c = { { (cl_uint)(x >> 96), (cl_uint)(x >> 64) }, { (cl_uint)(x >> 32), (cl_uint)x } };
+	return c;
+}
+#endif
+
+// a + b, or a - b, modulo 2^130
+static COUNTER432_RNG(Position) addPositions(COUNTER432_RNG(Position) a, COUNTER432_RNG(Position) b, cl_bool subtract)
+{
+	COUNTER432_RNG(Position) r;
+	cl_int index = subtract ? (cl_int)a.index - (cl_int)b.index : (cl_int)(a.index + b.index);
+	cl_int carry = index < 0 ? -1 : index >> 2;
+	r.index = (cl_uint)(index + 4) & 3;
+#ifdef __SIZEOF_INT128__
+	uint128 x = counterToInt(a.ctr);
+	uint128 y = counterToInt(b.ctr);
+	r.ctr = intToCounter((subtract ? x - y : x + y) + (uint128)(int128)carry);
+#else
+	static const COUNTER432_RNG(Counter) one = { { 0, 0 }, { 0, 1 } };
+	r.ctr = subtract ? COUNTER432_RNG(Substract)(a.ctr, b.ctr) : COUNTER432_RNG(Add)(a.ctr, b.ctr);
+	if (carry > 0)
+		r.ctr = COUNTER432_RNG(Add)(r.ctr, one);
+	else if (carry < 0)
+		r.ctr = COUNTER432_RNG(Substract)(r.ctr, one);
+#endif
+	return r;
+}
+
+// the steps of 2^e + c (e > 0), -2^|e| + c (e < 0) or c (e = 0), modulo 2^130
+static COUNTER432_RNG(Position) makeSteps(cl_int e, cl_int c)
+{
+	static const COUNTER432_RNG(Position) zero = { { { 0, 0 }, { 0, 0 } }, 0 };
+	COUNTER432_RNG(Position) power = zero;
+	COUNTER432_RNG(Position) linear = zero;
+
+	// bit |e| of the position; 2^|e| vanishes for |e| >= 130
+	cl_uint a = e < 0 ? 0u - (cl_uint)e : (cl_uint)e;
+	if (e != 0 && a < 2)
+		power.index = 1u << a;
+	else if (e != 0 && a < 130) {
+		cl_uint word = 1u << ((a - 2) % 32);
+		switch ((a - 2) / 32) {
+		case 0: power.ctr.L.lsb = word; break;
+		case 1: power.ctr.L.msb = word; break;
+		case 2: power.ctr.H.lsb = word; break;
+		default: power.ctr.H.msb = word; break;
+		}
+	}
+
+	cl_uint m = c < 0 ? 0u - (cl_uint)c : (cl_uint)c;
+	linear.ctr.L.lsb = m >> 2;
+	linear.index = m & 3;
+
+	return addPositions(addPositions(zero, power, e < 0), linear, c < 0);
+}
+
+
+/*! @brief Default initial seed of the first stream
+*/
+
+#define BASE_CREATOR_STATE { \
+        {{ 0, 0},{ 0, 1}}, \
+        { 0, 0, 0, 0 }, \
+        0, \
+        { 0, 0 } }
+/*! @brief Jump Struc for \f$2^{100}\f$ steps forward
+*/
+#define BASE_CREATOR_JUMP_DISTANCE {{ 16, 0},{ 0, 0 }}
+
+/*! @brief Default stream creator (defaults to \f$2^{100}\f$ steps forward)
+*
+*  Contains the default seed;
+*  adjacent streams are spaced nu steps apart.
+*  The default is \f$nu = 2^{100}\f$.
+*  The default seed is \f$({{0,0},{0,0}})\f$.
+*/
+static  COUNTER432_RNG(StreamCreator) defaultStreamCreator = { BASE_CREATOR_STATE, BASE_CREATOR_STATE, BASE_CREATOR_JUMP_DISTANCE, CL_FALSE };
+
+/*! @brief Check the validity of a seed
+*/
+static clrngStatus validateSeed(const COUNTER432_RNG(StreamState)* seed)
+{
+	return CLRNG_SUCCESS;
+}
+
+COUNTER432_RNG(StreamCreator)* COUNTER432_RNG(CopyStreamCreator)(const COUNTER432_RNG(StreamCreator)* creator, clrngStatus* err)
+{
+	return COUNTER432_RNG(CopyStreamCreatorEx)(creator, NULL, err);
+}
+
+COUNTER432_RNG(StreamCreator)* COUNTER432_RNG(CopyStreamCreatorEx)(const COUNTER432_RNG(StreamCreator)* creator, const clrngAllocator* allocator, clrngStatus* err)
+{
+	clrngStatus err_ = CLRNG_SUCCESS;
+
+	// allocate creator
+	COUNTER432_RNG(StreamCreator)* newCreator = (COUNTER432_RNG(StreamCreator)*)clrngAlloc(sizeof(COUNTER432_RNG(StreamCreator)), 0, allocator);
+
+	if (newCreator == NULL)
+		// allocation failed
+		err_ = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for stream creator", __func__);
+	else {
+		if (creator == NULL)
+			creator = &defaultStreamCreator;
+		// initialize creator
+		*newCreator = *creator;
+	}
+
+	// set error status if needed
+	if (err != NULL)
+		*err = err_;
+
+	return newCreator;
+}
+
+clrngStatus COUNTER432_RNG(DestroyStreamCreator)(COUNTER432_RNG(StreamCreator)* creator)
+{
+	clrngRelease(creator);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(RewindStreamCreator)(COUNTER432_RNG(StreamCreator)* creator)
+{
+	if (creator == NULL)
+		creator = &defaultStreamCreator;
+	creator->nextState = creator->initialState;
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(SetBaseCreatorState)(COUNTER432_RNG(StreamCreator)* creator, const COUNTER432_RNG(StreamState)* baseState)
+{
+	//Check params
+	if (creator == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_STREAM_CREATOR, "%s(): modifying the default stream creator is forbidden", __func__);
+	if (baseState == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): baseState cannot be NULL", __func__);
+
+	clrngStatus err = validateSeed(baseState);
+
+	if (err == CLRNG_SUCCESS) {
+		// initialize new creator
+		creator->initialState = creator->nextState = *baseState;
+	}
+
+	return err;
+}
+
+clrngStatus COUNTER432_RNG(ChangeStreamsSpacing)(COUNTER432_RNG(StreamCreator)* creator, cl_int e, cl_int c)
+{
+	//Check params
+	if (creator == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_STREAM_CREATOR, "%s(): modifying the default stream creator is forbidden", __func__);
+	if (e < 2 && e != 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): e must be 0 or >= 2", __func__);
+	if ((c % 4) != 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): c must be a multiple of 4", __func__);
+
+	creator->JumpDistance = makeSteps(e, c).ctr;
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(ChangeStreamsKeying)(COUNTER432_RNG(StreamCreator)* creator, cl_bool keyPerStream)
+{
+	//Check params
+	if (creator == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_STREAM_CREATOR, "%s(): modifying the default stream creator is forbidden", __func__);
+
+	creator->keyPerStream = keyPerStream ? CL_TRUE : CL_FALSE;
+
+	return CLRNG_SUCCESS;
+}
+
+// jump between successive streams of a creator: a counter distance, or the
+// next key for keyed streams
+typedef struct {
+	COUNTER432_RNG(Counter) ctr;
+	cl_ulong key;
+} StreamJump;
+
+static cl_ulong stateKey(const COUNTER432_RNG(StreamState)* state)
+{
+	return ((cl_ulong)state->key.msb << 32) | state->key.lsb;
+}
+
+static void applyStreamJump(const StreamJump* jump, COUNTER432_RNG(StreamState)* state)
+{
+	cl_ulong key = stateKey(state) + jump->key;
+	state->ctr = COUNTER432_RNG(Add)(state->ctr, jump->ctr);
+	state->key.msb = (cl_uint)(key >> 32);
+	state->key.lsb = (cl_uint)key;
+	// at index 0, the deck is generated when the next value is drawn
+	if (state->deckIndex != 0)
+		COUNTER432_RNG(GenerateDeck)(state);
+}
+
+// state of the next stream of a creator, and jump to the following one
+static void creatorNext(const COUNTER432_RNG(StreamCreator)* creator, COUNTER432_RNG(StreamState)* state, StreamJump* jump)
+{
+	static const COUNTER432_RNG(Counter) zero = { { 0, 0 }, { 0, 0 } };
+	if (creator->keyPerStream) {
+		COUNTER432_RNG(MakeKeyedState)(stateKey(&creator->nextState), state);
+		jump->ctr = zero;
+		jump->key = 1;
+	}
+	else {
+		*state = creator->nextState;
+		jump->ctr = creator->JumpDistance;
+		jump->key = 0;
+	}
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(AllocStreams)(size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return COUNTER432_RNG(AllocStreamsEx)(count, 0, NULL, bufSize, err);
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(AllocStreamsEx)(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
+{
+	clrngStatus err_ = CLRNG_SUCCESS;
+	size_t bufSize_ = count * sizeof(COUNTER432_RNG(Stream));
+	COUNTER432_RNG(Stream)* buf = NULL;
+
+	//Check params
+	if (!clrngValidAlignment(alignment))
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): alignment must be a power of two", __func__);
+	else
+		// allocate streams
+		buf = (COUNTER432_RNG(Stream)*)clrngAlloc(bufSize_, alignment, allocator);
+
+	if (err_ == CLRNG_SUCCESS && buf == NULL) {
+		// allocation failed
+		err_ = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for streams", __func__);
+		bufSize_ = 0;
+	}
+
+	// set buffer size if needed
+	if (bufSize != NULL)
+		*bufSize = bufSize_;
+
+	// set error status if needed
+	if (err != NULL)
+		*err = err_;
+
+	return buf;
+}
+
+clrngStatus COUNTER432_RNG(DestroyStreams)(COUNTER432_RNG(Stream)* streams)
+{
+	clrngRelease(streams);
+	return CLRNG_SUCCESS;
+}
+
+static clrngStatus createStream(COUNTER432_RNG(StreamCreator)* creator, COUNTER432_RNG(Stream)* buffer)
+{
+	//Check params
+	if (buffer == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+
+	// use default creator if not given
+	if (creator == NULL)
+		creator = &defaultStreamCreator;
+
+	// initialize stream
+	StreamJump jump;
+	creatorNext(creator, &buffer->current, &jump);
+	buffer->initial = buffer->substream = buffer->current;
+#ifdef CLRNG_INSTRUMENT
+	buffer->draws = 0;
+#endif
+
+	//Advance next state in stream creator
+	applyStreamJump(&jump, &creator->nextState);
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(CreateOverStreams)(COUNTER432_RNG(StreamCreator)* creator, size_t count, COUNTER432_RNG(Stream)* streams)
+{
+	// iterate over all individual stream buffers
+	for (size_t i = 0; i < count; i++) {
+
+		clrngStatus err = createStream(creator, &streams[i]);
+
+		// abort on error
+		if (err != CLRNG_SUCCESS)
+			return err;
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(CreateStreams)(COUNTER432_RNG(StreamCreator)* creator, size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return COUNTER432_RNG(CreateStreamsEx)(creator, count, 0, NULL, bufSize, err);
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(CreateStreamsEx)(COUNTER432_RNG(StreamCreator)* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
+{
+	clrngStatus err_;
+	size_t bufSize_;
+	COUNTER432_RNG(Stream)* streams = COUNTER432_RNG(AllocStreamsEx)(count, alignment, allocator, &bufSize_, &err_);
+
+	if (err_ == CLRNG_SUCCESS)
+		err_ = COUNTER432_RNG(CreateOverStreams)(creator, count, streams);
+
+	if (bufSize != NULL)
+		*bufSize = bufSize_;
+
+	if (err != NULL)
+		*err = err_;
+
+	return streams;
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(CopyStreams)(size_t count, const COUNTER432_RNG(Stream)* streams, clrngStatus* err)
+{
+	return COUNTER432_RNG(CopyStreamsEx)(count, streams, 0, NULL, err);
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(CopyStreamsEx)(size_t count, const COUNTER432_RNG(Stream)* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err)
+{
+	clrngStatus err_ = CLRNG_SUCCESS;
+	COUNTER432_RNG(Stream)* dest = NULL;
+
+	//Check params
+	if (streams == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+
+	if (err_ == CLRNG_SUCCESS)
+		dest = COUNTER432_RNG(AllocStreamsEx)(count, alignment, allocator, NULL, &err_);
+
+	if (err_ == CLRNG_SUCCESS)
+		err_ = COUNTER432_RNG(CopyOverStreams)(count, dest, streams);
+
+	if (err != NULL)
+		*err = err_;
+
+	return dest;
+}
+
+clrngStatus COUNTER432_RNG(GetStreamStates)(size_t count, const COUNTER432_RNG(Stream)* streams, COUNTER432_RNG(StreamState)* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		states[i] = streams[i].current;
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(SetStreamStates)(size_t count, COUNTER432_RNG(Stream)* streams, const COUNTER432_RNG(StreamState)* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		streams[i].current = states[i];
+
+	return CLRNG_SUCCESS;
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(MakeSubstreams)(COUNTER432_RNG(Stream)* stream, size_t count, size_t* bufSize, clrngStatus* err)
+{
+	clrngStatus err_;
+	size_t bufSize_;
+	COUNTER432_RNG(Stream)* substreams = COUNTER432_RNG(AllocStreams)(count, &bufSize_, &err_);
+
+	if (err_ == CLRNG_SUCCESS)
+		err_ = COUNTER432_RNG(MakeOverSubstreams)(stream, count, substreams);
+
+	if (bufSize != NULL)
+		*bufSize = bufSize_;
+
+	if (err != NULL)
+		*err = err_;
+
+	return substreams;
+}
+
+clrngStatus COUNTER432_RNG(RandomU01Array_53)(COUNTER432_RNG(Stream)* stream, size_t count, cl_double* buffer)
+{
+	//Check params
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+
+	_CLRNG_COUNT_DRAWS(stream, 2 * count);
+
+	// Take the outputs from the deck, generating a new deck every four
+	// outputs, in blocks; then convert each block at once.
+	cl_uint hi[CLRNG_U01_53_BLOCK];
+	cl_uint lo[CLRNG_U01_53_BLOCK];
+	for (size_t i = 0; i < count; i += CLRNG_U01_53_BLOCK) {
+		size_t n = count - i < CLRNG_U01_53_BLOCK ? count - i : CLRNG_U01_53_BLOCK;
+		for (size_t k = 0; k < n; k++) {
+			hi[k] = (cl_uint)COUNTER432_RNG(NextState)(&stream->current);
+			lo[k] = (cl_uint)COUNTER432_RNG(NextState)(&stream->current);
+		}
+		clrngCombineU01_53(n, hi, lo, 0.5, COUNTER432_NORM_cl_double, buffer + i);
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(WriteStreamInfo)(const COUNTER432_RNG(Stream)* stream, FILE *file)
+{
+	//Check params
+	if (stream == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (file == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): file cannot be NULL", __func__);
+
+	//The Initial state of the Stream
+	//fprintf(file, "initial : (ctr, index)=( %u %u %u %u , [%u]) [deck = { %u %u %u %u}] \n\n",
+	//	stream->initial.ctr.H.msb, stream->initial.ctr.H.lsb, stream->initial.ctr.L.msb, stream->initial.ctr.L.lsb, stream->initial.deckIndex,
+	//	stream->initial.deck[3], stream->initial.deck[2], stream->initial.deck[1], stream->initial.deck[0]);
+
+	//The Current state of the Stream
+	fprintf(file, "Current : (ctr, index)=( %u %u %u %u , [%u])  [deck = { %u %u %u %u}] \n\n",
+		stream->current.ctr.H.msb, stream->current.ctr.H.lsb, stream->current.ctr.L.msb, stream->current.ctr.L.lsb, stream->current.deckIndex
+		, stream->current.deck[3], stream->current.deck[2], stream->current.deck[1], stream->current.deck[0]
+		);
+
+
+	return CLRNG_SUCCESS;
+}
+
+// serialized state: the counter, least significant word first, the deck index
+// and the key, least significant word first; the deck is recomputed from the
+// counter and key.  Records written before keys were stored have 5 words, and
+// their key reads as zero.
+static void packState(const void* state, cl_uint* words)
+{
+	const COUNTER432_RNG(StreamState)* s = (const COUNTER432_RNG(StreamState)*)state;
+	words[0] = s->ctr.L.lsb;
+	words[1] = s->ctr.L.msb;
+	words[2] = s->ctr.H.lsb;
+	words[3] = s->ctr.H.msb;
+	words[4] = s->deckIndex;
+	words[5] = s->key.lsb;
+	words[6] = s->key.msb;
+}
+
+static clrngStatus unpackState(const cl_uint* words, void* state)
+{
+	COUNTER432_RNG(StreamState)* s = (COUNTER432_RNG(StreamState)*)state;
+	s->ctr.L.lsb = words[0];
+	s->ctr.L.msb = words[1];
+	s->ctr.H.lsb = words[2];
+	s->ctr.H.msb = words[3];
+	s->deckIndex = words[4];
+	s->key.lsb = words[5];
+	s->key.msb = words[6];
+	if (s->deckIndex >= 4)
+		return clrngSetErrorString(CLRNG_INVALID_SEED, "deckIndex must be smaller than 4");
+	COUNTER432_RNG(GenerateDeck)(s);
+	return CLRNG_SUCCESS;
+}
+
+static void* allocSerialStreams(size_t count, clrngStatus* err)
+{
+	return COUNTER432_RNG(AllocStreams)(count, NULL, err);
+}
+
+static const clrngSerialFormat serialFormat = {
+	COUNTER432_SERIAL, 7, 5, sizeof(COUNTER432_RNG(StreamState)), sizeof(COUNTER432_RNG(Stream)), packState, unpackState, allocSerialStreams
+};
+
+clrngStatus COUNTER432_RNG(SerializeStreams)(size_t count, const COUNTER432_RNG(Stream)* streams, cl_uint flags, void* buffer, size_t* bufSize)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (bufSize == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): bufSize cannot be NULL", __func__);
+
+	return clrngSerialWrite(&serialFormat, count, streams, flags, buffer, bufSize);
+}
+
+clrngStatus COUNTER432_RNG(WriteStreams)(size_t count, const COUNTER432_RNG(Stream)* streams, cl_uint flags, FILE *file)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (file == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): file cannot be NULL", __func__);
+
+	return clrngSerialWriteFile(&serialFormat, count, streams, flags, file);
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(DeserializeStreams)(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (buffer == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (COUNTER432_RNG(Stream)*)clrngSerialRead(&serialFormat, buffer, bufSize, count, err);
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(ReadStreams)(const char* path, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (path == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (COUNTER432_RNG(Stream)*)clrngSerialReadFile(&serialFormat, path, count, err);
+}
+
+// jump between successive streams of a pool: that of the creator
+static void composePoolJumps(const void* a, const void* b, void* result)
+{
+	const StreamJump* ja = (const StreamJump*)a;
+	const StreamJump* jb = (const StreamJump*)b;
+	StreamJump* r = (StreamJump*)result;
+	r->ctr = COUNTER432_RNG(Add)(ja->ctr, jb->ctr);
+	r->key = ja->key + jb->key;
+}
+
+static void applyPoolJump(const void* jump, void* state)
+{
+	applyStreamJump((const StreamJump*)jump, (COUNTER432_RNG(StreamState)*)state);
+}
+
+static const clrngPoolFormat poolFormat = {
+	COUNTER432_SERIAL, sizeof(COUNTER432_RNG(StreamState)), sizeof(COUNTER432_RNG(Stream)), sizeof(StreamJump), composePoolJumps, applyPoolJump
+};
+
+COUNTER432_RNG(StreamPool)* COUNTER432_RNG(CreateStreamPool)(COUNTER432_RNG(StreamCreator)* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else {
+		// use default creator if not given
+		if (creator == NULL)
+			creator = &defaultStreamCreator;
+
+		COUNTER432_RNG(StreamState) base;
+		StreamJump jump;
+		creatorNext(creator, &base, &jump);
+		pool = clrngPoolCreate(&poolFormat, &base, &jump, count, path, flags, &err_);
+
+		// skip the streams of the pool, as clrngCreateStreams() would
+		if (pool != NULL)
+			clrngPoolJump(pool, (cl_ulong)count, &creator->nextState);
+	}
+
+	if (err != NULL)
+		*err = err_;
+
+	return (COUNTER432_RNG(StreamPool)*)pool;
+}
+
+COUNTER432_RNG(StreamPool)* COUNTER432_RNG(OpenStreamPool)(const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else
+		pool = clrngPoolOpen(&poolFormat, path, flags, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (COUNTER432_RNG(StreamPool)*)pool;
+}
+
+clrngStatus COUNTER432_RNG(DestroyStreamPool)(COUNTER432_RNG(StreamPool)* pool)
+{
+	if (pool != NULL)
+		return clrngPoolDestroy((clrngPool*)pool);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(SyncStreamPool)(COUNTER432_RNG(StreamPool)* pool)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+
+	return clrngPoolSync((clrngPool*)pool);
+}
+
+size_t COUNTER432_RNG(GetStreamPoolSize)(const COUNTER432_RNG(StreamPool)* pool)
+{
+	return pool != NULL ? clrngPoolSize((const clrngPool*)pool) : 0;
+}
+
+COUNTER432_RNG(Stream)* COUNTER432_RNG(GetPoolStream)(COUNTER432_RNG(StreamPool)* pool, size_t index, clrngStatus* err)
+{
+	clrngStatus err_;
+	void* stream = NULL;
+
+	//Check params
+	if (pool == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	else
+		stream = clrngPoolStream((clrngPool*)pool, index, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (COUNTER432_RNG(Stream)*)stream;
+}
+
+clrngStatus COUNTER432_RNG(CopyPoolStreams)(const COUNTER432_RNG(StreamPool)* pool, size_t first, size_t count, COUNTER432_RNG(Stream)* streams)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	return clrngPoolCopyStreams((const clrngPool*)pool, first, count, streams);
+}
+
+static void jumpState(COUNTER432_RNG(StreamState)* state, const COUNTER432_RNG(Position)* steps, cl_bool backward)
+{
+	COUNTER432_RNG(Position) p = { state->ctr, state->deckIndex };
+	p = addPositions(p, *steps, backward);
+	state->ctr = p.ctr;
+	state->deckIndex = p.index;
+	// at index 0, the deck is generated when the next value is drawn
+	if (state->deckIndex != 0)
+		COUNTER432_RNG(GenerateDeck)(state);
+}
+
+clrngStatus COUNTER432_RNG(AdvanceStreams)(size_t count, COUNTER432_RNG(Stream)* streams, cl_int e, cl_int c)
+{
+	//Check params
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	COUNTER432_RNG(Position) steps = makeSteps(e, c);
+	for (size_t i = 0; i < count; i++)
+		jumpState(&streams[i].current, &steps, CL_FALSE);
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(JumpStreams)(size_t count, COUNTER432_RNG(Stream)* streams, const COUNTER432_RNG(Position)* steps, cl_bool backward)
+{
+	//Check params
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (steps == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): steps cannot be NULL", __func__);
+	if (steps->index >= 4)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): steps->index must be smaller than 4", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		jumpState(&streams[i].current, steps, backward);
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(GetPosition)(const COUNTER432_RNG(Stream)* stream, COUNTER432_RNG(Position)* position)
+{
+	//Check params
+	if (stream == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (position == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): position cannot be NULL", __func__);
+
+	position->ctr = stream->current.ctr;
+	position->index = stream->current.deckIndex;
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(SetPosition)(COUNTER432_RNG(Stream)* stream, const COUNTER432_RNG(Position)* position)
+{
+	//Check params
+	if (stream == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (position == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): position cannot be NULL", __func__);
+	if (position->index >= 4)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): position->index must be smaller than 4", __func__);
+
+	stream->current.ctr = position->ctr;
+	stream->current.deckIndex = position->index;
+	if (stream->current.deckIndex != 0)
+		COUNTER432_RNG(GenerateDeck)(&stream->current);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus COUNTER432_RNG(GetStreamPosition)(const COUNTER432_RNG(Stream)* stream, cl_ulong* position)
+{
+	//Check params
+	if (stream == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (position == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): position cannot be NULL", __func__);
+
+	// each counter value yields four outputs
+	COUNTER432_RNG(Counter) d = COUNTER432_RNG(Substract)(stream->current.ctr, stream->substream.ctr);
+	if (d.H.msb != 0 || d.H.lsb != 0 || d.L.msb >= (1u << 30))
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): the current state is not within 2^64 steps of the start of the substream", __func__);
+	cl_ulong steps = ((((cl_ulong)d.L.msb << 32) | d.L.lsb) << 2) + stream->current.deckIndex;
+	if (steps < stream->substream.deckIndex)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): the current state is before the start of the substream", __func__);
+
+	*position = steps - stream->substream.deckIndex;
+	return CLRNG_SUCCESS;
+}
+
+/*! @brief Kernel of COUNTER432_RNG(DeviceRandomU01Array_)()
+ */
+static const char fillSource[] =
+	COUNTER432_KERNEL_PRELUDE
+	"__kernel void fillBufferU01(__global COUNTER432_RNG(HostStream)* streams, uint streamCount, uint numberCount, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	int gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	//Copy a stream from global stream array to local stream struct\n"
+	"	COUNTER432_RNG(Stream) local_stream;\n"
+	"	COUNTER432_RNG(CopyOverStreamsFromGlobal)(1, &local_stream, &streams[gid]);\n"
+	"	// wavefront-friendly ordering\n"
+	"	for (int i = 0; i < numberCount; i++)\n"
+	"		numbers[i * streamCount + gid] = COUNTER432_RNG(RandomU01)(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of COUNTER432_RNG(DeviceFillU01_)()
+ */
+static const char blockSource[] =
+	COUNTER432_KERNEL_PRELUDE
+	"__kernel void fillBlocksU01(__global COUNTER432_RNG(HostStream)* streams, uint streamCount, ulong perStream, uint blockSize,\n"
+	"	uint blocksPerStream, ulong numberCount, __global const uint* leaps, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	uint s = gid / blocksPerStream;\n"
+	"	uint b = gid % blocksPerStream;\n"
+	"	ulong first = s * perStream + (ulong)b * blockSize;\n"
+	"	// the global size is padded, and the last streams can have fewer values\n"
+	"	if (s >= streamCount || first >= numberCount)\n"
+	"		return;\n"
+	"	ulong last = min(min(first + blockSize, (s + 1) * perStream), numberCount);\n"
+	"	COUNTER432_RNG(Stream) local_stream;\n"
+	"	COUNTER432_RNG(CopyOverStreamsFromGlobal)(1, &local_stream, &streams[s]);\n"
+	"	// jump to value b * blockSize of the stream by adding to the counter\n"
+	"	if (b != 0) {\n"
+	"		ulong skip = (ulong)b * blockSize + local_stream.current.deckIndex;\n"
+	"		COUNTER432_RNG(Counter) inc = { { 0, 0 }, { (uint)(skip >> 34), (uint)(skip >> 2) } };\n"
+	"		local_stream.current.ctr = COUNTER432_RNG(Add)(local_stream.current.ctr, inc);\n"
+	"		local_stream.current.deckIndex = (uint)(skip & 3);\n"
+	"		COUNTER432_RNG(GenerateDeck)(&local_stream.current);\n"
+	"	}\n"
+	"	for (ulong n = first; n < last; n++)\n"
+	"		numbers[n] = COUNTER432_RNG(RandomU01)(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of COUNTER432_RNG(DeviceAdvanceStreams)()
+ */
+static const char advanceSource[] =
+	COUNTER432_KERNEL_PRELUDE
+	"typedef struct { COUNTER432_RNG(Counter) ctr; uint index; } Position;\n"
+	"__kernel void advanceStreams(__global COUNTER432_RNG(HostStream)* streams, uint streamCount, __constant Position* steps) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	COUNTER432_RNG(StreamState) state = streams[gid].current;\n"
+	"	COUNTER432_RNG(Counter) one = { { 0, 0 }, { 0, 1 } };\n"
+	"	uint index = state.deckIndex + steps->index;\n"
+	"	state.ctr = COUNTER432_RNG(Add)(state.ctr, steps->ctr);\n"
+	"	if (index >= 4)\n"
+	"		state.ctr = COUNTER432_RNG(Add)(state.ctr, one);\n"
+	"	state.deckIndex = index & 3;\n"
+	"	// at index 0, the deck is generated when the next value is drawn\n"
+	"	if (state.deckIndex != 0)\n"
+	"		COUNTER432_RNG(GenerateDeck)(&state);\n"
+	"	streams[gid].current = state;\n"
+	"}\n";
+
+const clrngDeviceKernels COUNTER432_RNG(DeviceKernels) = {
+	COUNTER432_GENERATOR,
+	sizeof(COUNTER432_RNG(Stream)),
+	fillSource,
+	blockSource,
+	0,
+	NULL,
+	advanceSource
+};
+
+clrngStatus COUNTER432_RNG(DeviceRandomU01Array_)(size_t streamCount, cl_mem streams,
+	size_t numberCount, cl_mem outBuffer, cl_uint numQueuesAndEvents,
+	cl_command_queue* commQueues, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvents, cl_bool singlePrecision)
+{
+	//Check params
+	if (streamCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streamCount cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream_array cannot be NULL", __func__);
+	if (numberCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount cannot be less than 1", __func__);
+	if (outBuffer == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	if (commQueues == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): commQueues cannot be NULL", __func__);
+	if (numberCount % streamCount != 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount must be a multiple of streamCount", __func__);
+	if (numQueuesAndEvents != 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numQueuesAndEvents can only have the value '1'", __func__);
+
+	return clrngDeviceRandomArray(&COUNTER432_RNG(DeviceKernels), streamCount, streams, numberCount, outBuffer,
+		commQueues[0], numWaitEvents, waitEvents, outEvents, singlePrecision, __func__);
+}
+
+clrngStatus COUNTER432_RNG(DeviceFillU01_)(size_t streamCount, cl_mem streams,
+	size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision)
+{
+	//Check params
+	if (streamCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streamCount cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (numberCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount cannot be less than 1", __func__);
+	if (outBuffer == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
+
+	return clrngDeviceFillBlocks(&COUNTER432_RNG(DeviceKernels), streamCount, streams, numberCount, outBuffer, blockSize,
+		queue, numWaitEvents, waitEvents, outEvent, singlePrecision, __func__);
+}
+
+clrngStatus COUNTER432_RNG(DeviceAdvanceStreams)(size_t count, cl_mem streams, cl_int e, cl_int c,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent)
+{
+	//Check params
+	if (count < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): count cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
+	COUNTER432_RNG(Position) steps = makeSteps(e, c);
+
+	return clrngDeviceAdvance(&COUNTER432_RNG(DeviceKernels), count, streams, &steps, sizeof(steps),
+		queue, numWaitEvents, waitEvents, outEvent, __func__);
+}
+
+static clrngStatus fillU01_cl_float(void* stream, size_t count, void* numbers)
+{
+	return COUNTER432_RNG(RandomU01Array_cl_float)((COUNTER432_RNG(Stream)*)stream, count, (cl_float*)numbers);
+}
+
+static clrngStatus fillU01_cl_double(void* stream, size_t count, void* numbers)
+{
+	return COUNTER432_RNG(RandomU01Array_cl_double)((COUNTER432_RNG(Stream)*)stream, count, (cl_double*)numbers);
+}
+
+clrngStatus COUNTER432_RNG(ParallelFillU01_cl_float)(size_t streamCount, COUNTER432_RNG(Stream)* streams, size_t numberCount, cl_float* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_float, sizeof(COUNTER432_RNG(Stream)), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
+
+clrngStatus COUNTER432_RNG(ParallelFillU01_cl_double)(size_t streamCount, COUNTER432_RNG(Stream)* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_double, sizeof(COUNTER432_RNG(Stream)), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
+
+clrngStatus COUNTER432_RNG(HostRandomU01Array_cl_float)(size_t streamCount, const COUNTER432_RNG(Stream)* streams, size_t numberCount, cl_float* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_float, sizeof(COUNTER432_RNG(Stream)), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount);
+}
+
+clrngStatus COUNTER432_RNG(HostRandomU01Array_cl_double)(size_t streamCount, const COUNTER432_RNG(Stream)* streams, size_t numberCount, cl_double* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_double, sizeof(COUNTER432_RNG(Stream)), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount);
+}
+
+#endif
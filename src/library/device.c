@@ -0,0 +1,587 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file device.c
+ * @brief Compilation, caching and enqueueing of the library kernels
+ */
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#include <string.h>
+
+#define GENERATOR_COUNT (CLRNG_THREEFRY432 + 1)
+
+/*! @brief Compiled program, cached per context, device, source and precision
+ */
+typedef struct cachedProgram_ {
+	cl_context              context;
+	cl_device_id            device;
+	const char*             source;
+	cl_bool                 singlePrecision;
+	cl_program              program;
+	struct cachedProgram_*  next;
+} cachedProgram;
+
+// all protected by clrngLockLibrary()
+static clrngDeviceStats     stats[GENERATOR_COUNT];
+static cachedProgram*       programs = NULL;
+static clrngEnqueueCallback beforeEnqueue = NULL;
+static clrngEnqueueCallback afterEnqueue = NULL;
+static void*                callbackData = NULL;
+
+static void addStats(clrngDeviceStats* total, const clrngDeviceStats* s)
+{
+	total->programBuilds    += s->programBuilds;
+	total->programCacheHits += s->programCacheHits;
+	total->buildSeconds     += s->buildSeconds;
+	total->kernelLaunches   += s->kernelLaunches;
+	total->enqueueSeconds   += s->enqueueSeconds;
+	total->kernelsTimed     += s->kernelsTimed;
+	total->kernelSeconds    += s->kernelSeconds;
+	total->bytesWritten     += s->bytesWritten;
+	total->numbersGenerated += s->numbersGenerated;
+}
+
+clrngStatus clrngGetDeviceStats(cl_uint generator, clrngDeviceStats* s)
+{
+	//Check params
+	if (s == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stats cannot be NULL", __func__);
+	if (generator >= GENERATOR_COUNT)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): invalid generator", __func__);
+
+	clrngLockLibrary();
+	if (generator == CLRNG_ALL_GENERATORS) {
+		memset(s, 0, sizeof(*s));
+		for (cl_uint g = 1; g < GENERATOR_COUNT; g++)
+			addStats(s, &stats[g]);
+	}
+	else
+		*s = stats[generator];
+	clrngUnlockLibrary();
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngResetDeviceStats()
+{
+	clrngLockLibrary();
+	memset(stats, 0, sizeof(stats));
+	clrngUnlockLibrary();
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngSetEnqueueCallbacks(clrngEnqueueCallback before, clrngEnqueueCallback after, void* userData)
+{
+	clrngLockLibrary();
+	beforeEnqueue = before;
+	afterEnqueue = after;
+	callbackData = userData;
+	clrngUnlockLibrary();
+	return CLRNG_SUCCESS;
+}
+
+/*! @brief Release the cached programs of \c context, or all of them if `NULL`
+ */
+static void releasePrograms(cl_context context)
+{
+	cachedProgram* released = NULL;
+
+	clrngLockLibrary();
+	cachedProgram** link = &programs;
+	while (*link != NULL) {
+		cachedProgram* p = *link;
+		if (context == NULL || p->context == context) {
+			*link = p->next;
+			p->next = released;
+			released = p;
+		}
+		else
+			link = &p->next;
+	}
+	clrngUnlockLibrary();
+
+	while (released != NULL) {
+		cachedProgram* next = released->next;
+		clReleaseProgram(released->program);
+		clrngRelease(released);
+		released = next;
+	}
+}
+
+clrngStatus clrngReleaseProgramCache()
+{
+	releasePrograms(NULL);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngReleaseContextPrograms(cl_context context)
+{
+	//Check params
+	if (context == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): context cannot be NULL", __func__);
+
+	releasePrograms(context);
+	return CLRNG_SUCCESS;
+}
+
+/*! @brief Look up a program in the cache and retain it; `NULL` if absent
+ *
+ *  Must be called with the library lock held.
+ */
+static cl_program findProgram(cl_context ctx, cl_device_id dev, const char* source, cl_bool singlePrecision)
+{
+	for (cachedProgram* p = programs; p != NULL; p = p->next) {
+		if (p->context == ctx && p->device == dev && p->source == source && p->singlePrecision == singlePrecision) {
+			clRetainProgram(p->program);
+			return p->program;
+		}
+	}
+	return NULL;
+}
+
+/*! @brief Definitions prepended to the kernels of \c generator for device \c dev
+ *
+ *  MRG32k3a uses its floating-point recurrence on every device if the
+ *  library was built with \c CLRNG_MRG32K3A_FP_ARITHMETIC; both recurrences
+ *  produce the same states.  It is not selected per device until it has
+ *  been measured to be faster there (see the Mrg32k3aArithmetic client).
+ */
+static const char* deviceDefines(cl_uint generator, cl_device_id dev)
+{
+	(void)dev;
+#ifdef CLRNG_MRG32K3A_FP_ARITHMETIC
+	if (generator == CLRNG_MRG32K3A)
+		return "#define CLRNG_MRG32K3A_FP_ARITHMETIC\n";
+#else
+	(void)generator;
+#endif
+	return "";
+}
+
+cl_program clrngGetProgram(cl_uint generator, cl_command_queue queue, const char* source, cl_bool singlePrecision, const char* caller, clrngStatus* status)
+{
+	cl_int err;
+
+	cl_context ctx;
+	err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, NULL);
+	if (err != CLRNG_SUCCESS) {
+		*status = clrngSetErrorString(err, "%s(): cannot retrieve context", caller);
+		return NULL;
+	}
+
+	cl_device_id dev;
+	err = clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &dev, NULL);
+	if (err != CLRNG_SUCCESS) {
+		*status = clrngSetErrorString(err, "%s(): cannot retrieve the device", caller);
+		return NULL;
+	}
+
+	clrngLockLibrary();
+	cl_program program = findProgram(ctx, dev, source, singlePrecision);
+	if (program != NULL)
+		stats[generator].programCacheHits++;
+	clrngUnlockLibrary();
+	if (program != NULL) {
+		*status = CLRNG_SUCCESS;
+		return program;
+	}
+
+	// compile without holding the lock
+	cl_double start = clrngWallTime();
+
+	const char *sources[3] = {
+		singlePrecision ? "#define CLRNG_SINGLE_PRECISION\n" : "",
+		deviceDefines(generator, dev),
+		source
+	};
+	program = clCreateProgramWithSource(ctx, 3, sources, NULL, &err);
+	if (err != CLRNG_SUCCESS) {
+		*status = clrngSetErrorString(err, "%s(): cannot create program", caller);
+		return NULL;
+	}
+
+	// construct compiler options
+	const char* includes = clrngGetLibraryDeviceIncludes(&err);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseProgram(program);
+		*status = (clrngStatus)err;
+		return NULL;
+	}
+
+	err = clBuildProgram(program, 1, &dev, includes, NULL, NULL);
+	if (err < 0) {
+		// Find size of log and print to std output
+		char *program_log;
+		size_t log_size;
+		clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, 0, NULL, &log_size);
+		program_log = (char *)clrngAlloc(log_size + 1, 0, NULL);
+		if (program_log != NULL) {
+			program_log[log_size] = '\0';
+			clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, log_size + 1, program_log, NULL);
+			printf("clBuildProgram fails:\n%s\n", program_log);
+			clrngRelease(program_log);
+		}
+		clReleaseProgram(program);
+		*status = clrngSetErrorString(err, "%s(): cannot build program", caller);
+		return NULL;
+	}
+
+	cl_double elapsed = clrngWallTime() - start;
+
+	// cache the program, unless another thread has built it in the meantime
+	cachedProgram* entry = (cachedProgram*)clrngAlloc(sizeof(cachedProgram), 0, NULL);
+	clrngLockLibrary();
+	stats[generator].programBuilds++;
+	stats[generator].buildSeconds += elapsed;
+	cl_program existing = findProgram(ctx, dev, source, singlePrecision);
+	if (existing == NULL && entry != NULL) {
+		clRetainProgram(program);
+		entry->context = ctx;
+		entry->device = dev;
+		entry->source = source;
+		entry->singlePrecision = singlePrecision;
+		entry->program = program;
+		entry->next = programs;
+		programs = entry;
+		entry = NULL;
+	}
+	clrngUnlockLibrary();
+	clrngRelease(entry);
+	if (existing != NULL) {
+		clReleaseProgram(program);
+		program = existing;
+	}
+
+	*status = CLRNG_SUCCESS;
+	return program;
+}
+
+/*! @brief Record the execution time of a kernel when it completes
+ *
+ *  \c data holds the generator in its low byte, and a flag in bit 8 if the
+ *  event belongs to the library.
+ */
+static void CL_CALLBACK kernelComplete(cl_event event, cl_int status, void* data)
+{
+	size_t flags = (size_t)data;
+	cl_uint generator = (cl_uint)(flags & 0xff);
+	cl_ulong start, end;
+	if (status == CL_COMPLETE &&
+	    clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(start), &start, NULL) == CL_SUCCESS &&
+	    clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END, sizeof(end), &end, NULL) == CL_SUCCESS) {
+		clrngLockLibrary();
+		stats[generator].kernelsTimed++;
+		stats[generator].kernelSeconds += (end - start) * 1e-9;
+		clrngUnlockLibrary();
+	}
+	if (flags & 0x100)
+		clReleaseEvent(event);
+}
+
+clrngStatus clrngEnqueueKernel(cl_uint generator, const char* caller, cl_command_queue queue, cl_kernel kernel,
+	size_t globalSize, size_t localSize, size_t numberCount, size_t numberSize,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent)
+{
+	cl_command_queue_properties properties = 0;
+	clGetCommandQueueInfo(queue, CL_QUEUE_PROPERTIES, sizeof(properties), &properties, NULL);
+	cl_bool profiling = (properties & CL_QUEUE_PROFILING_ENABLE) != 0;
+
+	clrngLockLibrary();
+	clrngEnqueueCallback before = beforeEnqueue;
+	clrngEnqueueCallback after = afterEnqueue;
+	void* userData = callbackData;
+	clrngUnlockLibrary();
+
+	clrngEnqueueInfo info = { generator, caller, queue, kernel, globalSize, localSize, numberCount, NULL, CL_SUCCESS };
+	if (before != NULL)
+		before(&info, userData);
+
+	// an event is needed for timing and for the callback even if the caller does not want one
+	cl_event event = NULL;
+	cl_bool ownEvent = outEvent == NULL && (profiling || after != NULL);
+	cl_event* eventPtr = outEvent != NULL ? outEvent : (ownEvent ? &event : NULL);
+
+	cl_double start = clrngWallTime();
+	cl_int err = clEnqueueNDRangeKernel(queue, kernel, 1, NULL, &globalSize, &localSize, numWaitEvents, waitEvents, eventPtr);
+	cl_double elapsed = clrngWallTime() - start;
+
+	if (err == CL_SUCCESS && eventPtr != NULL)
+		event = *eventPtr;
+
+	clrngLockLibrary();
+	stats[generator].enqueueSeconds += elapsed;
+	if (err == CL_SUCCESS) {
+		stats[generator].kernelLaunches++;
+		stats[generator].numbersGenerated += numberCount;
+		stats[generator].bytesWritten += (cl_ulong)numberCount * numberSize;
+	}
+	clrngUnlockLibrary();
+
+	if (after != NULL) {
+		info.event = event;
+		info.status = err;
+		after(&info, userData);
+	}
+
+	if (err != CL_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot enqueue kernel", caller);
+
+	if (profiling) {
+		size_t flags = generator | (ownEvent ? 0x100 : 0);
+		if (clSetEventCallback(event, CL_COMPLETE, kernelComplete, (void*)flags) == CL_SUCCESS)
+			ownEvent = CL_FALSE;
+	}
+	if (ownEvent)
+		clReleaseEvent(event);
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngDeviceRandomArray(const clrngDeviceKernels* kernels,
+	size_t streamCount, cl_mem streams, size_t numberCount, cl_mem outBuffer,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent,
+	cl_bool singlePrecision, const char* caller)
+{
+	clrngStatus status;
+	cl_program program = clrngGetProgram(kernels->generator, queue, kernels->fillSource, singlePrecision, caller, &status);
+	if (program == NULL)
+		return status;
+
+	// Create the kernel
+	cl_int err;
+	cl_kernel kernel = clCreateKernel(program, "fillBufferU01", &err);
+	clReleaseProgram(program);
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot create kernel", caller);
+
+	//Random numbers generated by each work-item
+	cl_uint stream_count = (cl_uint)streamCount;
+	cl_uint number_count_per_stream = (cl_uint)(numberCount / streamCount);
+
+	//Work Group Size (local_size): tuned, or the largest possible
+	cl_device_id dev;
+	size_t local_size = 0;
+	err = clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &dev, NULL);
+	if (err == CLRNG_SUCCESS)
+		local_size = clrngTunedLocalSize(kernels->generator, dev, singlePrecision);
+	if (err == CLRNG_SUCCESS && local_size == 0)
+		err = clGetKernelWorkGroupInfo(kernel, dev, CL_KERNEL_WORK_GROUP_SIZE, sizeof(local_size), &local_size, NULL);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(err, "%s(): cannot read CL_KERNEL_WORK_GROUP_SIZE", caller);
+	}
+	if (local_size > streamCount)
+		local_size = streamCount;
+	// pad the global size; the kernel ignores the extra work-items
+	size_t global_size = (streamCount + local_size - 1) / local_size * local_size;
+
+	// Set kernel arguments for kernel and enqueue that kernel.
+	err = clSetKernelArg(kernel, 0, sizeof(streams), &streams);
+	err |= clSetKernelArg(kernel, 1, sizeof(stream_count), &stream_count);
+	err |= clSetKernelArg(kernel, 2, sizeof(number_count_per_stream), &number_count_per_stream);
+	err |= clSetKernelArg(kernel, 3, sizeof(outBuffer), &outBuffer);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(err, "%s(): cannot create kernel arguments", caller);
+	}
+
+	status = clrngEnqueueKernel(kernels->generator, caller, queue, kernel, global_size, local_size, numberCount,
+		singlePrecision ? sizeof(cl_float) : sizeof(cl_double), numWaitEvents, waitEvents, outEvent);
+
+	clReleaseKernel(kernel);
+	return status;
+}
+
+/*! @brief Smallest block size chosen by clrngDeviceFillBlocks()
+ */
+#define MIN_FILL_BLOCK 64
+
+/*! @brief Number of work-groups per compute unit aimed at by clrngDeviceFillBlocks()
+ */
+#define FILL_GROUPS_PER_UNIT 4
+
+clrngStatus clrngDeviceFillBlocks(const clrngDeviceKernels* kernels,
+	size_t streamCount, cl_mem streams, size_t numberCount, cl_mem outBuffer, size_t blockSize,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent,
+	cl_bool singlePrecision, const char* caller)
+{
+	clrngStatus status;
+	cl_program program = clrngGetProgram(kernels->generator, queue, kernels->blockSource, singlePrecision, caller, &status);
+	if (program == NULL)
+		return status;
+
+	cl_int err;
+	cl_kernel kernel = clCreateKernel(program, "fillBlocksU01", &err);
+	clReleaseProgram(program);
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot create kernel", caller);
+
+	cl_context ctx;
+	cl_device_id dev;
+	size_t local_size;
+	cl_uint units;
+	err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, NULL);
+	err |= clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &dev, NULL);
+	err |= clGetKernelWorkGroupInfo(kernel, dev, CL_KERNEL_WORK_GROUP_SIZE, sizeof(local_size), &local_size, NULL);
+	err |= clGetDeviceInfo(dev, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(units), &units, NULL);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(err, "%s(): cannot query the device", caller);
+	}
+
+	// values per stream; the last streams can have fewer, or none
+	cl_ulong perStream = ((cl_ulong)numberCount + streamCount - 1) / streamCount;
+	if (blockSize == 0) {
+		// enough work-items to occupy the device
+		cl_ulong items = (cl_ulong)units * local_size * FILL_GROUPS_PER_UNIT;
+		cl_ulong blocks = (items + streamCount - 1) / streamCount;
+		blockSize = (size_t)((perStream + blocks - 1) / blocks);
+		if (blockSize < MIN_FILL_BLOCK)
+			blockSize = MIN_FILL_BLOCK;
+	}
+	cl_ulong blocksPerStream = (perStream + blockSize - 1) / blockSize;
+	cl_ulong workItems = blocksPerStream * streamCount;
+	if (blockSize > 0xFFFFFFFFu || workItems > 0xFFFFFFFFu) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): blockSize too %s", caller, blockSize > 0xFFFFFFFFu ? "large" : "small");
+	}
+
+	// one leap per bit of the largest block index
+	size_t leapCount = 0;
+	while (((blocksPerStream - 1) >> leapCount) != 0)
+		leapCount++;
+	cl_mem leaps = NULL;
+	if (kernels->leapSize > 0 && leapCount > 0) {
+		void* hostLeaps = clrngAlloc(leapCount * kernels->leapSize, 0, NULL);
+		if (hostLeaps == NULL) {
+			clReleaseKernel(kernel);
+			return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for leaps", caller);
+		}
+		kernels->makeBlockLeaps((cl_uint)blockSize, leapCount, hostLeaps);
+		leaps = clCreateBuffer(ctx, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, leapCount * kernels->leapSize, hostLeaps, &err);
+		clrngRelease(hostLeaps);
+		if (err != CLRNG_SUCCESS) {
+			clReleaseKernel(kernel);
+			return clrngSetErrorString(err, "%s(): cannot create leaps buffer", caller);
+		}
+	}
+
+	if (local_size > workItems)
+		local_size = (size_t)workItems;
+	// pad the global size; the kernel ignores the extra work-items
+	size_t global_size = ((size_t)workItems + local_size - 1) / local_size * local_size;
+
+	cl_uint  stream_count = (cl_uint)streamCount;
+	cl_ulong per_stream = perStream;
+	cl_uint  block_size = (cl_uint)blockSize;
+	cl_uint  blocks_per_stream = (cl_uint)blocksPerStream;
+	cl_ulong number_count = numberCount;
+	err = clSetKernelArg(kernel, 0, sizeof(streams), &streams);
+	err |= clSetKernelArg(kernel, 1, sizeof(stream_count), &stream_count);
+	err |= clSetKernelArg(kernel, 2, sizeof(per_stream), &per_stream);
+	err |= clSetKernelArg(kernel, 3, sizeof(block_size), &block_size);
+	err |= clSetKernelArg(kernel, 4, sizeof(blocks_per_stream), &blocks_per_stream);
+	err |= clSetKernelArg(kernel, 5, sizeof(number_count), &number_count);
+	err |= clSetKernelArg(kernel, 6, sizeof(leaps), &leaps);
+	err |= clSetKernelArg(kernel, 7, sizeof(outBuffer), &outBuffer);
+	if (err == CLRNG_SUCCESS)
+		status = clrngEnqueueKernel(kernels->generator, caller, queue, kernel, global_size, local_size, numberCount,
+			singlePrecision ? sizeof(cl_float) : sizeof(cl_double), numWaitEvents, waitEvents, outEvent);
+	else
+		status = clrngSetErrorString(err, "%s(): cannot create kernel arguments", caller);
+
+	// the buffer is kept alive by the enqueued kernel
+	if (leaps != NULL)
+		clReleaseMemObject(leaps);
+	clReleaseKernel(kernel);
+	return status;
+}
+
+clrngStatus clrngDeviceAdvance(const clrngDeviceKernels* kernels,
+	size_t count, cl_mem streams, const void* jump, size_t jumpSize,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent,
+	const char* caller)
+{
+	if (count > 0xFFFFFFFFu)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): count too large", caller);
+
+	// the kernel uses no floating-point type: build it without double precision
+	clrngStatus status;
+	cl_program program = clrngGetProgram(kernels->generator, queue, kernels->advanceSource, CL_TRUE, caller, &status);
+	if (program == NULL)
+		return status;
+
+	cl_int err;
+	cl_kernel kernel = clCreateKernel(program, "advanceStreams", &err);
+	clReleaseProgram(program);
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot create kernel", caller);
+
+	cl_context ctx;
+	cl_device_id dev;
+	size_t local_size;
+	err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, NULL);
+	err |= clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &dev, NULL);
+	err |= clGetKernelWorkGroupInfo(kernel, dev, CL_KERNEL_WORK_GROUP_SIZE, sizeof(local_size), &local_size, NULL);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(err, "%s(): cannot read CL_KERNEL_WORK_GROUP_SIZE", caller);
+	}
+	if (local_size > count)
+		local_size = count;
+	// pad the global size; the kernel ignores the extra work-items
+	size_t global_size = (count + local_size - 1) / local_size * local_size;
+
+	// a __constant buffer rather than a by-value argument, which can exceed
+	// the minimum CL_DEVICE_MAX_PARAMETER_SIZE of 256 bytes (Lfsr113)
+	cl_mem jumpBuffer = clCreateBuffer(ctx, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, jumpSize, (void*)jump, &err);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(err, "%s(): cannot create jump buffer", caller);
+	}
+
+	cl_uint stream_count = (cl_uint)count;
+	err = clSetKernelArg(kernel, 0, sizeof(streams), &streams);
+	err |= clSetKernelArg(kernel, 1, sizeof(stream_count), &stream_count);
+	err |= clSetKernelArg(kernel, 2, sizeof(jumpBuffer), &jumpBuffer);
+	if (err == CLRNG_SUCCESS)
+		status = clrngEnqueueKernel(kernels->generator, caller, queue, kernel, global_size, local_size, 0, 0,
+			numWaitEvents, waitEvents, outEvent);
+	else
+		status = clrngSetErrorString(err, "%s(): cannot create kernel arguments", caller);
+
+	// the buffer is kept alive by the enqueued kernel
+	clReleaseMemObject(jumpBuffer);
+	clReleaseKernel(kernel);
+	return status;
+}
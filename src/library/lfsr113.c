@@ -34,6 +34,7 @@
 
 #include "private.h"
 #include <stdlib.h>
+#include <string.h>
 
 #if defined ( WIN32 )
 #define __func__ __FUNCTION__
@@ -41,14 +42,113 @@
 
 
 
+// jump of many steps: the transition matrices of the four components over GF(2)
+typedef struct {
+	cl_uint cols[4][32];   // column k of the matrix of component i: image of bit k
+} Leap;
+
 struct clrngLfsr113StreamCreator_ {
 	clrngLfsr113StreamState initialState;
 	clrngLfsr113StreamState nextState;
+	cl_bool customSpacing;   // streams spaced by nu rather than by lfsr113AdvanceState()
+	Leap nu;
 };
 
 // code that is common to host and device
 #include "../include/clRNG/private/lfsr113.c.h"
 
+// number of significant bits of each component, whose period is 2^bits - 1
+static const cl_uint componentBits[4] = { 31, 29, 28, 25 };
+
+// matrices of 2^j steps of each component, j = 0, ..., 31; computed on first use
+static cl_uint powerTable[4][32][32];
+static int powerTableReady = 0;
+
+static cl_uint gf2MatVec(const cl_uint* cols, cl_uint x)
+{
+	cl_uint y = 0;
+	for (size_t k = 0; x != 0; k++, x >>= 1)
+		if (x & 1)
+			y ^= cols[k];
+	return y;
+}
+
+// C = A * B (C may alias A or B)
+static void gf2MatMat(const cl_uint* a, const cl_uint* b, cl_uint* c)
+{
+	cl_uint w[32];
+	for (size_t k = 0; k < 32; k++)
+		w[k] = gf2MatVec(a, b[k]);
+	memcpy(c, w, sizeof(w));
+}
+
+static void usePowerTable()
+{
+	clrngLockLibrary();
+	if (!powerTableReady) {
+		// matrices of one step, applied to the unit vectors
+		for (size_t k = 0; k < 32; k++) {
+			clrngLfsr113StreamState unit = { { 1u << k, 1u << k, 1u << k, 1u << k } };
+			clrngLfsr113NextState(&unit);
+			for (size_t i = 0; i < 4; i++)
+				powerTable[i][0][k] = unit.g[i];
+		}
+		for (size_t j = 1; j < 32; j++)
+			for (size_t i = 0; i < 4; i++)
+				gf2MatMat(powerTable[i][j - 1], powerTable[i][j - 1], powerTable[i][j]);
+		powerTableReady = 1;
+	}
+	clrngUnlockLibrary();
+}
+
+// matrix of n steps of component i, for n < 2^32
+static void componentPower(size_t i, cl_ulong n, cl_uint* cols)
+{
+	for (size_t k = 0; k < 32; k++)
+		cols[k] = 1u << k;
+	for (size_t j = 0; n != 0; j++, n >>= 1)
+		if (n & 1)
+			gf2MatMat(powerTable[i][j], cols, cols);
+}
+
+static void makeLeap(cl_uint steps, void* leap)
+{
+	Leap* l = (Leap*)leap;
+	usePowerTable();
+	for (size_t i = 0; i < 4; i++)
+		componentPower(i, steps, l->cols[i]);
+}
+
+static void applyLeap(const void* leap, void* state)
+{
+	const Leap* l = (const Leap*)leap;
+	clrngLfsr113StreamState* s = (clrngLfsr113StreamState*)state;
+	for (size_t i = 0; i < 4; i++)
+		s->g[i] = gf2MatVec(l->cols[i], s->g[i]);
+}
+
+// jump of 2^e + c (e > 0), -2^|e| + c (e < 0) or c (e = 0) steps; the steps
+// of each component are taken modulo its period, where 2^e is 2^(e mod bits)
+static void makeJump(cl_int e, cl_int c, Leap* jump)
+{
+	cl_uint a = e < 0 ? 0u - (cl_uint)e : (cl_uint)e;
+	// the first step discards the low bits of the state, so a positive
+	// multiple of the period is not the identity
+	int none = e == 0 ? c == 0 : a <= 31 && (cl_long)c == (e > 0 ? -1 : 1) * ((cl_long)1 << a);
+
+	usePowerTable();
+	for (size_t i = 0; i < 4; i++) {
+		cl_long period = ((cl_long)1 << componentBits[i]) - 1;
+		cl_long n = c % period;
+		if (e != 0)
+			n += (e > 0 ? 1 : -1) * ((cl_long)1 << (a % componentBits[i]));
+		n = (n % period + period) % period;
+		if (n == 0 && !none)
+			n = period;
+		componentPower(i, (cl_ulong)n, jump->cols[i]);
+	}
+}
+
 
 /*! @brief Default initial seed of the first stream
 */
@@ -64,7 +164,9 @@ struct clrngLfsr113StreamCreator_ {
 */
 static clrngLfsr113StreamCreator defaultStreamCreator = {
 	{ BASE_CREATOR_STATE },
-	{ BASE_CREATOR_STATE }
+	{ BASE_CREATOR_STATE },
+	CL_FALSE,          // streams spaced by lfsr113AdvanceState()
+	{ { { 0 } } }      // nu, unused without custom spacing
 };
 
 /*! @brief Check the validity of a seed for Lfsr113
@@ -88,11 +190,16 @@ static clrngStatus validateSeed(const clrngLfsr113StreamState* seed)
 }
 
 clrngLfsr113StreamCreator* clrngLfsr113CopyStreamCreator(const clrngLfsr113StreamCreator* creator, clrngStatus* err)
+{
+	return clrngLfsr113CopyStreamCreatorEx(creator, NULL, err);
+}
+
+clrngLfsr113StreamCreator* clrngLfsr113CopyStreamCreatorEx(const clrngLfsr113StreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 
 	// allocate creator
-	clrngLfsr113StreamCreator* newCreator = (clrngLfsr113StreamCreator*)malloc(sizeof(clrngLfsr113StreamCreator));
+	clrngLfsr113StreamCreator* newCreator = (clrngLfsr113StreamCreator*)clrngAlloc(sizeof(clrngLfsr113StreamCreator), 0, allocator);
 
 	if (newCreator == NULL)
 		// allocation failed
@@ -113,8 +220,7 @@ clrngLfsr113StreamCreator* clrngLfsr113CopyStreamCreator(const clrngLfsr113Strea
 
 clrngStatus clrngLfsr113DestroyStreamCreator(clrngLfsr113StreamCreator* creator)
 {
-	if (creator != NULL)
-		free(creator);
+	clrngRelease(creator);
 	return CLRNG_SUCCESS;
 }
 
@@ -146,18 +252,37 @@ clrngStatus clrngLfsr113SetBaseCreatorState(clrngLfsr113StreamCreator* creator,
 
 clrngStatus clrngLfsr113ChangeStreamsSpacing(clrngLfsr113StreamCreator* creator, cl_int e, cl_int c)
 {
-	return clrngSetErrorString(CLRNG_FUNCTION_NOT_IMPLEMENTED, "%s(): Not Implemented", __func__);
+	//Check params
+	if (creator == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_STREAM_CREATOR, "%s(): modifying the default stream creator is forbidden", __func__);
+	if (e < 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): e must be >= 0", __func__);
+
+	makeJump(e, c, &creator->nu);
+	creator->customSpacing = CL_TRUE;
+
+	return CLRNG_SUCCESS;
 }
 
 clrngLfsr113Stream* clrngLfsr113AllocStreams(size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return clrngLfsr113AllocStreamsEx(count, 0, NULL, bufSize, err);
+}
+
+clrngLfsr113Stream* clrngLfsr113AllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 	size_t bufSize_ = count * sizeof(clrngLfsr113Stream);
+	clrngLfsr113Stream* buf = NULL;
 
-	// allocate streams
-	clrngLfsr113Stream* buf = (clrngLfsr113Stream*)malloc(bufSize_);
+	//Check params
+	if (!clrngValidAlignment(alignment))
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): alignment must be a power of two", __func__);
+	else
+		// allocate streams
+		buf = (clrngLfsr113Stream*)clrngAlloc(bufSize_, alignment, allocator);
 
-	if (buf == NULL) {
+	if (err_ == CLRNG_SUCCESS && buf == NULL) {
 		// allocation failed
 		err_ = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for streams", __func__);
 		bufSize_ = 0;
@@ -176,8 +301,7 @@ clrngLfsr113Stream* clrngLfsr113AllocStreams(size_t count, size_t* bufSize, clrn
 
 clrngStatus clrngLfsr113DestroyStreams(clrngLfsr113Stream* streams)
 {
-	if (streams != NULL)
-		free(streams);
+	clrngRelease(streams);
 	return CLRNG_SUCCESS;
 }
 void lfsr113AdvanceState(clrngLfsr113StreamState* currentState)
@@ -249,9 +373,15 @@ static clrngStatus Lfsr113CreateStream(clrngLfsr113StreamCreator* creator, clrng
 
 	// initialize stream
 	buffer->current = buffer->initial = buffer->substream = creator->nextState;
+#ifdef CLRNG_INSTRUMENT
+	buffer->draws = 0;
+#endif
 
 	//Advance next state in stream creator
-	lfsr113AdvanceState(&creator->nextState);
+	if (creator->customSpacing)
+		applyLeap(&creator->nu, &creator->nextState);
+	else
+		lfsr113AdvanceState(&creator->nextState);
 
 	return CLRNG_SUCCESS;
 }
@@ -272,10 +402,15 @@ clrngStatus clrngLfsr113CreateOverStreams(clrngLfsr113StreamCreator* creator, si
 }
 
 clrngLfsr113Stream* clrngLfsr113CreateStreams(clrngLfsr113StreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return clrngLfsr113CreateStreamsEx(creator, count, 0, NULL, bufSize, err);
+}
+
+clrngLfsr113Stream* clrngLfsr113CreateStreamsEx(clrngLfsr113StreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_;
 	size_t bufSize_;
-	clrngLfsr113Stream* streams = clrngLfsr113AllocStreams(count, &bufSize_, &err_);
+	clrngLfsr113Stream* streams = clrngLfsr113AllocStreamsEx(count, alignment, allocator, &bufSize_, &err_);
 
 	if (err_ == CLRNG_SUCCESS)
 		err_ = clrngLfsr113CreateOverStreams(creator, count, streams);
@@ -290,6 +425,11 @@ clrngLfsr113Stream* clrngLfsr113CreateStreams(clrngLfsr113StreamCreator* creator
 }
 
 clrngLfsr113Stream* clrngLfsr113CopyStreams(size_t count, const clrngLfsr113Stream* streams, clrngStatus* err)
+{
+	return clrngLfsr113CopyStreamsEx(count, streams, 0, NULL, err);
+}
+
+clrngLfsr113Stream* clrngLfsr113CopyStreamsEx(size_t count, const clrngLfsr113Stream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 	clrngLfsr113Stream* dest = NULL;
@@ -299,7 +439,7 @@ clrngLfsr113Stream* clrngLfsr113CopyStreams(size_t count, const clrngLfsr113Stre
 		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
 
 	if (err_ == CLRNG_SUCCESS)
-		dest = clrngLfsr113AllocStreams(count, NULL, &err_);
+		dest = clrngLfsr113AllocStreamsEx(count, alignment, allocator, NULL, &err_);
 
 	if (err_ == CLRNG_SUCCESS)
 		err_ = clrngLfsr113CopyOverStreams(count, dest, streams);
@@ -310,6 +450,34 @@ clrngLfsr113Stream* clrngLfsr113CopyStreams(size_t count, const clrngLfsr113Stre
 	return dest;
 }
 
+clrngStatus clrngLfsr113GetStreamStates(size_t count, const clrngLfsr113Stream* streams, clrngLfsr113StreamState* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		states[i] = streams[i].current;
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngLfsr113SetStreamStates(size_t count, clrngLfsr113Stream* streams, const clrngLfsr113StreamState* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		streams[i].current = states[i];
+
+	return CLRNG_SUCCESS;
+}
+
 clrngLfsr113Stream* clrngLfsr113MakeSubstreams(clrngLfsr113Stream* stream, size_t count, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_;
@@ -330,7 +498,43 @@ clrngLfsr113Stream* clrngLfsr113MakeSubstreams(clrngLfsr113Stream* stream, size_
 
 clrngStatus clrngLfsr113AdvanceStreams(size_t count, clrngLfsr113Stream* streams, cl_int e, cl_int c)
 {
-	return clrngSetErrorString(CLRNG_FUNCTION_NOT_IMPLEMENTED, "%s(): Not Implemented", __func__);
+	//Check params
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	//Advance streams
+	Leap jump;
+	makeJump(e, c, &jump);
+	for (size_t i = 0; i < count; i++)
+		applyLeap(&jump, &streams[i].current);
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngLfsr113RandomU01Array_53(clrngLfsr113Stream* stream, size_t count, cl_double* buffer)
+{
+	//Check params
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+
+	_CLRNG_COUNT_DRAWS(stream, 2 * count);
+
+	// Each step of the LFSR113 components depends on the previous state:
+	// produce the outputs in blocks, then convert each block at once.
+	cl_uint hi[CLRNG_U01_53_BLOCK];
+	cl_uint lo[CLRNG_U01_53_BLOCK];
+	for (size_t i = 0; i < count; i += CLRNG_U01_53_BLOCK) {
+		size_t n = count - i < CLRNG_U01_53_BLOCK ? count - i : CLRNG_U01_53_BLOCK;
+		for (size_t k = 0; k < n; k++) {
+			hi[k] = (cl_uint)clrngLfsr113NextState(&stream->current);
+			lo[k] = (cl_uint)clrngLfsr113NextState(&stream->current);
+		}
+		clrngCombineU01_53(n, hi, lo, 0.0, Lfsr113_NORM_cl_double, buffer + i);
+	}
+
+	return CLRNG_SUCCESS;
 }
 
 clrngStatus clrngLfsr113WriteStreamInfo(const clrngLfsr113Stream* stream, FILE *file)
@@ -358,6 +562,316 @@ clrngStatus clrngLfsr113WriteStreamInfo(const clrngLfsr113Stream* stream, FILE *
 	return CLRNG_SUCCESS;
 }
 
+// serialized state: g
+static void packState(const void* state, cl_uint* words)
+{
+	const clrngLfsr113StreamState* s = (const clrngLfsr113StreamState*)state;
+	for (size_t i = 0; i < 4; i++)
+		words[i] = s->g[i];
+}
+
+static clrngStatus unpackState(const cl_uint* words, void* state)
+{
+	clrngLfsr113StreamState* s = (clrngLfsr113StreamState*)state;
+	for (size_t i = 0; i < 4; i++)
+		s->g[i] = words[i];
+	return validateSeed(s);
+}
+
+static void* allocSerialStreams(size_t count, clrngStatus* err)
+{
+	return clrngLfsr113AllocStreams(count, NULL, err);
+}
+
+static const clrngSerialFormat serialFormat = {
+	CLRNG_SERIAL_LFSR113, 4, 4, sizeof(clrngLfsr113StreamState), sizeof(clrngLfsr113Stream), packState, unpackState, allocSerialStreams
+};
+
+clrngStatus clrngLfsr113SerializeStreams(size_t count, const clrngLfsr113Stream* streams, cl_uint flags, void* buffer, size_t* bufSize)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (bufSize == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): bufSize cannot be NULL", __func__);
+
+	return clrngSerialWrite(&serialFormat, count, streams, flags, buffer, bufSize);
+}
+
+clrngStatus clrngLfsr113WriteStreams(size_t count, const clrngLfsr113Stream* streams, cl_uint flags, FILE *file)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (file == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): file cannot be NULL", __func__);
+
+	return clrngSerialWriteFile(&serialFormat, count, streams, flags, file);
+}
+
+clrngLfsr113Stream* clrngLfsr113DeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (buffer == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (clrngLfsr113Stream*)clrngSerialRead(&serialFormat, buffer, bufSize, count, err);
+}
+
+clrngLfsr113Stream* clrngLfsr113ReadStreams(const char* path, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (path == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (clrngLfsr113Stream*)clrngSerialReadFile(&serialFormat, path, count, err);
+}
+
+// jump between successive streams of a pool: the nu matrices of the creator, or
+// those of lfsr113AdvanceState() for the default spacing, which is linear too
+static void makeStreamJump(const clrngLfsr113StreamCreator* creator, Leap* jump)
+{
+	if (creator->customSpacing) {
+		*jump = creator->nu;
+		return;
+	}
+	for (size_t k = 0; k < 32; k++) {
+		clrngLfsr113StreamState unit = { { 1u << k, 1u << k, 1u << k, 1u << k } };
+		lfsr113AdvanceState(&unit);
+		for (size_t i = 0; i < 4; i++)
+			jump->cols[i][k] = unit.g[i];
+	}
+}
+
+static void composePoolJumps(const void* a, const void* b, void* result)
+{
+	const Leap* x = (const Leap*)a;
+	const Leap* y = (const Leap*)b;
+	Leap* z = (Leap*)result;
+	for (size_t i = 0; i < 4; i++)
+		gf2MatMat(y->cols[i], x->cols[i], z->cols[i]);
+}
+
+static const clrngPoolFormat poolFormat = {
+	CLRNG_SERIAL_LFSR113, sizeof(clrngLfsr113StreamState), sizeof(clrngLfsr113Stream), sizeof(Leap), composePoolJumps, applyLeap
+};
+
+clrngLfsr113StreamPool* clrngLfsr113CreateStreamPool(clrngLfsr113StreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else {
+		// use default creator if not given
+		if (creator == NULL)
+			creator = &defaultStreamCreator;
+
+		Leap jump;
+		makeStreamJump(creator, &jump);
+		pool = clrngPoolCreate(&poolFormat, &creator->nextState, &jump, count, path, flags, &err_);
+
+		// skip the streams of the pool, as clrngCreateStreams() would
+		if (pool != NULL)
+			clrngPoolJump(pool, (cl_ulong)count, &creator->nextState);
+	}
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngLfsr113StreamPool*)pool;
+}
+
+clrngLfsr113StreamPool* clrngLfsr113OpenStreamPool(const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else
+		pool = clrngPoolOpen(&poolFormat, path, flags, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngLfsr113StreamPool*)pool;
+}
+
+clrngStatus clrngLfsr113DestroyStreamPool(clrngLfsr113StreamPool* pool)
+{
+	if (pool != NULL)
+		return clrngPoolDestroy((clrngPool*)pool);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngLfsr113SyncStreamPool(clrngLfsr113StreamPool* pool)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+
+	return clrngPoolSync((clrngPool*)pool);
+}
+
+size_t clrngLfsr113GetStreamPoolSize(const clrngLfsr113StreamPool* pool)
+{
+	return pool != NULL ? clrngPoolSize((const clrngPool*)pool) : 0;
+}
+
+clrngLfsr113Stream* clrngLfsr113GetPoolStream(clrngLfsr113StreamPool* pool, size_t index, clrngStatus* err)
+{
+	clrngStatus err_;
+	void* stream = NULL;
+
+	//Check params
+	if (pool == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	else
+		stream = clrngPoolStream((clrngPool*)pool, index, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngLfsr113Stream*)stream;
+}
+
+clrngStatus clrngLfsr113CopyPoolStreams(const clrngLfsr113StreamPool* pool, size_t first, size_t count, clrngLfsr113Stream* streams)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	return clrngPoolCopyStreams((const clrngPool*)pool, first, count, streams);
+}
+
+// position in a substream: baby steps with the recurrence, giant steps with
+// powers of the transition matrices
+static void stepState(void* state)
+{
+	clrngLfsr113NextState((clrngLfsr113StreamState*)state);
+}
+
+static const clrngPositionSearch positionSearch = {
+	sizeof(clrngLfsr113StreamState), sizeof(Leap), stepState, makeLeap, applyLeap
+};
+
+clrngStatus clrngLfsr113GetStreamPosition(const clrngLfsr113Stream* stream, cl_ulong* position)
+{
+	//Check params
+	if (stream == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (position == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): position cannot be NULL", __func__);
+
+	return clrngFindPosition(&positionSearch, &stream->substream, &stream->current, position, __func__);
+}
+
+/*! @brief Kernel of clrngLfsr113DeviceRandomU01Array_()
+ */
+static const char fillSource[] =
+	"#include <clRNG/lfsr113.clh>\n"
+	"__kernel void fillBufferU01(__global clrngLfsr113HostStream* streams, uint streamCount, uint numberCount, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	int gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	//Copy a stream from global stream array to local stream struct\n"
+	"	clrngLfsr113Stream local_stream;\n"
+	"	clrngLfsr113CopyOverStreamsFromGlobal(1, &local_stream, &streams[gid]);\n"
+	"	// wavefront-friendly ordering\n"
+	"	for (int i = 0; i < numberCount; i++)\n"
+	"		numbers[i * streamCount + gid] = clrngLfsr113RandomU01(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of clrngLfsr113DeviceFillU01_()
+ */
+static const char blockSource[] =
+	"#include <clRNG/lfsr113.clh>\n"
+	"typedef struct { uint cols[4][32]; } Leap;\n"
+	"__kernel void fillBlocksU01(__global clrngLfsr113HostStream* streams, uint streamCount, ulong perStream, uint blockSize,\n"
+	"	uint blocksPerStream, ulong numberCount, __global const Leap* leaps, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	uint s = gid / blocksPerStream;\n"
+	"	uint b = gid % blocksPerStream;\n"
+	"	ulong first = s * perStream + (ulong)b * blockSize;\n"
+	"	// the global size is padded, and the last streams can have fewer values\n"
+	"	if (s >= streamCount || first >= numberCount)\n"
+	"		return;\n"
+	"	ulong last = min(min(first + blockSize, (s + 1) * perStream), numberCount);\n"
+	"	clrngLfsr113Stream local_stream;\n"
+	"	clrngLfsr113CopyOverStreamsFromGlobal(1, &local_stream, &streams[s]);\n"
+	"	// jump to value b * blockSize of the stream\n"
+	"	for (uint i = 0; (b >> i) != 0; i++) {\n"
+	"		if ((b >> i) & 1) {\n"
+	"			for (uint j = 0; j < 4; j++) {\n"
+	"				uint v = local_stream.current.g[j];\n"
+	"				uint r = 0;\n"
+	"				for (uint k = 0; k < 32; k++)\n"
+	"					if ((v >> k) & 1)\n"
+	"						r ^= leaps[i].cols[j][k];\n"
+	"				local_stream.current.g[j] = r;\n"
+	"			}\n"
+	"		}\n"
+	"	}\n"
+	"	for (ulong n = first; n < last; n++)\n"
+	"		numbers[n] = clrngLfsr113RandomU01(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of clrngLfsr113DeviceAdvanceStreams()
+ */
+static const char advanceSource[] =
+	"#include <clRNG/lfsr113.clh>\n"
+	"typedef struct { uint cols[4][32]; } Jump;\n"
+	"__kernel void advanceStreams(__global clrngLfsr113HostStream* streams, uint streamCount, __constant Jump* jump) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	for (uint j = 0; j < 4; j++) {\n"
+	"		uint v = streams[gid].current.g[j];\n"
+	"		uint r = 0;\n"
+	"		for (uint k = 0; k < 32; k++)\n"
+	"			if ((v >> k) & 1)\n"
+	"				r ^= jump->cols[j][k];\n"
+	"		streams[gid].current.g[j] = r;\n"
+	"	}\n"
+	"}\n";
+
+static void makeBlockLeaps(cl_uint blockSize, size_t count, void* leaps)
+{
+	Leap* l = (Leap*)leaps;
+	makeLeap(blockSize, &l[0]);
+	for (size_t i = 1; i < count; i++)
+		for (size_t j = 0; j < 4; j++)
+			gf2MatMat(l[i - 1].cols[j], l[i - 1].cols[j], l[i].cols[j]);
+}
+
+const clrngDeviceKernels clrngLfsr113DeviceKernels = {
+	CLRNG_LFSR113,
+	sizeof(clrngLfsr113Stream),
+	fillSource,
+	blockSource,
+	sizeof(Leap),
+	makeBlockLeaps,
+	advanceSource
+};
+
 clrngStatus clrngLfsr113DeviceRandomU01Array_(size_t streamCount, cl_mem streams,
 	size_t numberCount, cl_mem outBuffer, cl_uint numQueuesAndEvents,
 	cl_command_queue* commQueues, cl_uint numWaitEvents,
@@ -379,95 +893,80 @@ clrngStatus clrngLfsr113DeviceRandomU01Array_(size_t streamCount, cl_mem streams
 	if (numQueuesAndEvents != 1)
 		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numQueuesAndEvents can only have the value '1'", __func__);
 
-	//***************************************************************************************
-	//Get the context
-	cl_int err;
-
-	cl_context ctx;
-	err = clGetCommandQueueInfo(commQueues[0], CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot retrieve context", __func__);
-
-	//Get the Device
-	cl_device_id dev;
-	err = clGetCommandQueueInfo(commQueues[0], CL_QUEUE_DEVICE, sizeof(cl_device_id), &dev, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot retrieve the device", __func__);
-
-	//create the program
-	const char *sources[4] = {
-	        singlePrecision ? "#define CLRNG_SINGLE_PRECISION\n" : "",
-		"#include <clRNG/lfsr113.clh>\n"
-		"__kernel void fillBufferU01(__global clrngLfsr113HostStream* streams, uint numberCount, __global ",
-		singlePrecision ? "float" : "double",
-		"* numbers) {\n"
-		"	int gid = get_global_id(0);\n"
-		"       int gsize = get_global_size(0);\n"
-		"	//Copy a stream from global stream array to local stream struct\n"
-		"	clrngLfsr113Stream local_stream;\n"
-		"	clrngLfsr113CopyOverStreamsFromGlobal(1, &local_stream, &streams[gid]);\n"
-		"	// wavefront-friendly ordering\n"
-		"	for (int i = 0; i < numberCount; i++)\n"
-		"		numbers[i * gsize + gid] = clrngLfsr113RandomU01(&local_stream);\n"
-		"}\n"
-	};
-	cl_program program = clCreateProgramWithSource(ctx, 4, sources, NULL, &err);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create program", __func__);
-
-	// construct compiler options
-	const char* includes = clrngGetLibraryDeviceIncludes(&err);
-	if (err != CLRNG_SUCCESS)
-		return (clrngStatus)err;
-
-	err = clBuildProgram(program, 0, NULL, includes, NULL, NULL);
-	if (err < 0) {
-		// Find size of log and print to std output
-		char *program_log;
-		size_t log_size;
-		clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, 0, NULL, &log_size);
-		program_log = (char *)malloc(log_size + 1);
-		program_log[log_size] = '\0';
-		clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, log_size + 1, program_log, NULL);
-		printf("clBuildProgram fails:\n%s\n", program_log);
-		free(program_log);
-		exit(1);
-	}
+	return clrngDeviceRandomArray(&clrngLfsr113DeviceKernels, streamCount, streams, numberCount, outBuffer,
+		commQueues[0], numWaitEvents, waitEvents, outEvents, singlePrecision, __func__);
+}
 
-	// Create the kernel
-	cl_kernel kernel = clCreateKernel(program, "fillBufferU01", &err);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create kernel", __func__);
+clrngStatus clrngLfsr113DeviceFillU01_(size_t streamCount, cl_mem streams,
+	size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision)
+{
+	//Check params
+	if (streamCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streamCount cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (numberCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount cannot be less than 1", __func__);
+	if (outBuffer == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
+
+	return clrngDeviceFillBlocks(&clrngLfsr113DeviceKernels, streamCount, streams, numberCount, outBuffer, blockSize,
+		queue, numWaitEvents, waitEvents, outEvent, singlePrecision, __func__);
+}
+
+clrngStatus clrngLfsr113DeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent)
+{
+	//Check params
+	if (count < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): count cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
 
-	//***************************************************************************************
-	//Random numbers generated by each work-item
-	cl_uint number_count_per_stream = numberCount / streamCount;
+	Leap jump;
+	makeJump(e, c, &jump);
 
-	//Work Group Size (local_size)
-	size_t local_size;
-	err = clGetDeviceInfo(dev, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(local_size), &local_size, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot read CL_DEVICE_MAX_WORK_GROUP_SIZE", __func__);
+	return clrngDeviceAdvance(&clrngLfsr113DeviceKernels, count, streams, &jump, sizeof(jump),
+		queue, numWaitEvents, waitEvents, outEvent, __func__);
+}
 
-	if (local_size > streamCount)
-		local_size = streamCount;
+static clrngStatus fillU01_cl_float(void* stream, size_t count, void* numbers)
+{
+	return clrngLfsr113RandomU01Array_cl_float((clrngLfsr113Stream*)stream, count, (cl_float*)numbers);
+}
+
+static clrngStatus fillU01_cl_double(void* stream, size_t count, void* numbers)
+{
+	return clrngLfsr113RandomU01Array_cl_double((clrngLfsr113Stream*)stream, count, (cl_double*)numbers);
+}
 
-	// Set kernel arguments for kernel and enqueue that kernel.
-	err = clSetKernelArg(kernel, 0, sizeof(streams), &streams);
-	err |= clSetKernelArg(kernel, 1, sizeof(number_count_per_stream), &number_count_per_stream);
-	err |= clSetKernelArg(kernel, 2, sizeof(outBuffer), &outBuffer);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create kernel arguments", __func__);
+clrngStatus clrngLfsr113ParallelFillU01_cl_float(size_t streamCount, clrngLfsr113Stream* streams, size_t numberCount, cl_float* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_float, sizeof(clrngLfsr113Stream), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
 
-	// Enqueue kernel
-	err = clEnqueueNDRangeKernel(commQueues[0], kernel, 1, NULL, &streamCount, &local_size, numWaitEvents, waitEvents, outEvents);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot enqueue kernel", __func__);
+clrngStatus clrngLfsr113ParallelFillU01_cl_double(size_t streamCount, clrngLfsr113Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_double, sizeof(clrngLfsr113Stream), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
 
-	clReleaseKernel(kernel);
-	clReleaseProgram(program);
+clrngStatus clrngLfsr113HostRandomU01Array_cl_float(size_t streamCount, const clrngLfsr113Stream* streams, size_t numberCount, cl_float* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_float, sizeof(clrngLfsr113Stream), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount);
+}
 
-	return(clrngStatus)EXIT_SUCCESS;
+clrngStatus clrngLfsr113HostRandomU01Array_cl_double(size_t streamCount, const clrngLfsr113Stream* streams, size_t numberCount, cl_double* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_double, sizeof(clrngLfsr113Stream), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount);
 }
 
 #if 0
@@ -0,0 +1,148 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file mapfile.c
+ * @brief Portable memory mapping of files
+ */
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+void* clrngMapFile(const char* path, clrngMapMode mode, size_t* size, clrngStatus* err)
+{
+	void* addr = NULL;
+	size_t size_ = (mode == CLRNG_MAP_CREATE) ? *size : 0;
+	*err = CLRNG_SUCCESS;
+
+#ifdef _WIN32
+	DWORD access = (mode == CLRNG_MAP_READ_ONLY) ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+	DWORD share = (mode == CLRNG_MAP_READ_ONLY) ? FILE_SHARE_READ : FILE_SHARE_READ | FILE_SHARE_WRITE;
+	DWORD disposition = (mode == CLRNG_MAP_CREATE) ? CREATE_ALWAYS : OPEN_EXISTING;
+	HANDLE file = CreateFileA(path, access, share, NULL, disposition, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "cannot open %s", path);
+		*size = 0;
+		return NULL;
+	}
+	if (mode == CLRNG_MAP_CREATE) {
+		// let the file system allocate only the pages that are written
+		DWORD returned;
+		DeviceIoControl(file, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &returned, NULL);
+	}
+	else {
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize))
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "cannot get the size of %s", path);
+		else
+			size_ = (size_t)fileSize.QuadPart;
+	}
+	if (*err == CLRNG_SUCCESS && size_ > 0) {
+		ULARGE_INTEGER mapSize;
+		mapSize.QuadPart = size_;
+		HANDLE mapping = CreateFileMappingA(file, NULL, (mode == CLRNG_MAP_READ_ONLY) ? PAGE_READONLY : PAGE_READWRITE,
+			mapSize.HighPart, mapSize.LowPart, NULL);
+		if (mapping != NULL) {
+			addr = MapViewOfFile(mapping, (mode == CLRNG_MAP_READ_ONLY) ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+		if (addr == NULL)
+			*err = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "cannot map %s", path);
+	}
+	CloseHandle(file);
+#else
+	int flags = (mode == CLRNG_MAP_READ_ONLY) ? O_RDONLY : (mode == CLRNG_MAP_CREATE) ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR;
+	int fd = open(path, flags, 0644);
+	if (fd < 0) {
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "cannot open %s", path);
+		*size = 0;
+		return NULL;
+	}
+	if (mode == CLRNG_MAP_CREATE) {
+		// the file is sparse until pages are written
+		if (ftruncate(fd, (off_t)size_) != 0)
+			*err = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "cannot resize %s", path);
+	}
+	else {
+		struct stat st;
+		if (fstat(fd, &st) != 0)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "cannot get the size of %s", path);
+		else
+			size_ = (size_t)st.st_size;
+	}
+	if (*err == CLRNG_SUCCESS && size_ > 0) {
+		int prot = (mode == CLRNG_MAP_READ_ONLY) ? PROT_READ : PROT_READ | PROT_WRITE;
+		void* map = mmap(NULL, size_, prot, MAP_SHARED, fd, 0);
+		if (map == MAP_FAILED)
+			*err = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "cannot map %s", path);
+		else
+			addr = map;
+	}
+	close(fd);
+#endif
+
+	*size = (*err == CLRNG_SUCCESS) ? size_ : 0;
+	return addr;
+}
+
+clrngStatus clrngSyncMappedFile(void* addr, size_t size)
+{
+	if (addr == NULL)
+		return CLRNG_SUCCESS;
+#ifdef _WIN32
+	if (!FlushViewOfFile(addr, size))
+#else
+	if (msync(addr, size, MS_SYNC) != 0)
+#endif
+		return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "cannot write mapped memory back to file");
+	return CLRNG_SUCCESS;
+}
+
+void clrngUnmapFile(const void* addr, size_t size)
+{
+	if (addr == NULL)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(addr);
+#else
+	munmap((void*)addr, size);
+#endif
+}
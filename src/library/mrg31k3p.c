@@ -34,6 +34,21 @@
 
 #include "private.h"
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// 64-bit hosts multiply 64-bit integers natively, which is faster than the
+// 32-bit-only products of MODULAR_MULT_31, even with four SSE2 lanes; define
+// CLRNG_MRG31K3P_MULT_31 to use the latter anyway
+#if SIZE_MAX <= UINT32_MAX && !defined(CLRNG_MRG31K3P_MULT_31)
+#define CLRNG_MRG31K3P_MULT_31
+#endif
+#ifdef CLRNG_MRG31K3P_MULT_31
+#if defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CLRNG_HAVE_SSE2
+#endif
+#endif
 
 #if defined ( WIN32 )
 #define __func__ __FUNCTION__
@@ -50,44 +65,131 @@ struct clrngMrg31k3pStreamCreator_ {
 
 #define MODULAR_NUMBER_TYPE cl_uint
 #define MODULAR_FIXED_SIZE 3
+#ifdef CLRNG_MRG31K3P_MULT_31
+#define MODULAR_MULT_31
+#endif
 #include "./modularHost.c.h"
 
+#ifdef CLRNG_HAVE_SSE2
+
+// The following functions are the SSE2 counterparts of those of modular.c.h
+// for MODULAR_MULT_31, on four 32-bit lanes.
+
+/*! @brief Lane-wise 32-bit products, which must not overflow
+ */
+static __m128i mullo32(__m128i a, __m128i b)
+{
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+	                          _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/*! @brief Lane-wise `x >= m ? x - m : x` for unsigned x
+ */
+static __m128i modReduce31x4(__m128i x, __m128i m)
+{
+	// SSE2 only compares signed integers: flip the sign bits
+	const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+	__m128i less = _mm_cmpgt_epi32(_mm_xor_si128(m, bias), _mm_xor_si128(x, bias));
+	return _mm_sub_epi32(x, _mm_andnot_si128(less, m));
+}
+
+static __m128i modFold31x4(__m128i x, __m128i m, __m128i c)
+{
+	x = _mm_add_epi32(_mm_and_si128(x, _mm_set1_epi32(0x7fffffff)), _mm_and_si128(c, _mm_srai_epi32(x, 31)));
+	return modReduce31x4(x, m);
+}
+
+static __m128i modShift31x4(__m128i x, __m128i m, __m128i c)
+{
+	x = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(x, _mm_set1_epi32(0x7fff)), 16), mullo32(c, _mm_srli_epi32(x, 15)));
+	return modFold31x4(x, m, c);
+}
+
+/*! @brief Lane-wise `(a*s + x) % m`, where \c ah and \c al are the 16-bit halves of \c a
+ */
+static __m128i modMult31x4(__m128i ah, __m128i al, __m128i s, __m128i x, __m128i m, __m128i c)
+{
+	__m128i sh = _mm_srli_epi32(s, 16);
+	__m128i sl = _mm_and_si128(s, _mm_set1_epi32(0xffff));
+	__m128i y = modShift31x4(modShift31x4(mullo32(ah, sh), m, c), m, c);
+	__m128i t = modFold31x4(_mm_add_epi32(mullo32(ah, sl), mullo32(al, sh)), m, c);
+	y = modReduce31x4(_mm_add_epi32(y, modShift31x4(t, m, c)), m);
+	y = modReduce31x4(_mm_add_epi32(y, modFold31x4(mullo32(al, sl), m, c)), m);
+	return modReduce31x4(_mm_add_epi32(y, x), m);
+}
+
+/*! @brief modMatVec() on the components \c g[0], ..., \c g[3] of four states
+ */
+static void modMatVec31x4(cl_uint A[3][3], cl_uint* g[4], cl_uint m)
+{
+	__m128i vm = _mm_set1_epi32((int)m);
+	__m128i vc = _mm_set1_epi32((int)(0x80000000u - m));
+	__m128i s[3], v[3];
+	for (size_t j = 0; j < 3; j++)
+		s[j] = _mm_set_epi32((int)g[3][j], (int)g[2][j], (int)g[1][j], (int)g[0][j]);
+	for (size_t i = 0; i < 3; i++) {
+		v[i] = _mm_setzero_si128();
+		for (size_t j = 0; j < 3; j++)
+			v[i] = modMult31x4(_mm_set1_epi32((int)(A[i][j] >> 16)), _mm_set1_epi32((int)(A[i][j] & 0xffff)),
+			                   s[j], v[i], vm, vc);
+	}
+	for (size_t i = 0; i < 3; i++) {
+		cl_uint x[4];
+		_mm_storeu_si128((__m128i*)x, v[i]);
+		for (size_t k = 0; k < 4; k++)
+			g[k][i] = x[k];
+	}
+}
+
+#endif
+
+static void jumpStates(cl_uint A1[3][3], cl_uint A2[3][3], size_t count, clrngMrg31k3pStreamState* states, size_t stride);
+
 // code that is common to host and device
 #include "../include/clRNG/private/mrg31k3p.c.h"
 
+/*! @brief Apply the jump matrices \c A1 and \c A2 to \c count states
+ *
+ *  The states are \c stride bytes apart, starting at \c states.  With SSE2,
+ *  four states are processed at a time.
+ */
+static void jumpStates(cl_uint A1[3][3], cl_uint A2[3][3], size_t count, clrngMrg31k3pStreamState* states, size_t stride)
+{
+	size_t i = 0;
+#define STATE(i) ((clrngMrg31k3pStreamState*)((char*)states + (i) * stride))
+#ifdef CLRNG_HAVE_SSE2
+	for (; i + 4 <= count; i += 4) {
+		cl_uint* g1[4] = { STATE(i)->g1, STATE(i + 1)->g1, STATE(i + 2)->g1, STATE(i + 3)->g1 };
+		cl_uint* g2[4] = { STATE(i)->g2, STATE(i + 1)->g2, STATE(i + 2)->g2, STATE(i + 3)->g2 };
+		modMatVec31x4(A1, g1, mrg31k3p_M1);
+		modMatVec31x4(A2, g2, mrg31k3p_M2);
+	}
+#endif
+	for (; i < count; i++) {
+		modMatVec(A1, STATE(i)->g1, STATE(i)->g1, mrg31k3p_M1);
+		modMatVec(A2, STATE(i)->g2, STATE(i)->g2, mrg31k3p_M2);
+	}
+#undef STATE
+}
 
 
 /*! @brief Matrices to advance to the next state
  */
-static cl_uint mrg31k3p_A1p0[3][3] = {
-    {0, 4194304, 129},
-    {1, 0, 0},
-    {0, 1, 0}
-};
+static cl_uint mrg31k3p_A1p0[3][3] = CLRNG_MRG31K3P_A1P0;
 
-static cl_uint mrg31k3p_A2p0[3][3] = {
-    {32768, 0, 32769},
-    {1, 0, 0},
-    {0, 1, 0}
-};
+static cl_uint mrg31k3p_A2p0[3][3] = CLRNG_MRG31K3P_A2P0;
 
 
 /*! @brief Inverse of mrg31k3p_A1p0 mod mrg31k3p_M1
  *
  *  Matrices to go back to the previous state.
  */
-static cl_uint invA1[3][3] = {
-	{ 0, 1, 0 },
-	{ 0, 0, 1 },
-	{ 1531538725, 0, 915561289 }
-};
+static cl_uint invA1[3][3] = CLRNG_MRG31K3P_INVA1;
 
 // inverse of mrg31k3p_A2p0 mod mrg31k3p_M2
-static cl_uint invA2[3][3] = {
-	{ 0, 1, 0 },
-	{ 0, 0, 1 },
-	{ 252696625, 252696624, 0 }
-};
+static cl_uint invA2[3][3] = CLRNG_MRG31K3P_INVA2;
 
 
 /*! @brief Default initial seed of the first stream
@@ -95,14 +197,8 @@ static cl_uint invA2[3][3] = {
 #define BASE_CREATOR_STATE { { 12345, 12345, 12345 }, { 12345, 12345, 12345 } }
 /*! @brief Jump matrices for \f$2^{134}\f$ steps forward
  */
-#define BASE_CREATOR_JUMP_MATRIX_1 { \
-        {1702500920, 1849582496, 1656874625}, \
-        { 828554832, 1702500920, 1512419905}, \
-        {1143731069,  828554832,  102237247} }
-#define BASE_CREATOR_JUMP_MATRIX_2 { \
-        { 796789021, 1464208080,  607337906}, \
-        {1241679051, 1431130166, 1464208080}, \
-        {1401213391, 1178684362, 1431130166} }
+#define BASE_CREATOR_JUMP_MATRIX_1 CLRNG_MRG31K3P_A1P134
+#define BASE_CREATOR_JUMP_MATRIX_2 CLRNG_MRG31K3P_A2P134
 
 /*! @brief Default stream creator (defaults to \f$2^{134}\f$ steps forward)
  *
@@ -141,11 +237,16 @@ static clrngStatus validateSeed(const clrngMrg31k3pStreamState* seed)
 }
 
 clrngMrg31k3pStreamCreator* clrngMrg31k3pCopyStreamCreator(const clrngMrg31k3pStreamCreator* creator, clrngStatus* err)
+{
+	return clrngMrg31k3pCopyStreamCreatorEx(creator, NULL, err);
+}
+
+clrngMrg31k3pStreamCreator* clrngMrg31k3pCopyStreamCreatorEx(const clrngMrg31k3pStreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 
 	// allocate creator
-	clrngMrg31k3pStreamCreator* newCreator = (clrngMrg31k3pStreamCreator*)malloc(sizeof(clrngMrg31k3pStreamCreator));
+	clrngMrg31k3pStreamCreator* newCreator = (clrngMrg31k3pStreamCreator*)clrngAlloc(sizeof(clrngMrg31k3pStreamCreator), 0, allocator);
 
 	if (newCreator == NULL)
 		// allocation failed
@@ -166,8 +267,7 @@ clrngMrg31k3pStreamCreator* clrngMrg31k3pCopyStreamCreator(const clrngMrg31k3pSt
 
 clrngStatus clrngMrg31k3pDestroyStreamCreator(clrngMrg31k3pStreamCreator* creator)
 {
-	if (creator != NULL)
-		free(creator);
+	clrngRelease(creator);
 	return CLRNG_SUCCESS;
 }
 
@@ -229,14 +329,24 @@ clrngStatus clrngMrg31k3pChangeStreamsSpacing(clrngMrg31k3pStreamCreator* creato
 }
 
 clrngMrg31k3pStream* clrngMrg31k3pAllocStreams(size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return clrngMrg31k3pAllocStreamsEx(count, 0, NULL, bufSize, err);
+}
+
+clrngMrg31k3pStream* clrngMrg31k3pAllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 	size_t bufSize_ = count * sizeof(clrngMrg31k3pStream);
+	clrngMrg31k3pStream* buf = NULL;
 
-	// allocate streams
-	clrngMrg31k3pStream* buf = (clrngMrg31k3pStream*)malloc(bufSize_);
+	//Check params
+	if (!clrngValidAlignment(alignment))
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): alignment must be a power of two", __func__);
+	else
+		// allocate streams
+		buf = (clrngMrg31k3pStream*)clrngAlloc(bufSize_, alignment, allocator);
 
-	if (buf == NULL) {
+	if (err_ == CLRNG_SUCCESS && buf == NULL) {
 		// allocation failed
 		err_ = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for streams", __func__);
 		bufSize_ = 0;
@@ -255,8 +365,7 @@ clrngMrg31k3pStream* clrngMrg31k3pAllocStreams(size_t count, size_t* bufSize, cl
 
 clrngStatus clrngMrg31k3pDestroyStreams(clrngMrg31k3pStream* streams)
 {
-	if (streams != NULL)
-		free(streams);
+	clrngRelease(streams);
 	return CLRNG_SUCCESS;
 }
 
@@ -272,6 +381,9 @@ static clrngStatus mrg31k3pCreateStream(clrngMrg31k3pStreamCreator* creator, clr
 
 	// initialize stream
 	buffer->current = buffer->initial = buffer->substream = creator->nextState;
+#ifdef CLRNG_INSTRUMENT
+	buffer->draws = 0;
+#endif
 
 	// advance next state in stream creator
 	modMatVec(creator->nuA1, creator->nextState.g1, creator->nextState.g1, mrg31k3p_M1);
@@ -296,10 +408,15 @@ clrngStatus clrngMrg31k3pCreateOverStreams(clrngMrg31k3pStreamCreator* creator,
 }
 
 clrngMrg31k3pStream* clrngMrg31k3pCreateStreams(clrngMrg31k3pStreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return clrngMrg31k3pCreateStreamsEx(creator, count, 0, NULL, bufSize, err);
+}
+
+clrngMrg31k3pStream* clrngMrg31k3pCreateStreamsEx(clrngMrg31k3pStreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_;
 	size_t bufSize_;
-	clrngMrg31k3pStream* streams = clrngMrg31k3pAllocStreams(count, &bufSize_, &err_);
+	clrngMrg31k3pStream* streams = clrngMrg31k3pAllocStreamsEx(count, alignment, allocator, &bufSize_, &err_);
 
 	if (err_ == CLRNG_SUCCESS)
 		err_ = clrngMrg31k3pCreateOverStreams(creator, count, streams);
@@ -314,6 +431,11 @@ clrngMrg31k3pStream* clrngMrg31k3pCreateStreams(clrngMrg31k3pStreamCreator* crea
 }
 
 clrngMrg31k3pStream* clrngMrg31k3pCopyStreams(size_t count, const clrngMrg31k3pStream* streams, clrngStatus* err)
+{
+	return clrngMrg31k3pCopyStreamsEx(count, streams, 0, NULL, err);
+}
+
+clrngMrg31k3pStream* clrngMrg31k3pCopyStreamsEx(size_t count, const clrngMrg31k3pStream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 	clrngMrg31k3pStream* dest = NULL;
@@ -323,7 +445,7 @@ clrngMrg31k3pStream* clrngMrg31k3pCopyStreams(size_t count, const clrngMrg31k3pS
 		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
 
 	if (err_ == CLRNG_SUCCESS)
-		dest = clrngMrg31k3pAllocStreams(count, NULL, &err_);
+		dest = clrngMrg31k3pAllocStreamsEx(count, alignment, allocator, NULL, &err_);
 
 	if (err_ == CLRNG_SUCCESS)
 		err_ = clrngMrg31k3pCopyOverStreams(count, dest, streams);
@@ -334,6 +456,34 @@ clrngMrg31k3pStream* clrngMrg31k3pCopyStreams(size_t count, const clrngMrg31k3pS
 	return dest;
 }
 
+clrngStatus clrngMrg31k3pGetStreamStates(size_t count, const clrngMrg31k3pStream* streams, clrngMrg31k3pStreamState* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		states[i] = streams[i].current;
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngMrg31k3pSetStreamStates(size_t count, clrngMrg31k3pStream* streams, const clrngMrg31k3pStreamState* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		streams[i].current = states[i];
+
+	return CLRNG_SUCCESS;
+}
+
 clrngMrg31k3pStream* clrngMrg31k3pMakeSubstreams(clrngMrg31k3pStream* stream, size_t count, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_;
@@ -352,15 +502,10 @@ clrngMrg31k3pStream* clrngMrg31k3pMakeSubstreams(clrngMrg31k3pStream* stream, si
 	return substreams;
 }
 
-clrngStatus clrngMrg31k3pAdvanceStreams(size_t count, clrngMrg31k3pStream* streams, cl_int e, cl_int c)
+// matrices of the jump of clrngMrg31k3pAdvanceStreams()
+static void makeAdvanceJump(cl_int e, cl_int c, cl_uint C1[3][3], cl_uint C2[3][3])
 {
-
-	//Check params
-	if (streams == NULL)
-		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
-
-	//Advance Stream
-	cl_uint B1[3][3], C1[3][3], B2[3][3], C2[3][3];
+	cl_uint B1[3][3], B2[3][3];
 
 	// if e == 0, do not add 2^0; just behave as in docs
 	if (e > 0) {
@@ -385,10 +530,44 @@ clrngStatus clrngMrg31k3pAdvanceStreams(size_t count, clrngMrg31k3pStream* strea
 		modMatMat(B1, C1, C1, mrg31k3p_M1);
 		modMatMat(B2, C2, C2, mrg31k3p_M2);
 	}
+}
 
-	for (size_t i = 0; i < count; i++) {
-		modMatVec(C1, streams[i].current.g1, streams[i].current.g1, mrg31k3p_M1);
-		modMatVec(C2, streams[i].current.g2, streams[i].current.g2, mrg31k3p_M2);
+clrngStatus clrngMrg31k3pAdvanceStreams(size_t count, clrngMrg31k3pStream* streams, cl_int e, cl_int c)
+{
+	//Check params
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	//Advance Stream
+	cl_uint C1[3][3], C2[3][3];
+	makeAdvanceJump(e, c, C1, C2);
+
+	jumpStates(C1, C2, count, &streams[0].current, sizeof(clrngMrg31k3pStream));
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngMrg31k3pRandomU01Array_53(clrngMrg31k3pStream* stream, size_t count, cl_double* buffer)
+{
+	//Check params
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+
+	_CLRNG_COUNT_DRAWS(stream, 2 * count);
+
+	// Each step of the MRG31k3p recurrence depends on the previous state:
+	// produce the outputs in blocks, then convert each block at once.
+	cl_uint hi[CLRNG_U01_53_BLOCK];
+	cl_uint lo[CLRNG_U01_53_BLOCK];
+	for (size_t i = 0; i < count; i += CLRNG_U01_53_BLOCK) {
+		size_t n = count - i < CLRNG_U01_53_BLOCK ? count - i : CLRNG_U01_53_BLOCK;
+		for (size_t k = 0; k < n; k++) {
+			hi[k] = (cl_uint)clrngMrg31k3pNextState(&stream->current);
+			lo[k] = (cl_uint)clrngMrg31k3pNextState(&stream->current);
+		}
+		clrngCombineU01_53(n, hi, lo, 0.0, mrg31k3p_NORM_cl_double, buffer + i);
 	}
 
 	return CLRNG_SUCCESS;
@@ -424,6 +603,318 @@ clrngStatus clrngMrg31k3pWriteStreamInfo(const clrngMrg31k3pStream* stream, FILE
 	return CLRNG_SUCCESS;
 }
 
+// serialized state: g1 followed by g2
+static void packState(const void* state, cl_uint* words)
+{
+	const clrngMrg31k3pStreamState* s = (const clrngMrg31k3pStreamState*)state;
+	for (size_t i = 0; i < 3; i++) {
+		words[i]     = s->g1[i];
+		words[3 + i] = s->g2[i];
+	}
+}
+
+static clrngStatus unpackState(const cl_uint* words, void* state)
+{
+	clrngMrg31k3pStreamState* s = (clrngMrg31k3pStreamState*)state;
+	for (size_t i = 0; i < 3; i++) {
+		s->g1[i] = words[i];
+		s->g2[i] = words[3 + i];
+	}
+	return validateSeed(s);
+}
+
+static void* allocSerialStreams(size_t count, clrngStatus* err)
+{
+	return clrngMrg31k3pAllocStreams(count, NULL, err);
+}
+
+static const clrngSerialFormat serialFormat = {
+	CLRNG_SERIAL_MRG31K3P, 6, 6, sizeof(clrngMrg31k3pStreamState), sizeof(clrngMrg31k3pStream), packState, unpackState, allocSerialStreams
+};
+
+clrngStatus clrngMrg31k3pSerializeStreams(size_t count, const clrngMrg31k3pStream* streams, cl_uint flags, void* buffer, size_t* bufSize)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (bufSize == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): bufSize cannot be NULL", __func__);
+
+	return clrngSerialWrite(&serialFormat, count, streams, flags, buffer, bufSize);
+}
+
+clrngStatus clrngMrg31k3pWriteStreams(size_t count, const clrngMrg31k3pStream* streams, cl_uint flags, FILE *file)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (file == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): file cannot be NULL", __func__);
+
+	return clrngSerialWriteFile(&serialFormat, count, streams, flags, file);
+}
+
+clrngMrg31k3pStream* clrngMrg31k3pDeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (buffer == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (clrngMrg31k3pStream*)clrngSerialRead(&serialFormat, buffer, bufSize, count, err);
+}
+
+clrngMrg31k3pStream* clrngMrg31k3pReadStreams(const char* path, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (path == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (clrngMrg31k3pStream*)clrngSerialReadFile(&serialFormat, path, count, err);
+}
+
+// jump between successive streams of a pool: the nuA1 and nuA2 matrices of the creator
+typedef struct {
+	cl_uint a1[3][3];
+	cl_uint a2[3][3];
+} PoolJump;
+
+static void composePoolJumps(const void* a, const void* b, void* result)
+{
+	PoolJump* x = (PoolJump*)a;
+	PoolJump* y = (PoolJump*)b;
+	PoolJump* z = (PoolJump*)result;
+	modMatMat(y->a1, x->a1, z->a1, mrg31k3p_M1);
+	modMatMat(y->a2, x->a2, z->a2, mrg31k3p_M2);
+}
+
+static void applyPoolJump(const void* jump, void* state)
+{
+	PoolJump* j = (PoolJump*)jump;
+	clrngMrg31k3pStreamState* s = (clrngMrg31k3pStreamState*)state;
+	modMatVec(j->a1, s->g1, s->g1, mrg31k3p_M1);
+	modMatVec(j->a2, s->g2, s->g2, mrg31k3p_M2);
+}
+
+static const clrngPoolFormat poolFormat = {
+	CLRNG_SERIAL_MRG31K3P, sizeof(clrngMrg31k3pStreamState), sizeof(clrngMrg31k3pStream), sizeof(PoolJump), composePoolJumps, applyPoolJump
+};
+
+clrngMrg31k3pStreamPool* clrngMrg31k3pCreateStreamPool(clrngMrg31k3pStreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else {
+		// use default creator if not given
+		if (creator == NULL)
+			creator = &defaultStreamCreator;
+
+		PoolJump jump;
+		memcpy(jump.a1, creator->nuA1, sizeof(jump.a1));
+		memcpy(jump.a2, creator->nuA2, sizeof(jump.a2));
+		pool = clrngPoolCreate(&poolFormat, &creator->nextState, &jump, count, path, flags, &err_);
+
+		// skip the streams of the pool, as clrngCreateStreams() would
+		if (pool != NULL)
+			clrngPoolJump(pool, (cl_ulong)count, &creator->nextState);
+	}
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngMrg31k3pStreamPool*)pool;
+}
+
+clrngMrg31k3pStreamPool* clrngMrg31k3pOpenStreamPool(const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else
+		pool = clrngPoolOpen(&poolFormat, path, flags, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngMrg31k3pStreamPool*)pool;
+}
+
+clrngStatus clrngMrg31k3pDestroyStreamPool(clrngMrg31k3pStreamPool* pool)
+{
+	if (pool != NULL)
+		return clrngPoolDestroy((clrngPool*)pool);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngMrg31k3pSyncStreamPool(clrngMrg31k3pStreamPool* pool)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+
+	return clrngPoolSync((clrngPool*)pool);
+}
+
+size_t clrngMrg31k3pGetStreamPoolSize(const clrngMrg31k3pStreamPool* pool)
+{
+	return pool != NULL ? clrngPoolSize((const clrngPool*)pool) : 0;
+}
+
+clrngMrg31k3pStream* clrngMrg31k3pGetPoolStream(clrngMrg31k3pStreamPool* pool, size_t index, clrngStatus* err)
+{
+	clrngStatus err_;
+	void* stream = NULL;
+
+	//Check params
+	if (pool == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	else
+		stream = clrngPoolStream((clrngPool*)pool, index, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngMrg31k3pStream*)stream;
+}
+
+clrngStatus clrngMrg31k3pCopyPoolStreams(const clrngMrg31k3pStreamPool* pool, size_t first, size_t count, clrngMrg31k3pStream* streams)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	return clrngPoolCopyStreams((const clrngPool*)pool, first, count, streams);
+}
+
+// position in a substream: baby steps with the recurrence, giant steps with powers of its matrices
+static void stepState(void* state)
+{
+	clrngMrg31k3pNextState((clrngMrg31k3pStreamState*)state);
+}
+
+static void makeLeap(cl_uint steps, void* leap)
+{
+	PoolJump* j = (PoolJump*)leap;
+	modMatPow(mrg31k3p_A1p0, j->a1, mrg31k3p_M1, steps);
+	modMatPow(mrg31k3p_A2p0, j->a2, mrg31k3p_M2, steps);
+}
+
+static const clrngPositionSearch positionSearch = {
+	sizeof(clrngMrg31k3pStreamState), sizeof(PoolJump), stepState, makeLeap, applyPoolJump
+};
+
+clrngStatus clrngMrg31k3pGetStreamPosition(const clrngMrg31k3pStream* stream, cl_ulong* position)
+{
+	//Check params
+	if (stream == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (position == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): position cannot be NULL", __func__);
+
+	return clrngFindPosition(&positionSearch, &stream->substream, &stream->current, position, __func__);
+}
+
+/*! @brief Kernel of clrngMrg31k3pDeviceRandomU01Array_()
+ */
+static const char fillSource[] =
+	"#include <clRNG/mrg31k3p.clh>\n"
+	"__kernel void fillBufferU01(__global clrngMrg31k3pHostStream* streams, uint streamCount, uint numberCount, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	int gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	//Copy a stream from global stream array to local stream struct\n"
+	"	clrngMrg31k3pStream local_stream;\n"
+	"	clrngMrg31k3pCopyOverStreamsFromGlobal(1, &local_stream, &streams[gid]);\n"
+	"	// wavefront-friendly ordering\n"
+	"	for (int i = 0; i < numberCount; i++)\n"
+	"		numbers[i * streamCount + gid] = clrngMrg31k3pRandomU01(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of clrngMrg31k3pDeviceFillU01_()
+ */
+static const char blockSource[] =
+	"#define CLRNG_ENABLE_SUBSTREAMS\n"
+	"#include <clRNG/mrg31k3p.clh>\n"
+	"typedef struct { uint a1[3][3]; uint a2[3][3]; } Leap;\n"
+	"__kernel void fillBlocksU01(__global clrngMrg31k3pHostStream* streams, uint streamCount, ulong perStream, uint blockSize,\n"
+	"	uint blocksPerStream, ulong numberCount, __global const Leap* leaps, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	uint s = gid / blocksPerStream;\n"
+	"	uint b = gid % blocksPerStream;\n"
+	"	ulong first = s * perStream + (ulong)b * blockSize;\n"
+	"	// the global size is padded, and the last streams can have fewer values\n"
+	"	if (s >= streamCount || first >= numberCount)\n"
+	"		return;\n"
+	"	ulong last = min(min(first + blockSize, (s + 1) * perStream), numberCount);\n"
+	"	clrngMrg31k3pStream local_stream;\n"
+	"	clrngMrg31k3pCopyOverStreamsFromGlobal(1, &local_stream, &streams[s]);\n"
+	"	// jump to value b * blockSize of the stream\n"
+	"	for (uint i = 0; (b >> i) != 0; i++) {\n"
+	"		if ((b >> i) & 1) {\n"
+	"			Leap leap = leaps[i];\n"
+	"			modMatVec(leap.a1, local_stream.current.g1, local_stream.current.g1, mrg31k3p_M1);\n"
+	"			modMatVec(leap.a2, local_stream.current.g2, local_stream.current.g2, mrg31k3p_M2);\n"
+	"		}\n"
+	"	}\n"
+	"	for (ulong n = first; n < last; n++)\n"
+	"		numbers[n] = clrngMrg31k3pRandomU01(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of clrngMrg31k3pDeviceAdvanceStreams()
+ */
+static const char advanceSource[] =
+	"#define CLRNG_ENABLE_SUBSTREAMS\n"
+	"#include <clRNG/mrg31k3p.clh>\n"
+	"typedef struct { uint a1[3][3]; uint a2[3][3]; } Jump;\n"
+	"__kernel void advanceStreams(__global clrngMrg31k3pHostStream* streams, uint streamCount, __constant Jump* jumps) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	Jump jump = *jumps;\n"
+	"	clrngMrg31k3pStreamState state = streams[gid].current;\n"
+	"	modMatVec(jump.a1, state.g1, state.g1, mrg31k3p_M1);\n"
+	"	modMatVec(jump.a2, state.g2, state.g2, mrg31k3p_M2);\n"
+	"	streams[gid].current = state;\n"
+	"}\n";
+
+static void makeBlockLeaps(cl_uint blockSize, size_t count, void* leaps)
+{
+	PoolJump* j = (PoolJump*)leaps;
+	makeLeap(blockSize, &j[0]);
+	for (size_t i = 1; i < count; i++)
+		composePoolJumps(&j[i - 1], &j[i - 1], &j[i]);
+}
+
+const clrngDeviceKernels clrngMrg31k3pDeviceKernels = {
+	CLRNG_MRG31K3P,
+	sizeof(clrngMrg31k3pStream),
+	fillSource,
+	blockSource,
+	sizeof(PoolJump),
+	makeBlockLeaps,
+	advanceSource
+};
+
 clrngStatus clrngMrg31k3pDeviceRandomU01Array_(size_t streamCount, cl_mem streams,
 	size_t numberCount, cl_mem outBuffer, cl_uint numQueuesAndEvents,
 	cl_command_queue* commQueues, cl_uint numWaitEvents,
@@ -445,95 +936,80 @@ clrngStatus clrngMrg31k3pDeviceRandomU01Array_(size_t streamCount, cl_mem stream
 	if (numQueuesAndEvents != 1)
 		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numQueuesAndEvents can only have the value '1'", __func__);
 
-	//***************************************************************************************
-	//Get the context
-	cl_int err;
-	
-	cl_context ctx;
-	err = clGetCommandQueueInfo(commQueues[0], CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot retrieve context", __func__);
-
-	//Get the Device
-	cl_device_id dev;
-	err = clGetCommandQueueInfo(commQueues[0], CL_QUEUE_DEVICE, sizeof(cl_device_id), &dev, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot retrieve the device", __func__);
-
-	//create the program
-	const char *sources[4] = {
-	        singlePrecision ? "#define CLRNG_SINGLE_PRECISION\n" : "",
-		"#include <clRNG/mrg31k3p.clh>\n"
-		"__kernel void fillBufferU01(__global clrngMrg31k3pHostStream* streams, uint numberCount, __global ",
-		singlePrecision ? "float" : "double",
-		"* numbers) {\n"
-		"	int gid = get_global_id(0);\n"
-		"       int gsize = get_global_size(0);\n"
-		"	//Copy a stream from global stream array to local stream struct\n"
-		"	clrngMrg31k3pStream local_stream;\n"
-		"	clrngMrg31k3pCopyOverStreamsFromGlobal(1, &local_stream, &streams[gid]);\n"
-		"	// wavefront-friendly ordering\n"
-		"	for (int i = 0; i < numberCount; i++)\n"
-		"		numbers[i * gsize + gid] = clrngMrg31k3pRandomU01(&local_stream);\n"
-		"}\n"
-	};
-	cl_program program = clCreateProgramWithSource(ctx, 4, sources, NULL, &err);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create program", __func__);
-
-	// construct compiler options
-	const char* includes = clrngGetLibraryDeviceIncludes(&err);
-	if (err != CLRNG_SUCCESS)
-		return (clrngStatus)err;
-
-	err = clBuildProgram(program, 0, NULL, includes, NULL, NULL);  
-	if (err < 0) {
-		// Find size of log and print to std output
-		char *program_log;
-		size_t log_size;
-		clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, 0, NULL, &log_size);
-		program_log = (char *)malloc(log_size + 1);
-		program_log[log_size] = '\0';
-		clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, log_size + 1, program_log, NULL);
-		printf("clBuildProgram fails:\n%s\n", program_log);
-		free(program_log);
-		exit(1);
-	}
+	return clrngDeviceRandomArray(&clrngMrg31k3pDeviceKernels, streamCount, streams, numberCount, outBuffer,
+		commQueues[0], numWaitEvents, waitEvents, outEvents, singlePrecision, __func__);
+}
 
-	// Create the kernel
-	cl_kernel kernel = clCreateKernel(program, "fillBufferU01", &err);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create kernel", __func__);
-	
-	//***************************************************************************************
-	//Random numbers generated by each work-item
-	cl_uint number_count_per_stream = numberCount / streamCount;
-
-	//Work Group Size (local_size)
-	size_t local_size;
-	err = clGetDeviceInfo(dev, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(local_size), &local_size, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot read CL_DEVICE_MAX_WORK_GROUP_SIZE", __func__);
-
-	if (local_size > streamCount)
-		local_size = streamCount;
-
-	// Set kernel arguments for kernel and enqueue that kernel.
-	err =  clSetKernelArg(kernel, 0, sizeof(streams),		     &streams);
-	err |= clSetKernelArg(kernel, 1, sizeof(number_count_per_stream),    &number_count_per_stream);
-	err |= clSetKernelArg(kernel, 2, sizeof(outBuffer),		     &outBuffer);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create kernel arguments", __func__);
-
-	// Enqueue kernel
-	err = clEnqueueNDRangeKernel(commQueues[0], kernel, 1, NULL, &streamCount, &local_size, numWaitEvents, waitEvents, outEvents);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot enqueue kernel", __func__);
-
-	clReleaseKernel(kernel);
-	clReleaseProgram(program);
-
-	return(clrngStatus)EXIT_SUCCESS;
+clrngStatus clrngMrg31k3pDeviceFillU01_(size_t streamCount, cl_mem streams,
+	size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision)
+{
+	//Check params
+	if (streamCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streamCount cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (numberCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount cannot be less than 1", __func__);
+	if (outBuffer == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
+
+	return clrngDeviceFillBlocks(&clrngMrg31k3pDeviceKernels, streamCount, streams, numberCount, outBuffer, blockSize,
+		queue, numWaitEvents, waitEvents, outEvent, singlePrecision, __func__);
+}
+
+clrngStatus clrngMrg31k3pDeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent)
+{
+	//Check params
+	if (count < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): count cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
+
+	PoolJump jump;
+	makeAdvanceJump(e, c, jump.a1, jump.a2);
+
+	return clrngDeviceAdvance(&clrngMrg31k3pDeviceKernels, count, streams, &jump, sizeof(jump),
+		queue, numWaitEvents, waitEvents, outEvent, __func__);
+}
+
+static clrngStatus fillU01_cl_float(void* stream, size_t count, void* numbers)
+{
+	return clrngMrg31k3pRandomU01Array_cl_float((clrngMrg31k3pStream*)stream, count, (cl_float*)numbers);
+}
+
+static clrngStatus fillU01_cl_double(void* stream, size_t count, void* numbers)
+{
+	return clrngMrg31k3pRandomU01Array_cl_double((clrngMrg31k3pStream*)stream, count, (cl_double*)numbers);
+}
+
+clrngStatus clrngMrg31k3pParallelFillU01_cl_float(size_t streamCount, clrngMrg31k3pStream* streams, size_t numberCount, cl_float* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_float, sizeof(clrngMrg31k3pStream), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
+
+clrngStatus clrngMrg31k3pParallelFillU01_cl_double(size_t streamCount, clrngMrg31k3pStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_double, sizeof(clrngMrg31k3pStream), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
+
+clrngStatus clrngMrg31k3pHostRandomU01Array_cl_float(size_t streamCount, const clrngMrg31k3pStream* streams, size_t numberCount, cl_float* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_float, sizeof(clrngMrg31k3pStream), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount);
+}
+
+clrngStatus clrngMrg31k3pHostRandomU01Array_cl_double(size_t streamCount, const clrngMrg31k3pStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_double, sizeof(clrngMrg31k3pStream), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount);
 }
 
 #if 0
@@ -34,6 +34,7 @@
 
 #include "private.h"
 #include <stdlib.h>
+#include <string.h>
 
 #if defined ( WIN32 )
 #define __func__ __FUNCTION__
@@ -59,35 +60,19 @@ struct clrngMrg32k3aStreamCreator_ {
 
 /*! @brief Matrices to advance to the next state
 */
-static cl_ulong Mrg32k3a_A1p0[3][3] = {
-	{ 0, 1, 0 },
-	{ 0, 0, 1 },
-	{ 4294156359, 1403580, 0 }
-};
+static cl_ulong Mrg32k3a_A1p0[3][3] = CLRNG_MRG32K3A_A1P0;
 
-static cl_ulong Mrg32k3a_A2p0[3][3] = {
-	{ 0, 1, 0 },
-	{ 0, 0, 1 },
-	{ 4293573854, 0, 527612 }
-};
+static cl_ulong Mrg32k3a_A2p0[3][3] = CLRNG_MRG32K3A_A2P0;
 
 
 /*! @brief Inverse of Mrg32k3a_A1p0 mod Mrg32k3a_M1
 *
 *  Matrices to go back to the previous state.
 */
-static cl_ulong invA1[3][3] = {
-	{ 184888585, 0, 1945170933 },
-	{ 1, 0, 0 },
-	{ 0, 1, 0 }
-};
+static cl_ulong invA1[3][3] = CLRNG_MRG32K3A_INVA1;
 
 // inverse of Mrg32k3a_A2p0 mod Mrg32k3a_M1
-static cl_ulong invA2[3][3] = {
-	{ 0, 360363334, 4225571728 },
-	{ 1, 0, 0 },
-	{ 0, 1, 0 }
-};
+static cl_ulong invA2[3][3] = CLRNG_MRG32K3A_INVA2;
 
 
 /*! @brief Default initial seed of the first stream
@@ -95,20 +80,14 @@ static cl_ulong invA2[3][3] = {
 #define BASE_CREATOR_STATE { { 12345, 12345, 12345 }, { 12345, 12345, 12345 } }
 /*! @brief Jump matrices for \f$2^{127}\f$ steps forward
 */
-#define BASE_CREATOR_JUMP_MATRIX_1 { \
-        {2427906178, 3580155704, 949770784}, \
-        { 226153695, 1230515664, 3580155704}, \
-        {1988835001, 986791581, 1230515664} }
-#define BASE_CREATOR_JUMP_MATRIX_2 { \
-        { 1464411153, 277697599, 1610723613}, \
-        {32183930, 1464411153, 1022607788}, \
-        {2824425944, 32183930, 2093834863} }
-
-/*! @brief Default stream creator (defaults to \f$2^{134}\f$ steps forward)
+#define BASE_CREATOR_JUMP_MATRIX_1 CLRNG_MRG32K3A_A1P127
+#define BASE_CREATOR_JUMP_MATRIX_2 CLRNG_MRG32K3A_A2P127
+
+/*! @brief Default stream creator (defaults to \f$2^{127}\f$ steps forward)
 *
 *  Contains the default seed and the transition matrices to jump \f$\nu\f$ steps forward;
 *  adjacent streams are spaced nu steps apart.
-*  The default is \f$nu = 2^{134}\f$.
+*  The default is \f$nu = 2^{127}\f$.
 *  The default seed is \f$(12345,12345,12345,12345,12345,12345)\f$.
 */
 static clrngMrg32k3aStreamCreator defaultStreamCreator = {
@@ -141,11 +120,16 @@ static clrngStatus validateSeed(const clrngMrg32k3aStreamState* seed)
 }
 
 clrngMrg32k3aStreamCreator* clrngMrg32k3aCopyStreamCreator(const clrngMrg32k3aStreamCreator* creator, clrngStatus* err)
+{
+	return clrngMrg32k3aCopyStreamCreatorEx(creator, NULL, err);
+}
+
+clrngMrg32k3aStreamCreator* clrngMrg32k3aCopyStreamCreatorEx(const clrngMrg32k3aStreamCreator* creator, const clrngAllocator* allocator, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 
 	// allocate creator
-	clrngMrg32k3aStreamCreator* newCreator = (clrngMrg32k3aStreamCreator*)malloc(sizeof(clrngMrg32k3aStreamCreator));
+	clrngMrg32k3aStreamCreator* newCreator = (clrngMrg32k3aStreamCreator*)clrngAlloc(sizeof(clrngMrg32k3aStreamCreator), 0, allocator);
 
 	if (newCreator == NULL)
 		// allocation failed
@@ -166,8 +150,7 @@ clrngMrg32k3aStreamCreator* clrngMrg32k3aCopyStreamCreator(const clrngMrg32k3aSt
 
 clrngStatus clrngMrg32k3aDestroyStreamCreator(clrngMrg32k3aStreamCreator* creator)
 {
-	if (creator != NULL)
-		free(creator);
+	clrngRelease(creator);
 	return CLRNG_SUCCESS;
 }
 
@@ -229,14 +212,24 @@ clrngStatus clrngMrg32k3aChangeStreamsSpacing(clrngMrg32k3aStreamCreator* creato
 }
 
 clrngMrg32k3aStream* clrngMrg32k3aAllocStreams(size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return clrngMrg32k3aAllocStreamsEx(count, 0, NULL, bufSize, err);
+}
+
+clrngMrg32k3aStream* clrngMrg32k3aAllocStreamsEx(size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 	size_t bufSize_ = count * sizeof(clrngMrg32k3aStream);
+	clrngMrg32k3aStream* buf = NULL;
 
-	// allocate streams
-	clrngMrg32k3aStream* buf = (clrngMrg32k3aStream*)malloc(bufSize_);
+	//Check params
+	if (!clrngValidAlignment(alignment))
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): alignment must be a power of two", __func__);
+	else
+		// allocate streams
+		buf = (clrngMrg32k3aStream*)clrngAlloc(bufSize_, alignment, allocator);
 
-	if (buf == NULL) {
+	if (err_ == CLRNG_SUCCESS && buf == NULL) {
 		// allocation failed
 		err_ = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for streams", __func__);
 		bufSize_ = 0;
@@ -255,8 +248,7 @@ clrngMrg32k3aStream* clrngMrg32k3aAllocStreams(size_t count, size_t* bufSize, cl
 
 clrngStatus clrngMrg32k3aDestroyStreams(clrngMrg32k3aStream* streams)
 {
-	if (streams != NULL)
-		free(streams);
+	clrngRelease(streams);
 	return CLRNG_SUCCESS;
 }
 
@@ -272,6 +264,9 @@ static clrngStatus Mrg32k3aCreateStream(clrngMrg32k3aStreamCreator* creator, clr
 
 	// initialize stream
 	buffer->current = buffer->initial = buffer->substream = creator->nextState;
+#ifdef CLRNG_INSTRUMENT
+	buffer->draws = 0;
+#endif
 
 	// advance next state in stream creator
 	modMatVec(creator->nuA1, creator->nextState.g1, creator->nextState.g1, Mrg32k3a_M1);
@@ -296,10 +291,15 @@ clrngStatus clrngMrg32k3aCreateOverStreams(clrngMrg32k3aStreamCreator* creator,
 }
 
 clrngMrg32k3aStream* clrngMrg32k3aCreateStreams(clrngMrg32k3aStreamCreator* creator, size_t count, size_t* bufSize, clrngStatus* err)
+{
+	return clrngMrg32k3aCreateStreamsEx(creator, count, 0, NULL, bufSize, err);
+}
+
+clrngMrg32k3aStream* clrngMrg32k3aCreateStreamsEx(clrngMrg32k3aStreamCreator* creator, size_t count, size_t alignment, const clrngAllocator* allocator, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_;
 	size_t bufSize_;
-	clrngMrg32k3aStream* streams = clrngMrg32k3aAllocStreams(count, &bufSize_, &err_);
+	clrngMrg32k3aStream* streams = clrngMrg32k3aAllocStreamsEx(count, alignment, allocator, &bufSize_, &err_);
 
 	if (err_ == CLRNG_SUCCESS)
 		err_ = clrngMrg32k3aCreateOverStreams(creator, count, streams);
@@ -314,6 +314,11 @@ clrngMrg32k3aStream* clrngMrg32k3aCreateStreams(clrngMrg32k3aStreamCreator* crea
 }
 
 clrngMrg32k3aStream* clrngMrg32k3aCopyStreams(size_t count, const clrngMrg32k3aStream* streams, clrngStatus* err)
+{
+	return clrngMrg32k3aCopyStreamsEx(count, streams, 0, NULL, err);
+}
+
+clrngMrg32k3aStream* clrngMrg32k3aCopyStreamsEx(size_t count, const clrngMrg32k3aStream* streams, size_t alignment, const clrngAllocator* allocator, clrngStatus* err)
 {
 	clrngStatus err_ = CLRNG_SUCCESS;
 	clrngMrg32k3aStream* dest = NULL;
@@ -323,7 +328,7 @@ clrngMrg32k3aStream* clrngMrg32k3aCopyStreams(size_t count, const clrngMrg32k3aS
 		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
 
 	if (err_ == CLRNG_SUCCESS)
-		dest = clrngMrg32k3aAllocStreams(count, NULL, &err_);
+		dest = clrngMrg32k3aAllocStreamsEx(count, alignment, allocator, NULL, &err_);
 
 	if (err_ == CLRNG_SUCCESS)
 		err_ = clrngMrg32k3aCopyOverStreams(count, dest, streams);
@@ -334,6 +339,34 @@ clrngMrg32k3aStream* clrngMrg32k3aCopyStreams(size_t count, const clrngMrg32k3aS
 	return dest;
 }
 
+clrngStatus clrngMrg32k3aGetStreamStates(size_t count, const clrngMrg32k3aStream* streams, clrngMrg32k3aStreamState* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		states[i] = streams[i].current;
+
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngMrg32k3aSetStreamStates(size_t count, clrngMrg32k3aStream* streams, const clrngMrg32k3aStreamState* states)
+{
+	//Check params
+	if (!streams)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (!states)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): states cannot be NULL", __func__);
+
+	for (size_t i = 0; i < count; i++)
+		streams[i].current = states[i];
+
+	return CLRNG_SUCCESS;
+}
+
 clrngMrg32k3aStream* clrngMrg32k3aMakeSubstreams(clrngMrg32k3aStream* stream, size_t count, size_t* bufSize, clrngStatus* err)
 {
 	clrngStatus err_;
@@ -352,14 +385,10 @@ clrngMrg32k3aStream* clrngMrg32k3aMakeSubstreams(clrngMrg32k3aStream* stream, si
 	return substreams;
 }
 
-clrngStatus clrngMrg32k3aAdvanceStreams(size_t count, clrngMrg32k3aStream* streams, cl_int e, cl_int c)
+// matrices of the jump of clrngMrg32k3aAdvanceStreams()
+static void makeAdvanceJump(cl_int e, cl_int c, cl_ulong C1[3][3], cl_ulong C2[3][3])
 {
-	//Check params
-	if (streams == NULL)
-		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
-
-	//Advance Stream
-	cl_ulong B1[3][3], C1[3][3], B2[3][3], C2[3][3];
+	cl_ulong B1[3][3], B2[3][3];
 
 	// if e == 0, do not add 2^0; just behave as in docs
 	if (e > 0) {
@@ -384,6 +413,17 @@ clrngStatus clrngMrg32k3aAdvanceStreams(size_t count, clrngMrg32k3aStream* strea
 		modMatMat(B1, C1, C1, Mrg32k3a_M1);
 		modMatMat(B2, C2, C2, Mrg32k3a_M2);
 	}
+}
+
+clrngStatus clrngMrg32k3aAdvanceStreams(size_t count, clrngMrg32k3aStream* streams, cl_int e, cl_int c)
+{
+	//Check params
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	//Advance Stream
+	cl_ulong C1[3][3], C2[3][3];
+	makeAdvanceJump(e, c, C1, C2);
 
 	for (size_t i = 0; i < count; i++) {
 		modMatVec(C1, streams[i].current.g1, streams[i].current.g1, Mrg32k3a_M1);
@@ -393,6 +433,32 @@ clrngStatus clrngMrg32k3aAdvanceStreams(size_t count, clrngMrg32k3aStream* strea
 	return CLRNG_SUCCESS;
 }
 
+clrngStatus clrngMrg32k3aRandomU01Array_53(clrngMrg32k3aStream* stream, size_t count, cl_double* buffer)
+{
+	//Check params
+	if (!stream)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (!buffer)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+
+	_CLRNG_COUNT_DRAWS(stream, 2 * count);
+
+	// Each step of the MRG32k3a recurrence depends on the previous state:
+	// produce the outputs in blocks, then convert each block at once.
+	cl_uint hi[CLRNG_U01_53_BLOCK];
+	cl_uint lo[CLRNG_U01_53_BLOCK];
+	for (size_t i = 0; i < count; i += CLRNG_U01_53_BLOCK) {
+		size_t n = count - i < CLRNG_U01_53_BLOCK ? count - i : CLRNG_U01_53_BLOCK;
+		for (size_t k = 0; k < n; k++) {
+			hi[k] = (cl_uint)clrngMrg32k3aNextState(&stream->current);
+			lo[k] = (cl_uint)clrngMrg32k3aNextState(&stream->current);
+		}
+		clrngCombineU01_53(n, hi, lo, 0.0, Mrg32k3a_NORM_cl_double, buffer + i);
+	}
+
+	return CLRNG_SUCCESS;
+}
+
 clrngStatus clrngMrg32k3aWriteStreamInfo(const clrngMrg32k3aStream* stream, FILE *file)
 {
 	//Check params
@@ -423,6 +489,318 @@ clrngStatus clrngMrg32k3aWriteStreamInfo(const clrngMrg32k3aStream* stream, FILE
 	return CLRNG_SUCCESS;
 }
 
+// serialized state: g1 followed by g2 (all values are below 2^32)
+static void packState(const void* state, cl_uint* words)
+{
+	const clrngMrg32k3aStreamState* s = (const clrngMrg32k3aStreamState*)state;
+	for (size_t i = 0; i < 3; i++) {
+		words[i]     = (cl_uint)s->g1[i];
+		words[3 + i] = (cl_uint)s->g2[i];
+	}
+}
+
+static clrngStatus unpackState(const cl_uint* words, void* state)
+{
+	clrngMrg32k3aStreamState* s = (clrngMrg32k3aStreamState*)state;
+	for (size_t i = 0; i < 3; i++) {
+		s->g1[i] = words[i];
+		s->g2[i] = words[3 + i];
+	}
+	return validateSeed(s);
+}
+
+static void* allocSerialStreams(size_t count, clrngStatus* err)
+{
+	return clrngMrg32k3aAllocStreams(count, NULL, err);
+}
+
+static const clrngSerialFormat serialFormat = {
+	CLRNG_SERIAL_MRG32K3A, 6, 6, sizeof(clrngMrg32k3aStreamState), sizeof(clrngMrg32k3aStream), packState, unpackState, allocSerialStreams
+};
+
+clrngStatus clrngMrg32k3aSerializeStreams(size_t count, const clrngMrg32k3aStream* streams, cl_uint flags, void* buffer, size_t* bufSize)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (bufSize == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): bufSize cannot be NULL", __func__);
+
+	return clrngSerialWrite(&serialFormat, count, streams, flags, buffer, bufSize);
+}
+
+clrngStatus clrngMrg32k3aWriteStreams(size_t count, const clrngMrg32k3aStream* streams, cl_uint flags, FILE *file)
+{
+	//Check params
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (file == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): file cannot be NULL", __func__);
+
+	return clrngSerialWriteFile(&serialFormat, count, streams, flags, file);
+}
+
+clrngMrg32k3aStream* clrngMrg32k3aDeserializeStreams(const void* buffer, size_t bufSize, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (buffer == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (clrngMrg32k3aStream*)clrngSerialRead(&serialFormat, buffer, bufSize, count, err);
+}
+
+clrngMrg32k3aStream* clrngMrg32k3aReadStreams(const char* path, size_t* count, clrngStatus* err)
+{
+	//Check params
+	if (path == NULL) {
+		if (count != NULL)
+			*count = 0;
+		if (err != NULL)
+			*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+		return NULL;
+	}
+
+	return (clrngMrg32k3aStream*)clrngSerialReadFile(&serialFormat, path, count, err);
+}
+
+// jump between successive streams of a pool: the nuA1 and nuA2 matrices of the creator
+typedef struct {
+	cl_ulong a1[3][3];
+	cl_ulong a2[3][3];
+} PoolJump;
+
+static void composePoolJumps(const void* a, const void* b, void* result)
+{
+	PoolJump* x = (PoolJump*)a;
+	PoolJump* y = (PoolJump*)b;
+	PoolJump* z = (PoolJump*)result;
+	modMatMat(y->a1, x->a1, z->a1, Mrg32k3a_M1);
+	modMatMat(y->a2, x->a2, z->a2, Mrg32k3a_M2);
+}
+
+static void applyPoolJump(const void* jump, void* state)
+{
+	PoolJump* j = (PoolJump*)jump;
+	clrngMrg32k3aStreamState* s = (clrngMrg32k3aStreamState*)state;
+	modMatVec(j->a1, s->g1, s->g1, Mrg32k3a_M1);
+	modMatVec(j->a2, s->g2, s->g2, Mrg32k3a_M2);
+}
+
+static const clrngPoolFormat poolFormat = {
+	CLRNG_SERIAL_MRG32K3A, sizeof(clrngMrg32k3aStreamState), sizeof(clrngMrg32k3aStream), sizeof(PoolJump), composePoolJumps, applyPoolJump
+};
+
+clrngMrg32k3aStreamPool* clrngMrg32k3aCreateStreamPool(clrngMrg32k3aStreamCreator* creator, size_t count, const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else {
+		// use default creator if not given
+		if (creator == NULL)
+			creator = &defaultStreamCreator;
+
+		PoolJump jump;
+		memcpy(jump.a1, creator->nuA1, sizeof(jump.a1));
+		memcpy(jump.a2, creator->nuA2, sizeof(jump.a2));
+		pool = clrngPoolCreate(&poolFormat, &creator->nextState, &jump, count, path, flags, &err_);
+
+		// skip the streams of the pool, as clrngCreateStreams() would
+		if (pool != NULL)
+			clrngPoolJump(pool, (cl_ulong)count, &creator->nextState);
+	}
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngMrg32k3aStreamPool*)pool;
+}
+
+clrngMrg32k3aStreamPool* clrngMrg32k3aOpenStreamPool(const char* path, cl_uint flags, clrngStatus* err)
+{
+	clrngStatus err_;
+	clrngPool* pool = NULL;
+
+	//Check params
+	if (path == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): path cannot be NULL", __func__);
+	else
+		pool = clrngPoolOpen(&poolFormat, path, flags, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngMrg32k3aStreamPool*)pool;
+}
+
+clrngStatus clrngMrg32k3aDestroyStreamPool(clrngMrg32k3aStreamPool* pool)
+{
+	if (pool != NULL)
+		return clrngPoolDestroy((clrngPool*)pool);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngMrg32k3aSyncStreamPool(clrngMrg32k3aStreamPool* pool)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+
+	return clrngPoolSync((clrngPool*)pool);
+}
+
+size_t clrngMrg32k3aGetStreamPoolSize(const clrngMrg32k3aStreamPool* pool)
+{
+	return pool != NULL ? clrngPoolSize((const clrngPool*)pool) : 0;
+}
+
+clrngMrg32k3aStream* clrngMrg32k3aGetPoolStream(clrngMrg32k3aStreamPool* pool, size_t index, clrngStatus* err)
+{
+	clrngStatus err_;
+	void* stream = NULL;
+
+	//Check params
+	if (pool == NULL)
+		err_ = clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	else
+		stream = clrngPoolStream((clrngPool*)pool, index, &err_);
+
+	if (err != NULL)
+		*err = err_;
+
+	return (clrngMrg32k3aStream*)stream;
+}
+
+clrngStatus clrngMrg32k3aCopyPoolStreams(const clrngMrg32k3aStreamPool* pool, size_t first, size_t count, clrngMrg32k3aStream* streams)
+{
+	//Check params
+	if (pool == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): pool cannot be NULL", __func__);
+	if (streams == NULL && count > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+
+	return clrngPoolCopyStreams((const clrngPool*)pool, first, count, streams);
+}
+
+// position in a substream: baby steps with the recurrence, giant steps with powers of its matrices
+static void stepState(void* state)
+{
+	clrngMrg32k3aNextState((clrngMrg32k3aStreamState*)state);
+}
+
+static void makeLeap(cl_uint steps, void* leap)
+{
+	PoolJump* j = (PoolJump*)leap;
+	modMatPow(Mrg32k3a_A1p0, j->a1, Mrg32k3a_M1, steps);
+	modMatPow(Mrg32k3a_A2p0, j->a2, Mrg32k3a_M2, steps);
+}
+
+static const clrngPositionSearch positionSearch = {
+	sizeof(clrngMrg32k3aStreamState), sizeof(PoolJump), stepState, makeLeap, applyPoolJump
+};
+
+clrngStatus clrngMrg32k3aGetStreamPosition(const clrngMrg32k3aStream* stream, cl_ulong* position)
+{
+	//Check params
+	if (stream == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): stream cannot be NULL", __func__);
+	if (position == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): position cannot be NULL", __func__);
+
+	return clrngFindPosition(&positionSearch, &stream->substream, &stream->current, position, __func__);
+}
+
+/*! @brief Kernel of clrngMrg32k3aDeviceRandomU01Array_()
+ */
+static const char fillSource[] =
+	"#include <clRNG/mrg32k3a.clh>\n"
+	"__kernel void fillBufferU01(__global clrngMrg32k3aHostStream* streams, uint streamCount, uint numberCount, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	int gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	//Copy a stream from global stream array to local stream struct\n"
+	"	clrngMrg32k3aStream local_stream;\n"
+	"	clrngMrg32k3aCopyOverStreamsFromGlobal(1, &local_stream, &streams[gid]);\n"
+	"	// wavefront-friendly ordering\n"
+	"	for (int i = 0; i < numberCount; i++)\n"
+	"		numbers[i * streamCount + gid] = clrngMrg32k3aRandomU01(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of clrngMrg32k3aDeviceFillU01_()
+ */
+static const char blockSource[] =
+	"#define CLRNG_ENABLE_SUBSTREAMS\n"
+	"#include <clRNG/mrg32k3a.clh>\n"
+	"typedef struct { ulong a1[3][3]; ulong a2[3][3]; } Leap;\n"
+	"__kernel void fillBlocksU01(__global clrngMrg32k3aHostStream* streams, uint streamCount, ulong perStream, uint blockSize,\n"
+	"	uint blocksPerStream, ulong numberCount, __global const Leap* leaps, __global _CLRNG_FPTYPE* numbers) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	uint s = gid / blocksPerStream;\n"
+	"	uint b = gid % blocksPerStream;\n"
+	"	ulong first = s * perStream + (ulong)b * blockSize;\n"
+	"	// the global size is padded, and the last streams can have fewer values\n"
+	"	if (s >= streamCount || first >= numberCount)\n"
+	"		return;\n"
+	"	ulong last = min(min(first + blockSize, (s + 1) * perStream), numberCount);\n"
+	"	clrngMrg32k3aStream local_stream;\n"
+	"	clrngMrg32k3aCopyOverStreamsFromGlobal(1, &local_stream, &streams[s]);\n"
+	"	// jump to value b * blockSize of the stream\n"
+	"	for (uint i = 0; (b >> i) != 0; i++) {\n"
+	"		if ((b >> i) & 1) {\n"
+	"			Leap leap = leaps[i];\n"
+	"			modMatVec(leap.a1, local_stream.current.g1, local_stream.current.g1, Mrg32k3a_M1);\n"
+	"			modMatVec(leap.a2, local_stream.current.g2, local_stream.current.g2, Mrg32k3a_M2);\n"
+	"		}\n"
+	"	}\n"
+	"	for (ulong n = first; n < last; n++)\n"
+	"		numbers[n] = clrngMrg32k3aRandomU01(&local_stream);\n"
+	"}\n";
+
+/*! @brief Kernel of clrngMrg32k3aDeviceAdvanceStreams()
+ */
+static const char advanceSource[] =
+	"#define CLRNG_ENABLE_SUBSTREAMS\n"
+	"#include <clRNG/mrg32k3a.clh>\n"
+	"typedef struct { ulong a1[3][3]; ulong a2[3][3]; } Jump;\n"
+	"__kernel void advanceStreams(__global clrngMrg32k3aHostStream* streams, uint streamCount, __constant Jump* jumps) {\n"
+	"	uint gid = get_global_id(0);\n"
+	"	// the global size is padded to a multiple of the work-group size\n"
+	"	if (gid >= streamCount)\n"
+	"		return;\n"
+	"	Jump jump = *jumps;\n"
+	"	clrngMrg32k3aStreamState state = streams[gid].current;\n"
+	"	modMatVec(jump.a1, state.g1, state.g1, Mrg32k3a_M1);\n"
+	"	modMatVec(jump.a2, state.g2, state.g2, Mrg32k3a_M2);\n"
+	"	streams[gid].current = state;\n"
+	"}\n";
+
+static void makeBlockLeaps(cl_uint blockSize, size_t count, void* leaps)
+{
+	PoolJump* j = (PoolJump*)leaps;
+	makeLeap(blockSize, &j[0]);
+	for (size_t i = 1; i < count; i++)
+		composePoolJumps(&j[i - 1], &j[i - 1], &j[i]);
+}
+
+const clrngDeviceKernels clrngMrg32k3aDeviceKernels = {
+	CLRNG_MRG32K3A,
+	sizeof(clrngMrg32k3aStream),
+	fillSource,
+	blockSource,
+	sizeof(PoolJump),
+	makeBlockLeaps,
+	advanceSource
+};
+
 clrngStatus clrngMrg32k3aDeviceRandomU01Array_(size_t streamCount, cl_mem streams,
 	size_t numberCount, cl_mem outBuffer, cl_uint numQueuesAndEvents,
 	cl_command_queue* commQueues, cl_uint numWaitEvents,
@@ -444,95 +822,80 @@ clrngStatus clrngMrg32k3aDeviceRandomU01Array_(size_t streamCount, cl_mem stream
 	if (numQueuesAndEvents != 1)
 		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numQueuesAndEvents can only have the value '1'", __func__);
 
-	//***************************************************************************************
-	//Get the context
-	cl_int err;
-
-	cl_context ctx;
-	err = clGetCommandQueueInfo(commQueues[0], CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot retrieve context", __func__);
-
-	//Get the Device
-	cl_device_id dev;
-	err = clGetCommandQueueInfo(commQueues[0], CL_QUEUE_DEVICE, sizeof(cl_device_id), &dev, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot retrieve the device", __func__);
-
-	//create the program
-	const char *sources[4] = {
-	        singlePrecision ? "#define CLRNG_SINGLE_PRECISION\n" : "",
-		"#include <clRNG/mrg32k3a.clh>\n"
-		"__kernel void fillBufferU01(__global clrngMrg32k3aHostStream* streams, uint numberCount, __global ",
-		singlePrecision ? "float" : "double",
-		"* numbers) {\n"
-		"	int gid = get_global_id(0);\n"
-		"       int gsize = get_global_size(0);\n"
-		"	//Copy a stream from global stream array to local stream struct\n"
-		"	clrngMrg32k3aStream local_stream;\n"
-		"	clrngMrg32k3aCopyOverStreamsFromGlobal(1, &local_stream, &streams[gid]);\n"
-		"	// wavefront-friendly ordering\n"
-		"	for (int i = 0; i < numberCount; i++)\n"
-		"		numbers[i * gsize + gid] = clrngMrg32k3aRandomU01(&local_stream);\n"
-		"}\n"
-	};
-	cl_program program = clCreateProgramWithSource(ctx, 4, sources, NULL, &err);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create program", __func__);
-
-	// construct compiler options
-	const char* includes = clrngGetLibraryDeviceIncludes(&err);
-	if (err != CLRNG_SUCCESS)
-		return (clrngStatus)err;
-
-	err = clBuildProgram(program, 0, NULL, includes, NULL, NULL);
-	if (err < 0) {
-		// Find size of log and print to std output
-		char *program_log;
-		size_t log_size;
-		clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, 0, NULL, &log_size);
-		program_log = (char *)malloc(log_size + 1);
-		program_log[log_size] = '\0';
-		clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, log_size + 1, program_log, NULL);
-		printf("clBuildProgram fails:\n%s\n", program_log);
-		free(program_log);
-		exit(1);
-	}
+	return clrngDeviceRandomArray(&clrngMrg32k3aDeviceKernels, streamCount, streams, numberCount, outBuffer,
+		commQueues[0], numWaitEvents, waitEvents, outEvents, singlePrecision, __func__);
+}
 
-	// Create the kernel
-	cl_kernel kernel = clCreateKernel(program, "fillBufferU01", &err);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create kernel", __func__);
+clrngStatus clrngMrg32k3aDeviceFillU01_(size_t streamCount, cl_mem streams,
+	size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision)
+{
+	//Check params
+	if (streamCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streamCount cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (numberCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount cannot be less than 1", __func__);
+	if (outBuffer == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): buffer cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
 
-	//***************************************************************************************
-	//Random numbers generated by each work-item
-	cl_uint number_count_per_stream = numberCount / streamCount;
+	return clrngDeviceFillBlocks(&clrngMrg32k3aDeviceKernels, streamCount, streams, numberCount, outBuffer, blockSize,
+		queue, numWaitEvents, waitEvents, outEvent, singlePrecision, __func__);
+}
 
-	//Work Group Size (local_size)
-	size_t local_size;
-	err = clGetDeviceInfo(dev, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(local_size), &local_size, NULL);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot read CL_DEVICE_MAX_WORK_GROUP_SIZE", __func__);
+clrngStatus clrngMrg32k3aDeviceAdvanceStreams(size_t count, cl_mem streams, cl_int e, cl_int c,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent)
+{
+	//Check params
+	if (count < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): count cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
 
-	if (local_size > streamCount)
-		local_size = streamCount;
+	PoolJump jump;
+	makeAdvanceJump(e, c, jump.a1, jump.a2);
 
-	// Set kernel arguments for kernel and enqueue that kernel.
-	err = clSetKernelArg(kernel, 0, sizeof(streams), &streams);
-	err |= clSetKernelArg(kernel, 1, sizeof(number_count_per_stream), &number_count_per_stream);
-	err |= clSetKernelArg(kernel, 2, sizeof(outBuffer), &outBuffer);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot create kernel arguments", __func__);
+	return clrngDeviceAdvance(&clrngMrg32k3aDeviceKernels, count, streams, &jump, sizeof(jump),
+		queue, numWaitEvents, waitEvents, outEvent, __func__);
+}
 
-	// Enqueue kernel
-	err = clEnqueueNDRangeKernel(commQueues[0], kernel, 1, NULL, &streamCount, &local_size, numWaitEvents, waitEvents, outEvents);
-	if (err != CLRNG_SUCCESS)
-		return clrngSetErrorString(err, "%s(): cannot enqueue kernel", __func__);
+static clrngStatus fillU01_cl_float(void* stream, size_t count, void* numbers)
+{
+	return clrngMrg32k3aRandomU01Array_cl_float((clrngMrg32k3aStream*)stream, count, (cl_float*)numbers);
+}
 
-	clReleaseKernel(kernel);
-	clReleaseProgram(program);
+static clrngStatus fillU01_cl_double(void* stream, size_t count, void* numbers)
+{
+	return clrngMrg32k3aRandomU01Array_cl_double((clrngMrg32k3aStream*)stream, count, (cl_double*)numbers);
+}
 
-	return(clrngStatus)EXIT_SUCCESS;
+clrngStatus clrngMrg32k3aParallelFillU01_cl_float(size_t streamCount, clrngMrg32k3aStream* streams, size_t numberCount, cl_float* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_float, sizeof(clrngMrg32k3aStream), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
+
+clrngStatus clrngMrg32k3aParallelFillU01_cl_double(size_t streamCount, clrngMrg32k3aStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount, cl_uint layout)
+{
+	return clrngParallelFill(fillU01_cl_double, sizeof(clrngMrg32k3aStream), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount, layout);
+}
+
+clrngStatus clrngMrg32k3aHostRandomU01Array_cl_float(size_t streamCount, const clrngMrg32k3aStream* streams, size_t numberCount, cl_float* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_float, sizeof(clrngMrg32k3aStream), sizeof(cl_float),
+		streamCount, streams, numberCount, numbers, threadCount);
+}
+
+clrngStatus clrngMrg32k3aHostRandomU01Array_cl_double(size_t streamCount, const clrngMrg32k3aStream* streams, size_t numberCount, cl_double* numbers, size_t threadCount)
+{
+	return clrngHostRandomArray(fillU01_cl_double, sizeof(clrngMrg32k3aStream), sizeof(cl_double),
+		streamCount, streams, numberCount, numbers, threadCount);
 }
 
 #if 0
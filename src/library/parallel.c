@@ -0,0 +1,267 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file parallel.c
+ * @brief Multithreaded host fill of random arrays
+ */
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef volatile LONG64 claimCounter;
+#define initCounter(p, v) (*(p) = (LONG64)(v))
+#define claimNext(p)      ((size_t)(InterlockedIncrement64(p) - 1))
+#else
+#include <stdatomic.h>
+typedef atomic_size_t claimCounter;
+#define initCounter(p, v) atomic_init(p, v)
+#define claimNext(p)      atomic_fetch_add(p, 1)
+#endif
+
+/*! @brief Number of values generated at once per stream with the interleaved layout
+ *
+ *  Small enough for the rows of the output touched by one block to remain in
+ *  the L1 cache while the thread walks through its streams.
+ */
+#define FILL_BLOCK 64
+
+typedef struct fillJob_ {
+	clrngFillFunction fill;
+	size_t            streamSize;
+	size_t            numberSize;
+	size_t            streamCount;
+	unsigned char*    streams;
+	size_t            perStream;
+	unsigned char*    numbers;
+	cl_uint           layout;
+	clrngStatus*      status;
+} fillJob;
+
+/*! @brief Fill the values of streams \c first to `last - 1` in the interleaved layout
+ *
+ *  \c streams points to the object of stream \c first.
+ */
+static clrngStatus fillInterleaved(const fillJob* job, unsigned char* streams, size_t first, size_t last)
+{
+	// value i of stream s goes to numbers[i * streamCount + s]
+	union {
+		cl_float  f[FILL_BLOCK];
+		cl_double d[FILL_BLOCK];
+	} block;
+	clrngStatus err = CLRNG_SUCCESS;
+	for (size_t i0 = 0; i0 < job->perStream && err == CLRNG_SUCCESS; i0 += FILL_BLOCK) {
+		size_t rows = job->perStream - i0 < FILL_BLOCK ? job->perStream - i0 : FILL_BLOCK;
+		for (size_t s = first; s < last && err == CLRNG_SUCCESS; s++) {
+			err = job->fill(streams + (s - first) * job->streamSize, rows, &block);
+			if (job->numberSize == sizeof(cl_float)) {
+				cl_float* out = (cl_float*)job->numbers + i0 * job->streamCount + s;
+				for (size_t k = 0; k < rows; k++)
+					out[k * job->streamCount] = block.f[k];
+			}
+			else {
+				cl_double* out = (cl_double*)job->numbers + i0 * job->streamCount + s;
+				for (size_t k = 0; k < rows; k++)
+					out[k * job->streamCount] = block.d[k];
+			}
+		}
+	}
+	return err;
+}
+
+static void fillWorker(size_t index, size_t count, void* arg)
+{
+	const fillJob* job = (const fillJob*)arg;
+	size_t first = job->streamCount * index / count;
+	size_t last  = job->streamCount * (index + 1) / count;
+	clrngStatus err = CLRNG_SUCCESS;
+
+	if (job->layout == CLRNG_FILL_BLOCKED) {
+		for (size_t s = first; s < last && err == CLRNG_SUCCESS; s++)
+			err = job->fill(job->streams + s * job->streamSize, job->perStream,
+				job->numbers + s * job->perStream * job->numberSize);
+	}
+	else
+		err = fillInterleaved(job, job->streams + first * job->streamSize, first, last);
+
+	job->status[index] = err;
+}
+
+clrngStatus clrngParallelFill(clrngFillFunction fill, size_t streamSize, size_t numberSize,
+	size_t streamCount, void* streams, size_t numberCount, void* numbers, size_t threadCount, cl_uint layout)
+{
+	//Check params
+	if (streamCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streamCount cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (numbers == NULL && numberCount > 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numbers cannot be NULL", __func__);
+	if (numberCount % streamCount != 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount must be a multiple of streamCount", __func__);
+	if (layout != CLRNG_FILL_INTERLEAVED && layout != CLRNG_FILL_BLOCKED)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): invalid layout", __func__);
+
+	if (threadCount == 0)
+		threadCount = clrngProcessorCount();
+	if (threadCount > streamCount)
+		threadCount = streamCount;
+
+	clrngStatus* status = (clrngStatus*)clrngAlloc(threadCount * sizeof(clrngStatus), 0, NULL);
+	if (status == NULL)
+		return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory", __func__);
+
+	fillJob job = {
+		fill, streamSize, numberSize, streamCount, (unsigned char*)streams,
+		numberCount / streamCount, (unsigned char*)numbers, layout, status
+	};
+	clrngStatus err = clrngRunThreads(threadCount, fillWorker, &job, CL_TRUE);
+
+	for (size_t k = 0; k < threadCount && err == CLRNG_SUCCESS; k++)
+		err = status[k];
+
+	clrngRelease(status);
+	return err;
+}
+
+
+/*! @brief Maximum number of streams in a chunk of work of clrngHostRandomArray()
+ */
+#define HOST_CHUNK 64
+
+/*! @brief Chunks of streams assigned to one thread
+ *
+ *  Chunks `next` to `end - 1` remain to be generated.  The owner thread and
+ *  the threads that steal from it both claim chunks by atomically
+ *  incrementing `next`, so each chunk is generated exactly once.  Padded to
+ *  its own cache line to avoid false sharing between threads.
+ */
+typedef struct chunkQueue_ {
+	claimCounter next;
+	size_t       end;
+	char         pad[64 - sizeof(claimCounter) - sizeof(size_t)];
+} chunkQueue;
+
+typedef struct hostJob_ {
+	fillJob              base;
+	const unsigned char* streams;
+	size_t               chunkSize;
+	chunkQueue*          queues;
+} hostJob;
+
+static void hostWorker(size_t index, size_t count, void* arg)
+{
+	const hostJob* job = (const hostJob*)arg;
+	clrngStatus err = CLRNG_SUCCESS;
+
+	// private copies of the streams, as the device kernel makes
+	unsigned char* copies = (unsigned char*)clrngAlloc(job->chunkSize * job->base.streamSize, 0, NULL);
+	if (copies == NULL)
+		err = CLRNG_OUT_OF_RESOURCES;
+
+	// own chunks first, then steal from the other threads in turn
+	for (size_t v = 0; v < count && err == CLRNG_SUCCESS; v++) {
+		chunkQueue* queue = &job->queues[(index + v) % count];
+		for (;;) {
+			size_t chunk = claimNext(&queue->next);
+			if (chunk >= queue->end || err != CLRNG_SUCCESS)
+				break;
+			size_t first = chunk * job->chunkSize;
+			size_t last  = first + job->chunkSize < job->base.streamCount ? first + job->chunkSize : job->base.streamCount;
+			memcpy(copies, job->streams + first * job->base.streamSize, (last - first) * job->base.streamSize);
+			err = fillInterleaved(&job->base, copies, first, last);
+		}
+	}
+
+	clrngRelease(copies);
+	job->base.status[index] = err;
+}
+
+clrngStatus clrngHostRandomArray(clrngFillFunction fill, size_t streamSize, size_t numberSize,
+	size_t streamCount, const void* streams, size_t numberCount, void* numbers, size_t threadCount)
+{
+	//Check params
+	if (streamCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streamCount cannot be less than 1", __func__);
+	if (streams == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): streams cannot be NULL", __func__);
+	if (numberCount < 1)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount cannot be less than 1", __func__);
+	if (numbers == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numbers cannot be NULL", __func__);
+	if (numberCount % streamCount != 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): numberCount must be a multiple of streamCount", __func__);
+
+	if (threadCount == 0)
+		threadCount = clrngProcessorCount();
+	if (threadCount > streamCount)
+		threadCount = streamCount;
+
+	// about eight chunks per thread, so that idle threads have work to steal
+	size_t chunkSize = streamCount / (8 * threadCount);
+	if (chunkSize < 1)
+		chunkSize = 1;
+	if (chunkSize > HOST_CHUNK)
+		chunkSize = HOST_CHUNK;
+	size_t chunkCount = (streamCount + chunkSize - 1) / chunkSize;
+
+	clrngStatus* status = (clrngStatus*)clrngAlloc(threadCount * sizeof(clrngStatus), 0, NULL);
+	chunkQueue* queues = (chunkQueue*)clrngAlloc(threadCount * sizeof(chunkQueue), sizeof(chunkQueue), NULL);
+	if (status == NULL || queues == NULL) {
+		clrngRelease(status);
+		clrngRelease(queues);
+		return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory", __func__);
+	}
+	for (size_t k = 0; k < threadCount; k++) {
+		initCounter(&queues[k].next, chunkCount * k / threadCount);
+		queues[k].end = chunkCount * (k + 1) / threadCount;
+	}
+
+	hostJob job = {
+		{ fill, streamSize, numberSize, streamCount, NULL,
+		  numberCount / streamCount, (unsigned char*)numbers, CLRNG_FILL_INTERLEAVED, status },
+		(const unsigned char*)streams, chunkSize, queues
+	};
+	clrngStatus err = clrngRunThreads(threadCount, hostWorker, &job, CL_TRUE);
+
+	for (size_t k = 0; k < threadCount && err == CLRNG_SUCCESS; k++)
+		err = status[k];
+	if (err == CLRNG_OUT_OF_RESOURCES)
+		err = clrngSetErrorString(err, "%s(): could not allocate memory", __func__);
+
+	clrngRelease(queues);
+	clrngRelease(status);
+	return err;
+}
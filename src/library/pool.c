@@ -0,0 +1,281 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file pool.c
+ * @brief Stream pools backed by memory-mapped files, common to all generators
+ *
+ * A pool file holds, in native byte order:
+ *
+ *     offset                 content
+ *          0                 header (see poolHeader)
+ *     CLRNG_POOL_PAGE        one status byte per stream (nonzero once the
+ *                            stream has been materialized)
+ *     dataOffset             stream objects, as laid out in host memory
+ *
+ * The file is created sparse, so that only the pages of the streams that
+ * are accessed use memory and disk space.  A stream that has not been
+ * materialized is computed from the base state of the pool with the
+ * precomputed jumps for 2^0, 2^1, ..., 2^63 streams.
+ */
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CLRNG_POOL_PAGE        4096
+#define CLRNG_POOL_VERSION     1
+#define CLRNG_POOL_BYTE_ORDER  0x01020304u
+#define CLRNG_POOL_JUMP_LEVELS 64
+
+static const char poolMagic[8] = { 'C', 'L', 'R', 'N', 'G', 'P', 'O', 'L' };
+
+typedef struct poolHeader_ {
+	char     magic[8];
+	cl_uint  byteOrder;
+	cl_uint  version;
+	cl_uint  generator;
+	cl_uint  streamSize;
+	cl_ulong count;
+	cl_ulong dataOffset;
+	// followed by the base state and by the jump at offsets baseOffset and jumpOffset
+} poolHeader;
+
+#define CLRNG_POOL_BASE_OFFSET 64
+#define CLRNG_POOL_JUMP_OFFSET (CLRNG_POOL_BASE_OFFSET + 256)
+
+struct clrngPool_ {
+	const clrngPoolFormat* format;
+	unsigned char* map;
+	size_t         mapSize;
+	cl_bool        readOnly;
+	size_t         count;
+	size_t         streamSize;
+	unsigned char* status;
+	unsigned char* streams;
+	const unsigned char* base;
+	// jumps[i] jumps over 2^i streams
+	unsigned char  jumps[CLRNG_POOL_JUMP_LEVELS][CLRNG_POOL_MAX_JUMP_SIZE];
+};
+
+static size_t roundToPage(size_t n)
+{
+	return (n + CLRNG_POOL_PAGE - 1) / CLRNG_POOL_PAGE * CLRNG_POOL_PAGE;
+}
+
+static void initJumps(clrngPool* pool)
+{
+	const clrngPoolFormat* format = pool->format;
+	memcpy(pool->jumps[0], pool->map + CLRNG_POOL_JUMP_OFFSET, format->jumpSize);
+	for (size_t i = 1; i < CLRNG_POOL_JUMP_LEVELS; i++)
+		format->compose(pool->jumps[i - 1], pool->jumps[i - 1], pool->jumps[i]);
+}
+
+void clrngPoolJump(const clrngPool* pool, cl_ulong k, void* state)
+{
+	for (size_t i = 0; k != 0; i++, k >>= 1)
+		if (k & 1)
+			pool->format->apply(pool->jumps[i], state);
+}
+
+// compute stream k of the pool into stream (current, initial and substream states)
+static void computeStream(const clrngPool* pool, size_t k, unsigned char* stream)
+{
+	size_t stateSize = pool->format->stateSize;
+	memcpy(stream, pool->base, stateSize);
+	clrngPoolJump(pool, (cl_ulong)k, stream);
+	memcpy(stream + stateSize, stream, stateSize);
+	memcpy(stream + 2 * stateSize, stream, stateSize);
+	memset(stream + 3 * stateSize, 0, pool->format->streamSize - 3 * stateSize);
+}
+
+static clrngPool* newPool(const clrngPoolFormat* format, unsigned char* map, size_t mapSize, cl_bool readOnly, clrngStatus* err)
+{
+	clrngPool* pool = (clrngPool*)clrngAlloc(sizeof(clrngPool), 0, NULL);
+	if (pool == NULL) {
+		*err = clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "could not allocate memory for stream pool");
+		return NULL;
+	}
+	const poolHeader* header = (const poolHeader*)map;
+	pool->format     = format;
+	pool->map        = map;
+	pool->mapSize    = mapSize;
+	pool->readOnly   = readOnly;
+	pool->count      = (size_t)header->count;
+	pool->streamSize = format->streamSize;
+	pool->status     = map + CLRNG_POOL_PAGE;
+	pool->streams    = map + header->dataOffset;
+	pool->base       = map + CLRNG_POOL_BASE_OFFSET;
+	initJumps(pool);
+	*err = CLRNG_SUCCESS;
+	return pool;
+}
+
+clrngPool* clrngPoolCreate(const clrngPoolFormat* format, const void* baseState, const void* jump, size_t count, const char* path, cl_uint flags, clrngStatus* err)
+{
+	size_t streamSize = format->streamSize;
+	size_t dataOffset = roundToPage(CLRNG_POOL_PAGE + count);
+
+	if (count > ((size_t)-1 - dataOffset) / streamSize) {
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngCreateStreamPool(): too many streams");
+		return NULL;
+	}
+	if (flags & CLRNG_POOL_READ_ONLY) {
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngCreateStreamPool(): cannot create a read-only pool");
+		return NULL;
+	}
+
+	size_t size = dataOffset + count * streamSize;
+	unsigned char* map = (unsigned char*)clrngMapFile(path, CLRNG_MAP_CREATE, &size, err);
+	if (*err != CLRNG_SUCCESS)
+		return NULL;
+
+	poolHeader* header = (poolHeader*)map;
+	memcpy(header->magic, poolMagic, sizeof(poolMagic));
+	header->byteOrder  = CLRNG_POOL_BYTE_ORDER;
+	header->version    = CLRNG_POOL_VERSION;
+	header->generator  = format->generator;
+	header->streamSize = (cl_uint)streamSize;
+	header->count      = count;
+	header->dataOffset = dataOffset;
+	memcpy(map + CLRNG_POOL_BASE_OFFSET, baseState, format->stateSize);
+	memcpy(map + CLRNG_POOL_JUMP_OFFSET, jump, format->jumpSize);
+
+	clrngPool* pool = newPool(format, map, size, CL_FALSE, err);
+	if (pool == NULL) {
+		clrngUnmapFile(map, size);
+		return NULL;
+	}
+
+	if (flags & CLRNG_POOL_PRECOMPUTE) {
+		// successive streams are one jump apart
+		unsigned char* stream = pool->streams;
+		for (size_t k = 0; k < count; k++, stream += streamSize) {
+			if (k == 0)
+				memcpy(stream, pool->base, format->stateSize);
+			else {
+				memcpy(stream, stream - streamSize, format->stateSize);
+				format->apply(pool->jumps[0], stream);
+			}
+			memcpy(stream + format->stateSize, stream, format->stateSize);
+			memcpy(stream + 2 * format->stateSize, stream, format->stateSize);
+			pool->status[k] = 1;
+		}
+	}
+
+	return pool;
+}
+
+clrngPool* clrngPoolOpen(const clrngPoolFormat* format, const char* path, cl_uint flags, clrngStatus* err)
+{
+	cl_bool readOnly = (flags & CLRNG_POOL_READ_ONLY) ? CL_TRUE : CL_FALSE;
+	size_t size;
+	unsigned char* map = (unsigned char*)clrngMapFile(path, readOnly ? CLRNG_MAP_READ_ONLY : CLRNG_MAP_READ_WRITE, &size, err);
+	if (*err != CLRNG_SUCCESS)
+		return NULL;
+
+	const poolHeader* header = (const poolHeader*)map;
+	if (size < CLRNG_POOL_PAGE || memcmp(header->magic, poolMagic, sizeof(poolMagic)) != 0)
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngOpenStreamPool(): %s is not a stream pool", path);
+	else if (header->byteOrder != CLRNG_POOL_BYTE_ORDER || header->version != CLRNG_POOL_VERSION)
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngOpenStreamPool(): %s was created on an incompatible host", path);
+	else if (header->generator != format->generator || header->streamSize != format->streamSize)
+		*err = clrngSetErrorString(CLRNG_INVALID_RNG_TYPE, "clrngOpenStreamPool(): %s was created for another generator", path);
+	else if (header->dataOffset < CLRNG_POOL_PAGE + header->count ||
+		header->count > (size - header->dataOffset) / header->streamSize)
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngOpenStreamPool(): %s is truncated", path);
+
+	clrngPool* pool = NULL;
+	if (*err == CLRNG_SUCCESS)
+		pool = newPool(format, map, size, readOnly, err);
+	if (pool == NULL)
+		clrngUnmapFile(map, size);
+
+	return pool;
+}
+
+clrngStatus clrngPoolDestroy(clrngPool* pool)
+{
+	clrngUnmapFile(pool->map, pool->mapSize);
+	clrngRelease(pool);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngPoolSync(clrngPool* pool)
+{
+	if (pool->readOnly)
+		return CLRNG_SUCCESS;
+	return clrngSyncMappedFile(pool->map, pool->mapSize);
+}
+
+size_t clrngPoolSize(const clrngPool* pool)
+{
+	return pool->count;
+}
+
+void* clrngPoolStream(clrngPool* pool, size_t index, clrngStatus* err)
+{
+	if (pool->readOnly) {
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngGetPoolStream(): the pool is read-only; use clrngCopyPoolStreams()");
+		return NULL;
+	}
+	if (index >= pool->count) {
+		*err = clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngGetPoolStream(): index out of range");
+		return NULL;
+	}
+
+	unsigned char* stream = pool->streams + index * pool->streamSize;
+	if (!pool->status[index]) {
+		computeStream(pool, index, stream);
+		pool->status[index] = 1;
+	}
+
+	*err = CLRNG_SUCCESS;
+	return stream;
+}
+
+clrngStatus clrngPoolCopyStreams(const clrngPool* pool, size_t first, size_t count, void* streams)
+{
+	if (first > pool->count || count > pool->count - first)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngCopyPoolStreams(): index out of range");
+
+	unsigned char* dest = (unsigned char*)streams;
+	for (size_t k = first; k < first + count; k++, dest += pool->streamSize) {
+		if (pool->status[k])
+			memcpy(dest, pool->streams + k * pool->streamSize, pool->streamSize);
+		else
+			computeStream(pool, k, dest);
+	}
+
+	return CLRNG_SUCCESS;
+}
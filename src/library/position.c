@@ -0,0 +1,135 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file position.c
+ * @brief Position of a state relative to another by baby-step giant-step search
+ */
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#include <string.h>
+
+/*! @brief 64-bit FNV-1a hash of a state
+ */
+static cl_ulong hashState(const unsigned char* state, size_t size)
+{
+	cl_ulong h = 14695981039346656037ULL;
+	for (size_t i = 0; i < size; i++) {
+		h ^= state[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+typedef struct babyStep_ {
+	cl_uint hash;     /*!< low bits of the hash of the state */
+	cl_uint index;    /*!< number of steps from the target, plus one (0 for an empty slot) */
+} babyStep;
+
+/*! @brief Look for the position of \c to relative to \c from, below `m * m`
+ *
+ *  Store the hashes of the states `A^j to` for `0 <= j < m` in a table,
+ *  then compute `A^(i m) from` for `i = 0, 1, ..., m`: a match with entry
+ *  \c j means that \c to is `i m - j` steps after \c from.
+ *  Matches are confirmed by comparing the states, to rule out collisions.
+ */
+static clrngStatus searchLevel(const clrngPositionSearch* search, size_t m, const void* from, const void* to,
+	unsigned char* buffer, cl_bool* found, cl_ulong* position)
+{
+	size_t tableSize = 2 * m;
+	size_t mask = tableSize - 1;
+	babyStep* table = (babyStep*)clrngAlloc(tableSize * sizeof(babyStep), 0, NULL);
+	if (table == NULL)
+		return CLRNG_OUT_OF_RESOURCES;
+	memset(table, 0, tableSize * sizeof(babyStep));
+
+	unsigned char* state = buffer;
+	unsigned char* check = buffer + search->stateSize;
+	unsigned char* leap  = buffer + 2 * search->stateSize;
+
+	// baby steps from the target state
+	memcpy(state, to, search->stateSize);
+	for (size_t j = 0; j < m; j++) {
+		cl_ulong h = hashState(state, search->stateSize);
+		size_t slot = (size_t)h & mask;
+		while (table[slot].index != 0)
+			slot = (slot + 1) & mask;
+		table[slot].hash  = (cl_uint)h;
+		table[slot].index = (cl_uint)(j + 1);
+		search->step(state);
+	}
+
+	// giant steps from the reference state
+	search->makeLeap((cl_uint)m, leap);
+	memcpy(state, from, search->stateSize);
+	*found = CL_FALSE;
+	for (size_t i = 0; i <= m && !*found; i++) {
+		cl_ulong h = hashState(state, search->stateSize);
+		for (size_t slot = (size_t)h & mask; table[slot].index != 0 && !*found; slot = (slot + 1) & mask) {
+			size_t j = (size_t)table[slot].index - 1;
+			if (table[slot].hash != (cl_uint)h || (cl_ulong)i * m < j)
+				continue;
+			memcpy(check, to, search->stateSize);
+			for (size_t k = 0; k < j; k++)
+				search->step(check);
+			if (memcmp(check, state, search->stateSize) == 0) {
+				*position = (cl_ulong)i * m - j;
+				*found = CL_TRUE;
+			}
+		}
+		search->leap(leap, state);
+	}
+
+	clrngRelease(table);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngFindPosition(const clrngPositionSearch* search, const void* from, const void* to, cl_ulong* position, const char* caller)
+{
+	unsigned char* buffer = (unsigned char*)clrngAlloc(2 * search->stateSize + search->leapSize, 0, NULL);
+	if (buffer == NULL)
+		return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory", caller);
+
+	// short distances are found quickly with small tables
+	clrngStatus err = CLRNG_SUCCESS;
+	cl_bool found = CL_FALSE;
+	for (size_t m = 1 << 10; m <= CLRNG_POSITION_BABY_STEPS && !found && err == CLRNG_SUCCESS; m <<= 5)
+		err = searchLevel(search, m, from, to, buffer, &found, position);
+
+	clrngRelease(buffer);
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): could not allocate memory", caller);
+	if (!found)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): the current state is not within 2^40 steps of the start of the substream", caller);
+	return CLRNG_SUCCESS;
+}
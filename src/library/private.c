@@ -40,6 +40,11 @@
 #include <stdarg.h>
 #include <stdlib.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CLRNG_HAVE_SSE2
+#endif
+
 #define CASE_ERR_(code,msg) case code: base = msg; break
 #define CASE_ERR(code)      CASE_ERR_(CLRNG_ ## code, MSG_ ## code)
 
@@ -74,3 +79,111 @@ clrngStatus clrngSetErrorString(cl_int err, const char* msg, ...)
     va_end(args);
 	return (clrngStatus)err;
 }
+
+static void* defaultAlloc(size_t size, size_t alignment, void* userData)
+{
+	(void)userData;
+	// aligned_alloc() requires the size to be a multiple of the alignment
+	size = (size + alignment - 1) & ~(alignment - 1);
+#ifdef _MSC_VER
+	return _aligned_malloc(size, alignment);
+#else
+	return aligned_alloc(alignment, size);
+#endif
+}
+
+static void defaultFree(void* ptr, size_t size, void* userData)
+{
+	(void)size;
+	(void)userData;
+#ifdef _MSC_VER
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+static clrngAllocator currentAllocator = { defaultAlloc, defaultFree, NULL };
+
+clrngStatus clrngSetAllocator(clrngAllocFunction allocFunc, clrngFreeFunction freeFunc, void* userData)
+{
+	if (allocFunc == NULL && freeFunc == NULL) {
+		currentAllocator.alloc    = defaultAlloc;
+		currentAllocator.free     = defaultFree;
+		currentAllocator.userData = NULL;
+		return CLRNG_SUCCESS;
+	}
+	if (allocFunc == NULL || freeFunc == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): allocFunc and freeFunc must be both NULL or both non-NULL", __func__);
+	currentAllocator.alloc    = allocFunc;
+	currentAllocator.free     = freeFunc;
+	currentAllocator.userData = userData;
+	return CLRNG_SUCCESS;
+}
+
+/* Bookkeeping stored right before each block returned by clrngAlloc().
+ * The block starts at the first multiple of the alignment past the header,
+ * so the header costs one alignment unit (or more, for small alignments).
+ */
+typedef struct allocHeader_ {
+	clrngAllocator allocator;
+	void*          base;
+	size_t         size;
+} allocHeader;
+
+void* clrngAlloc(size_t size, size_t alignment, const clrngAllocator* allocator)
+{
+	if (allocator == NULL)
+		allocator = &currentAllocator;
+	if (alignment < CLRNG_DEFAULT_ALIGNMENT)
+		alignment = CLRNG_DEFAULT_ALIGNMENT;
+	if (!clrngValidAlignment(alignment))
+		return NULL;
+
+	size_t offset = (sizeof(allocHeader) + alignment - 1) & ~(alignment - 1);
+	if (size > (size_t)-1 - offset)
+		return NULL;
+	unsigned char* base = (unsigned char*)allocator->alloc(offset + size, alignment, allocator->userData);
+	if (base == NULL)
+		return NULL;
+
+	allocHeader* header = (allocHeader*)(base + offset) - 1;
+	header->allocator = *allocator;
+	header->base      = base;
+	header->size      = offset + size;
+	return base + offset;
+}
+
+void clrngRelease(void* ptr)
+{
+	if (ptr == NULL)
+		return;
+	allocHeader header = *((allocHeader*)ptr - 1);
+	header.allocator.free(header.base, header.size, header.allocator.userData);
+}
+
+void clrngCombineU01_53(size_t count, const cl_uint* hi, const cl_uint* lo, cl_double loOffset, cl_double norm, cl_double* out)
+{
+	size_t i = 0;
+#ifdef CLRNG_HAVE_SSE2
+	// SSE2 only converts signed integers: flip the sign bit and add 2^31 back,
+	// which is exact in double precision.
+	const __m128i bias   = _mm_set1_epi32((int)0x80000000u);
+	const __m128d unbias = _mm_set1_pd(2147483648.0);
+	const __m128d offset = _mm_set1_pd(loOffset);
+	const __m128d scale  = _mm_set1_pd(norm);
+	const __m128d max    = _mm_set1_pd(_CLRNG_U01_53_MAX);
+	for (; i + 2 <= count; i += 2) {
+		__m128i h = _mm_xor_si128(_mm_loadl_epi64((const __m128i*)(hi + i)), bias);
+		__m128i l = _mm_xor_si128(_mm_loadl_epi64((const __m128i*)(lo + i)), bias);
+		__m128d dh = _mm_add_pd(_mm_cvtepi32_pd(h), unbias);
+		__m128d dl = _mm_add_pd(_mm_add_pd(_mm_cvtepi32_pd(l), unbias), offset);
+		__m128d u = _mm_mul_pd(_mm_add_pd(dh, _mm_mul_pd(dl, scale)), scale);
+		_mm_storeu_pd(out + i, _mm_min_pd(u, max));
+	}
+#endif
+	for (; i < count; i++) {
+		cl_double u = ((cl_double)hi[i] + ((cl_double)lo[i] + loOffset) * norm) * norm;
+		out[i] = u < _CLRNG_U01_53_MAX ? u : _CLRNG_U01_53_MAX;
+	}
+}
@@ -34,6 +34,8 @@
 #ifndef PRIVATE_H
 #define PRIVATE_H
 
+#include <stdio.h>
+
 
 /*! @brief Set the current error string
  *
@@ -47,5 +49,361 @@
  */
 clrngStatus clrngSetErrorString(cl_int err, const char* msg, ...);
 
+/*! @brief Minimum alignment in bytes of blocks returned by clrngAlloc()
+ */
+#define CLRNG_DEFAULT_ALIGNMENT 16
+
+/*! @brief Allocate memory through an allocator
+ *
+ *  The allocator is recorded along with the block, so clrngRelease() does
+ *  not need it.
+ *
+ *  @param[in]  size        Size of the block in bytes.
+ *  @param[in]  alignment   Alignment of the block: 0 or a power of two;
+ *                          values below ::CLRNG_DEFAULT_ALIGNMENT are raised
+ *                          to it.
+ *  @param[in]  allocator   Allocator to use, or `NULL` for the one set with
+ *                          clrngSetAllocator().
+ *  @return     The allocated block, or `NULL` on failure.
+ */
+void* clrngAlloc(size_t size, size_t alignment, const clrngAllocator* allocator);
+
+/*! @brief Release a block allocated by clrngAlloc() (`NULL` is ignored)
+ */
+void clrngRelease(void* ptr);
+
+/*! @brief Check that \c alignment is 0 or a power of two
+ */
+#define clrngValidAlignment(alignment) (((alignment) & ((alignment) - 1)) == 0)
+
+/*! @brief Number of values produced per block by the host RandomU01Array_53 functions
+ */
+#define CLRNG_U01_53_BLOCK 256
+
+/*! @brief Combine pairs of generator outputs into full-precision uniforms
+ *
+ *  Compute `out[i] = min((hi[i] + (lo[i] + loOffset) * norm) * norm, 1 - 2^-53)`
+ *  for `i = 0, ..., count - 1`, using SIMD instructions when available.
+ *  The result is bit-identical to the scalar RandomU01_53 functions.
+ *
+ *  @param[in]  count       Number of values to produce.
+ *  @param[in]  hi          First (most significant) outputs.
+ *  @param[in]  lo          Second (least significant) outputs.
+ *  @param[in]  loOffset    Offset added to \c lo before scaling (0 or 0.5).
+ *  @param[in]  norm        Normalization constant of the generator.
+ *  @param[out] out         Destination buffer.
+ */
+void clrngCombineU01_53(size_t count, const cl_uint* hi, const cl_uint* lo, cl_double loOffset, cl_double norm, cl_double* out);
+
+
+/*! @brief Version of the binary format written by clrngSerializeStreams()
+ *
+ *  Version 2 appends the key to the Philox432 and Threefry432 states.
+ */
+#define CLRNG_SERIAL_VERSION 2
+
+/*! @brief Oldest version of the binary format that can still be read
+ */
+#define CLRNG_SERIAL_MIN_VERSION 1
+
+/*! @brief Maximum number of 32-bit words per serialized state
+ */
+#define CLRNG_SERIAL_MAX_STATE_WORDS 16
+
+/*! @brief Generator identifiers stored in serialized stream arrays
+ */
+typedef enum clrngSerialGenerator_ {
+	CLRNG_SERIAL_MRG31K3P    = CLRNG_MRG31K3P,
+	CLRNG_SERIAL_MRG32K3A    = CLRNG_MRG32K3A,
+	CLRNG_SERIAL_LFSR113     = CLRNG_LFSR113,
+	CLRNG_SERIAL_PHILOX432   = CLRNG_PHILOX432,
+	CLRNG_SERIAL_THREEFRY432 = CLRNG_THREEFRY432
+} clrngSerialGenerator;
+
+/*! @brief Description of the serialized form of the streams of a generator
+ *
+ *  A stream object is assumed to start with three states of \c stateSize
+ *  bytes each, in the order current, initial, substream.  The rest of the
+ *  stream object (the draw counter with \c CLRNG_INSTRUMENT) is not
+ *  serialized, and is set to zero when reading.
+ */
+typedef struct clrngSerialFormat_ {
+	cl_uint generator;    /*!< one of clrngSerialGenerator */
+	size_t  stateWords;   /*!< number of 32-bit words per state */
+	size_t  minStateWords; /*!< smallest number of words per state accepted when reading (older records); missing words read as zero */
+	size_t  stateSize;    /*!< size of a state object in bytes */
+	size_t  streamSize;   /*!< size of a stream object in bytes */
+	/*! @brief Convert a state to \c stateWords words */
+	void (*pack)(const void* state, cl_uint* words);
+	/*! @brief Convert \c stateWords words to a state, and validate it */
+	clrngStatus (*unpack)(const cl_uint* words, void* state);
+	/*! @brief Allocate \c count stream objects */
+	void* (*alloc)(size_t count, clrngStatus* err);
+} clrngSerialFormat;
+
+/*! @brief Serialize streams to a memory buffer
+ *
+ *  If \c buffer is `NULL`, only set \c *bufSize to the required size.
+ *  Otherwise, \c *bufSize must contain the size of \c buffer on input, and
+ *  is set to the number of bytes written on output.
+ */
+clrngStatus clrngSerialWrite(const clrngSerialFormat* format, size_t count, const void* streams, cl_uint flags, void* buffer, size_t* bufSize);
+
+/*! @brief Serialize streams to a file
+ */
+clrngStatus clrngSerialWriteFile(const clrngSerialFormat* format, size_t count, const void* streams, cl_uint flags, FILE* file);
+
+/*! @brief Deserialize streams from a memory buffer into a new stream array
+ */
+void* clrngSerialRead(const clrngSerialFormat* format, const void* buffer, size_t bufSize, size_t* count, clrngStatus* err);
+
+/*! @brief Deserialize streams from a memory-mapped file into a new stream array
+ */
+void* clrngSerialReadFile(const clrngSerialFormat* format, const char* path, size_t* count, clrngStatus* err);
+
+
+/*! @brief Access modes for clrngMapFile()
+ */
+typedef enum clrngMapMode_ {
+	CLRNG_MAP_READ_ONLY,   /*!< map an existing file for reading */
+	CLRNG_MAP_READ_WRITE,  /*!< map an existing file for reading and writing */
+	CLRNG_MAP_CREATE       /*!< create (or truncate) a sparse file of the given size and map it for reading and writing */
+} clrngMapMode;
+
+/*! @brief Map a whole file in memory (shared mapping)
+ *
+ *  @param[in]     path  Path of the file.
+ *  @param[in]     mode  Access mode.
+ *  @param[in,out] size  Size of the file to create with ::CLRNG_MAP_CREATE;
+ *                       size of the mapped file on output.
+ *  @param[out]    err   Error status.
+ *  @return     Address of the mapping, or `NULL` if the file is empty or on error.
+ */
+void* clrngMapFile(const char* path, clrngMapMode mode, size_t* size, clrngStatus* err);
+
+/*! @brief Write a mapping created with clrngMapFile() back to its file
+ */
+clrngStatus clrngSyncMappedFile(void* addr, size_t size);
+
+/*! @brief Release a mapping created with clrngMapFile()
+ */
+void clrngUnmapFile(const void* addr, size_t size);
+
+
+/*! @brief Maximum size in bytes of the jump descriptor of a stream pool
+ */
+#define CLRNG_POOL_MAX_JUMP_SIZE 512
+
+/*! @brief Description of the stream pools of a generator
+ *
+ *  Stream \c k of a pool has its three states equal to the base state of
+ *  the pool with the jump applied \c k times.
+ *  For the MRGs, the jump is the pair of matrices of a stream creator; for
+ *  Lfsr113, the matrices of its four components over GF(2); for Philox432
+ *  and Threefry432, it is the counter distance between streams.
+ */
+typedef struct clrngPoolFormat_ {
+	cl_uint generator;    /*!< one of clrngSerialGenerator */
+	size_t  stateSize;    /*!< size of a state object in bytes */
+	size_t  streamSize;   /*!< size of a stream object in bytes */
+	size_t  jumpSize;     /*!< size of a jump descriptor in bytes (at most ::CLRNG_POOL_MAX_JUMP_SIZE) */
+	/*! @brief Compose two jumps: \c result is \c a followed by \c b (may alias) */
+	void (*compose)(const void* a, const void* b, void* result);
+	/*! @brief Apply a jump to a state, in place */
+	void (*apply)(const void* jump, void* state);
+} clrngPoolFormat;
+
+/*! @brief Generic stream pool (opaque)
+ */
+typedef struct clrngPool_ clrngPool;
+
+clrngPool* clrngPoolCreate(const clrngPoolFormat* format, const void* baseState, const void* jump, size_t count, const char* path, cl_uint flags, clrngStatus* err);
+clrngPool* clrngPoolOpen(const clrngPoolFormat* format, const char* path, cl_uint flags, clrngStatus* err);
+clrngStatus clrngPoolDestroy(clrngPool* pool);
+clrngStatus clrngPoolSync(clrngPool* pool);
+size_t clrngPoolSize(const clrngPool* pool);
+void* clrngPoolStream(clrngPool* pool, size_t index, clrngStatus* err);
+clrngStatus clrngPoolCopyStreams(const clrngPool* pool, size_t first, size_t count, void* streams);
+
+/*! @brief Apply the jump of a pool \c k times to \c state, in \f$O(\log k)\f$ operations
+ */
+void clrngPoolJump(const clrngPool* pool, cl_ulong k, void* state);
+
+
+/*! @brief Function run by each thread of clrngRunThreads()
+ *
+ *  @param[in]  index   Index of the thread, from 0 to `count - 1`.
+ *  @param[in]  count   Number of threads.
+ *  @param[in]  arg     Argument given to clrngRunThreads().
+ */
+typedef void (*clrngThreadFunction)(size_t index, size_t count, void* arg);
+
+/*! @brief Number of processors available to the process
+ */
+size_t clrngProcessorCount(void);
+
+/*! @brief Run \c func in \c count threads and wait for all of them
+ *
+ *  If \c pin is true, thread \c k is bound to the k-th processor available
+ *  to the process (modulo their number), where the operating system supports
+ *  it.  With a single thread, \c func is called directly.
+ */
+clrngStatus clrngRunThreads(size_t count, clrngThreadFunction func, void* arg, cl_bool pin);
+
+/*! @brief Acquire the library-wide lock (not recursive)
+ */
+void clrngLockLibrary(void);
+
+/*! @brief Release the lock acquired with clrngLockLibrary()
+ */
+void clrngUnlockLibrary(void);
+
+/*! @brief Monotonic wall-clock time in seconds, from an arbitrary origin
+ */
+cl_double clrngWallTime(void);
+
+
+/*! @brief Fill \c count numbers from a single stream (RandomU01Array) */
+typedef clrngStatus (*clrngFillFunction)(void* stream, size_t count, void* numbers);
+
+/*! @brief Generic implementation of the ParallelFillU01 functions
+ *
+ *  @param[in]  fill        RandomU01Array function of the generator and precision.
+ *  @param[in]  streamSize  Size of a stream object in bytes.
+ *  @param[in]  numberSize  Size of a number in bytes (of \c cl_float or \c cl_double).
+ */
+clrngStatus clrngParallelFill(clrngFillFunction fill, size_t streamSize, size_t numberSize,
+	size_t streamCount, void* streams, size_t numberCount, void* numbers, size_t threadCount, cl_uint layout);
+
+/*! @brief Generic implementation of the HostRandomU01Array functions
+ *
+ *  Same parameters as clrngParallelFill(); the streams are not modified.
+ */
+clrngStatus clrngHostRandomArray(clrngFillFunction fill, size_t streamSize, size_t numberSize,
+	size_t streamCount, const void* streams, size_t numberCount, void* numbers, size_t threadCount);
+
+
+
+/*! @brief Get a compiled program from the cache, or build and cache it
+ *
+ *  The program consists of the definition of `CLRNG_SINGLE_PRECISION` if
+ *  \c singlePrecision is true, of `CLRNG_MRG32K3A_FP_ARITHMETIC` for MRG32k3a
+ *  if the library was built with it, followed by \c source.  Programs are cached
+ *  per context, device, \c source pointer and precision, so \c source must
+ *  be a static string.  Builds and cache hits are counted in the statistics
+ *  of \c generator.  Error messages are attributed to \c caller.
+ *
+ *  @return     The program, to be released by the caller with clReleaseProgram(),
+ *              or `NULL` on error.
+ */
+cl_program clrngGetProgram(cl_uint generator, cl_command_queue queue, const char* source, cl_bool singlePrecision, const char* caller, clrngStatus* err);
+
+/*! @brief Enqueue a one-dimensional kernel of the library
+ *
+ *  Calls the callbacks set with clrngSetEnqueueCallbacks() and updates the
+ *  statistics of \c generator, with \c numberCount numbers of \c numberSize
+ *  bytes each written by the kernel.
+ */
+clrngStatus clrngEnqueueKernel(cl_uint generator, const char* caller, cl_command_queue queue, cl_kernel kernel,
+	size_t globalSize, size_t localSize, size_t numberCount, size_t numberSize,
+	cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent);
+
+/*! @brief Device kernels of a generator
+ */
+typedef struct clrngDeviceKernels_ {
+	cl_uint     generator;    /*!< one of clrngGenerator */
+	size_t      streamSize;   /*!< size of a stream object in bytes */
+	/*! @brief Source of the kernel
+	 *  `fillBufferU01(streams, streamCount, numberCount, numbers)`, which
+	 *  fills the numbers of one stream per work-item, in the interleaved
+	 *  layout, and ignores work-items beyond \c streamCount */
+	const char* fillSource;
+	/*! @brief Source of the kernel
+	 *  `fillBlocksU01(streams, streamCount, perStream, blockSize, blocksPerStream, numberCount, leaps, numbers)`,
+	 *  where work-item `s * blocksPerStream + b` jumps stream \c s ahead by
+	 *  `b * blockSize` values, applying `leaps[i]` for each bit \c i set in
+	 *  \c b, and generates the values of that block, up to value
+	 *  \c perStream of the stream and to output index \c numberCount */
+	const char* blockSource;
+	size_t      leapSize;     /*!< size of a leap in bytes, or 0 if the kernel takes no leaps */
+	/*! @brief Compute the \c count leaps of `blockSize * 2^i` values, `i = 0, ..., count - 1` */
+	void (*makeBlockLeaps)(cl_uint blockSize, size_t count, void* leaps);
+	/*! @brief Source of the kernel `advanceStreams(streams, streamCount, jump)`,
+	 *  which applies \c jump, passed by value, to the current state of each
+	 *  stream, and ignores work-items beyond \c streamCount; `NULL` if the
+	 *  generator has no jump-ahead */
+	const char* advanceSource;
+} clrngDeviceKernels;
+
+extern const clrngDeviceKernels clrngMrg31k3pDeviceKernels;
+extern const clrngDeviceKernels clrngMrg32k3aDeviceKernels;
+extern const clrngDeviceKernels clrngLfsr113DeviceKernels;
+extern const clrngDeviceKernels clrngPhilox432DeviceKernels;
+extern const clrngDeviceKernels clrngThreefry432DeviceKernels;
+
+/*! @brief Generic implementation of the DeviceRandomU01Array_ functions
+ *
+ *  Parameters must have been validated by the caller.
+ */
+clrngStatus clrngDeviceRandomArray(const clrngDeviceKernels* kernels,
+	size_t streamCount, cl_mem streams, size_t numberCount, cl_mem outBuffer,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent,
+	cl_bool singlePrecision, const char* caller);
+
+/*! @brief Generic implementation of the DeviceFillU01_ functions
+ *
+ *  Parameters must have been validated by the caller.
+ */
+clrngStatus clrngDeviceFillBlocks(const clrngDeviceKernels* kernels,
+	size_t streamCount, cl_mem streams, size_t numberCount, cl_mem outBuffer, size_t blockSize,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent,
+	cl_bool singlePrecision, const char* caller);
+
+/*! @brief Generic implementation of the DeviceAdvanceStreams functions
+ *
+ *  Parameters must have been validated by the caller; \c jump, of
+ *  \c jumpSize bytes, was computed on the host by the caller and is passed
+ *  to the `advanceStreams` kernel in a `__constant` buffer.
+ */
+clrngStatus clrngDeviceAdvance(const clrngDeviceKernels* kernels,
+	size_t count, cl_mem streams, const void* jump, size_t jumpSize,
+	cl_command_queue queue, cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent,
+	const char* caller);
+
+/*! @brief Work-group size chosen by clrngTuneDeviceKernels() for a kernel
+ *
+ *  Looks up the choices made in this process, then the on-disk cache.
+ *  @return     The work-group size, or 0 if the kernel was not tuned.
+ */
+size_t clrngTunedLocalSize(cl_uint generator, cl_device_id device, cl_bool singlePrecision);
+
+
+/*! @brief Number of baby steps of the largest search of clrngFindPosition()
+ *
+ *  Positions up to the square of this value (2^40) can be found.
+ */
+#define CLRNG_POSITION_BABY_STEPS ((size_t)1 << 20)
+
+/*! @brief Operations on the states of a generator used by clrngFindPosition()
+ */
+typedef struct clrngPositionSearch_ {
+	size_t stateSize;     /*!< size of a state object in bytes */
+	size_t leapSize;      /*!< size of a leap descriptor in bytes */
+	/*! @brief Advance a state by one step */
+	void (*step)(void* state);
+	/*! @brief Compute the descriptor of a leap of \c steps steps */
+	void (*makeLeap)(cl_uint steps, void* leap);
+	/*! @brief Apply a leap to a state, in place */
+	void (*leap)(const void* leap, void* state);
+} clrngPositionSearch;
+
+/*! @brief Find the number of steps from state \c from to state \c to
+ *
+ *  Uses a baby-step giant-step search, in time and memory proportional to
+ *  the square root of the distance; fails if the distance exceeds
+ *  `CLRNG_POSITION_BABY_STEPS^2`.  Error messages are attributed to \c caller.
+ */
+clrngStatus clrngFindPosition(const clrngPositionSearch* search, const void* from, const void* to, cl_ulong* position, const char* caller);
+
 
 #endif
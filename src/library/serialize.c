@@ -0,0 +1,275 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file serialize.c
+ * @brief Binary serialization of stream objects, common to all generators
+ *
+ * All values are stored as 32-bit little-endian words, so that files can be
+ * exchanged between hosts of different endianness.  A serialized array of
+ * streams is made of a header followed by one record per stream:
+ *
+ *     offset  size  content
+ *          0     8  magic string "CLRNGSTR"
+ *          8     4  format version (CLRNG_SERIAL_VERSION)
+ *         12     4  generator identifier (clrngSerialGenerator)
+ *         16     4  flags (clrngSerializeFlags)
+ *         20     4  number of words per state
+ *         24     8  number of streams (low word first)
+ *         32        records
+ *
+ * Each record contains the current state, followed by the initial state if
+ * CLRNG_SERIALIZE_INITIAL is set, and by the substream state if
+ * CLRNG_SERIALIZE_SUBSTREAM is set.
+ */
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+static const char serialMagic[8] = { 'C', 'L', 'R', 'N', 'G', 'S', 'T', 'R' };
+
+#define CLRNG_SERIAL_HEADER_SIZE 32
+#define CLRNG_SERIAL_KNOWN_FLAGS (CLRNG_SERIALIZE_INITIAL | CLRNG_SERIALIZE_SUBSTREAM)
+
+static void putWord(unsigned char* p, cl_uint w)
+{
+	p[0] = (unsigned char)(w);
+	p[1] = (unsigned char)(w >> 8);
+	p[2] = (unsigned char)(w >> 16);
+	p[3] = (unsigned char)(w >> 24);
+}
+
+static cl_uint getWord(const unsigned char* p)
+{
+	return (cl_uint)p[0] | ((cl_uint)p[1] << 8) | ((cl_uint)p[2] << 16) | ((cl_uint)p[3] << 24);
+}
+
+// number of states stored per record
+static size_t statesPerRecord(cl_uint flags)
+{
+	return 1 + ((flags & CLRNG_SERIALIZE_INITIAL) ? 1 : 0) + ((flags & CLRNG_SERIALIZE_SUBSTREAM) ? 1 : 0);
+}
+
+static size_t recordSize(size_t stateWords, cl_uint flags)
+{
+	return statesPerRecord(flags) * stateWords * 4;
+}
+
+static void writeHeader(const clrngSerialFormat* format, cl_uint flags, size_t count, unsigned char* p)
+{
+	memcpy(p, serialMagic, sizeof(serialMagic));
+	putWord(p + 8, CLRNG_SERIAL_VERSION);
+	putWord(p + 12, format->generator);
+	putWord(p + 16, flags);
+	putWord(p + 20, format->stateWords);
+	putWord(p + 24, (cl_uint)((cl_ulong)count & 0xffffffff));
+	putWord(p + 28, (cl_uint)((cl_ulong)count >> 32));
+}
+
+static void writeRecord(const clrngSerialFormat* format, cl_uint flags, const char* stream, unsigned char* p)
+{
+	// the states of a stream object are stored as current, initial, substream
+	cl_uint words[CLRNG_SERIAL_MAX_STATE_WORDS];
+	for (size_t s = 0; s < 3; s++) {
+		if ((s == 1 && !(flags & CLRNG_SERIALIZE_INITIAL)) || (s == 2 && !(flags & CLRNG_SERIALIZE_SUBSTREAM)))
+			continue;
+		format->pack(stream + s * format->stateSize, words);
+		for (size_t i = 0; i < format->stateWords; i++, p += 4)
+			putWord(p, words[i]);
+	}
+}
+
+static clrngStatus checkFlags(cl_uint flags, const char* caller)
+{
+	if (flags & ~(cl_uint)CLRNG_SERIAL_KNOWN_FLAGS)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): unknown serialization flags 0x%x", caller, flags);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngSerialWrite(const clrngSerialFormat* format, size_t count, const void* streams, cl_uint flags, void* buffer, size_t* bufSize)
+{
+	clrngStatus err = checkFlags(flags, "clrngSerializeStreams");
+	if (err != CLRNG_SUCCESS)
+		return err;
+
+	size_t recSize = recordSize(format->stateWords, flags);
+	size_t size = CLRNG_SERIAL_HEADER_SIZE + count * recSize;
+
+	if (buffer == NULL) {
+		*bufSize = size;
+		return CLRNG_SUCCESS;
+	}
+	if (*bufSize < size)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngSerializeStreams(): buffer too small (%lu bytes needed)", (unsigned long)size);
+
+	unsigned char* p = (unsigned char*)buffer;
+	writeHeader(format, flags, count, p);
+	p += CLRNG_SERIAL_HEADER_SIZE;
+	for (size_t k = 0; k < count; k++, p += recSize)
+		writeRecord(format, flags, (const char*)streams + k * format->streamSize, p);
+
+	*bufSize = size;
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngSerialWriteFile(const clrngSerialFormat* format, size_t count, const void* streams, cl_uint flags, FILE* file)
+{
+	clrngStatus err = checkFlags(flags, "clrngWriteStreams");
+	if (err != CLRNG_SUCCESS)
+		return err;
+
+	// records are packed into a small buffer that is flushed when full
+	unsigned char block[4096];
+	size_t recSize = recordSize(format->stateWords, flags);
+	size_t used = CLRNG_SERIAL_HEADER_SIZE;
+
+	writeHeader(format, flags, count, block);
+	for (size_t k = 0; k < count; k++) {
+		if (used + recSize > sizeof(block)) {
+			if (fwrite(block, 1, used, file) != used)
+				return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "clrngWriteStreams(): cannot write to file");
+			used = 0;
+		}
+		writeRecord(format, flags, (const char*)streams + k * format->streamSize, block + used);
+		used += recSize;
+	}
+	if (fwrite(block, 1, used, file) != used)
+		return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "clrngWriteStreams(): cannot write to file");
+
+	return CLRNG_SUCCESS;
+}
+
+static clrngStatus readHeader(const clrngSerialFormat* format, const void* buffer, size_t bufSize, size_t* count, cl_uint* flags, size_t* stateWords)
+{
+	const unsigned char* p = (const unsigned char*)buffer;
+
+	if (bufSize < CLRNG_SERIAL_HEADER_SIZE || memcmp(p, serialMagic, sizeof(serialMagic)) != 0)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngDeserializeStreams(): not a serialized stream array");
+	cl_uint version = getWord(p + 8);
+	if (version < CLRNG_SERIAL_MIN_VERSION || version > CLRNG_SERIAL_VERSION)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngDeserializeStreams(): unsupported format version %u", version);
+	if (getWord(p + 12) != format->generator)
+		return clrngSetErrorString(CLRNG_INVALID_RNG_TYPE, "clrngDeserializeStreams(): streams were serialized for another generator");
+	cl_uint words = getWord(p + 20);
+	if (words < format->minStateWords || words > format->stateWords)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngDeserializeStreams(): unexpected state size");
+
+	*flags = getWord(p + 16);
+	clrngStatus err = checkFlags(*flags, "clrngDeserializeStreams");
+	if (err != CLRNG_SUCCESS)
+		return err;
+
+	cl_ulong n = (cl_ulong)getWord(p + 24) | ((cl_ulong)getWord(p + 28) << 32);
+	size_t recSize = recordSize(words, *flags);
+	if (n > (bufSize - CLRNG_SERIAL_HEADER_SIZE) / recSize)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "clrngDeserializeStreams(): truncated buffer");
+
+	*count = (size_t)n;
+	*stateWords = words;
+	return CLRNG_SUCCESS;
+}
+
+static clrngStatus readRecords(const clrngSerialFormat* format, const void* buffer, size_t count, cl_uint flags, size_t stateWords, void* streams)
+{
+	const unsigned char* p = (const unsigned char*)buffer + CLRNG_SERIAL_HEADER_SIZE;
+	// words missing from older records stay zero
+	cl_uint words[CLRNG_SERIAL_MAX_STATE_WORDS] = { 0 };
+
+	for (size_t k = 0; k < count; k++) {
+		char* stream = (char*)streams + k * format->streamSize;
+		for (size_t s = 0; s < 3; s++) {
+			// missing initial and substream states start at the current state
+			if ((s == 1 && !(flags & CLRNG_SERIALIZE_INITIAL)) || (s == 2 && !(flags & CLRNG_SERIALIZE_SUBSTREAM))) {
+				memcpy(stream + s * format->stateSize, stream, format->stateSize);
+				continue;
+			}
+			for (size_t i = 0; i < stateWords; i++, p += 4)
+				words[i] = getWord(p);
+			clrngStatus err = format->unpack(words, stream + s * format->stateSize);
+			if (err != CLRNG_SUCCESS)
+				return err;
+		}
+		memset(stream + 3 * format->stateSize, 0, format->streamSize - 3 * format->stateSize);
+	}
+
+	return CLRNG_SUCCESS;
+}
+
+void* clrngSerialRead(const clrngSerialFormat* format, const void* buffer, size_t bufSize, size_t* count, clrngStatus* err)
+{
+	size_t count_ = 0;
+	cl_uint flags = 0;
+	size_t stateWords = 0;
+	void* streams = NULL;
+
+	clrngStatus err_ = readHeader(format, buffer, bufSize, &count_, &flags, &stateWords);
+	if (err_ == CLRNG_SUCCESS)
+		streams = format->alloc(count_, &err_);
+	if (err_ == CLRNG_SUCCESS) {
+		err_ = readRecords(format, buffer, count_, flags, stateWords, streams);
+		if (err_ != CLRNG_SUCCESS) {
+			clrngRelease(streams);
+			streams = NULL;
+		}
+	}
+	if (err_ != CLRNG_SUCCESS)
+		count_ = 0;
+
+	if (count != NULL)
+		*count = count_;
+	if (err != NULL)
+		*err = err_;
+
+	return streams;
+}
+
+void* clrngSerialReadFile(const clrngSerialFormat* format, const char* path, size_t* count, clrngStatus* err)
+{
+	size_t size;
+	clrngStatus err_;
+	void* streams = NULL;
+
+	const void* addr = clrngMapFile(path, CLRNG_MAP_READ_ONLY, &size, &err_);
+	if (err_ == CLRNG_SUCCESS)
+		streams = clrngSerialRead(format, addr, size, count, &err_);
+	else if (count != NULL)
+		*count = 0;
+	clrngUnmapFile(addr, size);
+
+	if (err != NULL)
+		*err = err_;
+
+	return streams;
+}
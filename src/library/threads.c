@@ -0,0 +1,247 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file threads.c
+ * @brief Portable worker threads with optional processor affinity, library lock and clock
+ */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#endif
+
+typedef struct worker_ {
+	clrngThreadFunction func;
+	void*               arg;
+	size_t              index;
+	size_t              count;
+	cl_bool             pin;
+} worker;
+
+#if defined(_WIN32)
+
+static DWORD_PTR nthProcessorMask(size_t n)
+{
+	DWORD_PTR process, system;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &process, &system) || process == 0)
+		return 0;
+	size_t available = 0;
+	for (DWORD_PTR m = process; m != 0; m &= m - 1)
+		available++;
+	n %= available;
+	for (DWORD_PTR bit = 1; bit != 0; bit <<= 1)
+		if ((process & bit) && n-- == 0)
+			return bit;
+	return 0;
+}
+
+size_t clrngProcessorCount(void)
+{
+	DWORD_PTR process, system;
+	size_t count = 0;
+	if (GetProcessAffinityMask(GetCurrentProcess(), &process, &system))
+		for (; process != 0; process &= process - 1)
+			count++;
+	return count > 0 ? count : 1;
+}
+
+static DWORD WINAPI workerMain(LPVOID arg)
+{
+	worker* w = (worker*)arg;
+	if (w->pin) {
+		DWORD_PTR mask = nthProcessorMask(w->index);
+		if (mask != 0)
+			SetThreadAffinityMask(GetCurrentThread(), mask);
+	}
+	w->func(w->index, w->count, w->arg);
+	return 0;
+}
+
+#else
+
+#ifdef __linux__
+static void pinToNthProcessor(size_t n)
+{
+	cpu_set_t process;
+	if (sched_getaffinity(0, sizeof(process), &process) != 0)
+		return;
+	size_t available = (size_t)CPU_COUNT(&process);
+	if (available == 0)
+		return;
+	n %= available;
+	for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (CPU_ISSET(cpu, &process) && n-- == 0) {
+			cpu_set_t target;
+			CPU_ZERO(&target);
+			CPU_SET(cpu, &target);
+			pthread_setaffinity_np(pthread_self(), sizeof(target), &target);
+			return;
+		}
+	}
+}
+#endif
+
+size_t clrngProcessorCount(void)
+{
+#ifdef __linux__
+	cpu_set_t process;
+	if (sched_getaffinity(0, sizeof(process), &process) == 0 && CPU_COUNT(&process) > 0)
+		return (size_t)CPU_COUNT(&process);
+#endif
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (size_t)count : 1;
+}
+
+static void* workerMain(void* arg)
+{
+	worker* w = (worker*)arg;
+#ifdef __linux__
+	if (w->pin)
+		pinToNthProcessor(w->index);
+#endif
+	w->func(w->index, w->count, w->arg);
+	return NULL;
+}
+
+#endif
+
+clrngStatus clrngRunThreads(size_t count, clrngThreadFunction func, void* arg, cl_bool pin)
+{
+	if (count <= 1) {
+		func(0, 1, arg);
+		return CLRNG_SUCCESS;
+	}
+
+	worker* workers = (worker*)clrngAlloc(count * sizeof(worker), 0, NULL);
+#ifdef _WIN32
+	HANDLE* threads = (HANDLE*)clrngAlloc(count * sizeof(HANDLE), 0, NULL);
+#else
+	pthread_t* threads = (pthread_t*)clrngAlloc(count * sizeof(pthread_t), 0, NULL);
+#endif
+	if (workers == NULL || threads == NULL) {
+		clrngRelease(workers);
+		clrngRelease(threads);
+		return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for threads", __func__);
+	}
+
+	// start the threads; if one cannot be created, run its work in this thread
+	for (size_t k = 0; k < count; k++) {
+		worker w = { func, arg, k, count, pin };
+		workers[k] = w;
+#ifdef _WIN32
+		threads[k] = CreateThread(NULL, 0, workerMain, &workers[k], 0, NULL);
+		if (threads[k] == NULL)
+			func(k, count, arg);
+#else
+		if (pthread_create(&threads[k], NULL, workerMain, &workers[k]) != 0) {
+			workers[k].func = NULL;
+			func(k, count, arg);
+		}
+#endif
+	}
+
+	for (size_t k = 0; k < count; k++) {
+#ifdef _WIN32
+		if (threads[k] != NULL) {
+			WaitForSingleObject(threads[k], INFINITE);
+			CloseHandle(threads[k]);
+		}
+#else
+		if (workers[k].func != NULL)
+			pthread_join(threads[k], NULL);
+#endif
+	}
+
+	clrngRelease(threads);
+	clrngRelease(workers);
+	return CLRNG_SUCCESS;
+}
+
+#if defined(_WIN32)
+
+static SRWLOCK libraryLock = SRWLOCK_INIT;
+
+void clrngLockLibrary(void)
+{
+	AcquireSRWLockExclusive(&libraryLock);
+}
+
+void clrngUnlockLibrary(void)
+{
+	ReleaseSRWLockExclusive(&libraryLock);
+}
+
+cl_double clrngWallTime(void)
+{
+	LARGE_INTEGER count, frequency;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return (cl_double)count.QuadPart / (cl_double)frequency.QuadPart;
+}
+
+#else
+
+static pthread_mutex_t libraryLock = PTHREAD_MUTEX_INITIALIZER;
+
+void clrngLockLibrary(void)
+{
+	pthread_mutex_lock(&libraryLock);
+}
+
+void clrngUnlockLibrary(void)
+{
+	pthread_mutex_unlock(&libraryLock);
+}
+
+cl_double clrngWallTime(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+#endif
@@ -0,0 +1,436 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/* @file tuning.c
+ * @brief Work-group size autotuning of the library kernels, with an on-disk cache
+ */
+#include <clRNG/clRNG.h>
+#include "private.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define makeDirectory(path) _mkdir(path)
+#define PATH_SEPARATOR      "\\"
+#else
+#include <sys/stat.h>
+#define makeDirectory(path) mkdir(path, 0755)
+#define PATH_SEPARATOR      "/"
+#endif
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define snprintf _snprintf
+#endif
+
+/*! @brief Number of streams of the benchmark of clrngTuneDeviceKernels() */
+#define TUNE_STREAMS (1 << 14)
+/*! @brief Number of values per stream of the benchmark of clrngTuneDeviceKernels() */
+#define TUNE_NUMBERS 64
+/*! @brief Number of timed runs per candidate, after one warm-up run */
+#define TUNE_REPEATS 3
+
+#define CACHE_FILE        "tuning.txt"
+#define CACHE_PATH_SIZE   1024
+#define CACHE_LINE_SIZE   1024
+#define DEVICE_KEY_SIZE   768
+
+/*! @brief Configuration of a kernel on a device, in this process
+ *
+ *  Entries with `tuning.tuned == CL_FALSE` record that the on-disk cache has
+ *  no choice for the kernel, so that it is read only once.
+ */
+typedef struct tuningEntry_ {
+	cl_device_id          device;
+	cl_uint               generator;
+	cl_bool               singlePrecision;
+	clrngDeviceTuning     tuning;
+	struct tuningEntry_*  next;
+} tuningEntry;
+
+// protected by clrngLockLibrary()
+static tuningEntry* tunings = NULL;
+
+static const clrngDeviceKernels* deviceKernels(cl_uint generator)
+{
+	switch (generator) {
+	case CLRNG_MRG31K3P:   return &clrngMrg31k3pDeviceKernels;
+	case CLRNG_MRG32K3A:   return &clrngMrg32k3aDeviceKernels;
+	case CLRNG_LFSR113:    return &clrngLfsr113DeviceKernels;
+	case CLRNG_PHILOX432:  return &clrngPhilox432DeviceKernels;
+	case CLRNG_THREEFRY432: return &clrngThreefry432DeviceKernels;
+	default:               return NULL;
+	}
+}
+
+/*! @brief Identify a device across processes by its vendor, name and driver version
+ */
+static void deviceKey(cl_device_id device, char* key)
+{
+	char vendor[256] = "", name[256] = "", driver[256] = "";
+	clGetDeviceInfo(device, CL_DEVICE_VENDOR, sizeof(vendor) - 1, vendor, NULL);
+	clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(name) - 1, name, NULL);
+	clGetDeviceInfo(device, CL_DRIVER_VERSION, sizeof(driver) - 1, driver, NULL);
+	snprintf(key, DEVICE_KEY_SIZE, "%s / %s / %s", vendor, name, driver);
+	// keep the key on one line
+	for (char* c = key; *c != '\0'; c++)
+		if (*c == '\n' || *c == '\r')
+			*c = ' ';
+}
+
+/*! @brief Path of the on-disk cache, creating its directory if \c create is true
+ *
+ *  @return     CL_FALSE if the cache is disabled.
+ */
+static cl_bool cachePath(char* path, cl_bool create)
+{
+	char dir[CACHE_PATH_SIZE];
+	const char* base = getenv("CLRNG_CACHE_DIR");
+	if (base != NULL) {
+		if (base[0] == '\0')
+			return CL_FALSE;
+		snprintf(dir, sizeof(dir), "%s", base);
+	}
+	else {
+#ifdef _WIN32
+		base = getenv("LOCALAPPDATA");
+		if (base == NULL || base[0] == '\0')
+			return CL_FALSE;
+		snprintf(dir, sizeof(dir), "%s\\clRNG", base);
+#else
+		base = getenv("XDG_CACHE_HOME");
+		if (base != NULL && base[0] != '\0')
+			snprintf(dir, sizeof(dir), "%s/clRNG", base);
+		else {
+			base = getenv("HOME");
+			if (base == NULL || base[0] == '\0')
+				return CL_FALSE;
+			snprintf(dir, sizeof(dir), "%s/.cache", base);
+			if (create)
+				makeDirectory(dir);
+			snprintf(dir, sizeof(dir), "%s/.cache/clRNG", base);
+		}
+#endif
+	}
+	if (create)
+		makeDirectory(dir);
+	return snprintf(path, CACHE_PATH_SIZE, "%s" PATH_SEPARATOR CACHE_FILE, dir) < CACHE_PATH_SIZE;
+}
+
+/*! @brief Read the choice for a kernel from the on-disk cache
+ *
+ *  Each line holds the generator, the precision (`s` or `d`), the work-group
+ *  size, the measured throughput and the device key; the last matching line
+ *  wins.
+ *
+ *  @return     CL_TRUE if a choice was found.
+ */
+static cl_bool readCache(cl_uint generator, cl_bool singlePrecision, const char* key, clrngDeviceTuning* tuning)
+{
+	char path[CACHE_PATH_SIZE];
+	if (!cachePath(path, CL_FALSE))
+		return CL_FALSE;
+	FILE* file = fopen(path, "r");
+	if (file == NULL)
+		return CL_FALSE;
+
+	cl_bool found = CL_FALSE;
+	char line[CACHE_LINE_SIZE];
+	while (fgets(line, sizeof(line), file) != NULL) {
+		unsigned int g;
+		char precision;
+		unsigned long localSize;
+		double rate;
+		int keyOffset = -1;
+		if (sscanf(line, "%u %c %lu %lg %n", &g, &precision, &localSize, &rate, &keyOffset) < 4 || keyOffset < 0)
+			continue;
+		line[strcspn(line, "\r\n")] = '\0';
+		if (g == generator && precision == (singlePrecision ? 's' : 'd') && localSize > 0 &&
+		    strcmp(line + keyOffset, key) == 0) {
+			tuning->localSize = (size_t)localSize;
+			tuning->numbersPerSecond = rate;
+			tuning->tuned = CL_TRUE;
+			found = CL_TRUE;
+		}
+	}
+	fclose(file);
+	return found;
+}
+
+/*! @brief Append a choice to the on-disk cache (errors are ignored)
+ */
+static void writeCache(cl_uint generator, cl_bool singlePrecision, const char* key, const clrngDeviceTuning* tuning)
+{
+	char path[CACHE_PATH_SIZE];
+	if (!cachePath(path, CL_TRUE))
+		return;
+	FILE* file = fopen(path, "a");
+	if (file == NULL)
+		return;
+	fprintf(file, "%u %c %lu %.6g %s\n", generator, singlePrecision ? 's' : 'd',
+		(unsigned long)tuning->localSize, tuning->numbersPerSecond, key);
+	fclose(file);
+}
+
+/*! @brief Record a configuration in this process, replacing any previous one
+ */
+static void storeTuning(cl_uint generator, cl_device_id device, cl_bool singlePrecision, const clrngDeviceTuning* tuning)
+{
+	clrngLockLibrary();
+	tuningEntry* e = tunings;
+	while (e != NULL && !(e->device == device && e->generator == generator && e->singlePrecision == singlePrecision))
+		e = e->next;
+	if (e == NULL) {
+		e = (tuningEntry*)clrngAlloc(sizeof(tuningEntry), 0, NULL);
+		if (e != NULL) {
+			e->device = device;
+			e->generator = generator;
+			e->singlePrecision = singlePrecision;
+			e->next = tunings;
+			tunings = e;
+		}
+	}
+	if (e != NULL)
+		e->tuning = *tuning;
+	clrngUnlockLibrary();
+}
+
+/*! @brief Configuration chosen for a kernel in this process or in the on-disk cache
+ */
+static cl_bool findTuning(cl_uint generator, cl_device_id device, cl_bool singlePrecision, clrngDeviceTuning* tuning)
+{
+	cl_bool found = CL_FALSE;
+	clrngLockLibrary();
+	for (tuningEntry* e = tunings; e != NULL && !found; e = e->next) {
+		if (e->device == device && e->generator == generator && e->singlePrecision == singlePrecision) {
+			*tuning = e->tuning;
+			found = CL_TRUE;
+		}
+	}
+	clrngUnlockLibrary();
+	if (found)
+		return tuning->tuned;
+
+	// first use of this kernel on this device
+	char key[DEVICE_KEY_SIZE];
+	deviceKey(device, key);
+	clrngDeviceTuning cached = { 0, 0.0, CL_FALSE };
+	readCache(generator, singlePrecision, key, &cached);
+	storeTuning(generator, device, singlePrecision, &cached);
+	*tuning = cached;
+	return cached.tuned;
+}
+
+size_t clrngTunedLocalSize(cl_uint generator, cl_device_id device, cl_bool singlePrecision)
+{
+	clrngDeviceTuning tuning;
+	return findTuning(generator, device, singlePrecision, &tuning) ? tuning.localSize : 0;
+}
+
+/*! @brief Create the fill kernel of a generator for the device of \c queue
+ */
+static cl_kernel createFillKernel(const clrngDeviceKernels* kernels, cl_command_queue queue, cl_bool singlePrecision, const char* caller, clrngStatus* status)
+{
+	cl_program program = clrngGetProgram(kernels->generator, queue, kernels->fillSource, singlePrecision, caller, status);
+	if (program == NULL)
+		return NULL;
+	cl_int err;
+	cl_kernel kernel = clCreateKernel(program, "fillBufferU01", &err);
+	clReleaseProgram(program);
+	if (err != CLRNG_SUCCESS) {
+		*status = clrngSetErrorString(err, "%s(): cannot create kernel", caller);
+		return NULL;
+	}
+	return kernel;
+}
+
+/*! @brief Time the fill kernel with each candidate work-group size and keep the fastest
+ */
+static clrngStatus benchmark(const clrngDeviceKernels* kernels, cl_command_queue queue, cl_device_id device, cl_bool singlePrecision, clrngDeviceTuning* best, const char* caller)
+{
+	clrngStatus status;
+	cl_kernel kernel = createFillKernel(kernels, queue, singlePrecision, caller, &status);
+	if (kernel == NULL)
+		return status;
+
+	cl_int err;
+	size_t maxLocal, multiple;
+	err = clGetKernelWorkGroupInfo(kernel, device, CL_KERNEL_WORK_GROUP_SIZE, sizeof(maxLocal), &maxLocal, NULL);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(err, "%s(): cannot read CL_KERNEL_WORK_GROUP_SIZE", caller);
+	}
+	if (clGetKernelWorkGroupInfo(kernel, device, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, sizeof(multiple), &multiple, NULL) != CLRNG_SUCCESS || multiple == 0)
+		multiple = 1;
+
+	cl_context ctx;
+	err = clGetCommandQueueInfo(queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, NULL);
+	if (err != CLRNG_SUCCESS) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(err, "%s(): cannot retrieve context", caller);
+	}
+
+	// the speed of the generators does not depend on the stream states
+	size_t streamsSize = TUNE_STREAMS * kernels->streamSize;
+	void* hostStreams = clrngAlloc(streamsSize, 0, NULL);
+	if (hostStreams == NULL) {
+		clReleaseKernel(kernel);
+		return clrngSetErrorString(CLRNG_OUT_OF_RESOURCES, "%s(): could not allocate memory for streams", caller);
+	}
+	memset(hostStreams, 0, streamsSize);
+	cl_int err2;
+	cl_mem streams = clCreateBuffer(ctx, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, streamsSize, hostStreams, &err);
+	cl_mem numbers = clCreateBuffer(ctx, CL_MEM_WRITE_ONLY,
+		(size_t)TUNE_STREAMS * TUNE_NUMBERS * (singlePrecision ? sizeof(cl_float) : sizeof(cl_double)), NULL, &err2);
+	clrngRelease(hostStreams);
+	if (err == CLRNG_SUCCESS)
+		err = err2;
+
+	cl_uint streamCount = TUNE_STREAMS;
+	cl_uint numberCount = TUNE_NUMBERS;
+	if (err == CLRNG_SUCCESS) {
+		err = clSetKernelArg(kernel, 0, sizeof(streams), &streams);
+		err |= clSetKernelArg(kernel, 1, sizeof(streamCount), &streamCount);
+		err |= clSetKernelArg(kernel, 2, sizeof(numberCount), &numberCount);
+		err |= clSetKernelArg(kernel, 3, sizeof(numbers), &numbers);
+	}
+
+	best->localSize = 0;
+	best->numbersPerSecond = 0.0;
+	best->tuned = CL_FALSE;
+
+	// candidates: doubling multiples of the preferred multiple, up to the maximum
+	size_t local = multiple < maxLocal ? multiple : maxLocal;
+	while (err == CLRNG_SUCCESS) {
+		size_t global = (TUNE_STREAMS + local - 1) / local * local;
+		cl_double seconds = 0.0;
+		cl_int runErr = CLRNG_SUCCESS;
+		// the first run is a warm-up
+		for (int r = 0; r <= TUNE_REPEATS && runErr == CLRNG_SUCCESS; r++) {
+			cl_double start = clrngWallTime();
+			runErr = clEnqueueNDRangeKernel(queue, kernel, 1, NULL, &global, &local, 0, NULL, NULL);
+			if (runErr == CLRNG_SUCCESS)
+				runErr = clFinish(queue);
+			cl_double elapsed = clrngWallTime() - start;
+			if (r == 1 || (r > 1 && elapsed < seconds))
+				seconds = elapsed;
+		}
+		// a candidate that cannot run is skipped
+		if (runErr == CLRNG_SUCCESS && seconds > 0.0) {
+			cl_double rate = (cl_double)TUNE_STREAMS * TUNE_NUMBERS / seconds;
+			if (rate > best->numbersPerSecond) {
+				best->localSize = local;
+				best->numbersPerSecond = rate;
+				best->tuned = CL_TRUE;
+			}
+		}
+		if (local == maxLocal)
+			break;
+		local = 2 * local <= maxLocal ? 2 * local : maxLocal;
+	}
+
+	if (numbers != NULL)
+		clReleaseMemObject(numbers);
+	if (streams != NULL)
+		clReleaseMemObject(streams);
+	clReleaseKernel(kernel);
+
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot set up the benchmark", caller);
+	if (!best->tuned)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): no work-group size could run the kernel", caller);
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngTuneDeviceKernels(cl_uint generator, cl_command_queue queue, cl_bool singlePrecision, clrngDeviceTuning* tuning)
+{
+	//Check params
+	const clrngDeviceKernels* kernels = deviceKernels(generator);
+	if (kernels == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): invalid generator", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
+
+	cl_device_id device;
+	cl_int err = clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &device, NULL);
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot retrieve the device", __func__);
+
+	clrngDeviceTuning best;
+	clrngStatus status = benchmark(kernels, queue, device, singlePrecision, &best, __func__);
+	if (status != CLRNG_SUCCESS)
+		return status;
+
+	storeTuning(generator, device, singlePrecision, &best);
+	char key[DEVICE_KEY_SIZE];
+	deviceKey(device, key);
+	writeCache(generator, singlePrecision, key, &best);
+
+	if (tuning != NULL)
+		*tuning = best;
+	return CLRNG_SUCCESS;
+}
+
+clrngStatus clrngGetDeviceTuning(cl_uint generator, cl_command_queue queue, cl_bool singlePrecision, clrngDeviceTuning* tuning)
+{
+	//Check params
+	const clrngDeviceKernels* kernels = deviceKernels(generator);
+	if (kernels == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): invalid generator", __func__);
+	if (queue == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): queue cannot be NULL", __func__);
+	if (tuning == NULL)
+		return clrngSetErrorString(CLRNG_INVALID_VALUE, "%s(): tuning cannot be NULL", __func__);
+
+	cl_device_id device;
+	cl_int err = clGetCommandQueueInfo(queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &device, NULL);
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot retrieve the device", __func__);
+
+	if (findTuning(generator, device, singlePrecision, tuning))
+		return CLRNG_SUCCESS;
+
+	// default: the largest work-group size of the kernel
+	clrngStatus status;
+	cl_kernel kernel = createFillKernel(kernels, queue, singlePrecision, __func__, &status);
+	if (kernel == NULL)
+		return status;
+	err = clGetKernelWorkGroupInfo(kernel, device, CL_KERNEL_WORK_GROUP_SIZE, sizeof(tuning->localSize), &tuning->localSize, NULL);
+	clReleaseKernel(kernel);
+	if (err != CLRNG_SUCCESS)
+		return clrngSetErrorString(err, "%s(): cannot read CL_KERNEL_WORK_GROUP_SIZE", __func__);
+	tuning->numbersPerSecond = 0.0;
+	tuning->tuned = CL_FALSE;
+	return CLRNG_SUCCESS;
+}
@@ -463,6 +463,344 @@ int CTEST_MANGLE(checkAdvanceStreams)()
 }
 
 
+#ifndef CTEST_NO_ADVANCE
+/*! @brief Structure for use with deviceAdvanceStreams()
+ */
+typedef struct DeviceAdvanceParams_ {
+  size_t        count;
+  clrngStream*  streams;
+  cl_int        e;
+  cl_int        c;
+} DeviceAdvanceParams;
+
+/*! @brief Helper function for checkDeviceAdvanceStreams()
+ */
+static int deviceAdvanceStreams(cl_context context, cl_device_id device, cl_command_queue queue, void* data_)
+{
+  const DeviceAdvanceParams* data = (const DeviceAdvanceParams*) data_;
+  size_t size = data->count * sizeof(clrngStream);
+
+  cl_int err;
+  cl_mem streams_buf = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, size, data->streams, &err);
+  check_error(err, "cannot create streams buffer");
+
+  err = clrngDeviceAdvanceStreams(data->count, streams_buf, data->e, data->c, queue, 0, NULL, NULL);
+  check_error(err, NULL);
+
+  err = clEnqueueReadBuffer(queue, streams_buf, CL_TRUE, 0, size, data->streams, 0, NULL, NULL);
+  check_error(err, "cannot read streams buffer");
+
+  clReleaseMemObject(streams_buf);
+
+  return EXIT_SUCCESS;
+}
+#endif
+
+/*! @brief Compare clrngDeviceAdvanceStreams() with clrngAdvanceStreams()
+ */
+int CTEST_MANGLE(checkDeviceAdvanceStreams)(const DeviceSelect* dev)
+{
+  int ret = EXIT_SUCCESS;
+#ifdef CTEST_NO_ADVANCE
+  fprintf(stderr, "  SKIP     %8s        -  %10s clrngDeviceAdvanceStreams()\n", "", RNG_TYPE_S);
+#else
+  size_t count = 1000;
+  struct e_c_type {
+    cl_int e;
+    cl_int c;
+  };
+  struct e_c_type e_c[] = { {0,2}, {10,-30}, {-10,1030}, {67,-5}, {-100,3} };
+  size_t num_tests = 0;
+
+  clrngStatus err;
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+  clrngStream* streams = clrngCreateStreams(creator, count, NULL, &err);
+  check_error(err, NULL);
+  clrngStream* expected = clrngCopyStreams(count, streams, &err);
+  check_error(err, NULL);
+  // leave the streams at various positions within their first values
+  for (size_t i = 0; i < count; i++) {
+    for (size_t j = 0; j < i % 7; j++)
+      clrngRandomU01(&streams[i]);
+  }
+
+  for (size_t k = 0; k < CTEST_ARRAY_SIZE(e_c) && ret == EXIT_SUCCESS; k++) {
+    err = clrngCopyOverStreams(count, expected, streams);
+    check_error(err, NULL);
+    err = clrngAdvanceStreams(count, expected, e_c[k].e, e_c[k].c);
+    check_error(err, NULL);
+
+    DeviceAdvanceParams params = { count, streams, e_c[k].e, e_c[k].c };
+    ret |= call_with_opencl(dev->platform_index, dev->device_type, dev->device_index, &deviceAdvanceStreams, &params, false);
+
+    for (size_t i = 0; i < count && ret == EXIT_SUCCESS; i++) {
+      if (CTEST_MANGLE(compareState)(&streams[i].current, &expected[i].current)) {
+        if (ctestVerbose)
+          printf("\n%4sStates do not match for stream %" SIZE_T_FORMAT " with e = %d and c = %d.\n",
+              "", i, e_c[k].e, e_c[k].c);
+        ret = EXIT_FAILURE;
+      }
+    }
+    num_tests += count;
+  }
+
+  err = clrngDestroyStreams(expected);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(streams);
+  check_error(err, NULL);
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngDeviceAdvanceStreams()\n",
+      SUCCESS_STR(ret), num_tests, RNG_TYPE_S);
+#endif
+
+  return ret;
+}
+
+/*! @brief Check clrngGetStreamPosition() after drawing known numbers of values
+ *
+ *  With CLRNG_INSTRUMENT, also check the draw counters.
+ */
+int CTEST_MANGLE(checkStreamPosition)()
+{
+  int ret = EXIT_SUCCESS;
+  const cl_ulong positions[] = { 0, 1, 3, 4, 5, 1000, 1025, 40000, 1100003 };
+  size_t num_substream_steps = 7;
+  size_t num_values_53 = 10;
+  cl_double buffer[10];
+  clrngStatus err;
+
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+
+  clrngStream* stream = clrngCreateStreams(creator, 1, NULL, &err);
+  check_error(err, NULL);
+
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+  for (size_t i = 0; i < CTEST_ARRAY_SIZE(positions) && ret == EXIT_SUCCESS; i++) {
+    clrngStream* copy = clrngCopyStreams(1, stream, &err);
+    check_error(err, NULL);
+
+    for (cl_ulong k = 0; k < positions[i]; k++)
+      clrngRandomU01(copy);
+
+    cl_ulong position = 0;
+    err = clrngGetStreamPosition(copy, &position);
+    check_error(err, NULL);
+    if (position != positions[i]) {
+      if (ctestVerbose)
+        printf("\n%4sPosition %llu, expected %llu.\n\n", "", (unsigned long long)position, (unsigned long long)positions[i]);
+      ret = EXIT_FAILURE;
+    }
+#ifdef CLRNG_INSTRUMENT
+    if (copy->draws != positions[i])
+      ret = EXIT_FAILURE;
+#endif
+
+    // positions are relative to the current substream
+    err = clrngForwardToNextSubstreams(1, copy);
+    check_error(err, NULL);
+    for (size_t k = 0; k < num_substream_steps; k++)
+      clrngRandomU01(copy);
+    err = clrngRandomU01Array_53(copy, num_values_53, buffer);
+    check_error(err, NULL);
+    err = clrngGetStreamPosition(copy, &position);
+    check_error(err, NULL);
+    if (position != num_substream_steps + 2 * num_values_53)
+      ret = EXIT_FAILURE;
+#ifdef CLRNG_INSTRUMENT
+    if (copy->draws != positions[i] + num_substream_steps + 2 * num_values_53)
+      ret = EXIT_FAILURE;
+#endif
+
+    err = clrngDestroyStreams(copy);
+    check_error(err, NULL);
+  }
+
+  err = clrngDestroyStreams(stream);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngGetStreamPosition()\n",
+      SUCCESS_STR(ret), 2 * CTEST_ARRAY_SIZE(positions), RNG_TYPE_S);
+
+  return ret;
+}
+
+
+/*! @brief Check the absolute positions and arbitrary jumps of counter-based generators
+ *
+ *  Jumps are checked against clrngAdvanceStreams(), against each other and
+ *  against the values drawn after them.
+ */
+int CTEST_MANGLE(checkAbsolutePosition)()
+{
+  int ret = EXIT_SUCCESS;
+#ifndef CTEST_ABSOLUTE_POSITION
+  fprintf(stderr, "  SKIP     %8s        -  %10s clrngGetPosition()\n", "", RNG_TYPE_S);
+#else
+  size_t num_tests = 0;
+  clrngStatus err;
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+  clrngStream* stream = clrngCreateStreams(creator, 1, NULL, &err);
+  check_error(err, NULL);
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+  for (int i = 0; i < 3; i++)
+    clrngRandomU01(stream);
+  clrngStream* copy = clrngCopyStreams(1, stream, &err);
+  check_error(err, NULL);
+  clrngPosition start;
+  err = clrngGetPosition(stream, &start);
+  check_error(err, NULL);
+
+  // 1001 steps with clrngAdvanceStreams(), back with clrngJumpStreams()
+  const clrngPosition small = { { { 0, 0 }, { 0, 250 } }, 1 };
+  err = clrngAdvanceStreams(1, copy, 0, 1001);
+  check_error(err, NULL);
+  clrngPosition pos;
+  err = clrngGetPosition(copy, &pos);
+  check_error(err, NULL);
+  clrngPosition expected = start;
+  expected.ctr.L.lsb += 250;
+  expected.index += 1;
+  if (expected.index >= 4) {
+    expected.index -= 4;
+    expected.ctr.L.lsb++;
+  }
+  ret |= memcmp(&pos, &expected, sizeof(pos)) ? EXIT_FAILURE : EXIT_SUCCESS;
+  err = clrngJumpStreams(1, copy, &small, CL_TRUE);
+  check_error(err, NULL);
+  ret |= CTEST_MANGLE(compareState)(&copy->current, &stream->current) ? EXIT_FAILURE : EXIT_SUCCESS;
+  num_tests += 2;
+
+  // 2^100 + 3 steps, both ways
+  const clrngPosition large = { { { 4, 0 }, { 0, 0 } }, 3 };
+  err = clrngAdvanceStreams(1, copy, 100, 3);
+  check_error(err, NULL);
+  clrngStream* other = clrngCopyStreams(1, stream, &err);
+  check_error(err, NULL);
+  err = clrngJumpStreams(1, other, &large, CL_FALSE);
+  check_error(err, NULL);
+  ret |= CTEST_MANGLE(compareState)(&copy->current, &other->current) ? EXIT_FAILURE : EXIT_SUCCESS;
+  err = clrngJumpStreams(1, other, &large, CL_TRUE);
+  check_error(err, NULL);
+  ret |= CTEST_MANGLE(compareState)(&other->current, &stream->current) ? EXIT_FAILURE : EXIT_SUCCESS;
+  num_tests += 2;
+
+  // the period is 2^130
+  err = clrngAdvanceStreams(1, other, 129, 0);
+  check_error(err, NULL);
+  err = clrngAdvanceStreams(1, other, -129, 0);
+  check_error(err, NULL);
+  err = clrngAdvanceStreams(1, other, 129, 0);
+  check_error(err, NULL);
+  err = clrngAdvanceStreams(1, other, 129, 0);
+  check_error(err, NULL);
+  ret |= CTEST_MANGLE(compareState)(&other->current, &stream->current) ? EXIT_FAILURE : EXIT_SUCCESS;
+  num_tests++;
+
+  // the values drawn after setting a position within a deck
+  const clrngPosition target = { { { 0x89abcdefu, 0x01234567u }, { 0xfedcba98u, 0x76543210u } }, 0 };
+  err = clrngSetPosition(copy, &target);
+  check_error(err, NULL);
+  for (int i = 0; i < 6; i++)
+    clrngRandomU01(copy);
+  clrngPosition target6 = target;
+  target6.ctr.L.lsb++;
+  target6.index = 2;
+  err = clrngSetPosition(other, &target6);
+  check_error(err, NULL);
+  for (int i = 0; i < 5; i++)
+    ret |= clrngRandomU01(copy) != clrngRandomU01(other) ? EXIT_FAILURE : EXIT_SUCCESS;
+  num_tests++;
+
+  // invalid index
+  clrngPosition invalid = target;
+  invalid.index = 4;
+  ret |= clrngSetPosition(other, &invalid) != CLRNG_INVALID_VALUE ? EXIT_FAILURE : EXIT_SUCCESS;
+  ret |= clrngJumpStreams(1, other, &invalid, CL_FALSE) != CLRNG_INVALID_VALUE ? EXIT_FAILURE : EXIT_SUCCESS;
+  num_tests += 2;
+
+  err = clrngDestroyStreams(other);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(copy);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(stream);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngGetPosition()\n",
+      SUCCESS_STR(ret), num_tests, RNG_TYPE_S);
+#endif
+
+  return ret;
+}
+
+/*! @brief Check the validation and reset of the device statistics
+ *
+ *  The statistics themselves are checked along with clrngDeviceRandomU01Array().
+ */
+int CTEST_MANGLE(checkDeviceStats)()
+{
+  int ret = EXIT_SUCCESS;
+  clrngDeviceStats stats;
+  clrngStatus err;
+
+  err = clrngResetDeviceStats();
+  check_error(err, NULL);
+  for (cl_uint g = CLRNG_ALL_GENERATORS; g <= CLRNG_THREEFRY432; g++) {
+    memset(&stats, 0xff, sizeof(stats));
+    err = clrngGetDeviceStats(g, &stats);
+    check_error(err, NULL);
+    if (stats.programBuilds != 0 || stats.programCacheHits != 0 || stats.buildSeconds != 0.0 ||
+        stats.kernelLaunches != 0 || stats.enqueueSeconds != 0.0 ||
+        stats.kernelsTimed != 0 || stats.kernelSeconds != 0.0 ||
+        stats.bytesWritten != 0 || stats.numbersGenerated != 0)
+      ret = EXIT_FAILURE;
+  }
+
+  // invalid arguments
+  if (clrngGetDeviceStats(CLRNG_THREEFRY432 + 1, &stats) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+  if (clrngGetDeviceStats(CLRNG_ALL_GENERATORS, NULL) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngGetDeviceStats()\n",
+      SUCCESS_STR(ret), (size_t) 7, RNG_TYPE_S);
+
+  return ret;
+}
+
+/*! @brief Check the validation of the arguments of the tuning functions
+ *
+ *  The tuned kernels are checked along with clrngDeviceRandomU01Array().
+ */
+int CTEST_MANGLE(checkDeviceTuning)()
+{
+  int ret = EXIT_SUCCESS;
+  clrngDeviceTuning tuning;
+
+  if (clrngTuneDeviceKernels(CLRNG_ALL_GENERATORS, NULL, CL_FALSE, &tuning) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+  if (clrngTuneDeviceKernels(CLRNG_THREEFRY432 + 1, NULL, CL_FALSE, &tuning) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+  if (clrngTuneDeviceKernels(CLRNG_MRG31K3P, NULL, CL_TRUE, &tuning) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+  if (clrngGetDeviceTuning(CLRNG_ALL_GENERATORS, NULL, CL_FALSE, &tuning) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+  if (clrngGetDeviceTuning(CLRNG_PHILOX432, NULL, CL_FALSE, &tuning) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngTuneDeviceKernels()\n",
+      SUCCESS_STR(ret), (size_t) 5, RNG_TYPE_S);
+
+  return ret;
+}
+
 /*! @brief Create multiple streams in sequence and advance them by many substream.
  *  
  *  Check clrngForwardToNextSubstreams() against the states defined by
@@ -564,6 +902,183 @@ int CTEST_MANGLE(checkForwardToNextSubstreams)()
 }
 
 
+/*! @brief Check that compact state buffers round-trip the current states only
+ */
+int CTEST_MANGLE(checkStreamStates)()
+{
+  int ret = EXIT_SUCCESS;
+  size_t num_streams = 10;
+  size_t num_steps = 30;
+  clrngStatus err;
+
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+
+  clrngStream* streams1 = clrngCreateStreams(creator, num_streams, NULL, &err);
+  check_error(err, NULL);
+
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+  clrngStream* streams2 = clrngCopyStreams(num_streams, streams1, &err);
+  check_error(err, NULL);
+
+  clrngStreamState* states = (clrngStreamState*) malloc(num_streams * sizeof(clrngStreamState));
+
+  // advance the copies, as a kernel would, and move their states back
+  for (size_t j = 0; j < num_streams; j++)
+    for (size_t k = 0; k < num_steps + j; k++)
+      clrngRandomU01(&streams2[j]);
+
+  err = clrngGetStreamStates(num_streams, streams2, states);
+  check_error(err, NULL);
+
+  err = clrngSetStreamStates(num_streams, streams1, states);
+  check_error(err, NULL);
+
+  for (size_t j = 0; j < num_streams && ret == EXIT_SUCCESS; j++) {
+    if (CTEST_MANGLE(compareState)(&streams1[j].current, &streams2[j].current) ||
+        CTEST_MANGLE(compareState)(&streams1[j].initial, &streams2[j].initial) ||
+        CTEST_MANGLE(compareState)(&streams1[j].substream, &streams2[j].substream)) {
+      ret = EXIT_FAILURE;
+      if (ctestVerbose) {
+        printf("\n%4sStates at index %" SIZE_T_FORMAT " do not match.\n", "", j);
+        printf("%4sRestored state:\n", "");
+        printf("%8s", "");
+        CTEST_MANGLE(writeState)(stdout, &streams1[j].current);
+        printf("%4sExpected state:\n", "");
+        printf("%8s", "");
+        CTEST_MANGLE(writeState)(stdout, &streams2[j].current);
+        printf("\n");
+      }
+    }
+  }
+
+  // the initial states must have survived
+  err = clrngRewindStreams(num_streams, streams1);
+  check_error(err, NULL);
+  err = clrngRewindStreams(num_streams, streams2);
+  check_error(err, NULL);
+  for (size_t j = 0; j < num_streams && ret == EXIT_SUCCESS; j++)
+    if (CTEST_MANGLE(compareState)(&streams1[j].current, &streams2[j].current))
+      ret = EXIT_FAILURE;
+
+  free(states);
+  err = clrngDestroyStreams(streams1);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(streams2);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngSetStreamStates()\n",
+      SUCCESS_STR(ret), num_streams, RNG_TYPE_S);
+
+  return ret;
+}
+
+
+/*! @brief Allocation statistics kept by countingAlloc() and countingFree()
+ */
+typedef struct AllocCounter_ {
+  size_t allocs;
+  size_t frees;
+} AllocCounter;
+
+static void* CTEST_MANGLE(countingAlloc)(size_t size, size_t alignment, void* userData)
+{
+  ((AllocCounter*) userData)->allocs++;
+  size = (size + alignment - 1) & ~(alignment - 1);
+#ifdef _MSC_VER
+  return _aligned_malloc(size, alignment);
+#else
+  return aligned_alloc(alignment, size);
+#endif
+}
+
+static void CTEST_MANGLE(countingFree)(void* ptr, size_t size, void* userData)
+{
+  (void) size;
+  ((AllocCounter*) userData)->frees++;
+#ifdef _MSC_VER
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+/*! @brief Check that custom allocators are used and honor the alignment
+ */
+int CTEST_MANGLE(checkAllocator)()
+{
+  int ret = EXIT_SUCCESS;
+  size_t num_streams = 10;
+  size_t alignment = 4096;
+  AllocCounter counter = { 0, 0 };
+  clrngAllocator allocator = { CTEST_MANGLE(countingAlloc), CTEST_MANGLE(countingFree), &counter };
+  clrngStatus err;
+
+  clrngStreamCreator* creator1 = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+  clrngStreamCreator* creator2 = clrngCopyStreamCreatorEx(NULL, &allocator, &err);
+  check_error(err, NULL);
+
+  clrngStream* streams1 = clrngCreateStreams(creator1, num_streams, NULL, &err);
+  check_error(err, NULL);
+  size_t bufSize;
+  clrngStream* streams2 = clrngCreateStreamsEx(creator2, num_streams, alignment, &allocator, &bufSize, &err);
+  check_error(err, NULL);
+  clrngStream* streams3 = clrngCopyStreamsEx(num_streams, streams1, alignment, &allocator, &err);
+  check_error(err, NULL);
+
+  if (((size_t) streams2 % alignment) != 0 || ((size_t) streams3 % alignment) != 0 ||
+      bufSize != num_streams * sizeof(clrngStream))
+    ret = EXIT_FAILURE;
+
+  for (size_t j = 0; j < num_streams && ret == EXIT_SUCCESS; j++)
+    if (CTEST_MANGLE(compareState)(&streams1[j].current, &streams2[j].current) ||
+        CTEST_MANGLE(compareState)(&streams1[j].current, &streams3[j].current))
+      ret = EXIT_FAILURE;
+
+  // the global allocator is used by functions without an allocator argument,
+  // and objects are released through the allocator they came from
+  err = clrngSetAllocator(CTEST_MANGLE(countingAlloc), CTEST_MANGLE(countingFree), &counter);
+  check_error(err, NULL);
+  clrngStream* streams4 = clrngCopyStreams(num_streams, streams1, &err);
+  check_error(err, NULL);
+  err = clrngSetAllocator(NULL, NULL, NULL);
+  check_error(err, NULL);
+
+  if (counter.allocs != 4 || counter.frees != 0)
+    ret = EXIT_FAILURE;
+
+  err = clrngDestroyStreams(streams4);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(streams3);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(streams2);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(streams1);
+  check_error(err, NULL);
+  err = clrngDestroyStreamCreator(creator2);
+  check_error(err, NULL);
+  err = clrngDestroyStreamCreator(creator1);
+  check_error(err, NULL);
+
+  if (counter.frees != 4)
+    ret = EXIT_FAILURE;
+
+  // invalid arguments
+  if (clrngAllocStreamsEx(num_streams, 3, NULL, NULL, &err) != NULL || err != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+  if (clrngSetAllocator(CTEST_MANGLE(countingAlloc), NULL, NULL) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngSetAllocator()\n",
+      SUCCESS_STR(ret), 3 * num_streams, RNG_TYPE_S);
+
+  return ret;
+}
+
+
 /*! @brief Create multiple streams in sequence and advance them by many substream.
  *  
  *  Check clrngMakeSubstreams() against clrngForwardToNextSubstreams().
@@ -630,3 +1145,381 @@ int CTEST_MANGLE(checkMakeSubstreams)()
   return ret;
 }
 
+
+
+// compare the states of deserialized streams with those of the original streams
+static int CTEST_MANGLE(compareSerializedStreams)(size_t num_streams, const clrngStream* streams, const clrngStream* restored, cl_uint flags)
+{
+  for (size_t j = 0; j < num_streams; j++) {
+    const clrngStreamState* initial   = (flags & CLRNG_SERIALIZE_INITIAL)   ? &streams[j].initial   : &streams[j].current;
+    const clrngStreamState* substream = (flags & CLRNG_SERIALIZE_SUBSTREAM) ? &streams[j].substream : &streams[j].current;
+    if (CTEST_MANGLE(compareState)(&streams[j].current, &restored[j].current) ||
+        CTEST_MANGLE(compareState)(initial, &restored[j].initial) ||
+        CTEST_MANGLE(compareState)(substream, &restored[j].substream)) {
+      if (ctestVerbose) {
+        printf("\n%4sStates do not match for stream %" SIZE_T_FORMAT " with flags %u.\n", "", j, flags);
+        printf("%4sOriginal current state:\n", "");
+        printf("%8s", "");
+        CTEST_MANGLE(writeState)(stdout, &streams[j].current);
+        printf("%4sDeserialized current state:\n", "");
+        printf("%8s", "");
+        CTEST_MANGLE(writeState)(stdout, &restored[j].current);
+        printf("\n");
+      }
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/*! @brief Check clrngSerializeStreams(), clrngDeserializeStreams(),
+ *  clrngWriteStreams() and clrngReadStreams()
+ */
+int CTEST_MANGLE(checkSerializeStreams)()
+{
+  int ret = EXIT_SUCCESS;
+  size_t num_streams = 10;
+  const cl_uint all_flags[] = { CLRNG_SERIALIZE_CURRENT, CLRNG_SERIALIZE_INITIAL, CLRNG_SERIALIZE_ALL };
+  const char* path = "ctest_" RNG_TYPE_S "_streams.bin";
+  clrngStatus err;
+
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+
+  clrngStream* streams = clrngCreateStreams(creator, num_streams, NULL, &err);
+  check_error(err, NULL);
+
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+  // make the current, initial and substream states different
+  for (size_t j = 0; j < num_streams; j++) {
+    err = clrngForwardToNextSubstreams(1, &streams[j]);
+    check_error(err, NULL);
+    for (size_t k = 0; k < 3 * j + 1; k++)
+      clrngRandomU01(&streams[j]);
+  }
+
+  for (size_t f = 0; f < CTEST_ARRAY_SIZE(all_flags) && ret == EXIT_SUCCESS; f++) {
+    cl_uint flags = all_flags[f];
+    size_t count;
+
+    // memory buffer
+    size_t bufSize;
+    err = clrngSerializeStreams(num_streams, streams, flags, NULL, &bufSize);
+    check_error(err, NULL);
+    unsigned char* buffer = (unsigned char*)malloc(bufSize);
+    err = clrngSerializeStreams(num_streams, streams, flags, buffer, &bufSize);
+    check_error(err, NULL);
+
+    clrngStream* restored = clrngDeserializeStreams(buffer, bufSize, &count, &err);
+    check_error(err, NULL);
+    if (count != num_streams || CTEST_MANGLE(compareSerializedStreams)(num_streams, streams, restored, flags))
+      ret = EXIT_FAILURE;
+    err = clrngDestroyStreams(restored);
+    check_error(err, NULL);
+
+    // truncated buffer and wrong generator must be rejected
+    if (clrngDeserializeStreams(buffer, bufSize - 1, &count, &err) != NULL || err == CLRNG_SUCCESS || count != 0)
+      ret = EXIT_FAILURE;
+    buffer[12] ^= 0xff;
+    if (clrngDeserializeStreams(buffer, bufSize, &count, &err) != NULL || err != CLRNG_INVALID_RNG_TYPE)
+      ret = EXIT_FAILURE;
+    buffer[12] ^= 0xff;
+
+    // so must a newer format version
+    buffer[8]++;
+    if (clrngDeserializeStreams(buffer, bufSize, &count, &err) != NULL || err != CLRNG_INVALID_VALUE)
+      ret = EXIT_FAILURE;
+
+    // file
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+      check_error(CLRNG_INVALID_VALUE, "cannot open %s", path);
+    err = clrngWriteStreams(num_streams, streams, flags, file);
+    check_error(err, NULL);
+    fclose(file);
+
+    restored = clrngReadStreams(path, &count, &err);
+    check_error(err, NULL);
+    if (count != num_streams || CTEST_MANGLE(compareSerializedStreams)(num_streams, streams, restored, flags))
+      ret = EXIT_FAILURE;
+    err = clrngDestroyStreams(restored);
+    check_error(err, NULL);
+    remove(path);
+
+    free(buffer);
+  }
+
+  err = clrngDestroyStreams(streams);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngSerializeStreams()\n",
+      SUCCESS_STR(ret), CTEST_ARRAY_SIZE(all_flags) * num_streams, RNG_TYPE_S);
+
+  return ret;
+}
+
+
+/*! @brief Check the outputs of counter-based generators against known answers
+ *
+ *  Requires `CTEST_MANGLE(knownAnswers)[]` to be defined; only the vectors for
+ *  the number of rounds the generator was compiled with, given by the value of
+ *  \c CTEST_KNOWN_ANSWERS, are checked.
+ */
+int CTEST_MANGLE(checkKnownAnswers)()
+{
+  int ret = EXIT_SUCCESS;
+#ifndef CTEST_KNOWN_ANSWERS
+  fprintf(stderr, "  SKIP     %8s        -  %10s known answers\n", "", RNG_TYPE_S);
+#else
+  size_t num_tests = 0;
+  clrngStatus err;
+  clrngStream* stream = clrngAllocStreams(1, NULL, &err);
+  check_error(err, NULL);
+
+  for (size_t i = 0; i < CTEST_ARRAY_SIZE(CTEST_MANGLE(knownAnswers)); i++) {
+    const cl_uint* v = CTEST_MANGLE(knownAnswers)[i];
+    if (v[0] != CTEST_KNOWN_ANSWERS)
+      continue;
+    // the deck is generated when moving inside it
+    clrngPosition pos = { { { v[4], v[3] }, { v[2], v[1] } }, 1 };
+    err = clrngMakeKeyedState(((cl_ulong)v[6] << 32) | v[5], &stream->current);
+    check_error(err, NULL);
+    err = clrngSetPosition(stream, &pos);
+    check_error(err, NULL);
+    // the deck holds the outputs in reverse order
+    for (size_t j = 0; j < 4; j++)
+      if (stream->current.deck[3 - j] != v[7 + j])
+        ret = EXIT_FAILURE;
+    num_tests++;
+  }
+
+  err = clrngDestroyStreams(stream);
+  check_error(err, NULL);
+
+  if (num_tests == 0)
+    fprintf(stderr, "  SKIP     %8s        -  %10s known answers (%d rounds)\n", "", RNG_TYPE_S, CTEST_KNOWN_ANSWERS);
+  else
+    printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s known answers (%d rounds)\n",
+        SUCCESS_STR(ret), num_tests, RNG_TYPE_S, CTEST_KNOWN_ANSWERS);
+#endif
+
+  return ret;
+}
+
+/*! @brief Check stream creators that give each stream its own key
+ *
+ *  Keyed streams are checked against clrngMakeKeyedState(), and serialized
+ *  keyed streams against the originals.  Records written before the key was
+ *  part of the state must still be readable.
+ */
+int CTEST_MANGLE(checkKeyedStreams)()
+{
+  int ret = EXIT_SUCCESS;
+#ifndef CTEST_KEYED_STREAMS
+  fprintf(stderr, "  SKIP     %8s        -  %10s clrngChangeStreamsKeying()\n", "", RNG_TYPE_S);
+#else
+  size_t num_streams = 4;
+  size_t num_tests = 0;
+  clrngStatus err;
+
+  ret |= clrngChangeStreamsKeying(NULL, CL_TRUE) != CLRNG_INVALID_STREAM_CREATOR ? EXIT_FAILURE : EXIT_SUCCESS;
+  num_tests++;
+
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+  err = clrngChangeStreamsKeying(creator, CL_TRUE);
+  check_error(err, NULL);
+
+  // stream k has key k and starts at counter 0, even after a rewind
+  clrngStream* streams = clrngCreateStreams(creator, num_streams, NULL, &err);
+  check_error(err, NULL);
+  err = clrngRewindStreamCreator(creator);
+  check_error(err, NULL);
+  clrngStream* again = clrngCreateStreams(creator, 1, NULL, &err);
+  check_error(err, NULL);
+  for (size_t k = 0; k < num_streams; k++) {
+    clrngStreamState state;
+    err = clrngMakeKeyedState(k, &state);
+    check_error(err, NULL);
+    ret |= CTEST_MANGLE(compareState)(&streams[k].current, &state) ? EXIT_FAILURE : EXIT_SUCCESS;
+    ret |= memcmp(streams[k].current.deck, state.deck, sizeof(state.deck)) ? EXIT_FAILURE : EXIT_SUCCESS;
+    num_tests++;
+  }
+  ret |= CTEST_MANGLE(compareState)(&again->current, &streams[0].current) ? EXIT_FAILURE : EXIT_SUCCESS;
+  ret |= clrngRandomU01(&streams[0]) == clrngRandomU01(&streams[1]) ? EXIT_FAILURE : EXIT_SUCCESS;
+  num_tests += 2;
+
+  // the key survives serialization
+  size_t bufSize;
+  size_t count;
+  err = clrngSerializeStreams(num_streams, streams, CLRNG_SERIALIZE_ALL, NULL, &bufSize);
+  check_error(err, NULL);
+  unsigned char* buffer = (unsigned char*)malloc(bufSize);
+  err = clrngSerializeStreams(num_streams, streams, CLRNG_SERIALIZE_ALL, buffer, &bufSize);
+  check_error(err, NULL);
+  clrngStream* restored = clrngDeserializeStreams(buffer, bufSize, &count, &err);
+  check_error(err, NULL);
+  if (count != num_streams || CTEST_MANGLE(compareSerializedStreams)(num_streams, streams, restored, CLRNG_SERIALIZE_ALL))
+    ret = EXIT_FAILURE;
+  num_tests++;
+  err = clrngDestroyStreams(restored);
+  check_error(err, NULL);
+  free(buffer);
+
+  // a record without key (5 words per state) reads as key 0
+  clrngStreamCreator* plainCreator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+  clrngStream* plain = clrngCreateStreams(plainCreator, 1, NULL, &err);
+  check_error(err, NULL);
+  err = clrngDestroyStreamCreator(plainCreator);
+  check_error(err, NULL);
+  clrngRandomU01(plain);
+  err = clrngSerializeStreams(1, plain, CLRNG_SERIALIZE_CURRENT, NULL, &bufSize);
+  check_error(err, NULL);
+  buffer = (unsigned char*)malloc(bufSize);
+  err = clrngSerializeStreams(1, plain, CLRNG_SERIALIZE_CURRENT, buffer, &bufSize);
+  check_error(err, NULL);
+  buffer[20] = 5;
+  restored = clrngDeserializeStreams(buffer, bufSize - 8, &count, &err);
+  check_error(err, NULL);
+  if (count != 1 || CTEST_MANGLE(compareSerializedStreams)(1, plain, restored, CLRNG_SERIALIZE_CURRENT))
+    ret = EXIT_FAILURE;
+  num_tests++;
+  err = clrngDestroyStreams(restored);
+  check_error(err, NULL);
+  free(buffer);
+
+  err = clrngDestroyStreams(plain);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(again);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(streams);
+  check_error(err, NULL);
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngChangeStreamsKeying()\n",
+      SUCCESS_STR(ret), num_tests, RNG_TYPE_S);
+#endif
+
+  return ret;
+}
+
+
+/*! @brief Check stream pools against clrngCreateStreams()
+ */
+int CTEST_MANGLE(checkStreamPool)()
+{
+  int ret = EXIT_SUCCESS;
+  size_t num_streams = 1000;
+  size_t num_steps = 7;
+  const size_t indices[] = { 999, 0, 500, 1, 998, 2 };
+  const char* path = "ctest_" RNG_TYPE_S "_pool.bin";
+  clrngStatus err;
+
+  // reference streams
+  clrngStreamCreator* creator1 = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+  clrngStream* streams = clrngCreateStreams(creator1, num_streams, NULL, &err);
+  check_error(err, NULL);
+  clrngStream* next1 = clrngCreateStreams(creator1, 1, NULL, &err);
+  check_error(err, NULL);
+  err = clrngDestroyStreamCreator(creator1);
+  check_error(err, NULL);
+
+  cl_uint all_flags[] = { CLRNG_POOL_SPARSE, CLRNG_POOL_PRECOMPUTE };
+  for (size_t f = 0; f < CTEST_ARRAY_SIZE(all_flags) && ret == EXIT_SUCCESS; f++) {
+
+    clrngStreamCreator* creator2 = clrngCopyStreamCreator(NULL, &err);
+    check_error(err, NULL);
+    clrngStreamPool* pool = clrngCreateStreamPool(creator2, num_streams, path, all_flags[f], &err);
+    check_error(err, NULL);
+
+    if (clrngGetStreamPoolSize(pool) != num_streams)
+      ret = EXIT_FAILURE;
+
+    // the creator skips the streams of the pool
+    clrngStream* next2 = clrngCreateStreams(creator2, 1, NULL, &err);
+    check_error(err, NULL);
+    if (CTEST_MANGLE(compareState)(&next1->current, &next2->current))
+      ret = EXIT_FAILURE;
+    err = clrngDestroyStreams(next2);
+    check_error(err, NULL);
+    err = clrngDestroyStreamCreator(creator2);
+    check_error(err, NULL);
+
+    // streams accessed in place, in arbitrary order
+    for (size_t i = 0; i < CTEST_ARRAY_SIZE(indices) && ret == EXIT_SUCCESS; i++) {
+      size_t k = indices[i];
+      clrngStream* stream = clrngGetPoolStream(pool, k, &err);
+      check_error(err, NULL);
+      if (CTEST_MANGLE(compareState)(&stream->current, &streams[k].current) ||
+          CTEST_MANGLE(compareState)(&stream->initial, &streams[k].initial) ||
+          CTEST_MANGLE(compareState)(&stream->substream, &streams[k].substream)) {
+        ret = EXIT_FAILURE;
+        if (ctestVerbose) {
+          printf("\n%4sStates do not match for pool stream %" SIZE_T_FORMAT ".\n", "", k);
+          printf("%4sWith clrngGetPoolStream():\n", "");
+          printf("%8s", "");
+          CTEST_MANGLE(writeState)(stdout, &stream->current);
+          printf("%4sWith clrngCreateStreams():\n", "");
+          printf("%8s", "");
+          CTEST_MANGLE(writeState)(stdout, &streams[k].current);
+          printf("\n");
+        }
+      }
+    }
+
+    // changes persist in the file
+    clrngStream* stream = clrngGetPoolStream(pool, indices[0], &err);
+    check_error(err, NULL);
+    clrngStream* expected = clrngCopyStreams(num_streams, streams, &err);
+    check_error(err, NULL);
+    for (size_t k = 0; k < num_steps; k++) {
+      clrngRandomU01(stream);
+      clrngRandomU01(&expected[indices[0]]);
+    }
+    err = clrngSyncStreamPool(pool);
+    check_error(err, NULL);
+    err = clrngDestroyStreamPool(pool);
+    check_error(err, NULL);
+
+    pool = clrngOpenStreamPool(path, CLRNG_POOL_READ_ONLY, &err);
+    check_error(err, NULL);
+    if (clrngGetPoolStream(pool, 0, &err) != NULL || err == CLRNG_SUCCESS)
+      ret = EXIT_FAILURE;
+    clrngStream* copies = clrngAllocStreams(num_streams, NULL, &err);
+    check_error(err, NULL);
+    err = clrngCopyPoolStreams(pool, 0, num_streams, copies);
+    check_error(err, NULL);
+    for (size_t k = 0; k < num_streams && ret == EXIT_SUCCESS; k++) {
+      if (CTEST_MANGLE(compareState)(&copies[k].current, &expected[k].current) ||
+          CTEST_MANGLE(compareState)(&copies[k].initial, &expected[k].initial)) {
+        ret = EXIT_FAILURE;
+        if (ctestVerbose)
+          printf("\n%4sStates do not match for stream %" SIZE_T_FORMAT " of the reopened pool.\n", "", k);
+      }
+    }
+    if (clrngCopyPoolStreams(pool, num_streams, 1, copies) == CLRNG_SUCCESS)
+      ret = EXIT_FAILURE;
+
+    err = clrngDestroyStreamPool(pool);
+    check_error(err, NULL);
+    err = clrngDestroyStreams(copies);
+    check_error(err, NULL);
+    err = clrngDestroyStreams(expected);
+    check_error(err, NULL);
+    remove(path);
+  }
+
+  err = clrngDestroyStreams(streams);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(next1);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngCreateStreamPool()\n",
+      SUCCESS_STR(ret), CTEST_ARRAY_SIZE(all_flags) * (CTEST_ARRAY_SIZE(indices) + num_streams + 3), RNG_TYPE_S);
+  return ret;
+}
@@ -40,6 +40,7 @@ int CTEST_MANGLE(checkSuccessiveStates)();
 //int CTEST_MANGLE_PREC(checkRandomU01,float)();
 int CTEST_MANGLE_PREC(checkRandomU01,double)();
 int CTEST_MANGLE_PREC(checkRandomInteger,double)();
+int CTEST_MANGLE_PREC(checkRandomU01_53,double)();
 int CTEST_MANGLE(checkCreateStreams)();
 int CTEST_MANGLE(checkRewindStreamCreator)();
 int CTEST_MANGLE(checkChangeStreamsSpacing)();
@@ -47,11 +48,28 @@ int CTEST_MANGLE(checkAdvanceStreams)();
 int CTEST_MANGLE(checkRewindStreams)();
 int CTEST_MANGLE(checkForwardToNextSubstreams)();
 int CTEST_MANGLE(checkMakeSubstreams)();
+int CTEST_MANGLE(checkStreamStates)();
+int CTEST_MANGLE(checkAllocator)();
+int CTEST_MANGLE(checkStreamPosition)();
+int CTEST_MANGLE(checkAbsolutePosition)();
+int CTEST_MANGLE(checkDeviceStats)();
+int CTEST_MANGLE(checkDeviceTuning)();
+int CTEST_MANGLE(checkSerializeStreams)();
+int CTEST_MANGLE(checkKnownAnswers)();
+int CTEST_MANGLE(checkKeyedStreams)();
+int CTEST_MANGLE(checkStreamPool)();
 int CTEST_MANGLE_PREC(checkCombinedOperations,float)();
 int CTEST_MANGLE_PREC(checkCombinedOperations,double)();
+int CTEST_MANGLE_PREC(checkParallelFill,float)();
+int CTEST_MANGLE_PREC(checkParallelFill,double)();
+int CTEST_MANGLE_PREC(checkHostRandomArray,float)();
+int CTEST_MANGLE_PREC(checkHostRandomArray,double)();
 int CTEST_MANGLE_PREC(checkDeviceOperations,float)(const DeviceSelect*);
 int CTEST_MANGLE_PREC(checkDeviceOperations,double)(const DeviceSelect*);
 int CTEST_MANGLE_PREC(checkDeviceRandomArray,float)(const DeviceSelect*);
 int CTEST_MANGLE_PREC(checkDeviceRandomArray,double)(const DeviceSelect*);
+int CTEST_MANGLE_PREC(checkDeviceFill,float)(const DeviceSelect*);
+int CTEST_MANGLE_PREC(checkDeviceFill,double)(const DeviceSelect*);
+int CTEST_MANGLE(checkDeviceAdvanceStreams)(const DeviceSelect*);
 
 #endif
@@ -35,6 +35,8 @@
  *
  *  These tests must be compiled twice for every generator: with and
  *  without CLRNG_SINGLE_PRECISION.
+ *  The checks against expected values are skipped if CTEST_NO_EXPECTED_VALUES
+ *  is defined, when the generator was configured for values that have none.
  */
 
 #include "mangle.h"
@@ -76,6 +78,10 @@ void    ctestPhilox432_writeState  (FILE* file, const clrngStreamState* state);
  */
 int CTEST_MANGLE_PREC2(checkRandomU01)()
 {
+#ifdef CTEST_NO_EXPECTED_VALUES
+  fprintf(stderr, "  SKIP     %8s        -  %10s clrngRandomU01() [%s] (no expected values)\n", "", RNG_TYPE_S, PREC_STR);
+  return EXIT_SUCCESS;
+#else
   int ret = EXIT_SUCCESS;
   size_t num_states = CTEST_ARRAY_SIZE(CTEST_MANGLE(expectedRandomU01Values));
   clrngStatus err;
@@ -114,6 +120,7 @@ int CTEST_MANGLE_PREC2(checkRandomU01)()
       SUCCESS_STR(ret), num_states, RNG_TYPE_S, PREC_STR);
 
   return ret;
+#endif
 }
 
 
@@ -123,6 +130,10 @@ int CTEST_MANGLE_PREC2(checkRandomU01)()
  */
 int CTEST_MANGLE_PREC2(checkRandomInteger)()
 {
+#ifdef CTEST_NO_EXPECTED_VALUES
+  fprintf(stderr, "  SKIP     %8s        -  %10s clrngRandomInteger() [%s] (no expected values)\n", "", RNG_TYPE_S, PREC_STR);
+  return EXIT_SUCCESS;
+#else
   int ret = EXIT_SUCCESS;
 
   struct bounds_type {
@@ -178,6 +189,109 @@ int CTEST_MANGLE_PREC2(checkRandomInteger)()
         SUCCESS_STR(ret), (num_values * num_bounds), RNG_TYPE_S, low, high, PREC_STR);
   }
 
+  return ret;
+#endif
+}
+
+
+/*! @brief Check clrngRandomU01_53() and clrngRandomU01Array_53()
+ *
+ *  Each full-precision value must lie within one output granularity of the
+ *  first of the two expected U01 values it consumes, and the array version
+ *  must reproduce the scalar version bit for bit, leaving the stream in the
+ *  same state.
+ */
+int CTEST_MANGLE_PREC2(checkRandomU01_53)()
+{
+  int ret = EXIT_SUCCESS;
+#ifdef CTEST_NO_EXPECTED_VALUES
+  size_t num_values = 0;
+#else
+  size_t num_values = CTEST_ARRAY_SIZE(CTEST_MANGLE(expectedRandomU01Values)) / 2;
+#endif
+  size_t num_array = 1000;
+  clrngStatus err;
+
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+
+  clrngStream* stream1 = clrngCreateStreams(creator, 1, NULL, &err);
+  check_error(err, NULL);
+
+  clrngStream* stream2 = clrngCopyStreams(1, stream1, &err);
+  check_error(err, NULL);
+
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+#ifndef CTEST_NO_EXPECTED_VALUES
+  for (size_t i = 0; i < num_values && ret == EXIT_SUCCESS; i++) {
+    cl_double u = clrngRandomU01_53(stream1);
+    cl_double u1 = CTEST_MANGLE(expectedRandomU01Values)[2 * i];
+    if (ctestVerbose >= 2)
+      printf("%8s%.18f\n", "", u);
+    if (!(u > 0.0 && u < 1.0) || fabs(u - u1) > 1.0 / (1UL << 30)) {
+      ret = EXIT_FAILURE;
+      if (ctestVerbose) {
+        printf("\n%4sValue out of range at iteration %" SIZE_T_FORMAT ".\n", "", i);
+        printf("%4sWith clrngRandomU01_53():\n", "");
+        printf("%8s%.18f\n", "", u);
+        printf("%4sExpected value close to:\n", "");
+        printf("%8s%.18f\n", "", u1);
+        printf("\n");
+      }
+    }
+  }
+#endif
+
+  cl_double* values1 = (cl_double*) malloc(num_array * sizeof(cl_double));
+  cl_double* values2 = (cl_double*) malloc(num_array * sizeof(cl_double));
+  for (size_t i = 0; i < num_array; i++)
+    values1[i] = clrngRandomU01_53(stream1);
+  err = clrngRewindStreams(1, stream2);
+  check_error(err, NULL);
+  for (size_t i = 0; i < num_values; i++)
+    clrngRandomU01_53(stream2);
+  err = clrngRandomU01Array_53(stream2, num_array, values2);
+  check_error(err, NULL);
+
+  for (size_t i = 0; i < num_array && ret == EXIT_SUCCESS; i++) {
+    if (values1[i] != values2[i]) {
+      ret = EXIT_FAILURE;
+      if (ctestVerbose) {
+        printf("\n%4sValues do not match at index %" SIZE_T_FORMAT ".\n", "", i);
+        printf("%4sWith clrngRandomU01Array_53():\n", "");
+        printf("%8s%.18f\n", "", values2[i]);
+        printf("%4sWith clrngRandomU01_53():\n", "");
+        printf("%8s%.18f\n", "", values1[i]);
+        printf("\n");
+      }
+    }
+  }
+  if (ret == EXIT_SUCCESS && CTEST_MANGLE(compareState)(&stream1->current, &stream2->current)) {
+    ret = EXIT_FAILURE;
+    if (ctestVerbose) {
+      printf("\n%4sStates do not match after clrngRandomU01Array_53().\n", "");
+      printf("%8s", "");
+      CTEST_MANGLE(writeState)(stdout, &stream2->current);
+      printf("%4sExpected state:\n", "");
+      printf("%8s", "");
+      CTEST_MANGLE(writeState)(stdout, &stream1->current);
+      printf("\n");
+    }
+  }
+
+  free(values1);
+  free(values2);
+
+  err = clrngDestroyStreams(stream1);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(stream2);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngRandomU01_53() [%s]\n",
+      SUCCESS_STR(ret), num_values + num_array, RNG_TYPE_S, PREC_STR);
+
   return ret;
 }
 #endif
@@ -205,6 +319,13 @@ typedef struct DeviceRandomArrayParams_ {
   fp_type*      output;
 } DeviceRandomArrayParams;
 
+/*! @brief Enqueue callback for deviceRandomArray() that counts its calls
+ */
+static void countEnqueue(const clrngEnqueueInfo* info, void* userData)
+{
+  (*(size_t*) userData)++;
+}
+
 /*! @brief Helper function for checkDeviceRandomArray()
  */
 static int deviceRandomArray(cl_context context, cl_device_id device, cl_command_queue queue, void* data_)
@@ -222,6 +343,13 @@ static int deviceRandomArray(cl_context context, cl_device_id device, cl_command
       output_count * sizeof(fp_type), NULL, &err);
   check_error(err, "cannot create numbers buffer");
 
+  clrngDeviceStats stats1, stats2;
+  err = clrngGetDeviceStats(CLRNG_ALL_GENERATORS, &stats1);
+  check_error(err, NULL);
+  size_t enqueues = 0;
+  err = clrngSetEnqueueCallbacks(countEnqueue, countEnqueue, &enqueues);
+  check_error(err, NULL);
+
   // fill array on the device
   cl_event event;
   err = clrngDeviceRandomU01Array(data->stream_count, streams_buf, output_count, numbers_buf, 1, &queue, 0, NULL, &event);
@@ -233,7 +361,30 @@ static int deviceRandomArray(cl_context context, cl_device_id device, cl_command
   err = clEnqueueReadBuffer(queue, numbers_buf, CL_TRUE, 0, output_count * sizeof(fp_type), data->output, 0, NULL, NULL);
   check_error(err, "cannot read output buffer");
 
-  return EXIT_SUCCESS;
+  err = clrngSetEnqueueCallbacks(NULL, NULL, NULL);
+  check_error(err, NULL);
+  err = clrngGetDeviceStats(CLRNG_ALL_GENERATORS, &stats2);
+  check_error(err, NULL);
+  err = clrngReleaseContextPrograms(context);
+  check_error(err, NULL);
+
+  // one kernel, compiled or taken from the cache
+  int ret = EXIT_SUCCESS;
+  if (enqueues != 2 ||
+      stats2.kernelLaunches - stats1.kernelLaunches != 1 ||
+      stats2.programBuilds + stats2.programCacheHits - stats1.programBuilds - stats1.programCacheHits != 1 ||
+      stats2.numbersGenerated - stats1.numbersGenerated != output_count ||
+      stats2.bytesWritten - stats1.bytesWritten != output_count * sizeof(fp_type)) {
+    if (ctestVerbose)
+      printf("\n%4sDevice statistics do not match the enqueued kernel.\n", "");
+    ret = EXIT_FAILURE;
+  }
+
+  clReleaseEvent(event);
+  clReleaseMemObject(numbers_buf);
+  clReleaseMemObject(streams_buf);
+
+  return ret;
 }
 
 /*! @brief Fill and compare arrays of random numbers generated on the host and device.
@@ -260,10 +411,9 @@ int CTEST_MANGLE_PREC2(checkDeviceRandomArrayHelper)(
   // function.
 
   DeviceRandomArrayParams params = { stream_count, streams, output_ratio, device_output };
-  call_with_opencl(dev->platform_index, dev->device_type, dev->device_index, &deviceRandomArray, &params, false);
+  int ret = call_with_opencl(dev->platform_index, dev->device_type, dev->device_index, &deviceRandomArray, &params, false);
   hostRandomArray(stream_count, streams, output_ratio, host_output);
 
-  int ret = EXIT_SUCCESS;
   for (size_t i = 0; i < output_count && ret == EXIT_SUCCESS; i++) {
     if (device_output[i] != host_output[i]) {
       if (ctestVerbose) {
@@ -292,24 +442,271 @@ int CTEST_MANGLE_PREC2(checkDeviceRandomArrayHelper)(
 
 int CTEST_MANGLE_PREC2(checkDeviceRandomArray)(const DeviceSelect* dev)
 {
-  size_t stream_count = 1 << 8;
+  // the second count is not a multiple of usual work-group sizes
+  const size_t stream_counts[] = { 1 << 8, 1000 };
   size_t output_ratio = 1 << 8;
+  int ret = EXIT_SUCCESS;
 
   clrngStatus err;
   clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
   check_error(err, NULL);
 
+  for (size_t k = 0; k < CTEST_ARRAY_SIZE(stream_counts); k++) {
+    clrngStream* streams = clrngCreateStreams(creator, stream_counts[k], NULL, &err);
+    check_error(err, NULL);
+
+    ret |= CTEST_MANGLE_PREC2(checkDeviceRandomArrayHelper)(stream_counts[k], streams, output_ratio, dev);
+
+    err = clrngDestroyStreams(streams);
+    check_error(err, NULL);
+  }
+
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+  return ret;
+}
+
+
+/*! @brief Structure for use with deviceFill()
+ */
+typedef struct DeviceFillParams_ {
+  size_t        stream_count;
+  clrngStream*  streams;
+  size_t        number_count;
+  size_t        block_size;
+  fp_type*      output;
+} DeviceFillParams;
+
+/*! @brief Helper function for checkDeviceFill()
+ */
+static int deviceFill(cl_context context, cl_device_id device, cl_command_queue queue, void* data_)
+{
+  const DeviceFillParams* data = (const DeviceFillParams*) data_;
+
+  cl_int err;
+  cl_mem streams_buf = clCreateBuffer(context,
+      CL_MEM_HOST_WRITE_ONLY | CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+      data->stream_count * sizeof(clrngStream), data->streams, &err);
+  check_error(err, "cannot create streams buffer");
+  cl_mem numbers_buf = clCreateBuffer(context,
+      CL_MEM_HOST_READ_ONLY | CL_MEM_WRITE_ONLY,
+      data->number_count * sizeof(fp_type), NULL, &err);
+  check_error(err, "cannot create numbers buffer");
+
+  err = clrngDeviceFillU01(data->stream_count, streams_buf, data->number_count, numbers_buf, data->block_size, queue, 0, NULL, NULL);
+  check_error(err, NULL);
+
+  err = clEnqueueReadBuffer(queue, numbers_buf, CL_TRUE, 0, data->number_count * sizeof(fp_type), data->output, 0, NULL, NULL);
+  check_error(err, "cannot read output buffer");
+
+  clReleaseMemObject(numbers_buf);
+  clReleaseMemObject(streams_buf);
+
+  return EXIT_SUCCESS;
+}
+
+/*! @brief Compare clrngDeviceFillU01() with a sequential fill on the host
+ *
+ *  The number counts are not multiples of the stream count, and the block
+ *  sizes include the automatic choice.
+ */
+int CTEST_MANGLE_PREC2(checkDeviceFill)(const DeviceSelect* dev)
+{
+  int ret = EXIT_SUCCESS;
+  size_t stream_count = 5;
+  const size_t number_counts[] = { 3, 10007, 123456 };
+  const size_t block_sizes[] = { 0, 1, 100, 3000 };
+  size_t num_tests = 0;
+
+  clrngStatus err;
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
   clrngStream* streams = clrngCreateStreams(creator, stream_count, NULL, &err);
   check_error(err, NULL);
+  // start from a state that is not at the beginning of a block of 4 values
+  fp_type discard[3];
+  err = clrngRandomU01Array(&streams[0], 3, discard);
+  check_error(err, NULL);
+
+  for (size_t c = 0; c < CTEST_ARRAY_SIZE(number_counts); c++) {
+    size_t number_count = number_counts[c];
+    size_t per_stream = (number_count + stream_count - 1) / stream_count;
+    fp_type* device_output = (fp_type*) malloc(number_count * sizeof(fp_type));
+    fp_type* host_output   = (fp_type*) malloc(number_count * sizeof(fp_type));
+
+    for (size_t s = 0; s < stream_count; s++) {
+      clrngStream stream = streams[s];
+      for (size_t i = 0; i < per_stream && s * per_stream + i < number_count; i++)
+        host_output[s * per_stream + i] = clrngRandomU01(&stream);
+    }
+
+    for (size_t b = 0; b < CTEST_ARRAY_SIZE(block_sizes) && ret == EXIT_SUCCESS; b++) {
+      DeviceFillParams params = { stream_count, streams, number_count, block_sizes[b], device_output };
+      ret |= call_with_opencl(dev->platform_index, dev->device_type, dev->device_index, &deviceFill, &params, false);
+      for (size_t i = 0; i < number_count && ret == EXIT_SUCCESS; i++) {
+        if (device_output[i] != host_output[i]) {
+          if (ctestVerbose)
+            printf("\n%4sValues do not match at output index %" SIZE_T_FORMAT " with %" SIZE_T_FORMAT
+                " values and block size %" SIZE_T_FORMAT ".\n", "", i, number_count, block_sizes[b]);
+          ret = EXIT_FAILURE;
+        }
+      }
+      num_tests += number_count;
+    }
 
-  int ret = CTEST_MANGLE_PREC2(checkDeviceRandomArrayHelper)(stream_count, streams, output_ratio, dev);
+    free(device_output);
+    free(host_output);
+  }
 
   err = clrngDestroyStreams(streams);
   check_error(err, NULL);
+  err = clrngDestroyStreamCreator(creator);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngDeviceFillU01() [%s]\n",
+      SUCCESS_STR(ret), num_tests, RNG_TYPE_S, PREC_STR);
 
+  return ret;
+}
+
+
+/*! @brief Compare clrngParallelFillU01() with a sequential fill, for
+ *  different numbers of threads and both layouts.
+ */
+int CTEST_MANGLE_PREC2(checkParallelFill)()
+{
+  int ret = EXIT_SUCCESS;
+  size_t stream_count = 37;
+  size_t output_ratio = 150;
+  size_t output_count = stream_count * output_ratio;
+  const size_t thread_counts[] = { 1, 3, 8, 0 };
+  const cl_uint layouts[] = { CLRNG_FILL_INTERLEAVED, CLRNG_FILL_BLOCKED };
+  clrngStatus err;
+
+  clrngStreamCreator* creator = clrngCopyStreamCreator(NULL, &err);
+  check_error(err, NULL);
+  clrngStream* streams = clrngCreateStreams(creator, stream_count, NULL, &err);
+  check_error(err, NULL);
   err = clrngDestroyStreamCreator(creator);
   check_error(err, NULL);
 
+  // reference, in the interleaved layout
+  clrngStream* expected_streams = clrngCopyStreams(stream_count, streams, &err);
+  check_error(err, NULL);
+  fp_type* expected = (fp_type*) malloc(output_count * sizeof(fp_type));
+  hostRandomArray(stream_count, expected_streams, output_ratio, expected);
+
+  fp_type* output = (fp_type*) malloc(output_count * sizeof(fp_type));
+
+  for (size_t l = 0; l < CTEST_ARRAY_SIZE(layouts); l++) {
+    for (size_t t = 0; t < CTEST_ARRAY_SIZE(thread_counts); t++) {
+      clrngStream* fill_streams = clrngCopyStreams(stream_count, streams, &err);
+      check_error(err, NULL);
+
+      err = clrngParallelFillU01(stream_count, fill_streams, output_count, output, thread_counts[t], layouts[l]);
+      check_error(err, NULL);
+
+      for (size_t i = 0; i < output_ratio && ret == EXIT_SUCCESS; i++) {
+        for (size_t j = 0; j < stream_count && ret == EXIT_SUCCESS; j++) {
+          size_t index = layouts[l] == CLRNG_FILL_BLOCKED ? j * output_ratio + i : i * stream_count + j;
+          if (output[index] != expected[i * stream_count + j]) {
+            if (ctestVerbose)
+              printf("\n%4sValues do not match for stream %" SIZE_T_FORMAT ", value %" SIZE_T_FORMAT
+                  " (%" SIZE_T_FORMAT " threads, layout %u).\n\n", "", j, i, thread_counts[t], layouts[l]);
+            ret = EXIT_FAILURE;
+          }
+        }
+      }
+
+      for (size_t j = 0; j < stream_count && ret == EXIT_SUCCESS; j++)
+        if (CTEST_MANGLE(compareState)(&fill_streams[j].current, &expected_streams[j].current))
+          ret = EXIT_FAILURE;
+
+      err = clrngDestroyStreams(fill_streams);
+      check_error(err, NULL);
+    }
+  }
+
+  // invalid arguments
+  if (clrngParallelFillU01(stream_count, streams, output_count - 1, output, 1, CLRNG_FILL_INTERLEAVED) != CLRNG_INVALID_VALUE)
+    ret = EXIT_FAILURE;
+
+  free(output);
+  free(expected);
+  err = clrngDestroyStreams(expected_streams);
+  check_error(err, NULL);
+  err = clrngDestroyStreams(streams);
+  check_error(err, NULL);
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngParallelFillU01() [%s]\n",
+      SUCCESS_STR(ret), CTEST_ARRAY_SIZE(layouts) * CTEST_ARRAY_SIZE(thread_counts) * output_count, RNG_TYPE_S, PREC_STR);
+
+  return ret;
+}
+
+
+
+/*! @brief Compare clrngHostRandomU01Array() with a sequential fill, for
+ *  different numbers of streams and of threads.
+ */
+int CTEST_MANGLE_PREC2(checkHostRandomArray)()
+{
+  int ret = EXIT_SUCCESS;
+  const size_t stream_counts[] = { 1, 37, 1000 };
+  const size_t thread_counts[] = { 1, 3, 8, 0 };
+  size_t output_ratio = 20;
+  size_t n = 0;
+  clrngStatus err;
+
+  for (size_t c = 0; c < CTEST_ARRAY_SIZE(stream_counts); c++) {
+    size_t stream_count = stream_counts[c];
+    size_t output_count = stream_count * output_ratio;
+
+    clrngStream* streams = clrngCreateStreams(NULL, stream_count, NULL, &err);
+    check_error(err, NULL);
+
+    // reference; the original streams must be left unchanged
+    clrngStream* expected_streams = clrngCopyStreams(stream_count, streams, &err);
+    check_error(err, NULL);
+    fp_type* expected = (fp_type*) malloc(output_count * sizeof(fp_type));
+    hostRandomArray(stream_count, expected_streams, output_ratio, expected);
+    err = clrngRewindStreams(stream_count, expected_streams);
+    check_error(err, NULL);
+
+    fp_type* output = (fp_type*) malloc(output_count * sizeof(fp_type));
+
+    for (size_t t = 0; t < CTEST_ARRAY_SIZE(thread_counts); t++) {
+      err = clrngHostRandomU01Array(stream_count, streams, output_count, output, thread_counts[t]);
+      check_error(err, NULL);
+
+      for (size_t i = 0; i < output_count && ret == EXIT_SUCCESS; i++) {
+        if (output[i] != expected[i]) {
+          if (ctestVerbose)
+            printf("\n%4sValues do not match at index %" SIZE_T_FORMAT " (%" SIZE_T_FORMAT " streams, %" SIZE_T_FORMAT " threads).\n\n",
+                "", i, stream_count, thread_counts[t]);
+          ret = EXIT_FAILURE;
+        }
+      }
+
+      for (size_t j = 0; j < stream_count && ret == EXIT_SUCCESS; j++)
+        if (CTEST_MANGLE(compareState)(&streams[j].current, &expected_streams[j].current))
+          ret = EXIT_FAILURE;
+
+      n += output_count;
+    }
+
+    free(output);
+    free(expected);
+    err = clrngDestroyStreams(expected_streams);
+    check_error(err, NULL);
+    err = clrngDestroyStreams(streams);
+    check_error(err, NULL);
+  }
+
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s clrngHostRandomU01Array() [%s]\n",
+      SUCCESS_STR(ret), n, RNG_TYPE_S, PREC_STR);
+
   return ret;
 }
 
@@ -342,8 +739,9 @@ typedef struct DeviceOperationsParams_ {
   size_t        num_work_items;
   cl_uint       quota_per_work_item;
   cl_int        substream_length;
+  bool          compact_states;
   size_t        streams_size;
-  clrngStream*  streams;
+  void*         streams;
   fp_type*      output;
 } DeviceOperationsParams;
 
@@ -367,7 +765,7 @@ static int deviceOperations(cl_context context, cl_device_id device, cl_command_
       output_count * sizeof(fp_type), NULL, &err);
   check_error(err, "cannot create numbers buffer");
 
-  char source[800];
+  char source[1000];
   char buf[100] = "\000";
   if (data->substream_length > 0) {
     sprintf(buf, "        if (i > 0 && i %% %d == 0) clrng" RNG_TYPE_S "ForwardToNextSubstreams(%" SIZE_T_FORMAT ", s);\n",
@@ -385,25 +783,29 @@ static int deviceOperations(cl_context context, cl_device_id device, cl_command_
       "#include " RNG_DEVICE_HEADER_S "\n"
       "#pragma OPENCL EXTENSION cl_amd_printf : enable\n"
       "#pragma OPENCL EXTENSION cl_amd_fp64 : enable\n"
-      "__kernel void example(__global clrng" RNG_TYPE_S "HostStream* streams, uint quota, __global " DEVICE_FP_TYPE "* out) {\n"
+      "__kernel void example(__global clrng" RNG_TYPE_S "%s* streams, uint quota, __global " DEVICE_FP_TYPE "* out) {\n"
       "    int gid = get_global_id(0);\n"
       "    int gsize = get_global_size(0);\n"
       "    clrng" RNG_TYPE_S "Stream s[%" SIZE_T_FORMAT "];\n"
-      "    clrng" RNG_TYPE_S "CopyOverStreamsFromGlobal(%" SIZE_T_FORMAT ", s, &streams[%" SIZE_T_FORMAT " * gid]);\n"
+      "    clrng" RNG_TYPE_S "CopyOver%sFromGlobal(%" SIZE_T_FORMAT ", s, &streams[%" SIZE_T_FORMAT " * gid]);\n"
       "    for (uint i = 0; i < quota; i++) {\n"
       "%s"
       "        for (uint j = 0; j < %" SIZE_T_FORMAT "; j++)\n"
       "           out[%" SIZE_T_FORMAT " * (i * gsize + gid) + j] = clrng" RNG_TYPE_S "RandomU01(&s[j]);\n"
       "    }\n"
-      "    clrng" RNG_TYPE_S "CopyOverStreamsToGlobal(%" SIZE_T_FORMAT ", &streams[%" SIZE_T_FORMAT " * gid], s);\n"
+      "    clrng" RNG_TYPE_S "CopyOver%sToGlobal(%" SIZE_T_FORMAT ", &streams[%" SIZE_T_FORMAT " * gid], s);\n"
       "}\n",
+      data->compact_states ? "#define CLRNG_NO_REWIND\n" :
       data->substream_length != 0 ? "#define CLRNG_ENABLE_SUBSTREAMS\n" : "",
+      data->compact_states ? "StreamState" : "HostStream",
       data->streams_per_work_item,
+      data->compact_states ? "StreamStates" : "Streams",
       data->streams_per_work_item,
       data->streams_per_work_item,
       buf,
       data->streams_per_work_item,
       data->streams_per_work_item,
+      data->compact_states ? "StreamStates" : "Streams",
       data->streams_per_work_item,
       data->streams_per_work_item);
 
@@ -466,6 +868,10 @@ static int deviceOperations(cl_context context, cl_device_id device, cl_command_
  *  - If `substream_length < 0`, streams are rewound `-substream_length` values
  *    are generated.
  *
+ *  If `compact_states` is true, only the current stream states are sent to the
+ *  device, which uses current-only stream objects (\c CLRNG_NO_REWIND), and
+ *  `substream_length` must be 0.
+ *
  *  With verbose `>= 2`: Display the array after filling.
  */
 int CTEST_MANGLE_PREC2(checkDeviceOperationsHelper)(
@@ -473,6 +879,7 @@ int CTEST_MANGLE_PREC2(checkDeviceOperationsHelper)(
   size_t  num_work_items,
   cl_uint quota_per_work_item,
   cl_int  substream_length,
+  bool    compact_states,
   const DeviceSelect* dev)
 {
   size_t total_streams = num_work_items * streams_per_work_item;
@@ -494,17 +901,31 @@ int CTEST_MANGLE_PREC2(checkDeviceOperationsHelper)(
   err = clrngDestroyStreamCreator(creator);
   check_error(err, NULL);
 
+  clrngStreamState* device_states = NULL;
+  if (compact_states) {
+    device_states = (clrngStreamState*) malloc(total_streams * sizeof(clrngStreamState));
+    err = clrngGetStreamStates(total_streams, device_streams, device_states);
+    check_error(err, NULL);
+  }
+
   DeviceOperationsParams params = {
     streams_per_work_item,
     num_work_items,
     quota_per_work_item,
     substream_length,
-    streams_size,
-    device_streams,
+    compact_states,
+    compact_states ? total_streams * sizeof(clrngStreamState) : streams_size,
+    compact_states ? (void*) device_states : (void*) device_streams,
     device_output
   };
   call_with_opencl(dev->platform_index, dev->device_type, dev->device_index, &deviceOperations, &params, false);
 
+  if (compact_states) {
+    err = clrngSetStreamStates(total_streams, device_streams, device_states);
+    check_error(err, NULL);
+    free(device_states);
+  }
+
   hostOperations(
       streams_per_work_item,
       num_work_items,
@@ -559,10 +980,10 @@ int CTEST_MANGLE_PREC2(checkDeviceOperationsHelper)(
   err = clrngDestroyStreams(host_streams);
   check_error(err, NULL);
 
-  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s device operations (%" SIZE_T_FORMAT ",%" SIZE_T_FORMAT ",%u,%d) [%s]\n",
+  printf("%s  %8" SIZE_T_FORMAT " tests  -  %10s device operations (%" SIZE_T_FORMAT ",%" SIZE_T_FORMAT ",%u,%d%s) [%s]\n",
       SUCCESS_STR(ret), output_count + total_streams, RNG_TYPE_S,
       streams_per_work_item, num_work_items,
-      quota_per_work_item, substream_length, PREC_STR);
+      quota_per_work_item, substream_length, compact_states ? ",compact" : "", PREC_STR);
 
   return ret;
 }
@@ -582,9 +1003,18 @@ int CTEST_MANGLE_PREC2(checkDeviceOperations)(const DeviceSelect* dev)
         num_work_items,
         quota_per_work_item,
         substream_length[i],
+        false,
         dev);
   }
 
+  ret |= CTEST_MANGLE_PREC2(checkDeviceOperationsHelper)(
+      streams_per_work_item,
+      num_work_items,
+      quota_per_work_item,
+      0,
+      true,
+      dev);
+
   return ret;
 }
 
@@ -601,6 +1031,10 @@ int CTEST_MANGLE_PREC2(checkDeviceOperations)(const DeviceSelect* dev)
  */
 int CTEST_MANGLE_PREC2(checkCombinedOperations)()
 {
+#ifdef CTEST_NO_EXPECTED_VALUES
+  fprintf(stderr, "  SKIP     %8s        -  %10s combined operations [%s] (no expected values)\n", "", RNG_TYPE_S, PREC_STR);
+  return EXIT_SUCCESS;
+#else
   fp_type sum;
   fp_type sum3;
   size_t sumi;
@@ -721,4 +1155,5 @@ int CTEST_MANGLE_PREC2(checkCombinedOperations)()
       SUCCESS_STR(ret), 1, RNG_TYPE_S, PREC_STR);
 
   return ret;
+#endif
 }
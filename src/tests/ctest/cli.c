@@ -48,6 +48,9 @@ int ctestMrg31k3p_dispatch (const DeviceSelect* dev);
 int ctestMrg32k3a_dispatch (const DeviceSelect* dev);
 int ctestLfsr113_dispatch  (const DeviceSelect* dev);
 int ctestPhilox432_dispatch(const DeviceSelect* dev);
+int ctestThreefry432_dispatch(const DeviceSelect* dev);
+// defined in cxx_checks.cpp
+int ctestCxx_dispatch(void);
 
 // defined below in this file
 int usage();
@@ -100,6 +103,8 @@ int main(int argc, char** argv)
   ret |= ctestMrg32k3a_dispatch (dev);
   ret |= ctestLfsr113_dispatch  (dev);
   ret |= ctestPhilox432_dispatch(dev);
+  ret |= ctestThreefry432_dispatch(dev);
+  ret |= ctestCxx_dispatch();
   return ret;
 }
 
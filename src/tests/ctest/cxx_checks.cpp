@@ -0,0 +1,254 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+
+/*! @file cxx_checks.cpp
+ *  @brief Tests for the C++ interface (clRNG.hpp).
+ *
+ *  Checks that the inline C++ implementation produces the same values and
+ *  states as the C library.
+ */
+
+#include <clRNG/clRNG.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#if defined(__has_include)
+#if __has_include(<concepts>)
+#include <concepts>
+#endif
+#endif
+
+#define SUCCESS_STR(ret) ((ret) == EXIT_SUCCESS ? "  SUCCESS" : "* FAILURE")
+
+// defined in util.c
+extern "C" int ctestVerbose;
+
+namespace {
+
+// C entry points that are not wrapped by the generator types
+template <class G> struct CApi;
+
+#define CTEST_CXX_CAPI(rng) \
+	template <> struct CApi<clrng::rng> { \
+		static clrng::rng::stream_type* createStreams(clrng::rng::creator_type* c, size_t n, clrngStatus* err) \
+			{ return clrng##rng##CreateStreams(c, n, NULL, err); } \
+		static cl_double u01d(clrng::rng::stream_type* s) { return clrng##rng##RandomU01_cl_double(s); } \
+		static cl_float  u01f(clrng::rng::stream_type* s) { return clrng##rng##RandomU01_cl_float(s); } \
+		static cl_int    randi(clrng::rng::stream_type* s, cl_int i, cl_int j) { return clrng##rng##RandomInteger_cl_double(s, i, j); } \
+		static const char* name() { return #rng; } \
+	};
+CTEST_CXX_CAPI(Mrg31k3p)
+CTEST_CXX_CAPI(Mrg32k3a)
+CTEST_CXX_CAPI(Lfsr113)
+CTEST_CXX_CAPI(Philox432)
+CTEST_CXX_CAPI(Threefry432)
+#undef CTEST_CXX_CAPI
+
+template <class G>
+int checkInterface()
+{
+	using C = CApi<G>;
+	using stream_type = typename G::stream_type;
+
+	static_assert(std::is_unsigned<typename clrng::Stream<G>::result_type>::value, "result_type must be unsigned");
+	static_assert(clrng::Stream<G>::min() < clrng::Stream<G>::max(), "min() must be smaller than max()");
+	static_assert(!std::is_copy_constructible<clrng::StreamArray<G>>::value, "StreamArray must not be copyable");
+	static_assert(std::is_nothrow_move_constructible<clrng::StreamArray<G>>::value, "StreamArray must be movable");
+#ifdef __cpp_lib_concepts
+	static_assert(std::uniform_random_bit_generator<clrng::Stream<G>>, "Stream must be a uniform random bit generator");
+#endif
+
+	int ret = EXIT_SUCCESS;
+	const size_t num_streams = 4;
+	const size_t num_steps = 100;
+	clrngStatus err;
+
+	clrng::Creator<G> creator;
+	clrng::StreamArray<G> streams = creator.createStreams(num_streams);
+
+	typename G::creator_type* ccreator = G::copyCreator(NULL, &err);
+	stream_type* cstreams = C::createStreams(ccreator, num_streams, &err);
+	G::destroyCreator(ccreator);
+
+	// moving transfers ownership
+	clrng::StreamArray<G> moved = std::move(streams);
+	if (!streams.empty() || streams.data() != nullptr || moved.size() != num_streams)
+		ret = EXIT_FAILURE;
+
+	for (size_t i = 0; i < num_streams && ret == EXIT_SUCCESS; i++) {
+		clrng::Stream<G>& stream = moved[i];
+		for (size_t k = 0; k < num_steps && ret == EXIT_SUCCESS; k++) {
+			bool same = true;
+			switch (k % 3) {
+			case 0: same = stream.u01() == C::u01d(&cstreams[i]); break;
+			case 1: same = stream.template u01<cl_float>() == C::u01f(&cstreams[i]); break;
+			case 2: same = stream.randomInteger(-10, 1000) == C::randi(&cstreams[i], -10, 1000); break;
+			}
+			if (!same || std::memcmp(&stream.get(), &cstreams[i], sizeof(stream_type)) != 0) {
+				ret = EXIT_FAILURE;
+				if (ctestVerbose)
+					std::printf("\n%4sValues or states differ for stream %zu at step %zu.\n\n", "", i, k);
+			}
+		}
+	}
+
+	// use with the standard distributions
+	std::uniform_int_distribution<int> dist(0, 9);
+	for (size_t k = 0; k < num_steps && ret == EXIT_SUCCESS; k++) {
+		int x = dist(moved[0]);
+		if (x < 0 || x > 9)
+			ret = EXIT_FAILURE;
+	}
+
+	G::destroyStreams(cstreams);
+
+	std::printf("%s  %8zu tests  -  %10s C++ interface\n",
+		SUCCESS_STR(ret), num_streams * num_steps, C::name());
+
+	return ret;
+}
+
+#ifdef CLRNG_INSTRUMENT
+// draws through the C++ interface update the draw counter as in the C API
+template <class G>
+int checkDraws()
+{
+	int ret = EXIT_SUCCESS;
+	const size_t num_steps = 100;
+
+	clrng::Creator<G> creator;
+	clrng::Stream<G> stream = creator.createStream();
+	for (size_t k = 0; k < num_steps; k++) {
+		switch (k % 4) {
+		case 0: stream(); break;
+		case 1: stream.u01(); break;
+		case 2: stream.template u01<cl_float>(); break;
+		case 3: stream.randomInteger(-10, 1000); break;
+		}
+	}
+	if (stream.get().draws != num_steps) {
+		ret = EXIT_FAILURE;
+		if (ctestVerbose)
+			std::printf("\n%4s%llu draws counted, expected %zu.\n\n", "",
+				(unsigned long long)stream.get().draws, num_steps);
+	}
+
+	std::printf("%s  %8zu tests  -  %10s C++ draw counter\n",
+		SUCCESS_STR(ret), num_steps, CApi<G>::name());
+
+	return ret;
+}
+#endif
+
+// compares a creator with compile-time spacing S with a C creator whose
+// spacing was changed at run time with the same arguments
+template <class G, class S>
+bool sameAsRuntimeSpacing(size_t num_streams)
+{
+	clrng::Creator<G, S> creator;
+	clrng::StreamArray<G> streams = creator.createStreams(num_streams);
+
+	clrng::Creator<G> ccreator;
+	ccreator.rewind();
+	ccreator.changeSpacing(S::e, S::c);
+	clrng::StreamArray<G> cstreams = ccreator.createStreams(num_streams);
+
+	return std::memcmp(streams.data(), cstreams.data(), streams.bufferSize()) == 0;
+}
+
+template <class G>
+int checkSpacing()
+{
+	using Std = clrng::StandardSpacings<G>;
+
+	int ret = EXIT_SUCCESS;
+	const size_t num_streams = 5;
+
+	if (!sameAsRuntimeSpacing<G, clrng::Spacing<0, 5>>(num_streams) ||
+	    !sameAsRuntimeSpacing<G, clrng::Spacing<0, -7>>(num_streams) ||
+	    !sameAsRuntimeSpacing<G, clrng::Spacing<40, -3>>(num_streams) ||
+	    !sameAsRuntimeSpacing<G, clrng::Spacing<100, 17>>(num_streams) ||
+	    !sameAsRuntimeSpacing<G, typename Std::stream>(num_streams))
+		ret = EXIT_FAILURE;
+
+	// the standard stream spacing is that of the default creator
+	clrng::Creator<G, typename Std::stream> creator;
+	clrng::Creator<G> ccreator;
+	ccreator.rewind();
+	for (size_t i = 0; i < num_streams; i++) {
+		clrng::Stream<G> stream = creator.createStream();
+		clrng::Stream<G> cstream = ccreator.createStream();
+		if (std::memcmp(&stream.get(), &cstream.get(), sizeof(stream.get())) != 0)
+			ret = EXIT_FAILURE;
+	}
+
+	// the standard substream spacing is that of clrngForwardToNextSubstreams()
+	clrng::Creator<G, typename Std::substream> subcreator;
+	clrng::Stream<G> substream = subcreator.createStream();
+	substream.nextSubstream();
+	if (std::memcmp(&substream.current(), &subcreator.nextState(), sizeof(substream.current())) != 0)
+		ret = EXIT_FAILURE;
+
+	if (ret != EXIT_SUCCESS && ctestVerbose)
+		std::printf("\n%4sStreams differ from those created with clrngChangeStreamsSpacing().\n\n", "");
+
+	std::printf("%s  %8zu tests  -  %10s C++ compile-time spacing\n",
+		SUCCESS_STR(ret), 6 * num_streams + 1, CApi<G>::name());
+
+	return ret;
+}
+
+} // namespace
+
+extern "C" int ctestCxx_dispatch()
+{
+	int ret = 0;
+	ret |= checkInterface<clrng::Mrg31k3p>();
+	ret |= checkInterface<clrng::Mrg32k3a>();
+	ret |= checkInterface<clrng::Lfsr113>();
+	ret |= checkInterface<clrng::Philox432>();
+	ret |= checkInterface<clrng::Threefry432>();
+#ifdef CLRNG_INSTRUMENT
+	ret |= checkDraws<clrng::Mrg31k3p>();
+	ret |= checkDraws<clrng::Mrg32k3a>();
+	ret |= checkDraws<clrng::Lfsr113>();
+	ret |= checkDraws<clrng::Philox432>();
+	ret |= checkDraws<clrng::Threefry432>();
+#endif
+	ret |= checkSpacing<clrng::Mrg31k3p>();
+	ret |= checkSpacing<clrng::Mrg32k3a>();
+	return ret;
+}
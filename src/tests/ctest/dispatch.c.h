@@ -61,16 +61,34 @@ int CTEST_MANGLE(dispatch)(const DeviceSelect* dev)
   ret |= CTEST_MANGLE(checkRewindStreamCreator)();
   ret |= CTEST_MANGLE(checkChangeStreamsSpacing)();
   ret |= CTEST_MANGLE_PREC(checkRandomInteger,double)();
+  ret |= CTEST_MANGLE_PREC(checkRandomU01_53,double)();
   ret |= CTEST_MANGLE(checkAdvanceStreams)();
   ret |= CTEST_MANGLE(checkRewindStreams)();
   ret |= CTEST_MANGLE(checkForwardToNextSubstreams)();
   ret |= CTEST_MANGLE(checkMakeSubstreams)();
+  ret |= CTEST_MANGLE(checkStreamStates)();
+  ret |= CTEST_MANGLE(checkAllocator)();
+  ret |= CTEST_MANGLE(checkStreamPosition)();
+  ret |= CTEST_MANGLE(checkAbsolutePosition)();
+  ret |= CTEST_MANGLE(checkDeviceStats)();
+  ret |= CTEST_MANGLE(checkDeviceTuning)();
+  ret |= CTEST_MANGLE(checkSerializeStreams)();
+  ret |= CTEST_MANGLE(checkKnownAnswers)();
+  ret |= CTEST_MANGLE(checkKeyedStreams)();
+  ret |= CTEST_MANGLE(checkStreamPool)();
   ret |= CTEST_MANGLE_PREC(checkCombinedOperations,float)();
   ret |= CTEST_MANGLE_PREC(checkCombinedOperations,double)();
+  ret |= CTEST_MANGLE_PREC(checkParallelFill,float)();
+  ret |= CTEST_MANGLE_PREC(checkParallelFill,double)();
+  ret |= CTEST_MANGLE_PREC(checkHostRandomArray,float)();
+  ret |= CTEST_MANGLE_PREC(checkHostRandomArray,double)();
   ret |= CTEST_MANGLE_PREC(checkDeviceOperations,float)(dev);
   ret |= CTEST_MANGLE_PREC(checkDeviceOperations,double)(dev);
   ret |= CTEST_MANGLE_PREC(checkDeviceRandomArray,float)(dev);
   ret |= CTEST_MANGLE_PREC(checkDeviceRandomArray,double)(dev);
+  ret |= CTEST_MANGLE_PREC(checkDeviceFill,float)(dev);
+  ret |= CTEST_MANGLE_PREC(checkDeviceFill,double)(dev);
+  ret |= CTEST_MANGLE(checkDeviceAdvanceStreams)(dev);
 
   return ret;
 }
@@ -79,9 +79,7 @@ clrngStreamState CTEST_MANGLE(expectedForwardToNextSubstreamsStates)[] = {
   {{  24859044U,  748969300U, 2377960193U,  703249964U}}
 };
 
-fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 39.036461095189096682;
-
-#define CTEST_NO_ADVANCE
+fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 37.843733073586193427;
 
 
 #include "checks.c.h"
@@ -35,6 +35,6 @@
 #define CTEST_RNG_HEADER lfsr113
 #include "mangle.h"
 
-fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 39.0364952087402343f;
+fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 37.8437652587890625f;
 
 #include "checks_prec.c.h"
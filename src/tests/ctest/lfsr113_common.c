@@ -44,10 +44,17 @@ void CTEST_MANGLE(writeState)(FILE* file, const clrngStreamState* state)
   fprintf(file, " ]\n");
 }
 
+/*! @brief Compare the bits of the states that are used by the recurrence
+ *
+ *  The low bits of each component are discarded by the next step, and the
+ *  jumps of clrngForwardToNextSubstreams() and clrngAdvanceStreams() do not
+ *  set them in the same way.
+ */
 cl_long CTEST_MANGLE(compareState)(const clrngStreamState* state1, const clrngStreamState* state2)
 {
+  static const cl_uint mask[4] = { (cl_uint)-2, (cl_uint)-8, (cl_uint)-16, (cl_uint)-128 };
   for (size_t i = 0; i < 4; i++) {
-    cl_int diff = state1->g[i] - state2->g[i];
+    cl_int diff = (state1->g[i] & mask[i]) - (state2->g[i] & mask[i]);
     if (diff)
       return diff;
   }
@@ -32,5 +32,4 @@
 
 #define CTEST_RNG_TYPE   Lfsr113
 #define CTEST_RNG_HEADER lfsr113
-#define CTEST_NO_ADVANCE
 #include "dispatch.c.h"
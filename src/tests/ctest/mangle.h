@@ -98,20 +98,35 @@ typedef cl_double fp_type;
 #define clrngStream                     _RNG_MANGLE(Stream)
 #define clrngStreamCreator              _RNG_MANGLE(StreamCreator)
 #define clrngCopyStreamCreator          _RNG_MANGLE(CopyStreamCreator)
+#define clrngCopyStreamCreatorEx        _RNG_MANGLE(CopyStreamCreatorEx)
 #define clrngDestroyStreamCreator       _RNG_MANGLE(DestroyStreamCreator)
 #define clrngRewindStreamCreator        _RNG_MANGLE(RewindStreamCreator)
 #define clrngSetBaseCreatorState        _RNG_MANGLE(SetBaseCreatorState)
 #define clrngChangeStreamsSpacing       _RNG_MANGLE(ChangeStreamsSpacing)
+#define clrngChangeStreamsKeying        _RNG_MANGLE(ChangeStreamsKeying)
+#define clrngMakeKeyedState             _RNG_MANGLE(MakeKeyedState)
 #define clrngAllocStreams               _RNG_MANGLE(AllocStreams)
+#define clrngAllocStreamsEx             _RNG_MANGLE(AllocStreamsEx)
 #define clrngDestroyStreams             _RNG_MANGLE(DestroyStreams)
 #define clrngCreateStreams              _RNG_MANGLE(CreateStreams)
+#define clrngCreateStreamsEx            _RNG_MANGLE(CreateStreamsEx)
 #define clrngCreateOverStreams          _RNG_MANGLE(CreateOverStreams)
 #define clrngCopyStreams                _RNG_MANGLE(CopyStreams)
+#define clrngCopyStreamsEx              _RNG_MANGLE(CopyStreamsEx)
 #define clrngCopyOverStreams            _RNG_MANGLE(CopyOverStreams)
+#define clrngGetStreamStates            _RNG_MANGLE(GetStreamStates)
+#define clrngSetStreamStates            _RNG_MANGLE(SetStreamStates)
+#define clrngGetStreamPosition          _RNG_MANGLE(GetStreamPosition)
+#define clrngPosition                   _RNG_MANGLE(Position)
+#define clrngGetPosition                _RNG_MANGLE(GetPosition)
+#define clrngSetPosition                _RNG_MANGLE(SetPosition)
+#define clrngJumpStreams                _RNG_MANGLE(JumpStreams)
 #define clrngRandomU01                  _RNG_MANGLE(RandomU01)
 #define clrngRandomInteger              _RNG_MANGLE(RandomInteger)
 #define clrngRandomU01Array             _RNG_MANGLE(RandomU01Array)
 #define clrngRandomIntegerArray         _RNG_MANGLE(RandomIntegerArray)
+#define clrngRandomU01_53               _RNG_MANGLE(RandomU01_53)
+#define clrngRandomU01Array_53          _RNG_MANGLE(RandomU01Array_53)
 #define clrngRewindStreams              _RNG_MANGLE(RewindStreams)
 #define clrngRewindSubstreams           _RNG_MANGLE(RewindSubstreams)
 #define clrngForwardToNextSubstreams    _RNG_MANGLE(ForwardToNextSubstreams)
@@ -119,7 +134,23 @@ typedef cl_double fp_type;
 #define clrngMakeOverSubstreams         _RNG_MANGLE(MakeOverSubstreams)
 #define clrngAdvanceStreams             _RNG_MANGLE(AdvanceStreams)
 #define clrngDeviceRandomU01Array       _RNG_MANGLE(DeviceRandomU01Array)
+#define clrngDeviceFillU01              _RNG_MANGLE(DeviceFillU01)
+#define clrngDeviceAdvanceStreams       _RNG_MANGLE(DeviceAdvanceStreams)
+#define clrngParallelFillU01            _RNG_MANGLE(ParallelFillU01)
+#define clrngHostRandomU01Array         _RNG_MANGLE(HostRandomU01Array)
 #define clrngWriteStreamInfo            _RNG_MANGLE(WriteStreamInfo)
+#define clrngSerializeStreams           _RNG_MANGLE(SerializeStreams)
+#define clrngWriteStreams               _RNG_MANGLE(WriteStreams)
+#define clrngDeserializeStreams         _RNG_MANGLE(DeserializeStreams)
+#define clrngReadStreams                _RNG_MANGLE(ReadStreams)
+#define clrngStreamPool                 _RNG_MANGLE(StreamPool)
+#define clrngCreateStreamPool           _RNG_MANGLE(CreateStreamPool)
+#define clrngOpenStreamPool             _RNG_MANGLE(OpenStreamPool)
+#define clrngDestroyStreamPool          _RNG_MANGLE(DestroyStreamPool)
+#define clrngSyncStreamPool             _RNG_MANGLE(SyncStreamPool)
+#define clrngGetStreamPoolSize          _RNG_MANGLE(GetStreamPoolSize)
+#define clrngGetPoolStream              _RNG_MANGLE(GetPoolStream)
+#define clrngCopyPoolStreams            _RNG_MANGLE(CopyPoolStreams)
 
 #include RNG_HOST_HEADER
 
@@ -36,8 +36,44 @@
 
 #define CTEST_SUBSTREAM_STEP_LOG2 66
 #define CTEST_SUBSTREAM_STEP_LIN  0
+#define CTEST_ABSOLUTE_POSITION
+#define CTEST_KEYED_STREAMS
+#define CTEST_KNOWN_ANSWERS CLRNG_PHILOX432_ROUNDS
+
+// Known-answer vectors of Random123 for philox4x32_R:
+// rounds, counter (4 words), key (2 words), output (4 words), lowest word first
+cl_uint CTEST_MANGLE(knownAnswers)[][11] = {
+  {  7, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x5f6fb709, 0x0d893f64, 0x4f121f81, 0x4f730a48 },
+  {  7, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+        0x5207ddc2, 0x45165e59, 0x4d8ee751, 0x8c52f662 },
+  {  7, 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+        0x4dfccaba, 0x190a87f0, 0xc47362ba, 0xb6b5242a },
+  { 10, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+  { 10, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+        0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+  { 10, 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+        0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }
+};
 
 // The following values were generated using Random123:
+#if CLRNG_PHILOX432_ROUNDS == 7
+cl_double CTEST_MANGLE(expectedRandomU01Values)[] = {
+  0.613184740883298218,
+  0.344985707080923021,
+  0.690621678135357797,
+  0.594640280702151358,
+  0.624620273127220571,
+  0.549920145771466196,
+  0.697538586915470660,
+  0.242784806643612683,
+  0.284623573417775333,
+  0.600097831687889993,
+  0.990157546591944993,
+  0.371895252377726138
+};
+#elif CLRNG_PHILOX432_ROUNDS == 10
 cl_double CTEST_MANGLE(expectedRandomU01Values)[] = {
   0.037094080704264343,
   0.693930919165723026,
@@ -52,6 +88,10 @@ cl_double CTEST_MANGLE(expectedRandomU01Values)[] = {
   0.415107050561346114,
   0.787367770797573030
 };
+#else
+// expected values are available for 7 and 10 Philox432 rounds only
+#define CTEST_NO_EXPECTED_VALUES
+#endif
 
 clrngStreamState CTEST_MANGLE(expectedSuccessiveStates)[] = {
   {{{0,0},{0,1}}, {0,0,0,0}, 0},
@@ -83,7 +123,11 @@ clrngStreamState CTEST_MANGLE(expectedForwardToNextSubstreamsStates)[] = {
   {{{0,5},{0,1}}, {0,0,0,0}, 0}
 };
 
+#if CLRNG_PHILOX432_ROUNDS == 7
+fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 45.232707889190990613;
+#elif CLRNG_PHILOX432_ROUNDS == 10
 fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 38.672370329515402432;
+#endif
 
 #define CTEST_STREAMS_SPACING_MULTIPLE_OF_4
 
@@ -35,6 +35,13 @@
 #define CTEST_RNG_HEADER philox432
 #include "mangle.h"
 
+#if CLRNG_PHILOX432_ROUNDS == 7
+fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 45.232719421386718750f;
+#elif CLRNG_PHILOX432_ROUNDS == 10
 fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 38.672428131103515625f;
+#else
+// expected values are available for 7 and 10 Philox432 rounds only
+#define CTEST_NO_EXPECTED_VALUES
+#endif
 
 #include "checks_prec.c.h"
@@ -34,27 +34,4 @@
 #define CTEST_RNG_HEADER philox432
 #include "mangle.h"
 
-void CTEST_MANGLE(writeState)(FILE* file, const clrngStreamState* state)
-{
-  fprintf(file, "[ %u, %u, %u, %u ; [%u] ]\n",
-      state->ctr.H.msb,
-      state->ctr.H.lsb,
-      state->ctr.L.msb,
-      state->ctr.L.lsb,
-      state->deckIndex);
-}
-
-cl_long CTEST_MANGLE(compareState)(const clrngStreamState* state1, const clrngStreamState* state2)
-{
-  cl_long ret;
-  ret = state1->ctr.H.msb - state2->ctr.H.msb;
-  if (ret) return ret;
-  ret = state1->ctr.H.lsb - state2->ctr.H.lsb;
-  if (ret) return ret;
-  ret = state1->ctr.L.msb - state2->ctr.L.msb;
-  if (ret) return ret;
-  ret = state1->ctr.L.lsb - state2->ctr.L.lsb;
-  if (ret) return ret;
-  ret = state1->deckIndex - state2->deckIndex;
-  return ret;
-}
+#include "counter432_common.c.h"
@@ -0,0 +1,102 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+#define CTEST_RNG_TYPE   Threefry432
+#define CTEST_RNG_HEADER threefry432
+#include "mangle.h"
+
+#define CTEST_SUBSTREAM_STEP_LOG2 66
+#define CTEST_SUBSTREAM_STEP_LIN  0
+#define CTEST_ABSOLUTE_POSITION
+#define CTEST_KEYED_STREAMS
+#define CTEST_KNOWN_ANSWERS 20
+
+// Known-answer vectors of Random123 for threefry4x32_R:
+// rounds, counter (4 words), key (2 words), output (4 words), lowest word first
+// (only the vectors whose upper two key words are zero apply to Threefry432)
+cl_uint CTEST_MANGLE(knownAnswers)[][11] = {
+  { 20, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x9c6ca96a, 0xe17eae66, 0xfc10ecd4, 0x5256a7d8 }
+};
+
+// The following values were generated using Random123:
+cl_double CTEST_MANGLE(expectedRandomU01Values)[] = {
+  0.256797897745855153,
+  0.156960745458491147,
+  0.334615180850960314,
+  0.376565256505273283,
+  0.091959698707796633,
+  0.530594108509831131,
+  0.597523121512494981,
+  0.802749436232261360,
+  0.983698244788683951,
+  0.582500825752504170,
+  0.116201531956903636,
+  0.202140302979387343
+};
+
+clrngStreamState CTEST_MANGLE(expectedSuccessiveStates)[] = {
+  {{{0,0},{0,1}}, {0,0,0,0}, 0},
+  {{{0,0},{0,1}}, {0,0,0,0}, 1},
+  {{{0,0},{0,1}}, {0,0,0,0}, 2},
+  {{{0,0},{0,1}}, {0,0,0,0}, 3},
+  {{{0,0},{0,2}}, {0,0,0,0}, 0},
+  {{{0,0},{0,2}}, {0,0,0,0}, 1},
+  {{{0,0},{0,2}}, {0,0,0,0}, 2},
+  {{{0,0},{0,2}}, {0,0,0,0}, 3},
+  {{{0,0},{0,3}}, {0,0,0,0}, 0},
+  {{{0,0},{0,3}}, {0,0,0,0}, 1}
+};
+
+clrngStreamState CTEST_MANGLE(expectedCreateStreamsStates)[] = {
+  {{{ 0,0},{0,1}}, {0,0,0,0}, 0},
+  {{{16,0},{0,1}}, {0,0,0,0}, 0},
+  {{{32,0},{0,1}}, {0,0,0,0}, 0},
+  {{{48,0},{0,1}}, {0,0,0,0}, 0},
+  {{{64,0},{0,1}}, {0,0,0,0}, 0},
+  {{{80,0},{0,1}}, {0,0,0,0}, 0}
+};
+
+clrngStreamState CTEST_MANGLE(expectedForwardToNextSubstreamsStates)[] = {
+  {{{0,1},{0,1}}, {0,0,0,0}, 0},
+  {{{0,2},{0,1}}, {0,0,0,0}, 0},
+  {{{0,3},{0,1}}, {0,0,0,0}, 0},
+  {{{0,4},{0,1}}, {0,0,0,0}, 0},
+  {{{0,5},{0,1}}, {0,0,0,0}, 0}
+};
+
+fp_type CTEST_MANGLE_PREC2(expectedCombinedOperationsValue) = 41.137646417142150312;
+
+#define CTEST_STREAMS_SPACING_MULTIPLE_OF_4
+
+#include "checks.c.h"
+#include "checks_prec.c.h"
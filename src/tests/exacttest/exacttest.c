@@ -0,0 +1,467 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file exacttest.c
+ *  @brief Bit-exactness checks of the host and device paths of all generators
+ *
+ *  For every generator and precision, the values generated one at a time by
+ *  clrngRandomU01() on the host are the reference.  They are compared bit
+ *  for bit with those of the array and multithreaded host functions, of the
+ *  device functions of the library, and of a kernel that uses the device
+ *  API with several streams per work-item, with and without substreams.
+ *  The final states of the streams are compared as well, and the throughput
+ *  of each path is reported.
+ *
+ *  The device checks run on the OpenCL device selected on the command line,
+ *  as for CTest; they are skipped if no OpenCL platform is found.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include "../../client/common.h"
+#include "../generators.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    #define SIZE_T_FORMAT   "Iu"
+#elif defined(__GNUC__)
+    #define SIZE_T_FORMAT   "zu"
+#else
+    #define SIZE_T_FORMAT   "lu"
+#endif
+
+#define SUCCESS_STR(ret) ((ret) == EXIT_SUCCESS ? "  SUCCESS" : "* FAILURE")
+#define PREC_STR(single) ((single) ? "float" : "double")
+#define ARRAY_SIZE(arr)  (sizeof(arr) / sizeof((arr)[0]))
+
+static int verbose = 0;
+
+
+#define STREAM(gen, streams, i) ((void*)((char*)(streams) + (i) * (gen)->streamSize))
+
+
+// Reporting
+
+/*! @brief Compare \c count values with the reference and report the result
+ *
+ *  Value \c i of \c numbers is compared with value `(i % a) * b + i / a` of
+ *  \c expected, which describes the interleaved layout with `a` streams of
+ *  `b` values, or the same layout with `a = count`.
+ */
+static int report(const Generator* gen, const char* what, cl_bool single,
+    size_t count, const void* numbers, const void* expected, size_t a, size_t b,
+    int statesMatch, double seconds)
+{
+  int ret = statesMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+  size_t elem = single ? sizeof(cl_float) : sizeof(cl_double);
+  for (size_t i = 0; i < count && ret == EXIT_SUCCESS; i++) {
+    size_t j = (i % a) * b + i / a;
+    if (memcmp((const char*) numbers + i * elem, (const char*) expected + j * elem, elem) != 0) {
+      ret = EXIT_FAILURE;
+      if (verbose) {
+        double x = single ? ((const cl_float*) numbers)[i]  : ((const cl_double*) numbers)[i];
+        double y = single ? ((const cl_float*) expected)[j] : ((const cl_double*) expected)[j];
+        printf("\n%4sValues do not match at index %" SIZE_T_FORMAT ": %.17g instead of %.17g.\n\n", "", i, x, y);
+      }
+    }
+  }
+  if (!statesMatch && verbose)
+    printf("\n%4sFinal stream states do not match.\n\n", "");
+  char prec[16];
+  sprintf(prec, "[%s]", PREC_STR(single));
+  printf("%s  %8" SIZE_T_FORMAT " values  -  %11s %-44s %-8s", SUCCESS_STR(ret), count, gen->name, what, prec);
+  if (seconds > 0.0)
+    printf("  %8.1f M/s", count / seconds * 1e-6);
+  printf("\n");
+  return ret;
+}
+
+
+// Host checks
+
+typedef struct Setup_ {
+  size_t   streamCount;
+  size_t   perStream;
+  cl_bool  single;
+  void*    streams;     // initial streams
+  void*    expected;    // reference values, in the blocked layout
+  void*    final;       // streams after generating the reference values
+} Setup;
+
+static int hostChecks(const Generator* gen, const Setup* setup)
+{
+  size_t n = setup->streamCount * setup->perStream;
+  size_t elem = setup->single ? sizeof(cl_float) : sizeof(cl_double);
+  void* numbers = malloc(n * elem);
+  int ret = EXIT_SUCCESS;
+  double t;
+
+  // array functions, one stream at a time
+  void* streams = gen->copy(setup->streamCount, setup->streams);
+  t = wall_time();
+  for (size_t s = 0; s < setup->streamCount; s++)
+    check_error(gen->randomU01Array(STREAM(gen, streams, s), setup->perStream, (char*) numbers + s * setup->perStream * elem, setup->single), NULL);
+  t = wall_time() - t;
+  ret |= report(gen, "clrngRandomU01Array()", setup->single, n, numbers, setup->expected, n, 1,
+      gen->sameStates(setup->streamCount, streams, setup->final), t);
+  gen->destroy(streams);
+
+  // multithreaded, in both layouts
+  const cl_uint layouts[] = { CLRNG_FILL_BLOCKED, CLRNG_FILL_INTERLEAVED };
+  const char* layoutNames[] = { "clrngParallelFillU01(BLOCKED)", "clrngParallelFillU01(INTERLEAVED)" };
+  for (size_t k = 0; k < ARRAY_SIZE(layouts); k++) {
+    streams = gen->copy(setup->streamCount, setup->streams);
+    t = wall_time();
+    check_error(gen->parallelFill(setup->streamCount, streams, n, numbers, 0, layouts[k], setup->single), NULL);
+    t = wall_time() - t;
+    size_t a = layouts[k] == CLRNG_FILL_BLOCKED ? n : setup->streamCount;
+    size_t b = layouts[k] == CLRNG_FILL_BLOCKED ? 1 : setup->perStream;
+    ret |= report(gen, layoutNames[k], setup->single, n, numbers, setup->expected, a, b,
+        gen->sameStates(setup->streamCount, streams, setup->final), t);
+    gen->destroy(streams);
+  }
+
+  // from copies of the streams, which are left unchanged
+  streams = gen->copy(setup->streamCount, setup->streams);
+  t = wall_time();
+  check_error(gen->hostRandomArray(setup->streamCount, streams, n, numbers, setup->single), NULL);
+  t = wall_time() - t;
+  ret |= report(gen, "clrngHostRandomU01Array()", setup->single, n, numbers, setup->expected, setup->streamCount, setup->perStream,
+      gen->sameStates(setup->streamCount, streams, setup->streams), t);
+  gen->destroy(streams);
+
+  // full precision, against the scalar version
+  if (!setup->single) {
+    void* streams1 = gen->copy(setup->streamCount, setup->streams);
+    void* streams2 = gen->copy(setup->streamCount, setup->streams);
+    cl_double* expected = (cl_double*) malloc(n * sizeof(cl_double));
+    for (size_t s = 0; s < setup->streamCount; s++)
+      gen->randomU01_53(STREAM(gen, streams1, s), setup->perStream, expected + s * setup->perStream);
+    t = wall_time();
+    for (size_t s = 0; s < setup->streamCount; s++)
+      check_error(gen->randomU01Array_53(STREAM(gen, streams2, s), setup->perStream, (cl_double*) numbers + s * setup->perStream), NULL);
+    t = wall_time() - t;
+    ret |= report(gen, "clrngRandomU01Array_53()", CL_FALSE, n, numbers, expected, n, 1,
+        gen->sameStates(setup->streamCount, streams1, streams2), t);
+    free(expected);
+    gen->destroy(streams1);
+    gen->destroy(streams2);
+  }
+
+  free(numbers);
+  return ret;
+}
+
+
+// Device checks
+
+static const char* kernelPrologue =
+  "#ifndef CLRNG_SINGLE_PRECISION\n"
+  "#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+  "#endif\n";
+
+// Same as the MultiStream example: each work-item uses EXACT_SPWI streams
+// and moves to the next substream, or back to the start of the current
+// one, every EXACT_SUBSTREAM_LENGTH values (if positive or negative)
+static const char* kernelSource =
+  "#define EXACT_CAT_(a, b, c) a ## b ## c\n"
+  "#define EXACT_CAT(a, b, c)  EXACT_CAT_(a, b, c)\n"
+  "#define RNG(ident)          EXACT_CAT(clrng, EXACT_RNG, ident)\n"
+  "#ifdef CLRNG_SINGLE_PRECISION\n"
+  "typedef float fp_type;\n"
+  "#else\n"
+  "typedef double fp_type;\n"
+  "#endif\n"
+  "__kernel void exact(__global RNG(HostStream)* streams, uint quota, __global fp_type* out)\n"
+  "{\n"
+  "  size_t gid = get_global_id(0);\n"
+  "  size_t gsize = get_global_size(0);\n"
+  "  RNG(Stream) s[EXACT_SPWI];\n"
+  "  RNG(CopyOverStreamsFromGlobal)(EXACT_SPWI, s, &streams[EXACT_SPWI * gid]);\n"
+  "  for (uint i = 0; i < quota; i++) {\n"
+  "#if EXACT_SUBSTREAM_LENGTH > 0\n"
+  "    if (i > 0 && i % EXACT_SUBSTREAM_LENGTH == 0)\n"
+  "      RNG(ForwardToNextSubstreams)(EXACT_SPWI, s);\n"
+  "#elif EXACT_SUBSTREAM_LENGTH < 0\n"
+  "    if (i > 0 && i % (-EXACT_SUBSTREAM_LENGTH) == 0)\n"
+  "      RNG(RewindSubstreams)(EXACT_SPWI, s);\n"
+  "#endif\n"
+  "    for (uint j = 0; j < EXACT_SPWI; j++)\n"
+  "      out[EXACT_SPWI * (i * gsize + gid) + j] = RNG(RandomU01)(&s[j]);\n"
+  "  }\n"
+  "  RNG(CopyOverStreamsToGlobal)(EXACT_SPWI, &streams[EXACT_SPWI * gid], s);\n"
+  "}\n";
+
+/*! @brief Host counterpart of the kernel
+ */
+static void hostMultistream(const Generator* gen, size_t spwi, size_t workItems, size_t quota,
+    int substreamLength, void* streams, void* numbers, cl_bool single)
+{
+  size_t elem = single ? sizeof(cl_float) : sizeof(cl_double);
+  for (size_t i = 0; i < quota; i++) {
+    for (size_t gid = 0; gid < workItems; gid++) {
+      void* s = STREAM(gen, streams, spwi * gid);
+      if (i > 0 && substreamLength > 0 && i % substreamLength == 0)
+        check_error(gen->forwardSubstreams(spwi, s), NULL);
+      else if (i > 0 && substreamLength < 0 && i % (-substreamLength) == 0)
+        check_error(gen->rewindSubstreams(spwi, s), NULL);
+      for (size_t j = 0; j < spwi; j++)
+        gen->randomU01(STREAM(gen, s, j), 1, 1, (char*) numbers + (spwi * (i * workItems + gid) + j) * elem, single);
+    }
+  }
+}
+
+static double eventSeconds(cl_event event)
+{
+  cl_ulong start = 0, end = 0;
+  if (clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START, sizeof(start), &start, NULL) != CL_SUCCESS ||
+      clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END,   sizeof(end),   &end,   NULL) != CL_SUCCESS)
+    return 0.0;
+  return (end - start) * 1e-9;
+}
+
+typedef struct DeviceTask_ {
+  const Generator* gen;
+  const Setup*     setup;
+  int              ret;
+} DeviceTask;
+
+static int deviceChecks(cl_context context, cl_device_id device, cl_command_queue queue, void* data)
+{
+  DeviceTask* task = (DeviceTask*) data;
+  const Generator* gen = task->gen;
+  const Setup* setup = task->setup;
+  size_t n = setup->streamCount * setup->perStream;
+  size_t elem = setup->single ? sizeof(cl_float) : sizeof(cl_double);
+  void* numbers = malloc(n * elem);
+  size_t streamsSize = setup->streamCount * gen->streamSize;
+  cl_event event;
+  cl_int err;
+
+  if (!setup->single) {
+    cl_device_fp_config fp64 = 0;
+    clGetDeviceInfo(device, CL_DEVICE_DOUBLE_FP_CONFIG, sizeof(fp64), &fp64, NULL);
+    if (fp64 == 0) {
+      printf("%11s  device does not support double precision; skipped\n", "");
+      free(numbers);
+      return EXIT_SUCCESS;
+    }
+  }
+
+  cl_mem streamsBuf = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, streamsSize, setup->streams, &err);
+  check_error(err, "cannot create streams buffer");
+  cl_mem numbersBuf = clCreateBuffer(context, CL_MEM_READ_WRITE, n * elem, NULL, &err);
+  check_error(err, "cannot create numbers buffer");
+
+  // library kernels
+  check_error(gen->deviceRandomArray(setup->streamCount, streamsBuf, n, numbersBuf, 1, &queue, 0, NULL, &event, setup->single), NULL);
+  check_error(clEnqueueReadBuffer(queue, numbersBuf, CL_TRUE, 0, n * elem, numbers, 1, &event, NULL), "cannot read numbers buffer");
+  task->ret |= report(gen, "clrngDeviceRandomU01Array()", setup->single, n, numbers, setup->expected,
+      setup->streamCount, setup->perStream, 1, eventSeconds(event));
+  clReleaseEvent(event);
+
+  const size_t blockSizes[] = { 0, 100 };
+  for (size_t k = 0; k < ARRAY_SIZE(blockSizes); k++) {
+    char what[64];
+    sprintf(what, "clrngDeviceFillU01(blockSize=%" SIZE_T_FORMAT ")", blockSizes[k]);
+    check_error(gen->deviceFill(setup->streamCount, streamsBuf, n, numbersBuf, blockSizes[k], queue, 0, NULL, &event, setup->single), NULL);
+    check_error(clEnqueueReadBuffer(queue, numbersBuf, CL_TRUE, 0, n * elem, numbers, 1, &event, NULL), "cannot read numbers buffer");
+    task->ret |= report(gen, what, setup->single, n, numbers, setup->expected, n, 1, 1, eventSeconds(event));
+    clReleaseEvent(event);
+  }
+
+  // device API, with several streams per work-item and substreams
+  const size_t spwis[] = { 1, 2, 4 };
+  const int substreamLengths[] = { 0, 0, 100, -100 };
+  const int enableSubstreams[] = { 0, 1, 1, 1 };
+  void* expected = malloc(n * elem);
+  for (size_t k = 0; k < ARRAY_SIZE(spwis); k++) {
+    for (size_t m = 0; m < ARRAY_SIZE(substreamLengths); m++) {
+      size_t spwi = spwis[k];
+      size_t workItems = setup->streamCount / spwi;
+      size_t streamCount = workItems * spwi;
+      cl_uint quota = (cl_uint) setup->perStream;
+      size_t count = streamCount * quota;
+      int substreamLength = substreamLengths[m];
+
+      void* hostStreams = gen->copy(setup->streamCount, setup->streams);
+      hostMultistream(gen, spwi, workItems, quota, substreamLength, hostStreams, expected, setup->single);
+
+      char options[512];
+      sprintf(options, "-DEXACT_RNG=%s -DEXACT_SPWI=%" SIZE_T_FORMAT " -DEXACT_SUBSTREAM_LENGTH=%d%s%s %s",
+          gen->name, spwi, substreamLength,
+          enableSubstreams[m] ? " -DCLRNG_ENABLE_SUBSTREAMS" : "",
+          setup->single ? " -DCLRNG_SINGLE_PRECISION" : "",
+          clrngGetLibraryDeviceIncludes(NULL));
+      const char* sources[] = { kernelPrologue, gen->deviceHeader, kernelSource };
+      cl_program program = clCreateProgramWithSource(context, ARRAY_SIZE(sources), sources, NULL, &err);
+      check_error(err, "cannot create program");
+      err = clBuildProgram(program, 1, &device, options, NULL, NULL);
+      if (err < 0)
+        write_build_log(stderr, program, device);
+      check_error(err, "cannot build program");
+      cl_kernel kernel = clCreateKernel(program, "exact", &err);
+      check_error(err, "cannot create kernel");
+
+      check_error(clEnqueueWriteBuffer(queue, streamsBuf, CL_TRUE, 0, streamsSize, setup->streams, 0, NULL, NULL), "cannot write streams buffer");
+      err  = clSetKernelArg(kernel, 0, sizeof(streamsBuf), &streamsBuf);
+      err |= clSetKernelArg(kernel, 1, sizeof(quota),      &quota);
+      err |= clSetKernelArg(kernel, 2, sizeof(numbersBuf), &numbersBuf);
+      check_error(err, "cannot set kernel arguments");
+      check_error(clEnqueueNDRangeKernel(queue, kernel, 1, NULL, &workItems, NULL, 0, NULL, &event), "cannot enqueue kernel");
+
+      void* deviceStreams = gen->copy(setup->streamCount, setup->streams);
+      check_error(clEnqueueReadBuffer(queue, numbersBuf, CL_TRUE, 0, count * elem, numbers, 1, &event, NULL), "cannot read numbers buffer");
+      check_error(clEnqueueReadBuffer(queue, streamsBuf, CL_TRUE, 0, streamsSize, deviceStreams, 0, NULL, NULL), "cannot read streams buffer");
+
+      char what[64];
+      if (substreamLength != 0)
+        sprintf(what, "kernel(%" SIZE_T_FORMAT " per work-item, %s every %d)", spwi,
+            substreamLength > 0 ? "forward" : "rewind", abs(substreamLength));
+      else
+        sprintf(what, "kernel(%" SIZE_T_FORMAT " per work-item%s)", spwi,
+            enableSubstreams[m] ? ", substreams enabled" : "");
+      task->ret |= report(gen, what, setup->single, count, numbers, expected, count, 1,
+          gen->sameStates(streamCount, deviceStreams, hostStreams), eventSeconds(event));
+
+      clReleaseEvent(event);
+      clReleaseKernel(kernel);
+      clReleaseProgram(program);
+      gen->destroy(hostStreams);
+      gen->destroy(deviceStreams);
+    }
+  }
+  free(expected);
+
+  clReleaseMemObject(numbersBuf);
+  clReleaseMemObject(streamsBuf);
+  free(numbers);
+  return task->ret;
+}
+
+
+static int describeDevice(cl_context context, cl_device_id device, cl_command_queue queue, void* data)
+{
+  // call_with_opencl() outputs the platform and device information
+  return EXIT_SUCCESS;
+}
+
+
+// Command line interface
+
+static const char* global_prog;
+
+static int usage(void)
+{
+  fprintf(stderr, "usage:\n");
+  fprintf(stderr, "    %s [-v] [-n <values>] [CPU|GPU] [<device>] [<platform>]\n", global_prog);
+  fprintf(stderr, "\nwhere:\n");
+  fprintf(stderr, "             <values>: values per stream (default: 1024)\n");
+  fprintf(stderr, "             <device>: device index (starting from 0)\n");
+  fprintf(stderr, "           <platform>: platform index (starting from 0)\n");
+  fprintf(stderr, "      the `-v' switch: describes mismatches\n");
+  return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv)
+{
+  size_t perStream = 1024;
+  // not a multiple of usual work-group sizes
+  size_t streamCount = 1000;
+  cl_device_type deviceType = CL_DEVICE_TYPE_CPU;
+  long deviceIndex = 0, platformIndex = 0;
+
+  global_prog = *argv++; argc--;
+  while (argc >= 1 && (*argv)[0] == '-') {
+    if (strcmp(*argv, "-v") == 0)
+      verbose = 1;
+    else if (argc >= 2 && strcmp(*argv, "-n") == 0) {
+      perStream = strtoul(argv[1], NULL, 10);
+      argv++; argc--;
+    }
+    else
+      return usage();
+    argv++; argc--;
+  }
+  if (argc > 0 && (strcmp(*argv, "CPU") == 0 || strcmp(*argv, "GPU") == 0)) {
+    deviceType = strcmp(*argv, "GPU") == 0 ? CL_DEVICE_TYPE_GPU : CL_DEVICE_TYPE_CPU;
+    argv++; argc--;
+  }
+  if (argc > 0) { deviceIndex   = strtol(*argv++, NULL, 10); argc--; }
+  if (argc > 0) { platformIndex = strtol(*argv++, NULL, 10); argc--; }
+  if (argc > 0 || perStream < 1)
+    return usage();
+
+  cl_uint platformCount = 0;
+  int useDevice = clGetPlatformIDs(0, NULL, &platformCount) == CL_SUCCESS && platformCount > 0;
+  if (!useDevice)
+    printf("No OpenCL platform found; the device checks are skipped.\n");
+  else
+    call_with_opencl((int) platformIndex, deviceType, (int) deviceIndex, describeDevice, NULL, true);
+
+  int ret = EXIT_SUCCESS;
+  for (size_t g = 0; g < generatorCount; g++) {
+    const Generator* gen = &generators[g];
+    for (int single = 0; single <= 1; single++) {
+      size_t elem = single ? sizeof(cl_float) : sizeof(cl_double);
+      Setup setup = { streamCount, perStream, (cl_bool) single, gen->create(streamCount), NULL, NULL };
+      check_error(setup.streams == NULL ? CLRNG_OUT_OF_RESOURCES : CLRNG_SUCCESS, "cannot create streams");
+      setup.final = gen->copy(streamCount, setup.streams);
+      setup.expected = malloc(streamCount * perStream * elem);
+
+      double t = wall_time();
+      for (size_t s = 0; s < streamCount; s++)
+        gen->randomU01(STREAM(gen, setup.final, s), perStream, 1, (char*) setup.expected + s * perStream * elem, setup.single);
+      t = wall_time() - t;
+      ret |= report(gen, "clrngRandomU01() (reference)", setup.single, streamCount * perStream,
+          setup.expected, setup.expected, 1, 1, 1, t);
+
+      ret |= hostChecks(gen, &setup);
+      if (useDevice) {
+        DeviceTask task = { gen, &setup, EXIT_SUCCESS };
+        ret |= call_with_opencl((int) platformIndex, deviceType, (int) deviceIndex, deviceChecks, &task, false);
+      }
+
+      free(setup.expected);
+      gen->destroy(setup.final);
+      gen->destroy(setup.streams);
+    }
+  }
+  return ret;
+}
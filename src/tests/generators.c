@@ -0,0 +1,133 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file generators.c
+ *  @brief Table of the clRNG generators shared by StatTest and ExactTest
+ */
+
+#include <string.h>
+
+#include <clRNG/mrg31k3p.h>
+#include <clRNG/mrg32k3a.h>
+#include <clRNG/lfsr113.h>
+#include <clRNG/philox432.h>
+#include <clRNG/threefry432.h>
+
+#include "generators.h"
+
+#define TESTS_GENERATOR(rng) \
+static void* create##rng(size_t count) \
+{ \
+  return clrng##rng##CreateStreams(NULL, count, NULL, NULL); \
+} \
+static void* copy##rng(size_t count, const void* streams) \
+{ \
+  return clrng##rng##CopyStreams(count, (const clrng##rng##Stream*) streams, NULL); \
+} \
+static clrngStatus destroy##rng(void* streams) \
+{ \
+  return clrng##rng##DestroyStreams((clrng##rng##Stream*) streams); \
+} \
+static clrngStatus forwardSubstreams##rng(size_t count, void* streams) \
+{ \
+  return clrng##rng##ForwardToNextSubstreams(count, (clrng##rng##Stream*) streams); \
+} \
+static clrngStatus rewindSubstreams##rng(size_t count, void* streams) \
+{ \
+  return clrng##rng##RewindSubstreams(count, (clrng##rng##Stream*) streams); \
+} \
+static int sameStates##rng(size_t count, const void* streams1, const void* streams2) \
+{ \
+  const clrng##rng##Stream* s1 = (const clrng##rng##Stream*) streams1; \
+  const clrng##rng##Stream* s2 = (const clrng##rng##Stream*) streams2; \
+  for (size_t i = 0; i < count; i++) \
+    if (memcmp(&s1[i].current, &s2[i].current, sizeof(clrng##rng##StreamState)) != 0) \
+      return 0; \
+  return 1; \
+} \
+static void randomU01##rng(void* stream, size_t count, size_t stride, void* numbers, cl_bool single) \
+{ \
+  for (size_t i = 0; i < count; i++) { \
+    if (single) \
+      ((cl_float*) numbers)[i * stride] = clrng##rng##RandomU01_cl_float((clrng##rng##Stream*) stream); \
+    else \
+      ((cl_double*) numbers)[i * stride] = clrng##rng##RandomU01_cl_double((clrng##rng##Stream*) stream); \
+  } \
+} \
+static clrngStatus randomU01Array##rng(void* stream, size_t count, void* numbers, cl_bool single) \
+{ \
+  return single \
+    ? clrng##rng##RandomU01Array_cl_float ((clrng##rng##Stream*) stream, count, (cl_float*)  numbers) \
+    : clrng##rng##RandomU01Array_cl_double((clrng##rng##Stream*) stream, count, (cl_double*) numbers); \
+} \
+static void randomU01_53##rng(void* stream, size_t count, cl_double* numbers) \
+{ \
+  for (size_t i = 0; i < count; i++) \
+    numbers[i] = clrng##rng##RandomU01_53((clrng##rng##Stream*) stream); \
+} \
+static clrngStatus randomU01Array_53##rng(void* stream, size_t count, cl_double* numbers) \
+{ \
+  return clrng##rng##RandomU01Array_53((clrng##rng##Stream*) stream, count, numbers); \
+} \
+static clrngStatus parallelFill##rng(size_t streamCount, void* streams, size_t numberCount, void* numbers, size_t threadCount, cl_uint layout, cl_bool single) \
+{ \
+  return single \
+    ? clrng##rng##ParallelFillU01_cl_float (streamCount, (clrng##rng##Stream*) streams, numberCount, (cl_float*)  numbers, threadCount, layout) \
+    : clrng##rng##ParallelFillU01_cl_double(streamCount, (clrng##rng##Stream*) streams, numberCount, (cl_double*) numbers, threadCount, layout); \
+} \
+static clrngStatus hostRandomArray##rng(size_t streamCount, const void* streams, size_t numberCount, void* numbers, cl_bool single) \
+{ \
+  return single \
+    ? clrng##rng##HostRandomU01Array_cl_float (streamCount, (const clrng##rng##Stream*) streams, numberCount, (cl_float*)  numbers, 0) \
+    : clrng##rng##HostRandomU01Array_cl_double(streamCount, (const clrng##rng##Stream*) streams, numberCount, (cl_double*) numbers, 0); \
+}
+
+#define TESTS_GENERATOR_ENTRY(rng, header) \
+  { #rng, "#include <clRNG/" header ">\n", sizeof(clrng##rng##Stream), \
+    create##rng, copy##rng, destroy##rng, forwardSubstreams##rng, rewindSubstreams##rng, sameStates##rng, \
+    randomU01##rng, randomU01Array##rng, randomU01_53##rng, randomU01Array_53##rng, parallelFill##rng, hostRandomArray##rng, \
+    clrng##rng##DeviceRandomU01Array_, clrng##rng##DeviceFillU01_ }
+
+TESTS_GENERATOR(Mrg31k3p)
+TESTS_GENERATOR(Mrg32k3a)
+TESTS_GENERATOR(Lfsr113)
+TESTS_GENERATOR(Philox432)
+TESTS_GENERATOR(Threefry432)
+
+const Generator generators[] = {
+  TESTS_GENERATOR_ENTRY(Mrg31k3p,    "mrg31k3p.clh"),
+  TESTS_GENERATOR_ENTRY(Mrg32k3a,    "mrg32k3a.clh"),
+  TESTS_GENERATOR_ENTRY(Lfsr113,     "lfsr113.clh"),
+  TESTS_GENERATOR_ENTRY(Philox432,   "philox432.clh"),
+  TESTS_GENERATOR_ENTRY(Threefry432, "threefry432.clh"),
+};
+const size_t generatorCount = sizeof(generators) / sizeof(generators[0]);
@@ -0,0 +1,86 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file generators.h
+ *  @brief Table of the clRNG generators shared by StatTest and ExactTest
+ *
+ *  Each entry wraps the host API of one generator behind functions that
+ *  take and return untyped arrays of streams, so that the test programs can
+ *  loop over all generators.  Consecutive streams of an array lie
+ *  \c streamSize bytes apart.
+ */
+
+#ifndef TESTS_GENERATORS_H
+#define TESTS_GENERATORS_H
+
+#include <stddef.h>
+
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include <clRNG/clRNG.h>
+
+typedef clrngStatus (*DeviceRandomArrayFunction)(size_t streamCount, cl_mem streams,
+  size_t numberCount, cl_mem outBuffer, cl_uint numQueuesAndEvents,
+  cl_command_queue* commQueues, cl_uint numWaitEvents,
+  const cl_event* waitEvents, cl_event* outEvents, cl_bool singlePrecision);
+typedef clrngStatus (*DeviceFillFunction)(size_t streamCount, cl_mem streams,
+  size_t numberCount, cl_mem outBuffer, size_t blockSize, cl_command_queue queue,
+  cl_uint numWaitEvents, const cl_event* waitEvents, cl_event* outEvent, cl_bool singlePrecision);
+
+typedef struct Generator_ {
+  const char* name;
+  const char* deviceHeader;     // include directive for the kernel
+  size_t      streamSize;
+  void*       (*create)(size_t count);
+  void*       (*copy)(size_t count, const void* streams);
+  clrngStatus (*destroy)(void* streams);
+  clrngStatus (*forwardSubstreams)(size_t count, void* streams);
+  clrngStatus (*rewindSubstreams)(size_t count, void* streams);
+  int         (*sameStates)(size_t count, const void* streams1, const void* streams2);
+  void        (*randomU01)(void* stream, size_t count, size_t stride, void* numbers, cl_bool single);
+  clrngStatus (*randomU01Array)(void* stream, size_t count, void* numbers, cl_bool single);
+  void        (*randomU01_53)(void* stream, size_t count, cl_double* numbers);
+  clrngStatus (*randomU01Array_53)(void* stream, size_t count, cl_double* numbers);
+  clrngStatus (*parallelFill)(size_t streamCount, void* streams, size_t numberCount, void* numbers, size_t threadCount, cl_uint layout, cl_bool single);
+  clrngStatus (*hostRandomArray)(size_t streamCount, const void* streams, size_t numberCount, void* numbers, cl_bool single);
+  DeviceRandomArrayFunction deviceRandomArray;
+  DeviceFillFunction        deviceFill;
+} Generator;
+
+extern const Generator generators[];
+extern const size_t    generatorCount;
+
+#endif // TESTS_GENERATORS_H
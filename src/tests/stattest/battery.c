@@ -0,0 +1,301 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+#include "battery.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+
+// Cell of u in [0,1) among 2^bits cells, after dropping the r most significant bits
+static uint32_t cell(double u, int r, int bits)
+{
+  double x = ldexp(u, r);
+  return (uint32_t) ldexp(x - floor(x), bits);
+}
+
+// Sort a[0..n-1], using tmp[0..n-1] as scratch space
+static void radixSort(uint32_t* a, uint32_t* tmp, size_t n)
+{
+  for (int shift = 0; shift < 32; shift += 8) {
+    size_t start[257] = { 0 };
+    for (size_t i = 0; i < n; i++)
+      start[((a[i] >> shift) & 0xff) + 1]++;
+    for (size_t b = 1; b <= 256; b++)
+      start[b] += start[b - 1];
+    for (size_t i = 0; i < n; i++)
+      tmp[start[(a[i] >> shift) & 0xff]++] = a[i];
+    uint32_t* t = a; a = tmp; tmp = t;
+  }
+}
+
+static double chi2(const double* count, const double* expected, size_t cells)
+{
+  double x = 0.0;
+  for (size_t i = 0; i < cells; i++)
+    x += (count[i] - expected[i]) * (count[i] - expected[i]) / expected[i];
+  return x;
+}
+
+
+// Birthday spacings: m = 2^12 points in k = 2^32 cells made of two successive
+// values of 16 bits each; counts the spacings between sorted points that are
+// equal to another spacing.  The count is approximately Poisson with mean
+// m^3/(4k) = 4.
+static void birthdaySpacings(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  const size_t m = (size_t)1 << 12;
+  size_t reps = n / (2 * m);
+  uint32_t* a = (uint32_t*) malloc(2 * m * sizeof(uint32_t));
+  if (a == NULL) {
+    *stat = *param = NAN;
+    return;
+  }
+  uint32_t* tmp = a + m;
+  double collisions = 0.0;
+  for (size_t r = 0; r < reps; r++, u += 2 * m) {
+    for (size_t i = 0; i < m; i++)
+      a[i] = (cell(u[2 * i], 0, 16) << 16) | cell(u[2 * i + 1], 0, 16);
+    radixSort(a, tmp, m);
+    for (size_t i = m - 1; i > 0; i--)
+      a[i] -= a[i - 1];
+    radixSort(a, tmp, m);
+    for (size_t i = 1; i < m; i++)
+      if (a[i] == a[i - 1])
+        collisions++;
+  }
+  free(a);
+  *stat  = collisions;
+  *param = reps * 4.0;
+}
+
+// Collisions among 2^16 points in 2^24 cells made of three successive values
+// of 8 bits each
+static void collision(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  const size_t m = (size_t)1 << 16;
+  const size_t k = (size_t)1 << 24;
+  size_t reps = n / (3 * m);
+  unsigned char* seen = (unsigned char*) malloc(k / 8);
+  if (seen == NULL) {
+    *stat = *param = NAN;
+    return;
+  }
+  double collisions = 0.0;
+  for (size_t r = 0; r < reps; r++, u += 3 * m) {
+    memset(seen, 0, k / 8);
+    for (size_t i = 0; i < m; i++) {
+      uint32_t c = (cell(u[3 * i], 0, 8) << 16) | (cell(u[3 * i + 1], 0, 8) << 8) | cell(u[3 * i + 2], 0, 8);
+      if (seen[c >> 3] & (1 << (c & 7)))
+        collisions++;
+      else
+        seen[c >> 3] |= (unsigned char)(1 << (c & 7));
+    }
+  }
+  free(seen);
+  // expected number of collisions: m - k + k (1 - 1/k)^m
+  *stat  = collisions;
+  *param = reps * (m + k * expm1(m * log1p(-1.0 / k)));
+}
+
+// Lengths of the gaps between successive values in [0, 1/16), up to 64
+#define GAP_MAX 64
+static void gap(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  const double p = 1.0 / 16;
+  double count[GAP_MAX + 1] = { 0 };
+  double expected[GAP_MAX + 1];
+  size_t length = 0;
+  double hits = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    if (u[i] < p) {
+      count[length < GAP_MAX ? length : GAP_MAX]++;
+      hits++;
+      length = 0;
+    }
+    else
+      length++;
+  }
+  for (size_t j = 0; j < GAP_MAX; j++)
+    expected[j] = hits * p * pow(1.0 - p, (double) j);
+  expected[GAP_MAX] = hits * pow(1.0 - p, (double) GAP_MAX);
+  *stat  = chi2(count, expected, GAP_MAX + 1);
+  *param = GAP_MAX;
+}
+
+// Non-overlapping pairs of successive values in 64 x 64 cells
+static void serial(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  double count[4096] = { 0 };
+  double expected[4096];
+  for (size_t i = 0; i + 1 < n; i += 2)
+    count[(cell(u[i], 0, 6) << 6) | cell(u[i + 1], 0, 6)]++;
+  for (size_t c = 0; c < 4096; c++)
+    expected[c] = (n / 2) / 4096.0;
+  *stat  = chi2(count, expected, 4096);
+  *param = 4095;
+}
+
+// Maurer's universal test on blocks of 8 bits, after dropping r bits; the
+// mean and variance of the statistic for blocks of 8 bits are from Maurer (1992)
+static void maurer(const double* u, size_t n, int r, double* stat, double* param)
+{
+  const size_t L = 8;
+  const size_t Q = 10 << L;
+  size_t last[1 << 8] = { 0 };
+  for (size_t i = 0; i < Q; i++)
+    last[cell(u[i], r, L)] = i + 1;
+  double sum = 0.0;
+  for (size_t i = Q; i < n; i++) {
+    uint32_t b = cell(u[i], r, L);
+    sum += log2((double)(i + 1 - last[b]));
+    last[b] = i + 1;
+  }
+  double K = (double)(n - Q);
+  double c = 0.7 - 0.8 / L + (4.0 + 32.0 / L) * pow(K, -3.0 / L) / 15.0;
+  *stat  = (sum / K - 7.1836656) / (c * sqrt(3.238 / K));
+  *param = 1.0;
+}
+
+static void maurerHigh(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  maurer(u, n, 0, stat, param);
+}
+
+static void maurerLow(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  maurer(u, n, 16, stat, param);
+}
+
+// Correlation between values at the same position in two streams
+static void interStreamCorrelation(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < n; i++)
+    sum += (u[i] - 0.5) * (v[i] - 0.5);
+  // each product has variance 1/144
+  *stat  = 12.0 * sum / sqrt((double) n);
+  *param = 1.0;
+}
+
+// Pairs of values at the same position in two streams, in 64 x 64 cells
+static void interStreamSerial(const double* u, const double* v, size_t n, double* stat, double* param)
+{
+  double count[4096] = { 0 };
+  double expected[4096];
+  for (size_t i = 0; i < n; i++)
+    count[(cell(u[i], 0, 6) << 6) | cell(v[i], 0, 6)]++;
+  for (size_t c = 0; c < 4096; c++)
+    expected[c] = n / 4096.0;
+  *stat  = chi2(count, expected, 4096);
+  *param = 4095;
+}
+
+const StatTest statTests[] = {
+  { "BirthdaySpacings",       STAT_POISSON, 0, birthdaySpacings       },
+  { "Collision",              STAT_POISSON, 0, collision              },
+  { "Gap",                    STAT_CHI2,    0, gap                    },
+  { "Serial",                 STAT_CHI2,    0, serial                 },
+  { "MaurerUniversal",        STAT_NORMAL,  0, maurerHigh             },
+  { "MaurerUniversal r=16",   STAT_NORMAL,  0, maurerLow              },
+  { "InterStreamCorrelation", STAT_NORMAL,  1, interStreamCorrelation },
+  { "InterStreamSerial",      STAT_CHI2,    1, interStreamSerial      },
+};
+const size_t statTestCount = sizeof(statTests) / sizeof(statTests[0]);
+
+
+// Regularized incomplete gamma function P(a,x), by its series, for x < a + 1
+static double gammaSeries(double a, double x)
+{
+  double term = 1.0 / a, sum = term;
+  for (int k = 1; k < 100000 && fabs(term) > fabs(sum) * 1e-16; k++) {
+    term *= x / (a + k);
+    sum += term;
+  }
+  return sum * exp(a * log(x) - x - lgamma(a));
+}
+
+// Regularized incomplete gamma function Q(a,x), by its continued fraction
+// (modified Lentz's method), for x >= a + 1
+static double gammaFraction(double a, double x)
+{
+  const double tiny = 1e-300;
+  double b = x + 1.0 - a, c = 1.0 / tiny, d = 1.0 / b, h = d;
+  for (int i = 1; i < 100000; i++) {
+    double an = -i * (i - a);
+    b += 2.0;
+    d = an * d + b;
+    if (fabs(d) < tiny) d = tiny;
+    c = b + an / c;
+    if (fabs(c) < tiny) c = tiny;
+    d = 1.0 / d;
+    h *= d * c;
+    if (fabs(d * c - 1.0) < 1e-16)
+      break;
+  }
+  return h * exp(a * log(x) - x - lgamma(a));
+}
+
+static double gammaQ(double a, double x)
+{
+  if (x <= 0.0)
+    return 1.0;
+  return x < a + 1.0 ? 1.0 - gammaSeries(a, x) : gammaFraction(a, x);
+}
+
+static double normalRight(double z)
+{
+  return 0.5 * erfc(z / sqrt(2.0));
+}
+
+double statPValue(StatKind kind, double stat, double param)
+{
+  switch (kind) {
+  case STAT_CHI2:
+    // Wilson-Hilferty approximation for many degrees of freedom
+    if (param > 1000.0) {
+      double s = 2.0 / (9.0 * param);
+      return normalRight((cbrt(stat / param) - 1.0 + s) / sqrt(s));
+    }
+    return gammaQ(param / 2.0, stat / 2.0);
+  case STAT_POISSON:
+    // P(X >= stat) = P(stat, param); normal approximation for large means
+    if (param > 1000.0)
+      return normalRight((stat - 0.5 - param) / sqrt(param));
+    return stat <= 0.0 ? 1.0 : 1.0 - gammaQ(stat, param);
+  case STAT_NORMAL:
+    return normalRight(stat / sqrt(param));
+  }
+  return NAN;
+}
@@ -0,0 +1,78 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file battery.h
+ *  @brief Statistical tests of the StatTest program
+ *
+ *  Each test is applied to blocks of \c n uniform values: one block per
+ *  stream, or two blocks from adjacent streams for inter-stream tests.
+ *  The statistics of all blocks are summed and the sum is compared with
+ *  its distribution, which yields a single right-tail p-value per test.
+ */
+
+#ifndef STATTEST_BATTERY_H
+#define STATTEST_BATTERY_H
+
+#include <stddef.h>
+
+typedef enum StatKind_ {
+  STAT_CHI2,      // chi-square statistic; param: degrees of freedom
+  STAT_POISSON,   // count; param: expected value
+  STAT_NORMAL     // centered statistic; param: variance
+} StatKind;
+
+/*! @brief Apply a test to the block \c u (and \c v for inter-stream tests)
+ *
+ *  Stores the statistic of the block in \c stat and its parameter, as
+ *  described by ::StatKind, in \c param.
+ */
+typedef void (*StatFunction)(const double* u, const double* v, size_t n, double* stat, double* param);
+
+typedef struct StatTest_ {
+  const char*  name;
+  StatKind     kind;
+  int          interStream;   // applied to pairs of adjacent streams
+  StatFunction func;
+} StatTest;
+
+extern const StatTest statTests[];
+extern const size_t   statTestCount;
+
+// smallest block size accepted by all tests
+#define STATTEST_MIN_BLOCK (1 << 18)
+
+/*! @brief Right-tail p-value of the sum \c stat of statistics of kind \c kind
+ *         and of summed parameter \c param
+ */
+double statPValue(StatKind kind, double stat, double param);
+
+#endif
@@ -0,0 +1,496 @@
+
+ /*
+ ***********************************************************************
+ Copyright (c) 2015 Advanced Micro Devices, Inc. 
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without 
+ modification, are permitted provided that the following conditions 
+ are met:
+ 
+ 1. Redistributions of source code must retain the above copyright 
+ notice, this list of conditions and the following disclaimer.
+ 
+ 2. Redistributions in binary form must reproduce the above copyright 
+ notice, this list of conditions and the following disclaimer in the 
+ documentation and/or other materials provided with the distribution.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+ "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 
+ A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+ HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+ LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ 
+ ***********************************************************************
+ */
+
+/*! @file stattest.c
+ *  @brief Statistical test battery for the clRNG generators
+ *
+ *  Generates a block of values from each of many streams and applies the
+ *  tests of battery.c to each stream and to each pair of adjacent streams,
+ *  on all processors.  The values are generated by each of the fill paths
+ *  of the library: clrngParallelFillU01() on the host, the SIMD
+ *  clrngRandomU01Array_53() on the host and, if an OpenCL platform is
+ *  found, clrngDeviceFillU01() on a device.  The output of each generator
+ *  can also be piped to an
+ *  external test program, such as the PractRand or TestU01 command line
+ *  tools, as 32-bit words made of the 16 most significant bits of two
+ *  successive values.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#define popen  _popen
+#define pclose _pclose
+#else
+#include <signal.h>
+#include <sys/wait.h>
+#endif
+
+#include "../../client/common.h"
+#include "../generators.h"
+
+#include "battery.h"
+
+// p-values outside of [SUSPECT, 1 - SUSPECT] are reported; those outside of
+// [FAILURE, 1 - FAILURE] make the program fail
+#define SUSPECT 1e-3
+#define FAILURE 1e-6
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    #define SIZE_T_FORMAT   "Iu"
+#elif defined(__GNUC__)
+    #define SIZE_T_FORMAT   "zu"
+#else
+    #define SIZE_T_FORMAT   "lu"
+#endif
+
+
+// Fill paths
+
+/*! @brief Way of generating the values of a batch of streams
+ *
+ *  \c fill stores \c n values of each of the \c slots streams of
+ *  \c streams in \c values, in the blocked layout, and reports its errors.
+ */
+typedef struct Source_ Source;
+struct Source_ {
+  const char*      name;
+  int              (*fill)(const Source* source, const Generator* gen, size_t slots, void* streams, size_t n, double* values, size_t threadCount);
+  cl_context       context;     // device sources only
+  cl_command_queue queue;
+};
+
+static int hostFill(const Source* source, const Generator* gen, size_t slots, void* streams, size_t n, double* values, size_t threadCount)
+{
+  (void) source;
+  clrngStatus err = gen->parallelFill(slots, streams, slots * n, values, threadCount, CLRNG_FILL_BLOCKED, CL_FALSE);
+  if (err != CLRNG_SUCCESS) {
+    fprintf(stderr, "ERROR: %s\n", clrngGetErrorString());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+typedef struct Fill53Job_ {
+  const Generator* gen;
+  void*            streams;
+  size_t           slots;
+  size_t           n;
+  double*          values;
+  clrngStatus*     status;    // one per task
+} Fill53Job;
+
+static void fill53Worker(size_t index, size_t count, void* arg)
+{
+  const Fill53Job* job = (const Fill53Job*) arg;
+  job->status[index] = CLRNG_SUCCESS;
+  for (size_t k = index; k < job->slots && job->status[index] == CLRNG_SUCCESS; k += count)
+    job->status[index] = job->gen->randomU01Array_53((char*) job->streams + k * job->gen->streamSize, job->n, job->values + k * job->n);
+}
+
+static int hostFill53(const Source* source, const Generator* gen, size_t slots, void* streams, size_t n, double* values, size_t threadCount)
+{
+  (void) source;
+  clrngStatus* status = (clrngStatus*) malloc(threadCount * sizeof(clrngStatus));
+  if (status == NULL) {
+    fprintf(stderr, "ERROR: %s: could not allocate memory\n", gen->name);
+    return EXIT_FAILURE;
+  }
+  Fill53Job job = { gen, streams, slots, n, values, status };
+  run_threads(threadCount, fill53Worker, &job);
+  int ret = EXIT_SUCCESS;
+  for (size_t i = 0; i < threadCount; i++)
+    if (status[i] != CLRNG_SUCCESS) {
+      fprintf(stderr, "ERROR: %s: clrngRandomU01Array_53() failed with status %d\n", gen->name, (int) status[i]);
+      ret = EXIT_FAILURE;
+      break;
+    }
+  free(status);
+  return ret;
+}
+
+static int deviceFill(const Source* source, const Generator* gen, size_t slots, void* streams, size_t n, double* values, size_t threadCount)
+{
+  (void) threadCount;
+  cl_int err;
+  cl_event event;
+  cl_mem streamsBuf = clCreateBuffer(source->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, slots * gen->streamSize, streams, &err);
+  if (err != CL_SUCCESS) {
+    fprintf(stderr, "ERROR: %s: cannot create streams buffer (%d)\n", gen->name, (int) err);
+    return EXIT_FAILURE;
+  }
+  cl_mem numbersBuf = clCreateBuffer(source->context, CL_MEM_WRITE_ONLY, slots * n * sizeof(double), NULL, &err);
+  if (err != CL_SUCCESS) {
+    fprintf(stderr, "ERROR: %s: cannot create numbers buffer (%d)\n", gen->name, (int) err);
+    clReleaseMemObject(streamsBuf);
+    return EXIT_FAILURE;
+  }
+
+  int ret = EXIT_SUCCESS;
+  if (gen->deviceFill(slots, streamsBuf, slots * n, numbersBuf, 0, source->queue, 0, NULL, &event, CL_FALSE) != CLRNG_SUCCESS) {
+    fprintf(stderr, "ERROR: %s\n", clrngGetErrorString());
+    ret = EXIT_FAILURE;
+  }
+  else {
+    err = clEnqueueReadBuffer(source->queue, numbersBuf, CL_TRUE, 0, slots * n * sizeof(double), values, 1, &event, NULL);
+    clReleaseEvent(event);
+    if (err != CL_SUCCESS) {
+      fprintf(stderr, "ERROR: %s: cannot read numbers buffer (%d)\n", gen->name, (int) err);
+      ret = EXIT_FAILURE;
+    }
+  }
+  clReleaseMemObject(numbersBuf);
+  clReleaseMemObject(streamsBuf);
+  return ret;
+}
+
+
+// Battery
+
+typedef struct BatchJob_ {
+  const double* values;       // slot k at values + k * n; slot 0 holds the
+                              // previous stream, if any
+  size_t        n;
+  size_t        first;        // index of the stream in slot 1
+  size_t        slots;        // number of streams in the batch
+  size_t        streamCount;
+  double*       stat;         // result of test t for stream s (or streams
+  double*       param;        // s - 1 and s) at index t * streamCount + s
+} BatchJob;
+
+static void batchWorker(size_t index, size_t count, void* arg)
+{
+  const BatchJob* job = (const BatchJob*) arg;
+  for (size_t item = index; item < statTestCount * job->slots; item += count) {
+    size_t t = item / job->slots;
+    size_t k = item % job->slots + 1;
+    size_t s = job->first + k - 1;
+    const double* u = job->values + k * job->n;
+    size_t r = t * job->streamCount + s;
+    if (!statTests[t].interStream)
+      statTests[t].func(u, NULL, job->n, &job->stat[r], &job->param[r]);
+    else if (s > 0)
+      statTests[t].func(u - job->n, u, job->n, &job->stat[r], &job->param[r]);
+  }
+}
+
+static int runBattery(const Generator* gen, const Source* source, size_t streamCount, size_t n, size_t threadCount, int verbose)
+{
+  // one stream per thread at a time, within 512 MiB of values (128 MiB on a
+  // device, where a buffer can be limited to a quarter of the memory)
+  size_t maxValues = source->queue != NULL ? (size_t)1 << 24 : (size_t)1 << 26;
+  size_t batchSize = threadCount;
+  if (batchSize * n > maxValues)
+    batchSize = n < maxValues ? maxValues / n : 1;
+  void*   streams = gen->create(streamCount);
+  double* values  = (double*) malloc((batchSize + 1) * n * sizeof(double));
+  double* stat    = (double*) calloc(statTestCount * streamCount, sizeof(double));
+  double* param   = (double*) calloc(statTestCount * streamCount, sizeof(double));
+  if (streams == NULL || values == NULL || stat == NULL || param == NULL) {
+    fprintf(stderr, "ERROR: %s: could not allocate memory\n", gen->name);
+    if (streams != NULL)
+      gen->destroy(streams);
+    free(values);
+    free(stat);
+    free(param);
+    return EXIT_FAILURE;
+  }
+
+  printf("%s, %s: %" SIZE_T_FORMAT " streams x %" SIZE_T_FORMAT " values, %" SIZE_T_FORMAT " threads\n", gen->name, source->name, streamCount, n, threadCount);
+  double start = wall_time();
+  int ret = EXIT_SUCCESS;
+  int complete = 1;
+
+  for (size_t first = 0; first < streamCount; first += batchSize) {
+    size_t slots = streamCount - first < batchSize ? streamCount - first : batchSize;
+    if (source->fill(source, gen, slots, (char*) streams + first * gen->streamSize, n, values + n, threadCount) != EXIT_SUCCESS) {
+      ret = EXIT_FAILURE;
+      complete = 0;
+      break;
+    }
+    BatchJob job = { values, n, first, slots, streamCount, stat, param };
+    run_threads(threadCount, batchWorker, &job);
+    memcpy(values, values + slots * n, n * sizeof(double));
+  }
+
+  for (size_t t = 0; t < statTestCount && complete; t++) {
+    double sumStat = 0.0, sumParam = 0.0;
+    for (size_t s = 0; s < streamCount; s++) {
+      sumStat  += stat [t * streamCount + s];
+      sumParam += param[t * streamCount + s];
+    }
+    if (statTests[t].interStream && streamCount < 2) {
+      printf("  %-24s  skipped (needs two streams)\n", statTests[t].name);
+      continue;
+    }
+    double p = statPValue(statTests[t].kind, sumStat, sumParam);
+    const char* flag = "";
+    if (!(p >= FAILURE && p <= 1.0 - FAILURE)) {
+      flag = "  FAILURE";
+      ret = EXIT_FAILURE;
+    }
+    else if (p < SUSPECT || p > 1.0 - SUSPECT)
+      flag = "  suspect";
+    if (verbose)
+      printf("  %-24s  p = %-10.4g (statistic %.6g, parameter %.6g)%s\n", statTests[t].name, p, sumStat, sumParam, flag);
+    else
+      printf("  %-24s  p = %.4g%s\n", statTests[t].name, p, flag);
+  }
+  printf("  %.1f s\n", wall_time() - start);
+
+  gen->destroy(streams);
+  free(values);
+  free(stat);
+  free(param);
+  return ret;
+}
+
+
+typedef struct DeviceTask_ {
+  const Generator* gen;
+  size_t           streamCount;
+  size_t           n;
+  size_t           threadCount;
+  int              verbose;
+} DeviceTask;
+
+static int deviceBattery(cl_context context, cl_device_id device, cl_command_queue queue, void* data)
+{
+  const DeviceTask* task = (const DeviceTask*) data;
+  cl_device_fp_config fp64 = 0;
+  clGetDeviceInfo(device, CL_DEVICE_DOUBLE_FP_CONFIG, sizeof(fp64), &fp64, NULL);
+  if (fp64 == 0) {
+    printf("%s, clrngDeviceFillU01(): device does not support double precision; skipped\n", task->gen->name);
+    return EXIT_SUCCESS;
+  }
+  Source source = { "clrngDeviceFillU01()", deviceFill, context, queue };
+  int ret = runBattery(task->gen, &source, task->streamCount, task->n, task->threadCount, task->verbose);
+  // the context is released by call_with_opencl()
+  clrngReleaseContextPrograms(context);
+  return ret;
+}
+
+
+// External test program
+
+static int runExternal(const Generator* gen, const char* command, size_t streamCount, size_t megabytes, size_t threadCount)
+{
+  const size_t chunk = streamCount * 4096;
+  void*     streams = gen->create(streamCount);
+  double*   values  = (double*) malloc(chunk * sizeof(double));
+  uint32_t* words   = (uint32_t*) malloc(chunk / 2 * sizeof(uint32_t));
+  if (streams == NULL || values == NULL || words == NULL) {
+    fprintf(stderr, "ERROR: %s: could not allocate memory\n", gen->name);
+    if (streams != NULL)
+      gen->destroy(streams);
+    free(values);
+    free(words);
+    return EXIT_FAILURE;
+  }
+
+  printf("%s: piping %" SIZE_T_FORMAT " MiB to `%s'\n", gen->name, megabytes, command);
+  fflush(stdout);
+  FILE* pipe = popen(command, "w");
+  size_t remaining = megabytes << 20;
+  while (pipe != NULL && remaining > 0) {
+    if (gen->parallelFill(streamCount, streams, chunk, values, threadCount, CLRNG_FILL_INTERLEAVED, CL_FALSE) != CLRNG_SUCCESS)
+      break;
+    for (size_t i = 0; i < chunk / 2; i++) {
+      uint32_t hi = (uint32_t) (values[2 * i] * 65536.0);
+      uint32_t lo = (uint32_t) (values[2 * i + 1] * 65536.0);
+      words[i] = (hi << 16) | lo;
+    }
+    size_t bytes = chunk / 2 * sizeof(uint32_t) < remaining ? chunk / 2 * sizeof(uint32_t) : remaining;
+    // the command may stop reading before the end
+    if (fwrite(words, 1, bytes, pipe) != bytes)
+      break;
+    remaining -= bytes;
+  }
+  int status = pipe != NULL ? pclose(pipe) : -1;
+
+  int ret = EXIT_SUCCESS;
+#ifndef _WIN32
+  if (status != -1 && WIFEXITED(status))
+    status = WEXITSTATUS(status);
+  if (status == 127)
+    printf("  command not found; skipped\n");
+  else
+#endif
+  if (status != 0) {
+    printf("  FAILURE: exit status %d\n", status);
+    ret = EXIT_FAILURE;
+  }
+
+  gen->destroy(streams);
+  free(values);
+  free(words);
+  return ret;
+}
+
+
+// Command line interface
+
+static const char* global_prog;
+
+static int usage(void)
+{
+  fprintf(stderr, "usage:\n");
+  fprintf(stderr, "    %s [-v] [-g <generator>] [-s <streams>] [-n <log2 values>] [-t <threads>]\n", global_prog);
+  fprintf(stderr, "              [-f <fill>] [-d CPU|GPU] [-x <command> [-m <MiB>] [-X]]\n");
+  fprintf(stderr, "\nwhere:\n");
+  fprintf(stderr, "      <generator>: Mrg31k3p, Mrg32k3a, Lfsr113, Philox432 or Threefry432\n");
+  fprintf(stderr, "                   (default: all of them)\n");
+  fprintf(stderr, "        <streams>: number of streams (default: 256)\n");
+  fprintf(stderr, "    <log2 values>: log2 of the number of values per stream, at least 18\n");
+  fprintf(stderr, "                   (default: 20)\n");
+  fprintf(stderr, "        <threads>: number of threads (default: one per processor)\n");
+  fprintf(stderr, "           <fill>: host, host53 or device, for clrngParallelFillU01(),\n");
+  fprintf(stderr, "                   clrngRandomU01Array_53() or clrngDeviceFillU01() on the\n");
+  fprintf(stderr, "                   first device of the first platform (default: all of them;\n");
+  fprintf(stderr, "                   device only if an OpenCL platform is found)\n");
+  fprintf(stderr, "         CPU|GPU: type of the device (default: CPU)\n");
+  fprintf(stderr, "        <command>: external test program that reads 32-bit words from its\n");
+  fprintf(stderr, "                   standard input, e.g., `RNG_test stdin32'\n");
+  fprintf(stderr, "            <MiB>: amount of data written to <command> (default: 1024)\n");
+  fprintf(stderr, "   the `-X' switch: run only the external test program\n");
+  fprintf(stderr, "   the `-v' switch: display the statistics with the p-values\n");
+  return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv)
+{
+  const char* only = NULL;
+  const char* fill = NULL;
+  const char* command = NULL;
+  cl_device_type deviceType = CL_DEVICE_TYPE_CPU;
+  size_t streamCount = 256;
+  size_t log2Values = 20;
+  size_t threadCount = 0;
+  size_t megabytes = 1024;
+  int externalOnly = 0;
+  int verbose = 0;
+
+  global_prog = *argv++; argc--;
+  while (argc >= 1 && (*argv)[0] == '-') {
+    const char* sw = *argv++; argc--;
+    if (strcmp(sw, "-h") == 0)
+      return usage();
+    else if (strcmp(sw, "-v") == 0)
+      verbose = 1;
+    else if (strcmp(sw, "-X") == 0)
+      externalOnly = 1;
+    else if (argc >= 1 && strcmp(sw, "-g") == 0)
+      only = *argv;
+    else if (argc >= 1 && strcmp(sw, "-f") == 0)
+      fill = *argv;
+    else if (argc >= 1 && strcmp(sw, "-d") == 0 && (strcmp(*argv, "CPU") == 0 || strcmp(*argv, "GPU") == 0))
+      deviceType = strcmp(*argv, "GPU") == 0 ? CL_DEVICE_TYPE_GPU : CL_DEVICE_TYPE_CPU;
+    else if (argc >= 1 && strcmp(sw, "-x") == 0)
+      command = *argv;
+    else if (argc >= 1 && strcmp(sw, "-s") == 0)
+      streamCount = strtoul(*argv, NULL, 10);
+    else if (argc >= 1 && strcmp(sw, "-n") == 0)
+      log2Values = strtoul(*argv, NULL, 10);
+    else if (argc >= 1 && strcmp(sw, "-t") == 0)
+      threadCount = strtoul(*argv, NULL, 10);
+    else if (argc >= 1 && strcmp(sw, "-m") == 0)
+      megabytes = strtoul(*argv, NULL, 10);
+    else {
+      fprintf(stderr, "ERROR: unknown switch or missing value `%s'\n", sw);
+      return usage();
+    }
+    if (strcmp(sw, "-v") != 0 && strcmp(sw, "-X") != 0) {
+      argv++; argc--;
+    }
+  }
+  if (argc > 0 || streamCount < 1 || log2Values > 30 || ((size_t)1 << log2Values) < STATTEST_MIN_BLOCK || (externalOnly && command == NULL))
+    return usage();
+  int useHost   = fill == NULL || strcmp(fill, "host") == 0;
+  int useHost53 = fill == NULL || strcmp(fill, "host53") == 0;
+  int useDevice = fill == NULL || strcmp(fill, "device") == 0;
+  if (!useHost && !useHost53 && !useDevice) {
+    fprintf(stderr, "ERROR: unknown fill path `%s'\n", fill);
+    return usage();
+  }
+  if (threadCount == 0)
+    threadCount = processor_count();
+
+#ifndef _WIN32
+  // a failed write to the external program is reported by fwrite()
+  signal(SIGPIPE, SIG_IGN);
+#endif
+
+  if (useDevice && !externalOnly) {
+    cl_uint platformCount = 0;
+    if (clGetPlatformIDs(0, NULL, &platformCount) != CL_SUCCESS || platformCount == 0) {
+      printf("No OpenCL platform found; the device batteries are skipped.\n");
+      if (fill != NULL)
+        return EXIT_FAILURE;
+      useDevice = 0;
+    }
+  }
+
+  const Source hostSource   = { "clrngParallelFillU01()", hostFill, NULL, NULL };
+  const Source host53Source = { "clrngRandomU01Array_53()", hostFill53, NULL, NULL };
+  int echoVersion = 1;
+  int ret = EXIT_SUCCESS;
+  int found = 0;
+  for (size_t g = 0; g < generatorCount; g++) {
+    if (only != NULL && strcmp(only, generators[g].name) != 0)
+      continue;
+    found = 1;
+    size_t n = (size_t)1 << log2Values;
+    if (!externalOnly && useHost)
+      ret |= runBattery(&generators[g], &hostSource, streamCount, n, threadCount, verbose);
+    if (!externalOnly && useHost53)
+      ret |= runBattery(&generators[g], &host53Source, streamCount, n, threadCount, verbose);
+    if (!externalOnly && useDevice) {
+      DeviceTask task = { &generators[g], streamCount, n, threadCount, verbose };
+      ret |= call_with_opencl(0, deviceType, 0, deviceBattery, &task, echoVersion);
+      echoVersion = 0;
+    }
+    if (command != NULL)
+      ret |= runExternal(&generators[g], command, streamCount, megabytes, threadCount);
+  }
+  if (!found) {
+    fprintf(stderr, "ERROR: unknown generator `%s'\n", only);
+    return usage();
+  }
+  return ret;
+}